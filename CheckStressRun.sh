@@ -0,0 +1,65 @@
+#!/bin/bash
+# This script checks the output of a run of the demo applications with the stress
+# run profile (see profiles/stress.cfg) and fails if the parameters received by an
+# application differ from the parameters sent to it:
+# - the temperature limits printed by the slave applications when they execute a
+#   command to set the temperature limit ("Sx: Temperature limit set to ...") are
+#   checked against the limits printed by the Master Application when it loads the
+#   commands ("MA: Sending command to set the temperature limit in Slave x to ...");
+# - the number of violating channels and the first reported channel of the aggregated
+#   temperature violation reports received by the Master Application ("MA: ... Limit
+#   Violation in Slave x on ... channels (... reported from channel ...)") are checked
+#   against the values printed by the slave applications when they load the reports
+#   ("Sx: Temperature violation detected on ... channels -- Sending report from
+#   channel ...").
+#
+# Every command of a cycle sets a different limit and every report starts from a
+# different channel. Commands and reports may be shed under load, lost in a full
+# OutManager or OutStream, or still in transit at the end of the run: a value may
+# therefore be received fewer times than it was sent but never more often. A value
+# which is received more often than it was sent (for instance because several
+# OutComponents of the same kind shared their parameters) makes the check fail, and
+# so does a run in which an application received no values at all.
+#
+# The script takes the following parameter:
+# 1. The file holding the output of the run
+#
+#====================================================================================
+
+OUT_FILE=$1
+
+awk '
+/^MA: Sending command to set the temperature limit in Slave [12] to / {
+	sent["limit S" $11 " " $13]++
+}
+/^S[12]: Temperature limit set to / {
+	app = substr($1, 1, 2)
+	recv["limit " app " " $6]++
+	nOfRecv[app]++
+}
+/^S[12]: Temperature violation detected on [0-9]+ channels -- Sending report from channel / {
+	app = substr($1, 1, 2)
+	sent["report " app " " $6 " " $13]++
+}
+/^MA: Seq. Counter .* - Limit Violation in Slave [12] on [0-9]+ channels \(/ {
+	recv["report S" $10 " " $12 " " ($18+0)]++
+	nOfRecv["MA"]++
+}
+END {
+	nOfErrors = 0
+	for (v in recv) {
+		if (recv[v] > sent[v]) {
+			printf "Mismatch: %s received %d times but sent %d times\n", v, recv[v], sent[v]
+			nOfErrors++
+		}
+	}
+	printf "Temperature limits received: Slave 1 %d, Slave 2 %d\n", nOfRecv["S1"], nOfRecv["S2"]
+	printf "Aggregated temperature violation reports received by the Master: %d\n", nOfRecv["MA"]
+	if ((nOfRecv["S1"] == 0) || (nOfRecv["S2"] == 0) || (nOfRecv["MA"] == 0)) {
+		printf "Mismatch: no values received\n"
+		nOfErrors++
+	}
+	if (nOfErrors > 0)
+		exit 1
+	printf "All values received match the values sent\n"
+}' $OUT_FILE
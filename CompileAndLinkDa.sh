@@ -0,0 +1,182 @@
+#!/bin/bash
+# This script compiles the Demo Application Common Files and archives them into
+# the static library libcrda.a which is linked by the Master, Slave 1 and Slave 2
+# Applications.
+#
+# The script takes the following parameters:
+# 1. The path of the FW Profile source directory
+# 2. The path of the CORDET FW source directory
+# 3. The path of the demo application source directory
+# 4. The path to the directory where executables are created
+#
+# This script performs the following actions:
+# 1. Compile the Demo Application Common Files
+# 2. Compile the C2 Configuration Files which are common to all Demo Applications
+# 3. Build the libcrda.a library
+# 4. Build the cr_pcktquery packet capture query tool
+# 5. Build the cr_stats statistics reader tool
+# 6. Build the cr_relaybench relay benchmark tool
+# 7. Build the cr_udpbench UDP loss benchmark tool
+# 8. Build the cr_fanoutbench packet fan-out benchmark tool
+# 9. Build the cr_monbench channel monitoring benchmark tool
+# 10. Build the cr_kindbench_10, cr_kindbench_100 and cr_kindbench_1000 kind lookup
+#     benchmark tools on the catalogues generated by GenKindCatalogue.sh
+# 11. Build the cr_recbench packet recorder benchmark tool
+#
+# The common files only use the configuration types and constants which are
+# identical across the three applications. They are therefore compiled once
+# with the #INCLUDE files of the Slave 1 Application.
+#
+# In all cases, compilation is done with the gcov options.
+#
+#====================================================================================
+# Assign variables 
+#====================================================================================
+
+FW_DIR=$1
+CR_DIR=$2
+EXM_DIR=$3
+EXE_DIR=$4
+
+CR_SRC="$CR_DIR"
+
+DA_SRC="$EXM_DIR/CrDemoCommon"
+DA_CNF_SRC="$EXM_DIR/CrConfigDemoCommon"
+DA_APP_CNF_SRC="$EXM_DIR/CrConfigDemoSlave1"
+DA_OBJ="$EXE_DIR/crda"
+DA_TOOL_OBJ="$EXE_DIR/crda/tools"
+
+FW_OBJ="$EXE_DIR"
+
+mkdir -p ${DA_OBJ}
+mkdir -p ${DA_TOOL_OBJ}
+
+#====================================================================================
+# Set the compilation options
+#====================================================================================
+# Use the following definition for linker map
+#OPT="-Os -Wall -c -fmessage-length=0" 
+OPT="-O0 -g3 -Wall -c -fmessage-length=0 -fprofile-arcs -ftest-coverage"  
+
+#====================================================================================
+# Set the include path
+#====================================================================================
+INCLUDE="-I"$FW_DIR" -I"$DA_SRC" -I"$CR_SRC" -I"$DA_CNF_SRC" -I"$DA_APP_CNF_SRC"" 
+
+echo "===================================================================================="
+echo " Compile the Demo Application Common Files "
+echo "===================================================================================="
+function compileCommonFile {
+  gcc $INCLUDE $OPT -o $DA_OBJ/"$1.o" $DA_SRC/"$1.c"
+}
+compileCommonFile "CrDaClientSocket"
+compileCommonFile "CrDaClock"
+compileCommonFile "CrDaOutCmpTempViolation"
+compileCommonFile "CrDaPcktIndex"
+compileCommonFile "CrDaPcktRecorder"
+compileCommonFile "CrDaPcktReplay"
+compileCommonFile "CrDaProfile"
+compileCommonFile "CrDaServerSocket"
+compileCommonFile "CrDaStats"
+compileCommonFile "CrDaTempMonitor"
+compileCommonFile "CrDaTempChannelMonitor"
+compileCommonFile "CrDaTrace"
+compileCommonFile "CrDaSizing"
+compileCommonFile "CrDaOutLane"
+compileCommonFile "CrDaStartUp"
+compileCommonFile "CrDaLoadSm"
+compileCommonFile "CrDaBackpressure"
+compileCommonFile "CrDaUdpLink"
+compileCommonFile "CrDaUdpSocket"
+
+echo "===================================================================================="
+echo " Compile the Common C2 Configuration Files "
+echo "===================================================================================="
+function compileConfigFile {
+  gcc $INCLUDE $OPT -o $DA_OBJ/"$1.o" $DA_CNF_SRC/"$1.c"
+}
+compileConfigFile "CrFwRepErr"
+compileConfigFile "CrFwPckt"
+compileConfigFile "CrFwTime"
+
+echo "===================================================================================="
+echo " Build the libcrda.a library "
+echo "===================================================================================="
+rm -f $EXE_DIR/libcrda.a
+ar rcs $EXE_DIR/libcrda.a $DA_OBJ/*.o
+
+echo "===================================================================================="
+echo " Build the packet capture query tool "
+echo "===================================================================================="
+gcc $INCLUDE $OPT -o $DA_TOOL_OBJ/CrDaPcktQueryMain.o $DA_SRC/CrDaPcktQueryMain.c
+gcc $INCLUDE $OPT -o $DA_TOOL_OBJ/CrFwUtilityFunctions.o $CR_SRC/UtilityFunctions/CrFwUtilityFunctions.c
+gcc -fprofile-arcs -o $EXE_DIR/cr_pcktquery \
+$DA_TOOL_OBJ/CrDaPcktQueryMain.o $DA_TOOL_OBJ/CrFwUtilityFunctions.o $EXE_DIR/libcrda.a \
+$FW_OBJ/FwPrConfig.o $FW_OBJ/FwPrCore.o $FW_OBJ/FwPrDCreate.o $FW_OBJ/FwSmAux.o \
+$FW_OBJ/FwSmConfig.o $FW_OBJ/FwSmCore.o $FW_OBJ/FwSmDCreate.o $FW_OBJ/FwSmSCreate.o -lrt
+
+echo "===================================================================================="
+echo " Build the statistics reader tool "
+echo "===================================================================================="
+gcc $INCLUDE $OPT -o $DA_TOOL_OBJ/CrDaStatsMain.o $DA_SRC/CrDaStatsMain.c
+gcc -fprofile-arcs -o $EXE_DIR/cr_stats $DA_TOOL_OBJ/CrDaStatsMain.o -lrt
+
+echo "===================================================================================="
+echo " Build the relay benchmark tool "
+echo "===================================================================================="
+gcc $INCLUDE $OPT -o $DA_TOOL_OBJ/CrDaRelayBenchMain.o $DA_SRC/CrDaRelayBenchMain.c
+gcc -fprofile-arcs -o $EXE_DIR/cr_relaybench \
+$DA_TOOL_OBJ/CrDaRelayBenchMain.o $DA_TOOL_OBJ/CrFwUtilityFunctions.o $EXE_DIR/libcrda.a \
+$FW_OBJ/FwPrConfig.o $FW_OBJ/FwPrCore.o $FW_OBJ/FwPrDCreate.o $FW_OBJ/FwSmAux.o \
+$FW_OBJ/FwSmConfig.o $FW_OBJ/FwSmCore.o $FW_OBJ/FwSmDCreate.o $FW_OBJ/FwSmSCreate.o -lrt
+
+echo "===================================================================================="
+echo " Build the UDP loss benchmark tool "
+echo "===================================================================================="
+gcc $INCLUDE $OPT -o $DA_TOOL_OBJ/CrDaUdpBenchMain.o $DA_SRC/CrDaUdpBenchMain.c
+gcc -fprofile-arcs -o $EXE_DIR/cr_udpbench \
+$DA_TOOL_OBJ/CrDaUdpBenchMain.o $DA_TOOL_OBJ/CrFwUtilityFunctions.o $EXE_DIR/libcrda.a \
+$FW_OBJ/FwPrConfig.o $FW_OBJ/FwPrCore.o $FW_OBJ/FwPrDCreate.o $FW_OBJ/FwSmAux.o \
+$FW_OBJ/FwSmConfig.o $FW_OBJ/FwSmCore.o $FW_OBJ/FwSmDCreate.o $FW_OBJ/FwSmSCreate.o -lrt
+
+echo "===================================================================================="
+echo " Build the packet fan-out benchmark tool "
+echo "===================================================================================="
+gcc $INCLUDE $OPT -o $DA_TOOL_OBJ/CrDaFanOutBenchMain.o $DA_SRC/CrDaFanOutBenchMain.c
+gcc -fprofile-arcs -o $EXE_DIR/cr_fanoutbench \
+$DA_TOOL_OBJ/CrDaFanOutBenchMain.o $DA_TOOL_OBJ/CrFwUtilityFunctions.o $EXE_DIR/libcrda.a \
+$FW_OBJ/FwPrConfig.o $FW_OBJ/FwPrCore.o $FW_OBJ/FwPrDCreate.o $FW_OBJ/FwSmAux.o \
+$FW_OBJ/FwSmConfig.o $FW_OBJ/FwSmCore.o $FW_OBJ/FwSmDCreate.o $FW_OBJ/FwSmSCreate.o -lrt
+
+echo "===================================================================================="
+echo " Build the channel monitoring benchmark tool "
+echo "===================================================================================="
+gcc $INCLUDE $OPT -o $DA_TOOL_OBJ/CrDaMonBenchMain.o $DA_SRC/CrDaMonBenchMain.c
+gcc -fprofile-arcs -o $EXE_DIR/cr_monbench \
+$DA_TOOL_OBJ/CrDaMonBenchMain.o $DA_TOOL_OBJ/CrFwUtilityFunctions.o $EXE_DIR/libcrda.a \
+$FW_OBJ/FwPrConfig.o $FW_OBJ/FwPrCore.o $FW_OBJ/FwPrDCreate.o $FW_OBJ/FwSmAux.o \
+$FW_OBJ/FwSmConfig.o $FW_OBJ/FwSmCore.o $FW_OBJ/FwSmDCreate.o $FW_OBJ/FwSmSCreate.o -lrt
+
+echo "===================================================================================="
+echo " Build the kind lookup benchmark tools "
+echo "===================================================================================="
+for N_OF_KINDS in 10 100 1000; do
+  KIND_OBJ="$DA_TOOL_OBJ/kind$N_OF_KINDS"
+  ./GenKindCatalogue.sh $N_OF_KINDS $DA_APP_CNF_SRC/CrFwUserConstants.h $KIND_OBJ || exit 1
+  ./GenKindIndex.sh "-I$KIND_OBJ $INCLUDE" $KIND_OBJ/CrDaKindIndexTab.h || exit 1
+  gcc -I$KIND_OBJ $INCLUDE $OPT -o $KIND_OBJ/CrDaKindIndex.o $DA_SRC/CrDaKindIndex.c
+  gcc -I$KIND_OBJ $INCLUDE $OPT -o $KIND_OBJ/CrDaKindBenchMain.o $DA_SRC/CrDaKindBenchMain.c
+  gcc -fprofile-arcs -o $EXE_DIR/cr_kindbench_$N_OF_KINDS \
+  $KIND_OBJ/CrDaKindBenchMain.o $KIND_OBJ/CrDaKindIndex.o $DA_TOOL_OBJ/CrFwUtilityFunctions.o $EXE_DIR/libcrda.a \
+  $FW_OBJ/FwPrConfig.o $FW_OBJ/FwPrCore.o $FW_OBJ/FwPrDCreate.o $FW_OBJ/FwSmAux.o \
+  $FW_OBJ/FwSmConfig.o $FW_OBJ/FwSmCore.o $FW_OBJ/FwSmDCreate.o $FW_OBJ/FwSmSCreate.o -lrt
+done
+
+echo "===================================================================================="
+echo " Build the packet recorder benchmark tool "
+echo "===================================================================================="
+gcc $INCLUDE $OPT -o $DA_TOOL_OBJ/CrDaRecBenchMain.o $DA_SRC/CrDaRecBenchMain.c
+gcc -fprofile-arcs -o $EXE_DIR/cr_recbench \
+$DA_TOOL_OBJ/CrDaRecBenchMain.o $DA_TOOL_OBJ/CrFwUtilityFunctions.o $EXE_DIR/libcrda.a \
+$FW_OBJ/FwPrConfig.o $FW_OBJ/FwPrCore.o $FW_OBJ/FwPrDCreate.o $FW_OBJ/FwSmAux.o \
+$FW_OBJ/FwSmConfig.o $FW_OBJ/FwSmCore.o $FW_OBJ/FwSmDCreate.o $FW_OBJ/FwSmSCreate.o -lrt
@@ -35,6 +35,7 @@ echo "==========================================================================
 gcc $OPT -o $FW_OBJ/FwPrConfig.o $FW_SRC/FwPrConfig.c 
 gcc $OPT -o $FW_OBJ/FwPrCore.o $FW_SRC/FwPrCore.c
 gcc $OPT -o $FW_OBJ/FwPrDCreate.o $FW_SRC/FwPrDCreate.c
+gcc $OPT -o $FW_OBJ/FwPrSCreate.o $FW_SRC/FwPrSCreate.c
 gcc $OPT -o $FW_OBJ/FwSmAux.o $FW_SRC/FwSmAux.c
 gcc $OPT -o $FW_OBJ/FwSmConfig.o $FW_SRC/FwSmConfig.c
 gcc $OPT -o $FW_OBJ/FwSmCore.o $FW_SRC/FwSmCore.c
@@ -0,0 +1,80 @@
+#!/bin/bash
+# This script builds the loopback harness cr_loopback which runs the Master, Slave 1
+# and Slave 2 Applications in one single process (see CrDaLoopbackMain.c).
+# The script assumes that the loopback versions of the three applications are
+# available in relocatable objects cr_master_loopback.o, cr_slave1_loopback.o and
+# cr_slave2_loopback.o (see the "loopback" option of CompileAndLinkMa.sh,
+# CompileAndLinkS1.sh and CompileAndLinkS2.sh).
+#
+# The script takes the following parameters:
+# 1. The path of the FW Profile source directory
+# 2. The path of the CORDET FW source directory
+# 3. The path of the CORDET FW examples directory
+# 4. The path to the directory where executables are created
+# 5. Optional: "heapguard" to build the harness in executable cr_loopback_heapguard
+#    which traps the allocations made in the control cycles of the three
+#    applications (see CrDaHeapGuard.h)
+#
+# This script performs the following actions:
+# 1. Compile the in-memory packet bus, the run profile and the main program of the harness
+# 2. Build the executable of the harness
+#
+# The bus, the run profile and the main program do not use the framework and are therefore
+# compiled without its #INCLUDE files.
+#
+# In all cases, compilation and linking is done with the gcov options.
+#
+#====================================================================================
+# Assign variables
+#====================================================================================
+
+FW_DIR=$1
+CR_DIR=$2
+EXM_DIR=$3
+EXE_DIR=$4
+
+DA_SRC="$EXM_DIR/CrDemoCommon"
+LB_OBJ="$EXE_DIR/loopback"
+LB_EXE="$EXE_DIR/cr_loopback"
+if [ "$5" == "heapguard" ]; then
+  LB_OBJ="$LB_OBJ/heapguard"
+  LB_EXE="$EXE_DIR/cr_loopback_heapguard"
+fi
+
+mkdir -p ${LB_OBJ}
+
+#====================================================================================
+# Set the compilation options
+#====================================================================================
+OPT="-O0 -g3 -Wall -c -fmessage-length=0 -fprofile-arcs -ftest-coverage"
+LNK_OPT=""
+LNK_OBJ=""
+if [ "$5" == "heapguard" ]; then
+  # The heap guard interposes the allocator and the symbols are exported for its backtraces
+  OPT="$OPT -DCR_DA_HEAP_GUARD"
+  LNK_OPT="-rdynamic"
+  LNK_OBJ="$LB_OBJ/CrDaHeapGuard.o"
+fi
+
+#====================================================================================
+# Set the include path
+#====================================================================================
+INCLUDE="-I"$DA_SRC" -I"$EXM_DIR/CrDemoMaster" -I"$EXM_DIR/CrDemoSlave1" -I"$EXM_DIR/CrDemoSlave2""
+
+echo "===================================================================================="
+echo " Compile the loopback harness "
+echo "===================================================================================="
+gcc $INCLUDE $OPT -o $LB_OBJ/CrDaLoopbackBus.o $DA_SRC/CrDaLoopbackBus.c
+gcc $INCLUDE $OPT -o $LB_OBJ/CrDaLoopbackMain.o $DA_SRC/CrDaLoopbackMain.c
+gcc $INCLUDE $OPT -o $LB_OBJ/CrDaProfile.o $DA_SRC/CrDaProfile.c
+if [ "$5" == "heapguard" ]; then
+  gcc $INCLUDE $OPT -o $LB_OBJ/CrDaHeapGuard.o $DA_SRC/CrDaHeapGuard.c
+fi
+
+echo "===================================================================================="
+echo " Build the executable to run the loopback harness "
+echo "===================================================================================="
+gcc -fprofile-arcs $LNK_OPT -o $LB_EXE \
+$LB_OBJ/CrDaLoopbackMain.o $LB_OBJ/CrDaLoopbackBus.o $LB_OBJ/CrDaProfile.o $LNK_OBJ \
+$EXE_DIR/cr_master_loopback.o $EXE_DIR/cr_slave1_loopback.o $EXE_DIR/cr_slave2_loopback.o \
+-lpthread -lrt
@@ -1,13 +1,22 @@
 #!/bin/bash
 # This script compiles and links the Master Application for the C2 Implementation.
 # The script assumes that the FW Profile object files are available for linking
-# in directory $FW_OBJ.
+# in directory $FW_OBJ and that the demo application common files are available
+# in library $DA_LIB (see CompileAndLinkDa.sh).
 #
 # The script takes the following parameters:
 # 1. The path of the FW Profile source directory
 # 2. The path of the CORDET FW source directory
 # 3. The path of the CORDET FW examples directory
 # 4. The path to the directory where executables are created
+# 5. Optional: "replay" to build the replay version of the application in
+#    executable cr_master_replay (see CrDaReplayMain.c) or "loopback" to build the
+#    loopback version of the application in relocatable object cr_master_loopback.o
+#    (see CrDaLoopbackMain.c and CompileAndLinkLb.sh) or "heapguard" to build the
+#    version of the application in executable cr_master_heapguard which traps the
+#    allocations made in the control cycles (see CrDaHeapGuard.h) or "udp" to build
+#    the version of the application in executable cr_master_udp which exchanges its
+#    packets as UDP datagrams (see CrDaUdpSocket.h)
 #
 # This script performs the following actions:
 # 1. Compile the CORDET FW files with the Master Demo #INCLUDE files
@@ -33,6 +42,30 @@ MA_SRC="$EXM_DIR/CrDemoMaster"
 MA_CNF_SRC="$EXM_DIR/CrConfigDemoMaster" 
 MA_OBJ="$EXE_DIR/master"
 
+DA_SRC="$EXM_DIR/CrDemoCommon"
+DA_CNF_SRC="$EXM_DIR/CrConfigDemoCommon"
+DA_LIB="$EXE_DIR/libcrda.a"
+
+MA_EXE="$EXE_DIR/cr_master"
+MA_MAIN="$MA_SRC/CrMaMain.c"
+if [ "$5" == "replay" ]; then
+  MA_OBJ="$MA_OBJ/replay"
+  MA_EXE="$EXE_DIR/cr_master_replay"
+  MA_MAIN="$DA_SRC/CrDaReplayMain.c"
+fi
+if [ "$5" == "loopback" ]; then
+  MA_OBJ="$MA_OBJ/loopback"
+  MA_EXE="$EXE_DIR/cr_master_loopback.o"
+fi
+if [ "$5" == "heapguard" ]; then
+  MA_OBJ="$MA_OBJ/heapguard"
+  MA_EXE="$EXE_DIR/cr_master_heapguard"
+fi
+if [ "$5" == "udp" ]; then
+  MA_OBJ="$MA_OBJ/udp"
+  MA_EXE="$EXE_DIR/cr_master_udp"
+fi
+
 mkdir -p ${MA_OBJ}
 
 #====================================================================================
@@ -41,11 +74,35 @@ mkdir -p ${MA_OBJ}
 # Use the following definition for linker map
 #OPT="-Os -Wall -c -fmessage-length=0" 
 OPT="-O0 -g3 -Wall -c -fmessage-length=0 -fprofile-arcs -ftest-coverage"  
+if [ "$5" == "replay" ]; then
+  OPT="$OPT -DCR_DA_REPLAY"
+fi
+if [ "$5" == "loopback" ]; then
+  OPT="$OPT -DCR_DA_LOOPBACK"
+fi
+if [ "$5" == "heapguard" ]; then
+  OPT="$OPT -DCR_DA_HEAP_GUARD"
+fi
+if [ "$5" == "udp" ]; then
+  OPT="$OPT -DCR_DA_UDP"
+fi
 
 #====================================================================================
 # Set the include path
 #====================================================================================
-INCLUDE="-I"$FW_DIR" -I"$MA_SRC" -I"$CR_SRC" -I"$MA_CNF_SRC"" 
+INCLUDE="-I"$FW_DIR" -I"$MA_SRC" -I"$CR_SRC" -I"$MA_CNF_SRC" -I"$DA_SRC" -I"$DA_CNF_SRC" -I"$MA_OBJ"" 
+
+echo "===================================================================================="
+echo " Compile the Demo Application Common Files which depend on the configuration "
+echo "===================================================================================="
+./GenKindIndex.sh "$INCLUDE" $MA_OBJ/CrDaKindIndexTab.h || exit 1
+gcc $INCLUDE $OPT -o $MA_OBJ/CrDaKindIndex.o $DA_SRC/CrDaKindIndex.c
+if [ "$5" == "loopback" ]; then
+  gcc $INCLUDE $OPT -o $MA_OBJ/CrDaLoopback.o $DA_SRC/CrDaLoopback.c
+fi
+if [ "$5" == "heapguard" ]; then
+  gcc $INCLUDE $OPT -o $MA_OBJ/CrDaHeapGuard.o $DA_SRC/CrDaHeapGuard.c
+fi
 
 echo "===================================================================================="
 echo " Compile all the C2 Implementation Files "
@@ -82,11 +139,7 @@ gcc $INCLUDE $OPT -o $MA_OBJ/"$1.o" $MA_SRC/"$1.c"
 compileMasterFile "CrMaInRepTempViolation"
 compileMasterFile "CrMaOutCmpEnableDisable"
 compileMasterFile "CrMaOutCmpSetTempLimit"
-compileMasterFile "CrMaMain"
-compileMasterFile "CrDaClientSocket"
-compileMasterFile "CrDaOutCmpTempViolation"
-compileMasterFile "CrDaServerSocket"
-compileMasterFile "CrDaTempMonitor"
+gcc $INCLUDE $OPT -o $MA_OBJ/CrMaMain.o $MA_MAIN
 
 echo "===================================================================================="
 echo " Compile the C2 Configuration Files for the Master Application "
@@ -94,10 +147,7 @@ echo "==========================================================================
 function compileConfigFile {
 gcc $INCLUDE $OPT -o $MA_OBJ/"$1.o" $MA_CNF_SRC/"$1.c"
 }
-compileConfigFile "CrFwRepErr"
-compileConfigFile "CrFwPckt"
 compileConfigFile "CrFwRepInCmdOutcome"
-compileConfigFile "CrFwTime"
 compileConfigFile "CrFwAppStartUpProc"
 compileConfigFile "CrFwAppResetProc"
 compileConfigFile "CrFwAppShutdownProc"
@@ -108,19 +158,28 @@ echo "==========================================================================
 # Use following definition for linker map (and remove -fprofile-arcs option)
 #LNKMAP="-Wl,-Map,$EXE_DIR/cr_master.map" 
 LNKMAP=""
-#gcc -o $EXE_DIR/cr_master \
-gcc -fprofile-arcs -o $EXE_DIR/cr_master \
-$FW_OBJ/FwPrConfig.o $FW_OBJ/FwPrCore.o $FW_OBJ/FwPrDCreate.o $FW_OBJ/FwSmAux.o \
+MA_LNK_OBJ="$FW_OBJ/FwPrConfig.o $FW_OBJ/FwPrCore.o $FW_OBJ/FwPrDCreate.o $FW_OBJ/FwPrSCreate.o $FW_OBJ/FwSmAux.o \
 $FW_OBJ/FwSmConfig.o $FW_OBJ/FwSmCore.o $FW_OBJ/FwSmDCreate.o $FW_OBJ/FwSmSCreate.o \
 $MA_OBJ/CrFwAux.o $MA_OBJ/CrFwBaseCmp.o $MA_OBJ/CrFwDummyExecProc.o \
 $MA_OBJ/CrFwInitProc.o $MA_OBJ/CrFwResetProc.o $MA_OBJ/CrFwInCmd.o $MA_OBJ/CrFwInRegistry.o \
 $MA_OBJ/CrFwInManager.o $MA_OBJ/CrFwInRep.o $MA_OBJ/CrFwInRepExecProc.o $MA_OBJ/CrFwInLoader.o \
 $MA_OBJ/CrFwInFactory.o $MA_OBJ/CrFwInStream.o $MA_OBJ/CrFwOutCmp.o $MA_OBJ/CrFwOutFactory.o \
 $MA_OBJ/CrFwOutLoader.o $MA_OBJ/CrFwOutManager.o $MA_OBJ/CrFwOutRegistry.o $MA_OBJ/CrFwOutStream.o $MA_OBJ/CrFwPcktQueue.o \
-$MA_OBJ/CrFwUtilityFunctions.o $MA_OBJ/CrFwPckt.o $MA_OBJ/CrFwRepErr.o $MA_OBJ/CrFwTime.o \
+$MA_OBJ/CrFwUtilityFunctions.o \
 $MA_OBJ/CrFwAppSm.o $MA_OBJ/CrFwAppStartUpProc.o $MA_OBJ/CrFwAppResetProc.o $MA_OBJ/CrFwAppShutdownProc.o \
 $MA_OBJ/CrFwRepInCmdOutcome.o \
 $MA_OBJ/CrMaInRepTempViolation.o $MA_OBJ/CrMaOutCmpEnableDisable.o $MA_OBJ/CrMaOutCmpSetTempLimit.o \
-$MA_OBJ/CrMaMain.o $MA_OBJ/CrDaClientSocket.o $MA_OBJ/CrDaServerSocket.o \
-$MA_OBJ/CrDaOutCmpTempViolation.o $MA_OBJ/CrDaTempMonitor.o \
--lpthread $LNKMAP
+$MA_OBJ/CrMaMain.o $MA_OBJ/CrDaKindIndex.o"
+if [ "$5" == "loopback" ]; then
+  # Link the application into one relocatable object in which all symbols except
+  # its initialization, control cycle and termination functions are local
+  ld -r -d -o $MA_OBJ/CrMaApp.o $MA_LNK_OBJ $MA_OBJ/CrDaLoopback.o $DA_LIB
+  objcopy --keep-global-symbol=CrMaAppInit --keep-global-symbol=CrMaAppExecCycle \
+  --keep-global-symbol=CrMaAppTerm $MA_OBJ/CrMaApp.o $MA_EXE
+elif [ "$5" == "heapguard" ]; then
+  # The heap guard interposes the allocator and the symbols are exported for its backtraces
+  gcc -fprofile-arcs -rdynamic -o $MA_EXE $MA_LNK_OBJ $MA_OBJ/CrDaHeapGuard.o $DA_LIB -lpthread -lrt $LNKMAP
+else
+  #gcc -o $MA_EXE $MA_LNK_OBJ $DA_LIB -lpthread -lrt $LNKMAP
+  gcc -fprofile-arcs -o $MA_EXE $MA_LNK_OBJ $DA_LIB -lpthread -lrt $LNKMAP
+fi
@@ -1,12 +1,22 @@
 #!/bin/bash
 # This script compiles and links the Slave 1 Application for the C2 Implementation.
 # The script assumes that the FW Profile object files are available for linking
-# in directory $FW_OBJ.
+# in directory $FW_OBJ and that the demo application common files are available
+# in library $DA_LIB (see CompileAndLinkDa.sh).
 #
 # The script takes the following parameters:
 # 1. The path of the FW Profile source directory
 # 2. The path of the CORDET FW source directory
-# 3. The path to the directory where executables are created
+# 3. The path of the CORDET FW examples directory
+# 4. The path to the directory where executables are created
+# 5. Optional: "replay" to build the replay version of the application in
+#    executable cr_slave1_replay (see CrDaReplayMain.c) or "loopback" to build the
+#    loopback version of the application in relocatable object cr_slave1_loopback.o
+#    (see CrDaLoopbackMain.c and CompileAndLinkLb.sh) or "heapguard" to build the
+#    version of the application in executable cr_slave1_heapguard which traps the
+#    allocations made in the control cycles (see CrDaHeapGuard.h) or "udp" to build
+#    the version of the application in executable cr_slave1_udp which exchanges its
+#    packets as UDP datagrams (see CrDaUdpSocket.h)
 #
 # This script performs the following actions:
 # 1. Compile the CORDET FW files with the Slave 1 Demo #INCLUDE files
@@ -32,6 +42,30 @@ S1_SRC="$EXM_DIR/CrDemoSlave1"
 S1_CNF_SRC="$EXM_DIR/CrConfigDemoSlave1" 
 S1_OBJ="$EXE_DIR/S1"
 
+DA_SRC="$EXM_DIR/CrDemoCommon"
+DA_CNF_SRC="$EXM_DIR/CrConfigDemoCommon"
+DA_LIB="$EXE_DIR/libcrda.a"
+
+S1_EXE="$EXE_DIR/cr_slave1"
+S1_MAIN="$S1_SRC/CrS1Main.c"
+if [ "$5" == "replay" ]; then
+  S1_OBJ="$S1_OBJ/replay"
+  S1_EXE="$EXE_DIR/cr_slave1_replay"
+  S1_MAIN="$DA_SRC/CrDaReplayMain.c"
+fi
+if [ "$5" == "loopback" ]; then
+  S1_OBJ="$S1_OBJ/loopback"
+  S1_EXE="$EXE_DIR/cr_slave1_loopback.o"
+fi
+if [ "$5" == "heapguard" ]; then
+  S1_OBJ="$S1_OBJ/heapguard"
+  S1_EXE="$EXE_DIR/cr_slave1_heapguard"
+fi
+if [ "$5" == "udp" ]; then
+  S1_OBJ="$S1_OBJ/udp"
+  S1_EXE="$EXE_DIR/cr_slave1_udp"
+fi
+
 mkdir -p ${S1_OBJ}
 
 #====================================================================================
@@ -40,11 +74,35 @@ mkdir -p ${S1_OBJ}
 # Use the following definition for linker map
 #OPT="-Os -Wall -c -fmessage-length=0" 
 OPT="-O0 -g3 -Wall -c -fmessage-length=0 -fprofile-arcs -ftest-coverage"  
+if [ "$5" == "replay" ]; then
+  OPT="$OPT -DCR_DA_REPLAY"
+fi
+if [ "$5" == "loopback" ]; then
+  OPT="$OPT -DCR_DA_LOOPBACK"
+fi
+if [ "$5" == "heapguard" ]; then
+  OPT="$OPT -DCR_DA_HEAP_GUARD"
+fi
+if [ "$5" == "udp" ]; then
+  OPT="$OPT -DCR_DA_UDP"
+fi
 
 #====================================================================================
 # Set the include path
 #====================================================================================
-INCLUDE="-I"$FW_DIR" -I"$S1_SRC" -I"$CR_SRC" -I"$S1_CNF_SRC"" 
+INCLUDE="-I"$FW_DIR" -I"$S1_SRC" -I"$CR_SRC" -I"$S1_CNF_SRC" -I"$DA_SRC" -I"$DA_CNF_SRC" -I"$S1_OBJ"" 
+
+echo "===================================================================================="
+echo " Compile the Demo Application Common Files which depend on the configuration "
+echo "===================================================================================="
+./GenKindIndex.sh "$INCLUDE" $S1_OBJ/CrDaKindIndexTab.h || exit 1
+gcc $INCLUDE $OPT -o $S1_OBJ/CrDaKindIndex.o $DA_SRC/CrDaKindIndex.c
+if [ "$5" == "loopback" ]; then
+  gcc $INCLUDE $OPT -o $S1_OBJ/CrDaLoopback.o $DA_SRC/CrDaLoopback.c
+fi
+if [ "$5" == "heapguard" ]; then
+  gcc $INCLUDE $OPT -o $S1_OBJ/CrDaHeapGuard.o $DA_SRC/CrDaHeapGuard.c
+fi
 
 echo "===================================================================================="
 echo " Compile all the C2 Implementation Files "
@@ -73,13 +131,9 @@ gcc $INCLUDE $OPT -o $S1_OBJ/CrFwUtilityFunctions.o $CR_SRC/UtilityFunctions/CrF
 gcc $INCLUDE $OPT -o $S1_OBJ/CrFwAppSm.o $CR_SRC/AppStartUp/CrFwAppSm.c
 
 echo "===================================================================================="
-echo " Compile the Demo Application Common Files "
+echo " Compile the Slave 1 Demo Files "
 echo "===================================================================================="
-gcc $INCLUDE $OPT -o $S1_OBJ/CrS1Main.o $S1_SRC/CrS1Main.c
-gcc $INCLUDE $OPT -o $S1_OBJ/CrDaClientSocket.o $S1_SRC/CrDaClientSocket.c
-gcc $INCLUDE $OPT -o $S1_OBJ/CrDaOutCmpTempViolation.o $S1_SRC/CrDaOutCmpTempViolation.c
-gcc $INCLUDE $OPT -o $S1_OBJ/CrDaServerSocket.o $S1_SRC/CrDaServerSocket.c
-gcc $INCLUDE $OPT -o $S1_OBJ/CrDaTempMonitor.o $S1_SRC/CrDaTempMonitor.c
+gcc $INCLUDE $OPT -o $S1_OBJ/CrS1Main.o $S1_MAIN
 
 echo "===================================================================================="
 echo " Compile the C2 Configuration Files for the Slave 1 Application "
@@ -87,10 +141,7 @@ echo "==========================================================================
 function compileConfigFile {
   gcc $INCLUDE $OPT -o $S1_OBJ/"$1.o" $S1_CNF_SRC/"$1.c"
 }
-compileConfigFile "CrFwRepErr"
-compileConfigFile "CrFwPckt"
 compileConfigFile "CrFwRepInCmdOutcome"
-compileConfigFile "CrFwTime"
 compileConfigFile "CrFwAppStartUpProc"
 compileConfigFile "CrFwAppResetProc"
 compileConfigFile "CrFwAppShutdownProc"
@@ -101,18 +152,27 @@ echo "==========================================================================
 # Use following definition for linker map (and remove -fprofile-arcs option)
 #LNKMAP="-Wl,-Map,$EXE_DIR/cr_Slave 1.map" 
 LNKMAP=""
-#gcc -o $EXE_DIR/cr_Slave 1 \
-gcc -fprofile-arcs -o $EXE_DIR/cr_slave1 \
-$FW_OBJ/FwPrConfig.o $FW_OBJ/FwPrCore.o $FW_OBJ/FwPrDCreate.o $FW_OBJ/FwSmAux.o \
+S1_LNK_OBJ="$FW_OBJ/FwPrConfig.o $FW_OBJ/FwPrCore.o $FW_OBJ/FwPrDCreate.o $FW_OBJ/FwPrSCreate.o $FW_OBJ/FwSmAux.o \
 $FW_OBJ/FwSmConfig.o $FW_OBJ/FwSmCore.o $FW_OBJ/FwSmDCreate.o $FW_OBJ/FwSmSCreate.o \
 $S1_OBJ/CrFwAux.o $S1_OBJ/CrFwBaseCmp.o $S1_OBJ/CrFwDummyExecProc.o \
 $S1_OBJ/CrFwInitProc.o $S1_OBJ/CrFwResetProc.o $S1_OBJ/CrFwInCmd.o $S1_OBJ/CrFwInRegistry.o \
 $S1_OBJ/CrFwInManager.o $S1_OBJ/CrFwInRep.o $S1_OBJ/CrFwInRepExecProc.o $S1_OBJ/CrFwInLoader.o \
 $S1_OBJ/CrFwInFactory.o $S1_OBJ/CrFwInStream.o $S1_OBJ/CrFwOutCmp.o $S1_OBJ/CrFwOutFactory.o \
 $S1_OBJ/CrFwOutLoader.o $S1_OBJ/CrFwOutManager.o $S1_OBJ/CrFwOutRegistry.o $S1_OBJ/CrFwOutStream.o $S1_OBJ/CrFwPcktQueue.o \
-$S1_OBJ/CrFwUtilityFunctions.o $S1_OBJ/CrFwPckt.o $S1_OBJ/CrFwRepErr.o $S1_OBJ/CrFwTime.o \
+$S1_OBJ/CrFwUtilityFunctions.o \
 $S1_OBJ/CrFwAppSm.o $S1_OBJ/CrFwAppStartUpProc.o $S1_OBJ/CrFwAppResetProc.o $S1_OBJ/CrFwAppShutdownProc.o \
 $S1_OBJ/CrFwRepInCmdOutcome.o \
-$S1_OBJ/CrS1Main.o $S1_OBJ/CrDaClientSocket.o $S1_OBJ/CrDaServerSocket.o \
-$S1_OBJ/CrDaOutCmpTempViolation.o $S1_OBJ/CrDaTempMonitor.o \
--lpthread $LNKMAP
+$S1_OBJ/CrS1Main.o $S1_OBJ/CrDaKindIndex.o"
+if [ "$5" == "loopback" ]; then
+  # Link the application into one relocatable object in which all symbols except
+  # its initialization, control cycle and termination functions are local
+  ld -r -d -o $S1_OBJ/CrS1App.o $S1_LNK_OBJ $S1_OBJ/CrDaLoopback.o $DA_LIB
+  objcopy --keep-global-symbol=CrS1AppInit --keep-global-symbol=CrS1AppExecCycle \
+  --keep-global-symbol=CrS1AppTerm $S1_OBJ/CrS1App.o $S1_EXE
+elif [ "$5" == "heapguard" ]; then
+  # The heap guard interposes the allocator and the symbols are exported for its backtraces
+  gcc -fprofile-arcs -rdynamic -o $S1_EXE $S1_LNK_OBJ $S1_OBJ/CrDaHeapGuard.o $DA_LIB -lpthread -lrt $LNKMAP
+else
+  #gcc -o $S1_EXE $S1_LNK_OBJ $DA_LIB -lpthread -lrt $LNKMAP
+  gcc -fprofile-arcs -o $S1_EXE $S1_LNK_OBJ $DA_LIB -lpthread -lrt $LNKMAP
+fi
@@ -1,12 +1,22 @@
 #!/bin/bash
 # This script compiles and links the Slave 2 Application for the C2 Implementation.
 # The script assumes that the FW Profile object files are available for linking
-# in directory $FW_OBJ.
+# in directory $FW_OBJ and that the demo application common files are available
+# in library $DA_LIB (see CompileAndLinkDa.sh).
 #
 # The script takes the following parameters:
 # 1. The path of the FW Profile source directory
 # 2. The path of the CORDET FW source directory
-# 3. The path to the directory where executables are created
+# 3. The path of the CORDET FW examples directory
+# 4. The path to the directory where executables are created
+# 5. Optional: "replay" to build the replay version of the application in
+#    executable cr_slave2_replay (see CrDaReplayMain.c) or "loopback" to build the
+#    loopback version of the application in relocatable object cr_slave2_loopback.o
+#    (see CrDaLoopbackMain.c and CompileAndLinkLb.sh) or "heapguard" to build the
+#    version of the application in executable cr_slave2_heapguard which traps the
+#    allocations made in the control cycles (see CrDaHeapGuard.h) or "udp" to build
+#    the version of the application in executable cr_slave2_udp which exchanges its
+#    packets as UDP datagrams (see CrDaUdpSocket.h)
 #
 # This script performs the following actions:
 # 1. Compile the CORDET FW files with the Slave 2 Demo #INCLUDE files
@@ -33,6 +43,30 @@ S2_CNF_SRC="$EXM_DIR/CrConfigDemoSlave2"
 S1_CNF_SRC="$EXM_DIR/CrConfigDemoSlave1" 
 S2_OBJ="$EXE_DIR/S2"
 
+DA_SRC="$EXM_DIR/CrDemoCommon"
+DA_CNF_SRC="$EXM_DIR/CrConfigDemoCommon"
+DA_LIB="$EXE_DIR/libcrda.a"
+
+S2_EXE="$EXE_DIR/cr_slave2"
+S2_MAIN="$S2_SRC/CrS2Main.c"
+if [ "$5" == "replay" ]; then
+  S2_OBJ="$S2_OBJ/replay"
+  S2_EXE="$EXE_DIR/cr_slave2_replay"
+  S2_MAIN="$DA_SRC/CrDaReplayMain.c"
+fi
+if [ "$5" == "loopback" ]; then
+  S2_OBJ="$S2_OBJ/loopback"
+  S2_EXE="$EXE_DIR/cr_slave2_loopback.o"
+fi
+if [ "$5" == "heapguard" ]; then
+  S2_OBJ="$S2_OBJ/heapguard"
+  S2_EXE="$EXE_DIR/cr_slave2_heapguard"
+fi
+if [ "$5" == "udp" ]; then
+  S2_OBJ="$S2_OBJ/udp"
+  S2_EXE="$EXE_DIR/cr_slave2_udp"
+fi
+
 mkdir -p ${S2_OBJ}
 
 #====================================================================================
@@ -41,11 +75,35 @@ mkdir -p ${S2_OBJ}
 # Use the following definition for linker map
 #OPT="-Os -Wall -c -fmessage-length=0" 
 OPT="-O0 -g3 -Wall -c -fmessage-length=0 -fprofile-arcs -ftest-coverage"  
+if [ "$5" == "replay" ]; then
+  OPT="$OPT -DCR_DA_REPLAY"
+fi
+if [ "$5" == "loopback" ]; then
+  OPT="$OPT -DCR_DA_LOOPBACK"
+fi
+if [ "$5" == "heapguard" ]; then
+  OPT="$OPT -DCR_DA_HEAP_GUARD"
+fi
+if [ "$5" == "udp" ]; then
+  OPT="$OPT -DCR_DA_UDP"
+fi
 
 #====================================================================================
 # Set the include path
 #====================================================================================
-INCLUDE="-I"$FW_DIR" -I"$S2_SRC" -I"$CR_SRC" -I"$S2_CNF_SRC"" 
+INCLUDE="-I"$FW_DIR" -I"$S2_SRC" -I"$CR_SRC" -I"$S2_CNF_SRC" -I"$DA_SRC" -I"$DA_CNF_SRC" -I"$S2_OBJ"" 
+
+echo "===================================================================================="
+echo " Compile the Demo Application Common Files which depend on the configuration "
+echo "===================================================================================="
+./GenKindIndex.sh "$INCLUDE" $S2_OBJ/CrDaKindIndexTab.h || exit 1
+gcc $INCLUDE $OPT -o $S2_OBJ/CrDaKindIndex.o $DA_SRC/CrDaKindIndex.c
+if [ "$5" == "loopback" ]; then
+  gcc $INCLUDE $OPT -o $S2_OBJ/CrDaLoopback.o $DA_SRC/CrDaLoopback.c
+fi
+if [ "$5" == "heapguard" ]; then
+  gcc $INCLUDE $OPT -o $S2_OBJ/CrDaHeapGuard.o $DA_SRC/CrDaHeapGuard.c
+fi
 
 echo "===================================================================================="
 echo " Compile all the C2 Implementation Files "
@@ -74,13 +132,9 @@ gcc $INCLUDE $OPT -o $S2_OBJ/CrFwUtilityFunctions.o $CR_SRC/UtilityFunctions/CrF
 gcc $INCLUDE $OPT -o $S2_OBJ/CrFwAppSm.o $CR_SRC/AppStartUp/CrFwAppSm.c
 
 echo "===================================================================================="
-echo " Compile the Demo Application Common Files "
+echo " Compile the Slave 2 Demo Files "
 echo "===================================================================================="
-gcc $INCLUDE $OPT -o $S2_OBJ/CrS2Main.o $S2_SRC/CrS2Main.c
-gcc $INCLUDE $OPT -o $S2_OBJ/CrDaClientSocket.o $S2_SRC/CrDaClientSocket.c
-gcc $INCLUDE $OPT -o $S2_OBJ/CrDaOutCmpTempViolation.o $S2_SRC/CrDaOutCmpTempViolation.c
-gcc $INCLUDE $OPT -o $S2_OBJ/CrDaServerSocket.o $S2_SRC/CrDaServerSocket.c
-gcc $INCLUDE $OPT -o $S2_OBJ/CrDaTempMonitor.o $S2_SRC/CrDaTempMonitor.c
+gcc $INCLUDE $OPT -o $S2_OBJ/CrS2Main.o $S2_MAIN
 
 echo "===================================================================================="
 echo " Compile the C2 Configuration Files for the Slave 2 Application "
@@ -88,10 +142,7 @@ echo "==========================================================================
 function compileConfigFile {
   gcc $INCLUDE $OPT -o $S2_OBJ/"$1.o" $S2_CNF_SRC/"$1.c"
 }
-compileConfigFile "CrFwRepErr"
-compileConfigFile "CrFwPckt"
 compileConfigFile "CrFwRepInCmdOutcome"
-compileConfigFile "CrFwTime"
 compileConfigFile "CrFwAppStartUpProc"
 compileConfigFile "CrFwAppResetProc"
 compileConfigFile "CrFwAppShutdownProc"
@@ -102,18 +153,27 @@ echo "==========================================================================
 # Use following definition for linker map (and remove -fprofile-arcs option)
 #LNKMAP="-Wl,-Map,$EXE_DIR/cr_Slave2.map" 
 LNKMAP=""
-#gcc -o $EXE_DIR/cr_Slave2 \
-gcc -fprofile-arcs -o $EXE_DIR/cr_slave2 \
-$FW_OBJ/FwPrConfig.o $FW_OBJ/FwPrCore.o $FW_OBJ/FwPrDCreate.o $FW_OBJ/FwSmAux.o \
+S2_LNK_OBJ="$FW_OBJ/FwPrConfig.o $FW_OBJ/FwPrCore.o $FW_OBJ/FwPrDCreate.o $FW_OBJ/FwPrSCreate.o $FW_OBJ/FwSmAux.o \
 $FW_OBJ/FwSmConfig.o $FW_OBJ/FwSmCore.o $FW_OBJ/FwSmDCreate.o $FW_OBJ/FwSmSCreate.o \
 $S2_OBJ/CrFwAux.o $S2_OBJ/CrFwBaseCmp.o $S2_OBJ/CrFwDummyExecProc.o \
 $S2_OBJ/CrFwInitProc.o $S2_OBJ/CrFwResetProc.o $S2_OBJ/CrFwInCmd.o $S2_OBJ/CrFwInRegistry.o \
 $S2_OBJ/CrFwInManager.o $S2_OBJ/CrFwInRep.o $S2_OBJ/CrFwInRepExecProc.o $S2_OBJ/CrFwInLoader.o \
 $S2_OBJ/CrFwInFactory.o $S2_OBJ/CrFwInStream.o $S2_OBJ/CrFwOutCmp.o $S2_OBJ/CrFwOutFactory.o \
 $S2_OBJ/CrFwOutLoader.o $S2_OBJ/CrFwOutManager.o $S2_OBJ/CrFwOutRegistry.o $S2_OBJ/CrFwOutStream.o $S2_OBJ/CrFwPcktQueue.o \
-$S2_OBJ/CrFwUtilityFunctions.o $S2_OBJ/CrFwPckt.o $S2_OBJ/CrFwRepErr.o $S2_OBJ/CrFwTime.o \
+$S2_OBJ/CrFwUtilityFunctions.o \
 $S2_OBJ/CrFwAppSm.o $S2_OBJ/CrFwAppStartUpProc.o $S2_OBJ/CrFwAppResetProc.o $S2_OBJ/CrFwAppShutdownProc.o \
 $S2_OBJ/CrFwRepInCmdOutcome.o \
-$S2_OBJ/CrS2Main.o $S2_OBJ/CrDaClientSocket.o $S2_OBJ/CrDaServerSocket.o \
-$S2_OBJ/CrDaOutCmpTempViolation.o $S2_OBJ/CrDaTempMonitor.o \
--lpthread $LNKMAP
+$S2_OBJ/CrS2Main.o $S2_OBJ/CrDaKindIndex.o"
+if [ "$5" == "loopback" ]; then
+  # Link the application into one relocatable object in which all symbols except
+  # its initialization, control cycle and termination functions are local
+  ld -r -d -o $S2_OBJ/CrS2App.o $S2_LNK_OBJ $S2_OBJ/CrDaLoopback.o $DA_LIB
+  objcopy --keep-global-symbol=CrS2AppInit --keep-global-symbol=CrS2AppExecCycle \
+  --keep-global-symbol=CrS2AppTerm $S2_OBJ/CrS2App.o $S2_EXE
+elif [ "$5" == "heapguard" ]; then
+  # The heap guard interposes the allocator and the symbols are exported for its backtraces
+  gcc -fprofile-arcs -rdynamic -o $S2_EXE $S2_LNK_OBJ $S2_OBJ/CrDaHeapGuard.o $DA_LIB -lpthread -lrt $LNKMAP
+else
+  #gcc -o $S2_EXE $S2_LNK_OBJ $DA_LIB -lpthread -lrt $LNKMAP
+  gcc -fprofile-arcs -o $S2_EXE $S2_LNK_OBJ $DA_LIB -lpthread -lrt $LNKMAP
+fi
@@ -0,0 +1,65 @@
+#!/bin/bash
+# This script generates a synthetic kind catalogue for the cr_kindbench kind lookup
+# benchmark tool (see CrDaKindBenchMain.c).
+# The catalogue consists of the configuration files which GenKindIndex.sh and
+# CrDaKindIndex.c read:
+# - CrFwInFactoryUserPar.h and CrFwOutFactoryUserPar.h with the given number of
+#   InCommand and OutComponent kinds (only the [type, sub-type, discriminant]
+#   triplet of each kind descriptor is defined);
+# - CrFwUserConstants.h, a copy of the given file in which the maximum service
+#   type, service sub-type and discriminant are raised to 255, 63 and 1 so that
+#   the key space can hold 1000 kinds.
+#
+# The kinds are spread evenly over the key space in increasing key order (as the
+# framework requires for its kind descriptor arrays).
+#
+# The script takes the following parameters:
+# 1. The number of kinds of the catalogue
+# 2. The path of the CrFwUserConstants.h file of an application
+# 3. The directory where the catalogue is generated
+#
+#====================================================================================
+# Assign variables
+#====================================================================================
+
+N_OF_KINDS=$1
+USER_CONSTANTS=$2
+OUT_DIR=$3
+
+MAX_SERV_TYPE=255
+MAX_SERV_SUBTYPE=63
+MAX_DISCRIMINANT=1
+
+mkdir -p $OUT_DIR
+
+echo "===================================================================================="
+echo " Generate a catalogue of $N_OF_KINDS kinds in $OUT_DIR "
+echo "===================================================================================="
+sed -e "s/#define CR_FW_MAX_SERV_TYPE .*/#define CR_FW_MAX_SERV_TYPE $MAX_SERV_TYPE/" \
+    -e "s/#define CR_FW_MAX_SERV_SUBTYPE .*/#define CR_FW_MAX_SERV_SUBTYPE $MAX_SERV_SUBTYPE/" \
+    -e "s/#define CR_FW_MAX_DISCRIMINANT .*/#define CR_FW_MAX_DISCRIMINANT $MAX_DISCRIMINANT/" \
+    $USER_CONSTANTS > $OUT_DIR/CrFwUserConstants.h
+
+function genFactoryUserPar {
+awk -v n=$N_OF_KINDS -v nt=$((MAX_SERV_TYPE+1)) -v ns=$((MAX_SERV_SUBTYPE+1)) -v nd=$((MAX_DISCRIMINANT+1)) \
+    -v guard=$2 -v kind=$3 '
+BEGIN {
+	print "/* Generated by GenKindCatalogue.sh for the cr_kindbench tool. Do not edit. */"
+	print "#ifndef " guard
+	print "#define " guard
+	print ""
+	print "#define CR_FW_" kind "_NKINDS " n
+	print ""
+	print "#define CR_FW_" kind "_INIT_KIND_DESC \\"
+	printf "\t{ "
+	for (i = 0; i < n; i++) {
+		key = int((2*i+1)*nt*ns*nd/(2*n))
+		printf "{%d, %d, %d}, \\\n\t  ", int(key/(ns*nd)), int(key/nd)%ns, key%nd
+	}
+	print "}"
+	print ""
+	print "#endif /* " guard " */"
+}' > $OUT_DIR/$1
+}
+genFactoryUserPar CrFwInFactoryUserPar.h CRFW_INFACTORY_USERPAR_H_ INCMD
+genFactoryUserPar CrFwOutFactoryUserPar.h CRFW_OUTFACTORY_USERPAR_H_ OUTCMP
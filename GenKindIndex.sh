@@ -0,0 +1,80 @@
+#!/bin/bash
+# This script generates the direct-index tables for the command and report kinds
+# of an application (see CrDaKindIndex.h).
+# The script pre-processes the kind descriptor initializers defined in the
+# application's CrFwInFactoryUserPar.h and CrFwOutFactoryUserPar.h and writes
+# one CR_DA_KIND_INDEX_ENTRY line for each kind into the output header file.
+#
+# The script takes the following parameters:
+# 1. The include path of the application (as used to compile its files)
+# 2. The path of the header file to be generated
+#
+# The script fails if a [type, sub-type, discriminant] triplet is defined twice
+# in the same kind descriptor table.
+#
+#====================================================================================
+# Assign variables 
+#====================================================================================
+
+INCLUDE=$1
+OUT_FILE=$2
+
+TMP_SRC="$OUT_FILE.c"
+
+#====================================================================================
+# Expand the kind descriptor initializers
+#====================================================================================
+cat > $TMP_SRC <<EOT
+#include "CrFwInFactoryUserPar.h"
+#include "CrFwOutFactoryUserPar.h"
+CR_DA_GEN_INCMD CR_FW_INCMD_INIT_KIND_DESC
+CR_DA_GEN_OUTCMP CR_FW_OUTCMP_INIT_KIND_DESC
+EOT
+
+echo "===================================================================================="
+echo " Generate the kind index tables in $OUT_FILE "
+echo "===================================================================================="
+gcc $INCLUDE -E -P $TMP_SRC | grep "^CR_DA_GEN_" | awk '
+BEGIN {
+	print "/* Generated by GenKindIndex.sh from the kind descriptor initializers. Do not edit. */"
+	print "#ifndef CRDA_KINDINDEXTAB_H_"
+	print "#define CRDA_KINDINDEXTAB_H_"
+	err = 0
+}
+{
+	tab = $1
+	sub(/^CR_DA_GEN_/, "", tab)
+	line = $0
+	sub(/^CR_DA_GEN_[A-Z]+[ \t]*/, "", line)
+	gsub(/[ \t()]/, "", line)
+	print ""
+	print "#define CR_DA_" tab "_KIND_INDEX_INIT \\"
+	printf "\t{ "
+	pos = 0
+	while (match(line, /\{[^{}]*\}/)) {
+		item = substr(line, RSTART + 1, RLENGTH - 2)
+		line = substr(line, RSTART + RLENGTH)
+		split(item, f, ",")
+		key = f[1] "," f[2] "," f[3]
+		if (key in seen) {
+			print "GenKindIndex.sh: kind [" key "] defined twice in " tab " table" > "/dev/stderr"
+			err = 1
+		}
+		seen[key] = 1
+		printf "CR_DA_KIND_INDEX_ENTRY(%s, %s, %s, %d), \\\n\t  ", f[1], f[2], f[3], pos
+		pos++
+	}
+	print "}"
+	delete seen
+}
+END {
+	print ""
+	print "#endif /* CRDA_KINDINDEXTAB_H_ */"
+	exit err
+}' > $OUT_FILE
+STATUS=${PIPESTATUS[0]}${PIPESTATUS[2]}
+rm -f $TMP_SRC
+if [ "$STATUS" != "00" ]; then
+  rm -f $OUT_FILE
+  exit 1
+fi
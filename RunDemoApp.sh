@@ -1,8 +1,10 @@
 #!/bin/bash
 # This script runs the demo applications of the CORDET Framework.
 #
-# This script takes one parameter:
+# This script takes the following parameters:
 # 1. The path to the directory where the demo application executables are located
+# 2. (Optional) The run profile options which are passed to the three demo
+#    applications (see src/CrDemoCommon/CrDaProfile.h)
 #
 # This script performs the following actions:
 # 1. It spawns three processes each of which runs one of the 3 demo applications
@@ -12,6 +14,7 @@
 #====================================================================================
 
 EXE_DIR=$1
+shift
 OUTFILE1="DemoAppOut_Master.txt"
 OUTFILE2="DemoAppOut_Slave1.txt"
 OUTFILE3="DemoAppOut_Slave2.txt"
@@ -21,15 +24,13 @@ rm -f $EXE_DIR/$OUTFILE2
 rm -f $EXE_DIR/$OUTFILE3
 
 echo " "
-echo "Run Demo Applications -- this takes nearly 2 minutes"
+echo "Run Demo Applications -- with the default run profile, this takes nearly 2 minutes"
 echo "(Demo application outputs is in DemoAppOut_*.txt files)"
 echo " "
-$EXE_DIR/cr_slave1 > $EXE_DIR/$OUTFILE2 &
-sleep 1
-$EXE_DIR/cr_master > $EXE_DIR/$OUTFILE1 &
-sleep 1
-$EXE_DIR/cr_slave2 > $EXE_DIR/$OUTFILE3 &
+$EXE_DIR/cr_slave1 "$@" > $EXE_DIR/$OUTFILE2 &
+$EXE_DIR/cr_master "$@" > $EXE_DIR/$OUTFILE1 &
+$EXE_DIR/cr_slave2 "$@" > $EXE_DIR/$OUTFILE3 &
 
-# give time to the demo applications to terminate
-sleep 105
+# wait for the demo applications to terminate
+wait
 
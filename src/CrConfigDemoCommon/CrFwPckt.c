@@ -1,6 +1,6 @@
 /**
  * @file
- * @ingroup crConfigDemoMaster
+ * @ingroup crConfigDemoCommon
  *
  * Default implementation of the packet interface of <code>CrFwPckt.h</code>.
  * The implementation of this interface is one of the adaptation points of the
@@ -17,6 +17,14 @@
  * A packet is in use if it has been requested through a call to <code>::CrFwPcktMake</code>
  * and has not yet been released through a call to <code>::CrFwPcktRelease</code>.
  *
+ * The packets are reference-counted so that one serialized packet can be shared by
+ * several owners (e.g. the OutStreams of a multi-destination fan-out) instead of
+ * being copied for each of them (see <code>CrDaPcktShare.h</code>).
+ * A packet has one reference when it is made, each call to <code>::CrFwPcktRetain</code>
+ * adds a reference and each call to <code>::CrFwPcktRelease</code> removes one: the
+ * packet returns to the pool when its last reference is released.
+ * A shared packet must not be modified.
+ *
  * The implementation provided in this file uses global data structures to hold
  * the pool of pre-allocated packets.
  *
@@ -44,10 +52,15 @@
  */
 
 #include <stdlib.h>
+#include <stdint.h>
 #include "CrFwConstants.h"
 #include "UtilityFunctions/CrFwUtilityFunctions.h"
 #include "Pckt/CrFwPckt.h"
 #include "BaseCmp/CrFwBaseCmp.h"
+/* Include demo application files */
+#include "CrDaConstants.h"
+#include "CrDaStats.h"
+#include "CrDaPcktShare.h"
 
 /**
  * Maximum length of a packet expressed in number of bytes (see <code>CrFwPacket.h</code>).
@@ -57,7 +70,7 @@
 #define CR_FW_MAX_PACKET_LENGTH 100
 
 /** The maximum size in number of bytes of a packet */
-#define CR_FW_MAX_PCKT_LENGTH 100
+#define CR_FW_MAX_PCKT_LENGTH CR_DA_PCKT_MAX_LENGTH
 
 /**
  * The array holding the packets.
@@ -66,15 +79,22 @@
 static char pcktArray[CR_FW_MAX_NOF_PCKTS*CR_FW_MAX_PCKT_LENGTH];
 
 /**
- * The array holding the "in use" status of the packets.
- * A packet is in use if it has been requested through a call to the "make" function
- * and has not yet been released through a call to the "release" function.
+ * The array holding the reference counts of the packets.
+ * A packet is in use if its reference count is not zero: the count is set to 1 by the
+ * "make" function, incremented by the "retain" function and decremented by the "release"
+ * function.
  */
-static CrFwBool_t pcktInUse[CR_FW_MAX_NOF_PCKTS] = {0};
+static CrFwCounterU1_t pcktRefCount[CR_FW_MAX_NOF_PCKTS] = {0};
 
 /** The number of currently allocated packets. */
 static CrFwCounterU2_t nOfAllocatedPckts = 0;
 
+/** The number of references which have been added to packets in use (the copies saved) */
+static unsigned long nOfRetains = 0;
+
+/** The number of packet bytes which the added references have saved from being copied */
+static unsigned long long nOfBytesSaved = 0;
+
 /** Offset of the length field in a packet */
 static const CrFwPcktLength_t offsetLength = 0;
 
@@ -123,6 +143,13 @@ static const CrFwPcktLength_t offsetGroup = 56;
 /** Offset of the parameter area in a packet */
 static const CrFwPcktLength_t offsetPar = 60;
 
+/**
+ * Return the position of a packet in the packet array.
+ * @param pckt the packet
+ * @return the position of the packet or -1 if the argument is not a packet of the array
+ */
+static int getPcktPos(CrFwPckt_t pckt);
+
 /*-----------------------------------------------------------------------------------------*/
 CrFwPckt_t CrFwPcktMake(CrFwPcktLength_t pcktLength) {
 	CrFwCounterU2_t i;
@@ -138,36 +165,69 @@ CrFwPckt_t CrFwPcktMake(CrFwPcktLength_t pcktLength) {
 	}
 
 	for (i=0; i<CR_FW_MAX_NOF_PCKTS; i++) {
-		if (pcktInUse[i] == 0) {
-			pcktInUse[i] = 1;
+		if (pcktRefCount[i] == 0) {
+			pcktRefCount[i] = 1;
 			pcktArray[i*CR_FW_MAX_PCKT_LENGTH] = (char)pcktLength;
 			nOfAllocatedPckts++;
+			CrDaStatsSetNOfAllocatedPckts(nOfAllocatedPckts);
 			return (&pcktArray[i*CR_FW_MAX_PCKT_LENGTH]);
 		}
 	}
 
+	CrDaStatsPcktAllocFail();
 	CrFwSetAppErrCode(crPcktAllocationFail);
 	return NULL;
 }
 
 /*-----------------------------------------------------------------------------------------*/
 void CrFwPcktRelease(CrFwPckt_t pckt) {
-	CrFwCounterU2_t i;
+	int pos = getPcktPos(pckt);
 
-	for (i=0; i<CR_FW_MAX_NOF_PCKTS; i++) {
-		if (pckt == &pcktArray[i*CR_FW_MAX_PCKT_LENGTH]) {
-			if (pcktInUse[i] == 0) {
-				CrFwSetAppErrCode(crPcktRelErr);
-			} else {
-				nOfAllocatedPckts--;
-				pcktInUse[i] = 0;
-			}
-			return;
-		}
+	if ((pos < 0) || (pcktRefCount[pos] == 0)) {
+		CrFwSetAppErrCode(crPcktRelErr);
+		return;
+	}
+
+	pcktRefCount[pos]--;
+	if (pcktRefCount[pos] == 0) {	/* the last reference returns the packet to the pool */
+		nOfAllocatedPckts--;
+		CrDaStatsSetNOfAllocatedPckts(nOfAllocatedPckts);
+	}
+}
+
+/*-----------------------------------------------------------------------------------------*/
+CrFwBool_t CrFwPcktRetain(CrFwPckt_t pckt) {
+	int pos = getPcktPos(pckt);
+
+	/* The packet must be in use and its reference count must not overflow */
+	if ((pos < 0) || (pcktRefCount[pos] == 0) || (pcktRefCount[pos] == CR_DA_PCKT_SHARE_MAX_REFS)) {
+		CrFwSetAppErrCode(crPcktRetainErr);
+		return 0;
 	}
 
-	CrFwSetAppErrCode(crPcktRelErr);
-	return;
+	pcktRefCount[pos]++;
+	nOfRetains++;
+	nOfBytesSaved += CrFwPcktGetLength(pckt);
+	return 1;
+}
+
+/*-----------------------------------------------------------------------------------------*/
+CrFwCounterU1_t CrFwPcktGetRefCount(CrFwPckt_t pckt) {
+	int pos = getPcktPos(pckt);
+
+	if (pos < 0)
+		return 0;
+	return pcktRefCount[pos];
+}
+
+/*-----------------------------------------------------------------------------------------*/
+unsigned long CrFwPcktGetNOfRetains() {
+	return nOfRetains;
+}
+
+/*-----------------------------------------------------------------------------------------*/
+unsigned long long CrFwPcktGetNOfBytesSaved() {
+	return nOfBytesSaved;
 }
 
 /*-----------------------------------------------------------------------------------------*/
@@ -181,7 +241,7 @@ CrFwBool_t CrFwPcktIsAvail(CrFwPcktLength_t pcktLength) {
 		return 0;
 
 	for (i=0; i<CR_FW_MAX_NOF_PCKTS; i++) {
-		if (pcktInUse[i] == 0)
+		if (pcktRefCount[i] == 0)
 			return 1;
 	}
 
@@ -371,3 +431,18 @@ CrFwGroup_t CrFwPcktGetGroup(CrFwPckt_t pckt) {
 	CrFwGroup_t* loc = (CrFwGroup_t*)(pckt+offsetGroup);
 	return (*loc);
 }
+
+/*-----------------------------------------------------------------------------------------*/
+static int getPcktPos(CrFwPckt_t pckt) {
+	uintptr_t addr = (uintptr_t)pckt;
+	uintptr_t base = (uintptr_t)pcktArray;
+	uintptr_t offset;
+
+	/* Compare the addresses before subtracting: a pointer difference across arrays is undefined */
+	if ((addr < base) || (addr >= base + sizeof(pcktArray)))
+		return -1;
+	offset = addr - base;
+	if ((offset % CR_FW_MAX_PCKT_LENGTH) != 0)
+		return -1;
+	return (int)(offset / CR_FW_MAX_PCKT_LENGTH);
+}
@@ -1,6 +1,6 @@
 /**
  * @file
- * @ingroup crConfigDemoMaster
+ * @ingroup crConfigDemoCommon
  * Implementation of the error reporting interface of <code>CrFwRepErr.h</code>
  * for the Master Application of the CORDET Demo.
  * This implementation writes the error reports to standard output.
@@ -24,15 +24,19 @@
 /* Include Framework Files */
 #include "CrFwConstants.h"
 #include "CrFwRepErr.h"
+/* Include demo application files */
+#include "CrDaStats.h"
 
 /*-----------------------------------------------------------------------------------------*/
 void CrFwRepErr(CrFwRepErrCode_t errCode, CrFwTypeId_t typeId, CrFwInstanceId_t instanceId) {
+	CrDaStatsRepErr(errCode, typeId, instanceId);
 	printf("CrFwErrRep: error %d generated by component %d of type %d\n", errCode,instanceId,typeId);
 }
 
 /*-----------------------------------------------------------------------------------------*/
 void CrFwRepErrDestSrc(CrFwRepErrCode_t errCode, CrFwTypeId_t typeId, CrFwInstanceId_t instanceId,
                        CrFwDestSrc_t destSrc) {
+	CrDaStatsRepErr(errCode, typeId, instanceId);
 	printf("CrFwRepErrDestSrc: error %d generated by component %d of type %d for dest/src %d\n",
 	       errCode,instanceId,typeId,destSrc);
 }
@@ -40,6 +44,7 @@ void CrFwRepErrDestSrc(CrFwRepErrCode_t errCode, CrFwTypeId_t typeId, CrFwInstan
 /*-----------------------------------------------------------------------------------------*/
 void CrFwRepErrInstanceIdAndDest(CrFwRepErrCode_t errCode, CrFwTypeId_t typeId,
                                  CrFwInstanceId_t instanceId, CrFwInstanceId_t secondaryInstanceId, CrFwDestSrc_t dest) {
+	CrDaStatsRepErr(errCode, typeId, instanceId);
 	printf("CrFwRepErrInstanceIdAndDest: error %d generated by component %d of type %d\n",errCode,instanceId,typeId);
 	printf("                             secondary sequence identifier: %d, destination: %d\n",secondaryInstanceId,dest);
 }
@@ -47,6 +52,7 @@ void CrFwRepErrInstanceIdAndDest(CrFwRepErrCode_t errCode, CrFwTypeId_t typeId,
 /*-----------------------------------------------------------------------------------------*/
 void CrFwRepErrSeqCnt(CrFwRepErrCode_t errCode, CrFwTypeId_t typeId, CrFwInstanceId_t instanceId,
                       CrFwSeqCnt_t expSeqCnt, CrFwSeqCnt_t actSeqCnt) {
+	CrDaStatsRepErr(errCode, typeId, instanceId);
 	printf("CrFwRepErrSeqCnt: error %d generated by component %d of type %d\n",errCode,instanceId,typeId);
 	printf("                  expected sequence counter: %d, actual sequence counter: %d\n",expSeqCnt,actSeqCnt);
 }
@@ -54,6 +60,7 @@ void CrFwRepErrSeqCnt(CrFwRepErrCode_t errCode, CrFwTypeId_t typeId, CrFwInstanc
 /*-----------------------------------------------------------------------------------------*/
 void CrFwRepErrGroup(CrFwRepErrCode_t errCode, CrFwTypeId_t typeId, CrFwInstanceId_t instanceId,
                      CrFwGroup_t group) {
+	CrDaStatsRepErr(errCode, typeId, instanceId);
 	printf("CrFwRepErrGroup: error %d generated by component %d of type %d\n",errCode,instanceId,typeId);
 	printf("                  invalid group: %d\n",group);
 
@@ -62,6 +69,7 @@ void CrFwRepErrGroup(CrFwRepErrCode_t errCode, CrFwTypeId_t typeId, CrFwInstance
 /*-----------------------------------------------------------------------------------------*/
 void CrFwRepErrInstanceIdAndOutcome(CrFwRepErrCode_t errCode, CrFwTypeId_t typeId,
                                     CrFwInstanceId_t instanceId, CrFwInstanceId_t secondaryInstanceId, CrFwOutcome_t outcome) {
+	CrDaStatsRepErr(errCode, typeId, instanceId);
 	printf("CrFwRepErrInstanceIdAndOutcome: error %d generated by component %d of type %d\n",errCode,instanceId,typeId);
 	printf("                                secondary sequence identifier: %d, outcome: %d\n",secondaryInstanceId,outcome);
 }
@@ -69,6 +77,7 @@ void CrFwRepErrInstanceIdAndOutcome(CrFwRepErrCode_t errCode, CrFwTypeId_t typeI
 /*-----------------------------------------------------------------------------------------*/
 void CrFwRepErrPckt(CrFwRepErrCode_t errCode, CrFwTypeId_t typeId,
                                     CrFwInstanceId_t instanceId, CrFwPckt_t pckt) {
+	CrDaStatsRepErr(errCode, typeId, instanceId);
 	printf("CrFwRepErrPckt: error %d generated by component %d of type %d\n",errCode,instanceId,typeId);
 	printf("                pckt[0] : %d, pckt[1]: %d\n",pckt[0],pckt[1]);
 }
@@ -76,12 +85,14 @@ void CrFwRepErrPckt(CrFwRepErrCode_t errCode, CrFwTypeId_t typeId,
 /*-----------------------------------------------------------------------------------------*/
 void CrFwRepErrRep(CrFwRepErrCode_t errCode, CrFwTypeId_t typeId,
                                     CrFwInstanceId_t instanceId, FwSmDesc_t rep) {
+	CrDaStatsRepErr(errCode, typeId, instanceId);
 	printf("CrFwRepErrRep: error %d generated by component %d of type %d\n",errCode,instanceId,typeId);
 }
 
 /*-----------------------------------------------------------------------------------------*/
 void CrFwRepErrCmd(CrFwRepErrCode_t errCode, CrFwTypeId_t typeId,
                                     CrFwInstanceId_t instanceId, FwSmDesc_t cmd) {
+	CrDaStatsRepErr(errCode, typeId, instanceId);
 	printf("CrFwRepErrCmd: error %d generated by component %d of type %d\n",errCode,instanceId,typeId);
 }
 
@@ -89,5 +100,6 @@ void CrFwRepErrCmd(CrFwRepErrCode_t errCode, CrFwTypeId_t typeId,
 void CrFwRepErrKind(CrFwRepErrCode_t errCode, CrFwTypeId_t typeId,
                                     CrFwInstanceId_t instanceId, CrFwServType_t  servType,
 									CrFwServSubType_t servSubType, CrFwDiscriminant_t disc) {
+	CrDaStatsRepErr(errCode, typeId, instanceId);
 	printf("CrFwRepErrKind: error %d generated by component %d of type %d\n",errCode,instanceId,typeId);
 }
@@ -1,6 +1,6 @@
 /**
  * @file
- * @ingroup crConfigDemoMaster
+ * @ingroup crConfigDemoCommon
  *
  * Default implementation of the time interface of <code>CrFwTime.h</code>.
  * The implementation of this interface is one of the adaptation points of the
@@ -15,6 +15,13 @@
  * time function <code>::CrFwGetCurrentTimeStamp</code> is called.
  * The function returns the value of this integer.
  *
+ * When the clock of the demo applications is in simulation mode (see
+ * <code>CrDaClock.h</code>), the time is instead taken from the virtual clock:
+ * the current time is the virtual time in seconds, the time stamps are the
+ * virtual time in milliseconds and the cycle time is the current cycle number.
+ * The time and the time stamps of a run in simulation mode are therefore
+ * reproducible.
+ *
  * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
  * @author Alessandro Pasetti <pasetti@pnp-software.com>
  * @copyright P&P Software GmbH, 2013, All Rights Reserved
@@ -31,33 +38,44 @@
 #include <stdlib.h>
 #include "CrFwConstants.h"
 #include "CrFwTime.h"
+#include "CrDaClock.h"
 
 /** The <code>::CrFwGetCurrentTimeStamp</code> function increments this counter and then returns its value */
 static CrFwTimeStamp_t dummyTime = 0;
 
 /*-----------------------------------------------------------------------------------------*/
 CrFwTimeStamp_t CrFwGetCurrentTimeStamp() {
+	if (CrDaClockGetMode() == crDaClockSim)
+		return (CrFwTimeStamp_t)(CrDaClockGetTime()/1000000ULL);
 	dummyTime++;
 	return dummyTime;
 }
 
 /*-----------------------------------------------------------------------------------------*/
 CrFwTime_t CrFwGetCurrentTime() {
+	if (CrDaClockGetMode() == crDaClockSim)
+		return (CrFwTime_t)((double)CrDaClockGetTime()/1e9);
 	return dummyTime;
 }
 
 /*-----------------------------------------------------------------------------------------*/
 CrFwTimeCyc_t CrFwGetCurrentCycTime() {
+	if (CrDaClockGetMode() == crDaClockSim)
+		return (CrFwTimeCyc_t)CrDaClockGetCycle();
 	return dummyTime;
 }
 
 /*-----------------------------------------------------------------------------------------*/
 CrFwTimeStamp_t CrFwStdTimeToTimeStamp(CrFwTime_t stdTime) {
+	if (CrDaClockGetMode() == crDaClockSim)
+		return (CrFwTimeStamp_t)(stdTime*1000);
 	return (CrFwTimeStamp_t) stdTime;
 }
 
 /*-----------------------------------------------------------------------------------------*/
 CrFwTime_t CrFwTimeStampToStdTime(CrFwTimeStamp_t timeStamp) {
+	if (CrDaClockGetMode() == crDaClockSim)
+		return (CrFwTime_t)timeStamp/1000;
 	return (CrFwTime_t) timeStamp;
 }
 
@@ -28,7 +28,7 @@
 
 #include <stdlib.h>
 /* Include FW Profile Files */
-#include "FwPrDCreate.h"
+#include "FwPrSCreate.h"
 #include "FwPrConfig.h"
 #include "FwPrCore.h"
 #include "FwPrConstants.h"
@@ -37,23 +37,22 @@
 #include "AppStartUp/CrFwAppResetProc.h"
 #include "UtilityFunctions/CrFwUtilityFunctions.h"
 
+/** The statically allocated Application Start-Up Procedure (1 action node, 2 flows, 1 action, 1 guard) */
+FW_PR_INST_NODEC(startUpPr, 1, 2, 1, 1);
+
 /** The singleton instance of the Application Start-Up Procedure */
 FwPrDesc_t startUpPrDesc;
 
 /*-----------------------------------------------------------------------------------------*/
 FwPrDesc_t CrFwAppSmGetAppStartUpProc() {
-	const FwPrCounterS1_t nOfANodes = 1;	/* Number of action nodes */
-	const FwPrCounterS1_t nOfDNodes = 0;	/* Number of decision nodes */
-	const FwPrCounterS1_t nOfFlows = 2;		/* Number of control flows */
-	const FwPrCounterS1_t nOfActions = 1;	/* Number of actions */
-	const FwPrCounterS1_t nOfGuards = 1;	/* Number of guards */
 	const FwPrCounterS1_t N1 = 1;			/* Identifier of first action node */
 
 	if (startUpPrDesc != NULL)
 		return startUpPrDesc;
 
-	/* Create the initialization procedure */
-	startUpPrDesc = FwPrCreate(nOfANodes, nOfDNodes, nOfFlows, nOfActions, nOfGuards);
+	/* Initialize the statically allocated procedure */
+	FwPrInit(&startUpPr);
+	startUpPrDesc = &startUpPr;
 
 	/* Configure the initialization procedure */
 	FwPrAddActionNode(startUpPrDesc, N1, &CrFwPrEmptyAction);
@@ -61,7 +61,7 @@
  * initializer <code>#CR_FW_INREP_INIT_KIND_DESC</code> and it must be smaller
  * than the range of the <code>::CrFwCmdRepKindIndex_t</code> type.
  */
-#define CR_FW_INREP_NKINDS 1
+#define CR_FW_INREP_NKINDS 2
 
 /**
  * Definition of the incoming command kinds supported by the application.
@@ -158,6 +158,7 @@
  */
 #define CR_FW_INREP_INIT_KIND_DESC \
 	{ {64, 4, 0, &CrMaInRepTempViolationUpdateAction, &CrMaInRepTempViolationValidityCheck}, \
+	  {64, 5, 0, &CrMaInRepTempViolationAggrUpdateAction, &CrMaInRepTempViolationAggrValidityCheck}, \
 	}
 
 #endif /* CRFW_INFACTORY_USERPAR_H_ */
@@ -9,8 +9,10 @@
  * The parameters defined in this file determine the configuration of the OutManager Components.
  * The value of these parameters cannot be changed dynamically.
  *
- * The Master Application only uses one single OutManager which is responsible for sending out
- * the commands to the Slave Applications.
+ * The Master Application uses two OutManagers which act as priority lanes for sending out
+ * the commands to the Slave Applications (see <code>CrDaOutLane.h</code>):
+ * the first OutManager carries the urgent commands and the second OutManager carries
+ * the bulk traffic.
  *
  * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
  * @author Alessandro Pasetti <pasetti@pnp-software.com>
@@ -37,7 +39,7 @@
  * The value of this constant must be smaller than the range of the <code>::CrFwCounterU1_t</code>
  * integer type.
  */
-#define CR_FW_NOF_OUTMANAGER 1
+#define CR_FW_NOF_OUTMANAGER 2
 
 /**
  * The sizes of the Pending OutComponent List (POCL) of the OutManager components.
@@ -46,6 +48,6 @@
  * The size of a POCL must be a positive integer (i.e. it is not legal
  * to define a zero-size POCL) in the range of the <code>#CrFwCounterU2_t</code> type.
  */
-#define CR_FW_OUTMANAGER_POCLSIZE {10}
+#define CR_FW_OUTMANAGER_POCLSIZE {10,10}
 
 #endif /* CR_FW_OUTMANAGER_USERPAR_H_ */
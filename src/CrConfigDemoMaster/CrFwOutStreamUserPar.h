@@ -192,4 +192,74 @@
  */
 #define CR_FW_OUTSTREAM_SHUTDOWNACTION {&CrDaClientSocketShutdownAction,&CrDaClientSocketShutdownAction}
 
+#ifdef CR_DA_REPLAY
+/*
+ * Replay configuration of the Master Application (see <code>CrDaPcktReplay.h</code>).
+ * The OutStreams discard their packets instead of writing them to the socket
+ * and their initialization and shutdown are the framework defaults.
+ */
+#include "CrDaPcktReplay.h"
+#undef CR_FW_OUTSTREAM_PCKTHANDOVER
+#define CR_FW_OUTSTREAM_PCKTHANDOVER {&CrDaPcktReplayPcktHandover,&CrDaPcktReplayPcktHandover}
+#undef CR_FW_OUTSTREAM_INITCHECK
+#define CR_FW_OUTSTREAM_INITCHECK {&CrFwBaseCmpDefInitCheck,&CrFwBaseCmpDefInitCheck}
+#undef CR_FW_OUTSTREAM_INITACTION
+#define CR_FW_OUTSTREAM_INITACTION {&CrFwOutStreamDefInitAction,&CrFwOutStreamDefInitAction}
+#undef CR_FW_OUTSTREAM_SHUTDOWNACTION
+#define CR_FW_OUTSTREAM_SHUTDOWNACTION {&CrFwOutStreamDefShutdownAction,&CrFwOutStreamDefShutdownAction}
+#endif
+
+#ifdef CR_DA_LOOPBACK
+/*
+ * Loopback configuration of the Master Application (see <code>CrDaLoopback.h</code>).
+ * The OutStreams write their packets to the in-memory bus instead of the socket
+ * and their initialization and shutdown are the framework defaults.
+ */
+#include "CrDaLoopback.h"
+#undef CR_FW_OUTSTREAM_PCKTHANDOVER
+#define CR_FW_OUTSTREAM_PCKTHANDOVER {&CrDaLoopbackPcktHandover,&CrDaLoopbackPcktHandover}
+#undef CR_FW_OUTSTREAM_INITCHECK
+#define CR_FW_OUTSTREAM_INITCHECK {&CrFwBaseCmpDefInitCheck,&CrFwBaseCmpDefInitCheck}
+#undef CR_FW_OUTSTREAM_INITACTION
+#define CR_FW_OUTSTREAM_INITACTION {&CrFwOutStreamDefInitAction,&CrFwOutStreamDefInitAction}
+#undef CR_FW_OUTSTREAM_SHUTDOWNACTION
+#define CR_FW_OUTSTREAM_SHUTDOWNACTION {&CrFwOutStreamDefShutdownAction,&CrFwOutStreamDefShutdownAction}
+#endif
+
+#ifdef CR_DA_UDP
+/*
+ * UDP configuration of the Master Application (see <code>CrDaUdpSocket.h</code>).
+ * The OutStreams send their packets on the UDP socket instead of the TCP socket.
+ * A third OutStream serves the broadcast destination: its packets are multicast to
+ * all Slave Applications.
+ * It has two groups and the broadcast commands are sent in group
+ * <code>#CR_DA_BROADCAST_GROUP</code>.
+ */
+#include "CrDaUdpSocket.h"
+#undef CR_FW_NOF_OUTSTREAM
+#define CR_FW_NOF_OUTSTREAM 3
+#undef CR_FW_OUTSTREAM_PQSIZE
+#define CR_FW_OUTSTREAM_PQSIZE {10,10,10}
+#undef CR_FW_OUTSTREAM_DEST
+#define CR_FW_OUTSTREAM_DEST {CR_DA_SLAVE_1,CR_DA_SLAVE_2,CR_DA_BROADCAST}
+#undef CR_FW_OUTSTREAM_NOF_GROUPS
+#define CR_FW_OUTSTREAM_NOF_GROUPS {1,1,2}
+#undef CR_FW_OUTSTREAM_PCKTHANDOVER
+#define CR_FW_OUTSTREAM_PCKTHANDOVER {&CrDaUdpSocketPcktHandover,&CrDaUdpSocketPcktHandover,\
+	&CrDaUdpSocketPcktHandover}
+#undef CR_FW_OUTSTREAM_INITCHECK
+#define CR_FW_OUTSTREAM_INITCHECK {&CrDaUdpSocketInitCheck,&CrDaUdpSocketInitCheck,&CrDaUdpSocketInitCheck}
+#undef CR_FW_OUTSTREAM_INITACTION
+#define CR_FW_OUTSTREAM_INITACTION {&CrDaUdpSocketInitAction,&CrDaUdpSocketInitAction,&CrDaUdpSocketInitAction}
+#undef CR_FW_OUTSTREAM_CONFIGCHECK
+#define CR_FW_OUTSTREAM_CONFIGCHECK {&CrFwBaseCmpDefConfigCheck,&CrFwBaseCmpDefConfigCheck,\
+	&CrFwBaseCmpDefConfigCheck}
+#undef CR_FW_OUTSTREAM_CONFIGACTION
+#define CR_FW_OUTSTREAM_CONFIGACTION {&CrFwOutStreamDefConfigAction,&CrFwOutStreamDefConfigAction,\
+	&CrFwOutStreamDefConfigAction}
+#undef CR_FW_OUTSTREAM_SHUTDOWNACTION
+#define CR_FW_OUTSTREAM_SHUTDOWNACTION {&CrDaUdpSocketShutdownAction,&CrDaUdpSocketShutdownAction,\
+	&CrDaUdpSocketShutdownAction}
+#endif
+
 #endif /* CR_FW_OUTSTREAM_USERPAR_H_ */
@@ -112,16 +112,16 @@
  * <code>::CrFwAuxInFactoryInCmdConfigCheck</code>.
  *
  * The initializer values defined below are those which are used for the Slave Applications.
- * The non-default function pointers for the Progress Actions are defined in
+ * The non-default function pointers for the Start, Progress and Termination Actions are defined in
  * <code>CrDaTempMonitoring.h</code>.
  */
 #define CR_FW_INCMD_INIT_KIND_DESC \
-	{ {64, 1, 0, &CrFwPrCheckAlwaysTrue, &CrFwSmCheckAlwaysTrue, &CrFwSmEmptyAction, \
-						&CrDaTempMonitoringEnable, &CrFwSmEmptyAction, &CrFwSmEmptyAction}, \
-      {64, 2, 0, &CrFwPrCheckAlwaysTrue, &CrFwSmCheckAlwaysTrue, &CrFwSmEmptyAction, \
-						&CrDaTempMonitoringDisable, &CrFwSmEmptyAction, &CrFwSmEmptyAction}, \
-      {64, 3, 0, &CrFwPrCheckAlwaysTrue, &CrFwSmCheckAlwaysTrue, &CrFwSmEmptyAction, \
-						&CrDaTempMonitoringSetTempLimit, &CrFwSmEmptyAction, &CrFwSmEmptyAction}, \
+	{ {64, 1, 0, &CrFwPrCheckAlwaysTrue, &CrFwSmCheckAlwaysTrue, &CrDaTempMonitoringStartAction, \
+						&CrDaTempMonitoringEnable, &CrDaTempMonitoringTerminationAction, &CrFwSmEmptyAction}, \
+      {64, 2, 0, &CrFwPrCheckAlwaysTrue, &CrFwSmCheckAlwaysTrue, &CrDaTempMonitoringStartAction, \
+						&CrDaTempMonitoringDisable, &CrDaTempMonitoringTerminationAction, &CrFwSmEmptyAction}, \
+      {64, 3, 0, &CrFwPrCheckAlwaysTrue, &CrFwSmCheckAlwaysTrue, &CrDaTempMonitoringStartAction, \
+						&CrDaTempMonitoringSetTempLimit, &CrDaTempMonitoringTerminationAction, &CrFwSmEmptyAction}, \
 	}
 
 /**
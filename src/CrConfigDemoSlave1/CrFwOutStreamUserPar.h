@@ -194,4 +194,54 @@
  */
 #define CR_FW_OUTSTREAM_SHUTDOWNACTION {&CrDaServerSocketShutdownAction,&CrDaServerSocketShutdownAction}
 
+#ifdef CR_DA_REPLAY
+/*
+ * Replay configuration of the Slave 1 Application (see <code>CrDaPcktReplay.h</code>).
+ * The OutStreams discard their packets instead of writing them to the socket
+ * and their initialization and shutdown are the framework defaults.
+ */
+#include "CrDaPcktReplay.h"
+#undef CR_FW_OUTSTREAM_PCKTHANDOVER
+#define CR_FW_OUTSTREAM_PCKTHANDOVER {&CrDaPcktReplayPcktHandover,&CrDaPcktReplayPcktHandover}
+#undef CR_FW_OUTSTREAM_INITCHECK
+#define CR_FW_OUTSTREAM_INITCHECK {&CrFwBaseCmpDefInitCheck,&CrFwBaseCmpDefInitCheck}
+#undef CR_FW_OUTSTREAM_INITACTION
+#define CR_FW_OUTSTREAM_INITACTION {&CrFwOutStreamDefInitAction,&CrFwOutStreamDefInitAction}
+#undef CR_FW_OUTSTREAM_SHUTDOWNACTION
+#define CR_FW_OUTSTREAM_SHUTDOWNACTION {&CrFwOutStreamDefShutdownAction,&CrFwOutStreamDefShutdownAction}
+#endif
+
+#ifdef CR_DA_LOOPBACK
+/*
+ * Loopback configuration of the Slave 1 Application (see <code>CrDaLoopback.h</code>).
+ * The OutStreams write their packets to the in-memory bus instead of the socket
+ * and their initialization and shutdown are the framework defaults.
+ */
+#include "CrDaLoopback.h"
+#undef CR_FW_OUTSTREAM_PCKTHANDOVER
+#define CR_FW_OUTSTREAM_PCKTHANDOVER {&CrDaLoopbackPcktHandover,&CrDaLoopbackPcktHandover}
+#undef CR_FW_OUTSTREAM_INITCHECK
+#define CR_FW_OUTSTREAM_INITCHECK {&CrFwBaseCmpDefInitCheck,&CrFwBaseCmpDefInitCheck}
+#undef CR_FW_OUTSTREAM_INITACTION
+#define CR_FW_OUTSTREAM_INITACTION {&CrFwOutStreamDefInitAction,&CrFwOutStreamDefInitAction}
+#undef CR_FW_OUTSTREAM_SHUTDOWNACTION
+#define CR_FW_OUTSTREAM_SHUTDOWNACTION {&CrFwOutStreamDefShutdownAction,&CrFwOutStreamDefShutdownAction}
+#endif
+
+#ifdef CR_DA_UDP
+/*
+ * UDP configuration of the Slave 1 Application (see <code>CrDaUdpSocket.h</code>).
+ * The OutStreams send their packets on the UDP socket instead of the TCP socket.
+ */
+#include "CrDaUdpSocket.h"
+#undef CR_FW_OUTSTREAM_PCKTHANDOVER
+#define CR_FW_OUTSTREAM_PCKTHANDOVER {&CrDaUdpSocketPcktHandover,&CrDaUdpSocketPcktHandover}
+#undef CR_FW_OUTSTREAM_INITCHECK
+#define CR_FW_OUTSTREAM_INITCHECK {&CrDaUdpSocketInitCheck,&CrDaUdpSocketInitCheck}
+#undef CR_FW_OUTSTREAM_INITACTION
+#define CR_FW_OUTSTREAM_INITACTION {&CrDaUdpSocketInitAction,&CrDaUdpSocketInitAction}
+#undef CR_FW_OUTSTREAM_SHUTDOWNACTION
+#define CR_FW_OUTSTREAM_SHUTDOWNACTION {&CrDaUdpSocketShutdownAction,&CrDaUdpSocketShutdownAction}
+#endif
+
 #endif /* CR_FW_OUTSTREAM_USERPAR_H_ */
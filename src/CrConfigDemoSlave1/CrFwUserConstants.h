@@ -204,7 +204,9 @@ typedef enum {
 	/** An InCommand release request has encountered an error (see <code>::CrFwInFactoryReleaseInCmd</code>). */
 	crInCmdRelErr = 23,
 	/** A framework function has been called with an illegal InManager identifier. */
-	crInManagerIllId = 24
+	crInManagerIllId = 24,
+	/** A request to add a reference to a packet has failed (see <code>::CrFwPcktRetain</code>). */
+	crPcktRetainErr = 25
 } CrFwAppErrCode_t;
 
 /**
@@ -223,7 +225,7 @@ typedef enum {
 #define CR_FW_MAX_SERV_TYPE 64
 
 /** Maximum value of the service sub-type attribute of InReports and InCommands for the Master Application */
-#define CR_FW_MAX_SERV_SUBTYPE 4
+#define CR_FW_MAX_SERV_SUBTYPE 5
 
 /** Maximum value of the discriminant attribute of InReports and InCommands for the Master Application */
 #define CR_FW_MAX_DISCRIMINANT 1
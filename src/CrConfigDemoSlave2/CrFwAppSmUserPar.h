@@ -20,6 +20,9 @@
 #ifndef CRMA_APPSM_USERPAR_H_
 #define CRMA_APPSM_USERPAR_H_
 
+/* Include demo application files */
+#include "CrDaLoadSm.h"
+
 /**
  * The pointer to the state machine embedded in state START-UP.
  * The value of this constant must be either NULL (if no state machine is embedded in
@@ -34,10 +37,11 @@
  * NORMAL) or a pointer of type <code>FwSmDesc_t</code>.
  * The default value for this adaptation point is NULL.
  *
- * The value of the adaptation point defined in this file is the one used for the test cases
- * of <code>CrFwAppSmTestCases.h</code>.
+ * In the demo applications, the Load State Machine of <code>CrDaLoadSm.h</code> is
+ * embedded in NORMAL: it sheds the low-priority traffic of the application when its
+ * packet pool and queues fill up.
  */
-#define CR_FW_APPSM_NORMAL_ESM NULL
+#define CR_FW_APPSM_NORMAL_ESM CrDaLoadSmMake()
 
 /**
  * The pointer to the state machine embedded in state RESET.
@@ -203,4 +203,71 @@
  */
 #define CR_FW_INSTREAM_SHUTDOWNACTION {&CrDaClientSocketShutdownAction}
 
+#ifdef CR_DA_REPLAY
+/*
+ * Replay configuration of the Slave 2 Application (see <code>CrDaPcktReplay.h</code>).
+ * The InStreams collect their packets from a packet capture instead of the socket
+ * and their initialization, configuration and shutdown are the framework defaults.
+ */
+#include "CrDaPcktReplay.h"
+#undef CR_FW_INSTREAM_PCKTCOLLECT
+#define CR_FW_INSTREAM_PCKTCOLLECT {&CrDaPcktReplayPcktCollect}
+#undef CR_FW_INSTREAM_PCKTAVAILCHECK
+#define CR_FW_INSTREAM_PCKTAVAILCHECK {&CrDaPcktReplayIsPcktAvail}
+#undef CR_FW_INSTREAM_INITCHECK
+#define CR_FW_INSTREAM_INITCHECK {&CrFwBaseCmpDefInitCheck}
+#undef CR_FW_INSTREAM_INITACTION
+#define CR_FW_INSTREAM_INITACTION {&CrFwInStreamDefInitAction}
+#undef CR_FW_INSTREAM_CONFIGACTION
+#define CR_FW_INSTREAM_CONFIGACTION {&CrFwInStreamDefConfigAction}
+#undef CR_FW_INSTREAM_SHUTDOWNACTION
+#define CR_FW_INSTREAM_SHUTDOWNACTION {&CrFwInStreamDefShutdownAction}
+#endif
+
+#ifdef CR_DA_LOOPBACK
+/*
+ * Loopback configuration of the Slave 2 Application (see <code>CrDaLoopback.h</code>).
+ * The InStreams collect their packets from the in-memory bus instead of the socket
+ * and their initialization and shutdown are the framework defaults.
+ */
+#include "CrDaLoopback.h"
+#undef CR_FW_INSTREAM_PCKTCOLLECT
+#define CR_FW_INSTREAM_PCKTCOLLECT {&CrDaLoopbackPcktCollect}
+#undef CR_FW_INSTREAM_PCKTAVAILCHECK
+#define CR_FW_INSTREAM_PCKTAVAILCHECK {&CrDaLoopbackIsPcktAvail}
+#undef CR_FW_INSTREAM_INITCHECK
+#define CR_FW_INSTREAM_INITCHECK {&CrFwBaseCmpDefInitCheck}
+#undef CR_FW_INSTREAM_INITACTION
+#define CR_FW_INSTREAM_INITACTION {&CrFwInStreamDefInitAction}
+#undef CR_FW_INSTREAM_CONFIGACTION
+#define CR_FW_INSTREAM_CONFIGACTION {&CrDaLoopbackConfigAction}
+#undef CR_FW_INSTREAM_SHUTDOWNACTION
+#define CR_FW_INSTREAM_SHUTDOWNACTION {&CrFwInStreamDefShutdownAction}
+#endif
+
+#ifdef CR_DA_UDP
+/*
+ * UDP configuration of the Slave 2 Application (see <code>CrDaUdpSocket.h</code>).
+ * The InStreams collect their packets from the UDP socket instead of the TCP socket.
+ * The InStream of the Master Application has a second group for the commands which
+ * the Master Application sends to the broadcast destination (group
+ * <code>#CR_DA_BROADCAST_GROUP</code>).
+ */
+#include "CrDaUdpSocket.h"
+#undef CR_FW_INSTREAM_NOF_GROUPS
+#define CR_FW_INSTREAM_NOF_GROUPS {2}
+#undef CR_FW_INSTREAM_PCKTCOLLECT
+#define CR_FW_INSTREAM_PCKTCOLLECT {&CrDaUdpSocketPcktCollect}
+#undef CR_FW_INSTREAM_PCKTAVAILCHECK
+#define CR_FW_INSTREAM_PCKTAVAILCHECK {&CrDaUdpSocketIsPcktAvail}
+#undef CR_FW_INSTREAM_INITCHECK
+#define CR_FW_INSTREAM_INITCHECK {&CrDaUdpSocketInitCheck}
+#undef CR_FW_INSTREAM_INITACTION
+#define CR_FW_INSTREAM_INITACTION {&CrDaUdpSocketInitAction}
+#undef CR_FW_INSTREAM_CONFIGACTION
+#define CR_FW_INSTREAM_CONFIGACTION {&CrDaUdpSocketConfigAction}
+#undef CR_FW_INSTREAM_SHUTDOWNACTION
+#define CR_FW_INSTREAM_SHUTDOWNACTION {&CrDaUdpSocketShutdownAction}
+#endif
+
 #endif /* CR_FW_INSTREAM_USERPAR_H_ */
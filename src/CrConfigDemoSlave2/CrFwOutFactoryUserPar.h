@@ -17,6 +17,7 @@
  * For information on alternative licensing, please contact P&P Software GmbH.
  */
 
+#include "CrDaConstants.h"
 #include "CrDaOutCmpTempViolation.h"
 
 #ifndef CRFW_OUTFACTORY_USERPAR_H_
@@ -36,7 +37,7 @@
  * initializer <code>#CR_FW_OUTCMP_INIT_KIND_DESC</code> and it must be smaller
  * than the range of the <code>::CrFwCmdRepKindIndex_t</code> type.
  */
-#define CR_FW_OUTCMP_NKINDS 1
+#define CR_FW_OUTCMP_NKINDS 2
 
 /**
  * Definition of the OutComponent kinds supported by an application.
@@ -88,12 +89,15 @@
  * <code>::CrFwAuxOutFactoryConfigCheck</code>.
  *
  * The initializer values defined below are which are used for the Slave Applications.
- * The non-default function pointers for the serialize operationas are defined in
- * <code>CrDaOutCmpTempViolation</code>.
+ * The parameters of the temperature violation reports are written into their packets
+ * by the functions of <code>CrDaOutCmpTempViolation.h</code> and the reports therefore
+ * use the default serialize operation.
  */
 #define CR_FW_OUTCMP_INIT_KIND_DESC \
 	{ {64, 4, 0, 2, 100, &CrFwOutCmpDefEnableCheck, &CrFwSmCheckAlwaysTrue, \
-							&CrFwSmCheckAlwaysFalse, &CrFwSmEmptyAction, &CrDaOutCmpTempViolationSerialize}, \
+							&CrFwSmCheckAlwaysFalse, &CrFwSmEmptyAction, &CrFwOutCmpDefSerialize}, \
+	  {64, 5, 0, 2, CR_DA_AGGR_PCKT_LENGTH, &CrFwOutCmpDefEnableCheck, &CrFwSmCheckAlwaysTrue, \
+							&CrFwSmCheckAlwaysFalse, &CrFwSmEmptyAction, &CrFwOutCmpDefSerialize}, \
 	}
 
 #endif /* CR_FW_OUTFACTORY_USERPAR_H_ */
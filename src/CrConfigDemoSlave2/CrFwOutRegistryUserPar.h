@@ -40,7 +40,7 @@
  * by the application.
  * This constant must be smaller than the range of: <code>CrFwCmdRepIndex_t</code>.
  */
-#define CR_FW_OUTREGISTRY_NSERV 1
+#define CR_FW_OUTREGISTRY_NSERV 2
 
 /**
  * Definition of the range of out-going services supported by the application.
@@ -68,6 +68,7 @@
  */
 #define CR_FW_OUTREGISTRY_INIT_SERV_DESC \
 	{ {64, 4, 0}, \
+	  {64, 5, 0}, \
 	}
 
 #endif /* CRFW_OUTREGISTRY_USERPAR_H_ */
@@ -192,4 +192,54 @@
  */
 #define CR_FW_OUTSTREAM_SHUTDOWNACTION {&CrDaClientSocketShutdownAction}
 
+#ifdef CR_DA_REPLAY
+/*
+ * Replay configuration of the Slave 2 Application (see <code>CrDaPcktReplay.h</code>).
+ * The OutStreams discard their packets instead of writing them to the socket
+ * and their initialization and shutdown are the framework defaults.
+ */
+#include "CrDaPcktReplay.h"
+#undef CR_FW_OUTSTREAM_PCKTHANDOVER
+#define CR_FW_OUTSTREAM_PCKTHANDOVER {&CrDaPcktReplayPcktHandover}
+#undef CR_FW_OUTSTREAM_INITCHECK
+#define CR_FW_OUTSTREAM_INITCHECK {&CrFwBaseCmpDefInitCheck}
+#undef CR_FW_OUTSTREAM_INITACTION
+#define CR_FW_OUTSTREAM_INITACTION {&CrFwOutStreamDefInitAction}
+#undef CR_FW_OUTSTREAM_SHUTDOWNACTION
+#define CR_FW_OUTSTREAM_SHUTDOWNACTION {&CrFwOutStreamDefShutdownAction}
+#endif
+
+#ifdef CR_DA_LOOPBACK
+/*
+ * Loopback configuration of the Slave 2 Application (see <code>CrDaLoopback.h</code>).
+ * The OutStreams write their packets to the in-memory bus instead of the socket
+ * and their initialization and shutdown are the framework defaults.
+ */
+#include "CrDaLoopback.h"
+#undef CR_FW_OUTSTREAM_PCKTHANDOVER
+#define CR_FW_OUTSTREAM_PCKTHANDOVER {&CrDaLoopbackPcktHandover}
+#undef CR_FW_OUTSTREAM_INITCHECK
+#define CR_FW_OUTSTREAM_INITCHECK {&CrFwBaseCmpDefInitCheck}
+#undef CR_FW_OUTSTREAM_INITACTION
+#define CR_FW_OUTSTREAM_INITACTION {&CrFwOutStreamDefInitAction}
+#undef CR_FW_OUTSTREAM_SHUTDOWNACTION
+#define CR_FW_OUTSTREAM_SHUTDOWNACTION {&CrFwOutStreamDefShutdownAction}
+#endif
+
+#ifdef CR_DA_UDP
+/*
+ * UDP configuration of the Slave 2 Application (see <code>CrDaUdpSocket.h</code>).
+ * The OutStreams send their packets on the UDP socket instead of the TCP socket.
+ */
+#include "CrDaUdpSocket.h"
+#undef CR_FW_OUTSTREAM_PCKTHANDOVER
+#define CR_FW_OUTSTREAM_PCKTHANDOVER {&CrDaUdpSocketPcktHandover}
+#undef CR_FW_OUTSTREAM_INITCHECK
+#define CR_FW_OUTSTREAM_INITCHECK {&CrDaUdpSocketInitCheck}
+#undef CR_FW_OUTSTREAM_INITACTION
+#define CR_FW_OUTSTREAM_INITACTION {&CrDaUdpSocketInitAction}
+#undef CR_FW_OUTSTREAM_SHUTDOWNACTION
+#define CR_FW_OUTSTREAM_SHUTDOWNACTION {&CrDaUdpSocketShutdownAction}
+#endif
+
 #endif /* CR_FW_OUTSTREAM_USERPAR_H_ */
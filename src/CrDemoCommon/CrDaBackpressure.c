@@ -0,0 +1,84 @@
+/**
+ * @file
+ * @ingroup crDemoCommon
+ * Implementation of the backpressure from the packet queues of the InStreams.
+ *
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the CORDET Framework.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#include <stdio.h>
+#include "CrDaBackpressure.h"
+#include "CrDaClock.h"
+/* Include FW Profile files */
+#include "FwSmConstants.h"
+/* Include framework files */
+#include "CrFwConstants.h"
+#include "InStream/CrFwInStream.h"
+
+/** The registered InStreams */
+static FwSmDesc_t inStreams[CR_DA_BACKPRESSURE_MAX_N_OF_INSTREAMS];
+
+/** The sources of the registered InStreams */
+static CrFwDestSrc_t inStreamSrc[CR_DA_BACKPRESSURE_MAX_N_OF_INSTREAMS];
+
+/** The sizes of the packet queues of the registered InStreams */
+static unsigned int pqSize[CR_DA_BACKPRESSURE_MAX_N_OF_INSTREAMS];
+
+/** The number of cycles in which the collection from the source of each registered InStream was held back */
+static unsigned long nOfHeldBack[CR_DA_BACKPRESSURE_MAX_N_OF_INSTREAMS];
+
+/** The last cycle which was counted in <code>nOfHeldBack</code> for each registered InStream */
+static unsigned int lastHeldBackCycle[CR_DA_BACKPRESSURE_MAX_N_OF_INSTREAMS];
+
+/** The number of registered InStreams */
+static unsigned int nOfInStreams = 0;
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaBackpressureAddInStream(FwSmDesc_t inStream, unsigned int size) {
+	if ((nOfInStreams >= CR_DA_BACKPRESSURE_MAX_N_OF_INSTREAMS) || (size == 0))
+		return;
+	inStreams[nOfInStreams] = inStream;
+	inStreamSrc[nOfInStreams] = CrFwInStreamGetSrc(inStream);
+	pqSize[nOfInStreams] = size;
+	nOfHeldBack[nOfInStreams] = 0;
+	lastHeldBackCycle[nOfInStreams] = 0;
+	nOfInStreams++;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+CrFwBool_t CrDaBackpressureIsFull(CrFwDestSrc_t src) {
+	unsigned int i;
+
+	for (i=0; i<nOfInStreams; i++) {
+		if (inStreamSrc[i] != src)
+			continue;
+		if ((unsigned int)CrFwInStreamGetNOfPendingPckts(inStreams[i]) < pqSize[i])
+			return 0;
+		/* The adapters check several times per cycle: a held-back cycle is only counted once */
+		if (lastHeldBackCycle[i] != CrDaClockGetCycle()) {
+			lastHeldBackCycle[i] = CrDaClockGetCycle();
+			nOfHeldBack[i]++;
+		}
+		return 1;
+	}
+	return 0;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaBackpressurePrintSummary(const char* tag) {
+	unsigned int i;
+
+	for (i=0; i<nOfInStreams; i++)
+		printf("%s: Backpressure: %lu cycles with the collection from source %u held back by a full InStream packet queue\n",
+		       tag, nOfHeldBack[i], (unsigned int)inStreamSrc[i]);
+}
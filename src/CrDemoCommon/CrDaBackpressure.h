@@ -0,0 +1,74 @@
+/**
+ * @file
+ * @ingroup crDemoCommon
+ * Backpressure from the packet queues of the InStreams to the middleware adapters.
+ * An InStream whose packet queue is full discards the packets which it collects
+ * (error <code>crInStreamPQFull</code>).
+ * The middleware adapters (the client and server sockets of <code>CrDaClientSocket.h</code>
+ * and <code>CrDaServerSocket.h</code> and the loopback adapter of <code>CrDaLoopback.h</code>)
+ * therefore check with <code>::CrDaBackpressureIsFull</code> whether the packet queue of
+ * the InStream of a source is full before they declare a packet from that source available
+ * and before they read from the connection which carries it.
+ * If the queue is full, the packet stays in the buffer of the adapter and the next
+ * packets stay in the kernel buffer of the connection (or in the loopback bus): the
+ * flow control of TCP (or the back-pressure of the bus on its writer) then slows down
+ * the sender instead of its packets being discarded.
+ * The collection resumes in the next control cycle, after the InLoader has drained the
+ * packet queue.
+ *
+ * The InStreams are registered by the demo applications together with the size of their
+ * packet queue.
+ * The packets from sources whose InStream is not registered are never held back.
+ *
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the CORDET Framework.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#ifndef CRDA_BACKPRESSURE_H_
+#define CRDA_BACKPRESSURE_H_
+
+/* Include FW Profile files */
+#include "FwSmConstants.h"
+/* Include framework files */
+#include "CrFwConstants.h"
+/* Include configuration files */
+#include "CrFwUserConstants.h"
+
+/** The maximum number of InStreams which are registered */
+#define CR_DA_BACKPRESSURE_MAX_N_OF_INSTREAMS 4
+
+/**
+ * Register an InStream whose packet queue holds back the packets of its source.
+ * At most <code>#CR_DA_BACKPRESSURE_MAX_N_OF_INSTREAMS</code> InStreams are registered.
+ * @param inStream the InStream
+ * @param pqSize the size of the packet queue of the InStream
+ */
+void CrDaBackpressureAddInStream(FwSmDesc_t inStream, unsigned int pqSize);
+
+/**
+ * Check whether the packet queue of the InStream of a source is full.
+ * The adapters check a source several times per cycle (when they declare a packet
+ * available and when they collect it): the cycles in which at least one check is
+ * positive are counted as the cycles in which the collection was held back.
+ * @param src the source of the packets
+ * @return 1 if the InStream of the source is registered and its packet queue is full;
+ * 0 otherwise
+ */
+CrFwBool_t CrDaBackpressureIsFull(CrFwDestSrc_t src);
+
+/**
+ * Print, for each registered InStream, the number of cycles in which the collection was held back.
+ * @param tag the tag of the application with which the lines of the summary are prefixed
+ */
+void CrDaBackpressurePrintSummary(const char* tag);
+
+#endif /* CRDA_BACKPRESSURE_H_ */
@@ -0,0 +1,546 @@
+/**
+ * @file
+ *
+ * Implementation of interface to control the client socket.
+ *
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the CORDET Framework.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#include <stdlib.h>
+#include "CrDaClientSocket.h"
+#include "CrDaConstants.h"
+#include "CrDaPcktRecorder.h"
+#include "CrDaStats.h"
+#include "CrDaBackpressure.h"
+#include "CrDaTrace.h"
+#include "CrDaClock.h"
+#include "CrFwConstants.h"
+/* Include FW Profile files */
+#include "FwSmConstants.h"
+#include "FwSmConfig.h"
+#include "FwSmCore.h"
+#include "FwPrConfig.h"
+#include "FwPrCore.h"
+#include "FwPrConstants.h"
+/* Include configuration files */
+#include "CrFwInStreamUserPar.h"
+#include "CrFwCmpData.h"
+/* Include framework files */
+#include "InStream/CrFwInStream.h"
+#include "OutStream/CrFwOutStream.h"
+#include "BaseCmp/CrFwBaseCmp.h"
+#include "Pckt/CrFwPckt.h"
+#include "CrFwTime.h"
+#include "CrFwRepErr.h"
+#include "UtilityFunctions/CrFwUtilityFunctions.h"
+/* Include file for socket implementation */
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <string.h>
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <netdb.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <poll.h>
+
+/** The state of the connection to the server socket */
+typedef enum {
+	/** The client socket has not been initialized */
+	crDaConnUninit = 0,
+	/** No connection is open and a new connection is attempted when the backoff delay has expired */
+	crDaConnDown = 1,
+	/** A non-blocking connection is in progress */
+	crDaConnPending = 2,
+	/** The connection is established */
+	crDaConnUp = 3
+} CrDaConnState_t;
+
+/** The port number */
+static int portno = 0;
+
+/** The host name */
+static char* hostName = NULL;
+
+/** The identifier of the application which is sent to the server socket after connecting */
+static unsigned char appId = 0;
+
+/** The address of the server socket */
+static struct sockaddr_in servAddr;
+
+/** The file descriptor for the socket */
+static int sockfd = 0;
+
+/** The state of the connection */
+static CrDaConnState_t connState = crDaConnUninit;
+
+/** The current backoff delay in nanoseconds before a new connection is attempted */
+static unsigned long long backoff = CR_DA_SOCKET_MIN_BACKOFF;
+
+/** The host time in nanoseconds at which the next connection is attempted */
+static unsigned long long retryTime = 0;
+
+/** The instance identifiers of the OutStreams which use the client socket */
+static CrFwInstanceId_t outStreamIds[CR_DA_SOCKET_MAX_N_OF_OUTSTREAMS];
+
+/** The number of OutStreams which use the client socket */
+static int nOfOutStreams = 0;
+
+/** The maximum size of an incoming packet */
+static int pcktMaxLength;
+
+/** The Framing Buffer */
+static unsigned char frameBuffer[CR_DA_SOCKET_FRAME_BUFFER_SIZE];
+
+/** The offset in the Framing Buffer of the first byte which has not yet been consumed */
+static int frameStart = 0;
+
+/** The offset in the Framing Buffer of the first byte which has not yet been filled */
+static int frameEnd = 0;
+
+/** The Send Tail: the bytes of the last packet which the socket has not yet accepted */
+static unsigned char sendTail[CR_DA_SOCKET_SEND_TAIL_SIZE];
+
+/** The number of bytes in the Send Tail */
+static int sendTailLength = 0;
+
+/**
+ * Start a non-blocking connection to the server socket.
+ * If the connection cannot be started, a new connection is scheduled after the
+ * current backoff delay.
+ */
+static void startConnect();
+
+/**
+ * Advance the connection to the server socket.
+ * If the connection is down and the backoff delay has expired, a new connection is started.
+ * If a connection is in progress, its completion is checked.
+ * When a connection is established, the hello message (see <code>#CR_DA_SOCKET_HELLO_LENGTH</code>)
+ * is sent to the server socket and the OutStreams which use the client socket are notified
+ * through <code>::CrFwOutStreamConnectionAvail</code> so that they hand over the packets
+ * which they have buffered while the connection was down.
+ */
+static void advanceConnect();
+
+/**
+ * Close the socket and schedule a new connection after the current backoff delay.
+ * The backoff delay is then doubled up to <code>#CR_DA_SOCKET_MAX_BACKOFF</code>.
+ */
+static void closeAndRetry();
+
+/**
+ * Return the complete packet at the head of the Framing Buffer.
+ * If the Framing Buffer does not hold a complete packet, the incomplete packet is moved
+ * to the start of the Framing Buffer and one non-blocking read is performed on the socket.
+ * If the socket was closed or failed, the connection is closed and a new connection is
+ * scheduled.
+ * If the length of the packet at the head is invalid, the Framing Buffer is cleared.
+ * @return the packet at the head of the Framing Buffer or NULL if no complete packet is available
+ */
+static unsigned char* headPckt();
+
+/**
+ * Send the bytes of the Send Tail which the socket accepts.
+ * @return 1 if the Send Tail is empty; 0 otherwise
+ */
+static int flushSendTail();
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaClientSocketInitAction(FwPrDesc_t prDesc) {
+	CrFwCmpData_t* streamData = (CrFwCmpData_t*)FwPrGetData(prDesc);
+	struct hostent* server;
+	int i;
+
+	/* Register the OutStream so that it can be notified when the connection is re-established */
+	if (streamData->typeId == CR_FW_OUTSTREAM_TYPE) {
+		for (i=0; i<nOfOutStreams; i++)
+			if (outStreamIds[i] == streamData->instanceId)
+				break;
+		if ((i == nOfOutStreams) && (nOfOutStreams < CR_DA_SOCKET_MAX_N_OF_OUTSTREAMS))
+			outStreamIds[nOfOutStreams++] = streamData->instanceId;
+	}
+
+	if (connState != crDaConnUninit) {	/* Check if socket is already initialized */
+		if (streamData->typeId == CR_FW_INSTREAM_TYPE)
+			CrFwInStreamDefInitAction(prDesc);
+		else
+			CrFwOutStreamDefInitAction(prDesc);
+		return;
+	}
+
+	server = gethostbyname(hostName);
+	if (server == NULL) {
+		perror("CrDaClientSocketInitAction, Get host name");
+		streamData->outcome = 0;
+		return;
+	}
+
+	bzero((char*) &servAddr, sizeof(servAddr));
+	servAddr.sin_family = AF_INET;
+	bcopy((char*)server->h_addr,
+	      (char*)&servAddr.sin_addr.s_addr,
+	      server->h_length);
+	servAddr.sin_port = htons(portno);
+
+	/* Clear the framing buffer */
+	pcktMaxLength = (int)CrFwPcktGetMaxLength();
+	frameStart = 0;
+	frameEnd = 0;
+
+	/* Start the connection (it is completed by the poll function) */
+	connState = crDaConnDown;
+	backoff = CR_DA_SOCKET_MIN_BACKOFF;
+	retryTime = 0;
+	startConnect();
+
+	/* Execute default initialization action for OutStream/InStream */
+	if (streamData->typeId == CR_FW_INSTREAM_TYPE)
+		CrFwInStreamDefInitAction(prDesc);
+	else
+		CrFwOutStreamDefInitAction(prDesc);
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaClientSocketShutdownAction(FwSmDesc_t smDesc) {
+	CrFwCmpData_t* streamData = (CrFwCmpData_t*)FwSmGetData(smDesc);
+
+	if (streamData->typeId == CR_FW_INSTREAM_TYPE)
+		CrFwInStreamDefShutdownAction(smDesc);
+	else
+		CrFwOutStreamDefShutdownAction(smDesc);
+
+	if (connState == crDaConnUninit) 	/* Check if socket was already shutdown */
+		return;
+	if (sockfd != 0)
+		close(sockfd);
+	sockfd = 0;
+	nOfOutStreams = 0;
+	connState = crDaConnUninit;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaClientSocketInitCheck(FwPrDesc_t prDesc) {
+	CrFwCmpData_t* prData = (CrFwCmpData_t*)FwPrGetData(prDesc);
+
+	if (pcktMaxLength > 255) {
+		prData->outcome = 0;
+		return;
+	}
+
+	if (portno == 0) {
+		prData->outcome = 0;
+		return;
+	}
+
+	if (hostName == NULL) {
+		prData->outcome = 0;
+		return;
+	}
+
+	if (appId == 0) {
+		prData->outcome = 0;
+		return;
+	}
+
+	prData->outcome = 1;
+	return;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaClientSocketConfigAction(FwPrDesc_t prDesc) {
+	CrFwCmpData_t* streamData = (CrFwCmpData_t*)FwPrGetData(prDesc);
+
+	/* Clear Framing Buffer */
+	frameStart = 0;
+	frameEnd = 0;
+
+	if (streamData->typeId == CR_FW_INSTREAM_TYPE)
+		CrFwInStreamDefConfigAction(prDesc);
+	else if (streamData->typeId == CR_FW_OUTSTREAM_TYPE)
+		CrFwOutStreamDefConfigAction(prDesc);
+	else {
+		perror("CrDaClientSocketConfigAction, Incorrect caller type");
+		return;
+	}
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaClientSocketPoll() {
+	FwSmDesc_t inStream;
+	CrFwDestSrc_t src;
+	unsigned char* head;
+	int i;
+
+	/* Re-establish the connection if it is down */
+	advanceConnect();
+
+	/* Complete the send of the last packet and let the OutStreams hand over the packets they buffered meanwhile */
+	if ((connState == crDaConnUp) && (sendTailLength > 0) && flushSendTail())
+		for (i=0; i<nOfOutStreams; i++)
+			CrFwOutStreamConnectionAvail(CrFwOutStreamMake(outStreamIds[i]));
+
+	head = headPckt();
+	if (head == NULL)
+		return;	/* no complete packet is available from the socket */
+	src = CrFwPcktGetSrc((CrFwPckt_t)head);
+	inStream = CrFwInStreamGet(src);
+	CrFwInStreamPcktAvail(inStream);
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+CrFwPckt_t CrDaClientSocketPcktCollect(CrFwDestSrc_t src) {
+	CrFwPckt_t pckt;
+	unsigned char* head;
+
+	if (CrDaBackpressureIsFull(src))
+		return NULL;
+
+	head = headPckt();
+	if (head == NULL)
+		return NULL;
+	if (CrFwPcktGetSrc((CrFwPckt_t)head) != src)
+		return NULL;
+
+	pckt = CrFwPcktMake((CrFwPcktLength_t)head[0]);
+	if (pckt == NULL)
+		return NULL;
+	memcpy(pckt, head, head[0]);
+	frameStart += head[0];
+	CrDaPcktRecorderRecord(crDaPcktRecIn, src, pckt);
+	CrDaStatsPcktIn(src, CrFwPcktGetLength(pckt));
+	return pckt;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+CrFwBool_t CrDaClientSocketIsPcktAvail(CrFwDestSrc_t src) {
+	unsigned char* head;
+
+	/* Leave the packets in the socket while the InStream of the source cannot take them */
+	if (CrDaBackpressureIsFull(src))
+		return 0;
+
+	head = headPckt();
+	if (head == NULL)
+		return 0;	/* no complete packet is available from the socket */
+	if (CrFwPcktGetSrc((CrFwPckt_t)head) == src)
+		return 1;
+	else
+		return 0;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+CrFwBool_t CrDaClientSocketPcktHandover(CrFwPckt_t pckt) {
+	int len = (int)CrFwPcktGetLength(pckt);
+	int n;
+
+	/* The OutStream buffers the packet until the connection is re-established */
+	if (connState != crDaConnUp)
+		return 0;
+	/* The bytes of the previous packet must be sent first */
+	if (!flushSendTail())
+		return 0;
+
+	CrDaTraceBegin("send", (int)CrFwPcktGetDest(pckt));
+	n = send(sockfd, pckt, len, MSG_NOSIGNAL);
+	CrDaTraceEnd("send");
+
+	if (n < 0) {
+		if ((errno != EAGAIN) && (errno != EWOULDBLOCK)) {
+			perror("CrDaClientSocketPcktHandover, Write to socket");
+			closeAndRetry();
+		}
+		return 0;
+	}
+
+	/* The socket accepted part of the packet: its other bytes are sent from the Send Tail */
+	if (n < len) {
+		sendTailLength = len-n;
+		memcpy(sendTail, (unsigned char*)pckt+n, sendTailLength);
+	}
+
+	CrDaPcktRecorderRecord(crDaPcktRecOut, CrFwPcktGetDest(pckt), pckt);
+	CrDaStatsPcktOut(CrFwPcktGetDest(pckt), CrFwPcktGetLength(pckt));
+	return 1;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaClientSocketSetPort(int n) {
+	portno = n;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaClientSocketSetHost(char* name) {
+	hostName = name;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaClientSocketSetAppId(unsigned char id) {
+	appId = id;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static void startConnect() {
+	int flags, n;
+
+	sockfd = socket(AF_INET, SOCK_STREAM, 0);
+	if (sockfd < 0) {
+		perror("CrDaClientSocket, Socket Creation");
+		sockfd = 0;
+		closeAndRetry();
+		return;
+	}
+
+	/* Set the socket to non-blocking mode */
+	flags = fcntl(sockfd, F_GETFL, 0);
+	if ((flags < 0) || (fcntl(sockfd, F_SETFL, flags | O_NONBLOCK) < 0)) {
+		perror("CrDaClientSocket, Set socket attributes");
+		closeAndRetry();
+		return;
+	}
+
+	CrDaTraceBegin("connect", -1);
+	n = connect(sockfd,(struct sockaddr*) &servAddr,sizeof(servAddr));
+	CrDaTraceEnd("connect");
+	if (n < 0) {
+		if (errno != EINPROGRESS) {
+			closeAndRetry();
+			return;
+		}
+	}
+	connState = crDaConnPending;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static void advanceConnect() {
+	struct pollfd pfd;
+	unsigned char hello[CR_DA_SOCKET_HELLO_LENGTH];
+	int err;
+	socklen_t errLen = sizeof(err);
+	int i;
+
+	if ((connState == crDaConnDown) && (CrDaClockGetHostTime() >= retryTime))
+		startConnect();
+	if (connState != crDaConnPending)
+		return;
+
+	/* Check whether the non-blocking connection has completed */
+	pfd.fd = sockfd;
+	pfd.events = POLLOUT;
+	CrDaTraceBegin("poll", -1);
+	i = poll(&pfd, 1, 0);
+	CrDaTraceEnd("poll");
+	if (i <= 0)
+		return;
+	if ((getsockopt(sockfd, SOL_SOCKET, SO_ERROR, &err, &errLen) < 0) || (err != 0)) {
+		closeAndRetry();
+		return;
+	}
+
+	/* Identify the application to the server socket */
+	hello[0] = CR_DA_SOCKET_HELLO_LENGTH;
+	hello[1] = appId;
+	if (send(sockfd, hello, CR_DA_SOCKET_HELLO_LENGTH, MSG_NOSIGNAL) != CR_DA_SOCKET_HELLO_LENGTH) {
+		closeAndRetry();
+		return;
+	}
+	connState = crDaConnUp;
+	backoff = CR_DA_SOCKET_MIN_BACKOFF;
+	printf("CrDaClientSocket: connected to the server socket\n");
+
+	/* Let the OutStreams hand over the packets they buffered while the connection was down */
+	for (i=0; i<nOfOutStreams; i++)
+		CrFwOutStreamConnectionAvail(CrFwOutStreamMake(outStreamIds[i]));
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static void closeAndRetry() {
+	if (connState == crDaConnUp)
+		printf("CrDaClientSocket: connection to the server socket lost\n");
+	if (sockfd != 0)
+		close(sockfd);
+	sockfd = 0;
+	frameStart = 0;
+	frameEnd = 0;
+	sendTailLength = 0;
+	connState = crDaConnDown;
+	retryTime = CrDaClockGetHostTime() + backoff;
+	backoff = 2*backoff;
+	if (backoff > CR_DA_SOCKET_MAX_BACKOFF)
+		backoff = CR_DA_SOCKET_MAX_BACKOFF;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static unsigned char* headPckt() {
+	unsigned char* head;
+	int n, isRead = 0;
+
+	for (;;) {
+		head = frameBuffer + frameStart;
+		n = frameEnd - frameStart;
+		if ((n > 0) && ((head[0] == 0) || (head[0] > pcktMaxLength))) {
+			printf("CrDaClientSocketPoll: invalid packet received from socket\n");
+			frameStart = 0;
+			frameEnd = 0;
+			return NULL;
+		}
+		if ((n > 0) && (n >= head[0]))	/* a complete packet is at the head */
+			return head;
+
+		if (isRead || (connState != crDaConnUp))	/* one read per call or the connection is down */
+			return NULL;
+
+		/* Move the incomplete packet to the start of the buffer and read the next bytes */
+		memmove(frameBuffer, head, n);
+		frameStart = 0;
+		frameEnd = n;
+		CrDaTraceBegin("read", -1);
+		n = read(sockfd, frameBuffer+frameEnd, CR_DA_SOCKET_FRAME_BUFFER_SIZE-frameEnd);
+		CrDaTraceEnd("read");
+		isRead = 1;
+		if (n == -1) {	/* no data are available from the socket */
+			if ((errno != EAGAIN) && (errno != EWOULDBLOCK)) {
+				perror("CrDaClientSocketPoll, Read from socket");
+				closeAndRetry();
+			}
+			return NULL;
+		}
+		if (n == 0)	{
+			closeAndRetry();
+			return NULL;
+		}
+		frameEnd += n;
+	}
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static int flushSendTail() {
+	int n;
+
+	if (sendTailLength == 0)
+		return 1;
+	CrDaTraceBegin("send", -1);
+	n = send(sockfd, sendTail, sendTailLength, MSG_NOSIGNAL);
+	CrDaTraceEnd("send");
+	if (n < 0) {
+		if ((errno != EAGAIN) && (errno != EWOULDBLOCK)) {
+			perror("CrDaClientSocketPoll, Write to socket");
+			closeAndRetry();
+		}
+		return 0;
+	}
+	sendTailLength -= n;
+	memmove(sendTail, sendTail+n, sendTailLength);
+	return (sendTailLength == 0);
+}
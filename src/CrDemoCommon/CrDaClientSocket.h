@@ -1,6 +1,6 @@
 /**
  * @file
- * @ingroup crDemoMaster
+ * @ingroup crDemoCommon
  * Interface for the client socket used in the CORDET Demo.
  * The CORDET Demo consists of three applications which communicate with each other via sockets.
  * This module defines the functions through which the InStreams and OutStreams of the Master and
@@ -31,8 +31,29 @@
  * It is designed to work with the server socket of <code>CrDaServerSocket.h</code>.
  *
  * The socket must be initialized with the port number and with the host name for
- * its socket (these are defined through functions <code>::CrDaClientSocketSetPort</code> and
- * <code>::CrDaClientSocketSetHost</code>).
+ * its socket and with the identifier of its application (these are defined through functions
+ * <code>::CrDaClientSocketSetPort</code>, <code>::CrDaClientSocketSetHost</code> and
+ * <code>::CrDaClientSocketSetAppId</code>).
+ *
+ * The connection to the server socket is managed by the poll function
+ * <code>::CrDaClientSocketPoll</code>:
+ * - The initialization action starts a non-blocking connection and the poll function
+ *   detects its completion.
+ *   The client applications therefore do not need to be started after the server
+ *   application.
+ * - When a connection is established, the client socket sends a hello message with
+ *   the identifier of its application (see <code>#CR_DA_SOCKET_HELLO_LENGTH</code>) through
+ *   which the server socket associates the connection to the application.
+ * - When a connection fails or is lost (e.g. because the server application is restarted),
+ *   the socket is closed and a new connection is attempted after a backoff delay which
+ *   starts at <code>#CR_DA_SOCKET_MIN_BACKOFF</code> and doubles after each failure up
+ *   to <code>#CR_DA_SOCKET_MAX_BACKOFF</code>.
+ * - While the connection is down, the packet hand-over operation fails and the
+ *   OutStreams buffer their packets.
+ *   When the connection is re-established, the OutStreams which use the socket are
+ *   notified through <code>::CrFwOutStreamConnectionAvail</code> and hand over their
+ *   buffered packets.
+ * .
  *
  * The socket assumes a polling approach for incoming packets: function
  * <code>::CrDaClientSocketPoll</code> should be called periodically
@@ -45,23 +66,20 @@
  * This causes all pending packets from that source to be collected by the InStream and
  * stored in its Packet Queue.
  *
- * The implementation of this module assumes that, at each read operation, an entire
- * packet is received.
- * The situation where the packet is split into fragments during the transmission
- * process is not handled.
- * In practice, this socket is intended for the case where the socket is local
- * to the host platform (i.e. where the host name is "localhost" and both sender
- * and receiver of a packet are located on the same platform).
- *
- * Packets which are read from the socket are stored in a buffer (the <i>Read Buffer</i>).
- * This is an array of bytes whose size is equal to the maximum size of a
- * middleware packet.
- * The Read Buffer can be either "full" (if its first byte is different from zero)
- * or "empty" (if its first byte has been cleared).
+ * The bytes which are read from the socket are accumulated in a buffer (the
+ * <i>Framing Buffer</i>) of <code>#CR_DA_SOCKET_FRAME_BUFFER_SIZE</code> bytes.
+ * A read may return several packets or only a fragment of a packet: the packets
+ * are delimited in the Framing Buffer through their length (held in their first byte)
+ * and a packet is only made available to its InStream when it has completely arrived.
+ * The packet at the head of the Framing Buffer is held there while the packet queue of
+ * its InStream is full (see <code>CrDaBackpressure.h</code>): the socket is then not read
+ * and the flow control of TCP slows down the server socket.
  *
  * The packet hand-over operation for OutStreams is implemented in function
  * <code>::CrDaClientSocketPcktHandover</code> which performs a non-blocking write
  * to the socket.
+ * If the socket only accepts part of a packet, its other bytes are held in the
+ * <i>Send Tail</i> and are sent before the next packet (see <code>#CR_DA_SOCKET_SEND_TAIL_SIZE</code>).
  *
  * If an error is encountered while performing a system call, this module uses function
  * <code>perror</code> to print an error message and, if the error was encountered
@@ -125,9 +143,14 @@
  * Initialization action for the client socket.
  * If the client socket has already been initialized, this function calls the
  * Initialization Action of the base InStream/OutStream and then returns.
+ * In both cases, if the caller is an OutStream, it is registered for notification when
+ * the connection to the server socket is re-established.
  * If the client socket has not yet been initialized, this action:
- * - creates the Read Buffer;
- * - creates and connects the socket as a non-blocking socket;
+ * - resolves the address of the server socket;
+ * - clears the Framing Buffer;
+ * - creates the socket as a non-blocking socket and starts its connection
+ *   (a failure of the connection is not a failure of the action: the connection
+ *   is retried by <code>::CrDaClientSocketPoll</code>);
  * - executes the Initialization Action of the base InStream/OutStream;
  * - sets the outcome to "success" if the previous operations are successful.
  * .
@@ -140,8 +163,7 @@ void CrDaClientSocketInitAction(FwPrDesc_t prDesc);
  * If the client socket has already been shut down, this function calls the
  * Shutdown Action of the base InStream/OutStream and then returns.
  * If the client socket has not yet been shut down, this action executes
- * the Shutdown Action of the base InStream/OutStream, releases the Read Buffer,
- * and closes the socket.
+ * the Shutdown Action of the base InStream/OutStream and closes the socket.
  * @param smDesc the InStream or OutStream State Machine descriptor.
  */
 void CrDaClientSocketShutdownAction(FwSmDesc_t smDesc);
@@ -149,15 +171,15 @@ void CrDaClientSocketShutdownAction(FwSmDesc_t smDesc);
 /**
  * Initialization check for the client socket.
  * The check is successful if: the maximum length of a packet (as retrieved from
- * <code>::CrFwPcktGetMaxLength</code>) is smaller than 256; and the port number
- * and server host name have been set.
+ * <code>::CrFwPcktGetMaxLength</code>) is smaller than 256; and the port number,
+ * server host name and application identifier have been set.
  * @param prDesc the initialization procedure descriptor.
  */
 void CrDaClientSocketInitCheck(FwPrDesc_t prDesc);
 
 /**
  * Configuration action for the client socket.
- * This action clears the Read Buffer and executes the Configuration Action of
+ * This action clears the Framing Buffer and executes the Configuration Action of
  * the base InStream (function <code>::CrFwInStreamDefConfigAction</code>)
  * @param prDesc the configuration procedure descriptor.
  */
@@ -166,9 +188,16 @@ void CrDaClientSocketConfigAction(FwPrDesc_t prDesc);
 /**
  * Poll the client socket to check whether a new packet has arrived.
  * This function should be called periodically by an external scheduler.
- * It performs a non-blocking read on the socket to check whether a packet
- * is available at the socket.
- * If a packet is available, it is placed into the Read Buffer, its source
+ * If the connection to the server socket is down, it first advances its
+ * re-establishment (see the description of the module) and returns if the
+ * connection is not established.
+ * It then sends the bytes held in the Send Tail and, when the Send Tail becomes empty,
+ * calls <code>::CrFwOutStreamConnectionAvail</code> on the OutStreams.
+ * If the Framing Buffer does not hold a complete packet, it performs a non-blocking
+ * read on the socket.
+ * If the server socket has closed the connection, the socket is closed and a new
+ * connection is scheduled.
+ * If a complete packet is at the head of the Framing Buffer, its source
  * is determined, and then function <code>::CrFwInStreamPcktAvail</code> is
  * called on the InStream associated to that packet source.
  */
@@ -176,17 +205,18 @@ void CrDaClientSocketPoll();
 
 /**
  * Function implementing the Packet Collect Operation for the client socket.
- * If the packet in the Read Buffer has a source attribute equal to
+ * If the packet at the head of the Framing Buffer has a source attribute equal to
  * <code>packetSource</code>, this function:
  * - creates a packet instance through a call to <code>CrFwPcktMake</code>
- * - copies the content of the Read Buffer into the newly created packet instance
- * - clears the Read Buffer
+ * - copies the packet at the head of the Framing Buffer into the newly created packet instance
+ * - removes the packet from the Framing Buffer
  * - returns the packet instance
  * .
- * If the Read Buffer holds a packet from a source other then
- * <code>packetSource</code>, this function returns NULL.
- * Note that the logic of the client socket module guarantees that the Read Buffer
- * will always be full when this function is called.
+ * If the Framing Buffer does not hold a complete packet (after a non-blocking read on
+ * the socket) or if it holds a packet from a source other then <code>packetSource</code>,
+ * this function returns NULL.
+ * This function also returns NULL, and leaves the packet in the Framing Buffer, if the
+ * packet queue of the InStream of <code>packetSource</code> is full (see <code>CrDaBackpressure.h</code>).
  * @param pcktSrc the source associated to the InStream
  * @return the packet
  */
@@ -195,17 +225,15 @@ CrFwPckt_t CrDaClientSocketPcktCollect(CrFwDestSrc_t pcktSrc);
 /**
  * Function implementing the Packet Available Check Operation for the client socket.
  * This function implements the following logic:
- * - The function begins by checking the Read Buffer.
- * - If it is full and the source attribute of the packet it contains is equal
- *   to <code>packetSource</code>, the function returns 1.
- * - If the Read Buffer is not full or it is full but the source attribute of the
- *   packet it contains is not equal to <code>packetSource</code>, the function
- *   performs a non-blocking read on the socket.
- * - If the read operation returns nothing or returns a packet with a source
- *   attribute other than <code>packetSource</code>, the function returns 0.
- * - If the read operation returns a packet with a source attribute equal to
- *   <code>packetSource</code>, the function stores it in the
- *   Read Buffer and then returns 1.
+ * - If the packet queue of the InStream of <code>packetSource</code> is full (see
+ *   <code>CrDaBackpressure.h</code>), the function returns 0 without reading from the
+ *   socket: the packets stay in the kernel buffer of the socket and the flow control
+ *   of TCP slows down the sender.
+ * - If the Framing Buffer does not hold a complete packet, the function performs a
+ *   non-blocking read on the socket.
+ * - If the Framing Buffer then holds a complete packet at its head and the source
+ *   attribute of this packet is equal to <code>packetSource</code>, the function returns 1.
+ * - Otherwise, the function returns 0.
  * .
  * @param pcktSrc the source associated to the InStream
  * @return the value of a predefined flag
@@ -216,6 +244,8 @@ CrFwBool_t CrDaClientSocketIsPcktAvail(CrFwDestSrc_t pcktSrc);
  * Function implementing the hand-over operation for the client socket.
  * This function performs a non-blocking write on the socket and, if it succeeds,
  * it returns 1; otherwise, it returns 0.
+ * If the connection to the server socket is down, the function returns 0 without
+ * writing to the socket.
  * @param pckt the packet to be written to the socket
  * @return 1 if the packet was successfully written to the socket; 0 otherwise.
  */
@@ -236,4 +266,11 @@ void CrDaClientSocketSetPort(int n);
  */
 void CrDaClientSocketSetHost(char* name);
 
+/**
+ * Set the identifier of the application of the client socket.
+ * The identifier is sent to the server socket in the hello message.
+ * @param id the application identifier (must be greater than zero).
+ */
+void CrDaClientSocketSetAppId(unsigned char id);
+
 #endif /* CRDA_CLIENTSOCKET_H_ */
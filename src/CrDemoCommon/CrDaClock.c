@@ -0,0 +1,126 @@
+/**
+ * @file
+ * @ingroup crDemoCommon
+ * Implementation of the clock and cycle scheduler of the demo applications.
+ *
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the CORDET Framework.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#include <time.h>
+#include <errno.h>
+#include "CrDaClock.h"
+
+/** The mode of the clock */
+static CrDaClockMode_t clockMode = crDaClockReal;
+
+/** The period in nanoseconds of the control cycles */
+static unsigned long long cyclePeriod = CR_DA_CLOCK_DEF_PERIOD;
+
+/** The number of the current cycle */
+static unsigned int curCycle = 0;
+
+/** The scheduled start time of the first cycle (real-time mode only) */
+static unsigned long long originTime = 0;
+
+/** The virtual time (simulation mode only) */
+static unsigned long long simTime = 0;
+
+/** The number of cycle overruns */
+static unsigned long nOfOverruns = 0;
+
+/** The host time at which the current cycle was started */
+static unsigned long long cycleStartHostTime = 0;
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaClockSetMode(CrDaClockMode_t mode) {
+	clockMode = mode;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+CrDaClockMode_t CrDaClockGetMode() {
+	return clockMode;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaClockSetPeriod(unsigned long long period) {
+	if (period > 0)
+		cyclePeriod = period;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+unsigned long long CrDaClockGetPeriod() {
+	return cyclePeriod;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+unsigned long long CrDaClockGetTime() {
+	if (clockMode == crDaClockSim)
+		return simTime;
+	return CrDaClockGetHostTime();
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+unsigned long long CrDaClockGetHostTime() {
+	struct timespec now;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return (unsigned long long)now.tv_sec*1000000000ULL + (unsigned long long)now.tv_nsec;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+unsigned int CrDaClockGetCycle() {
+	return curCycle;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaClockStartCycle(unsigned int cycle) {
+	if (cycle == 0)
+		cycle = 1;
+
+	if (clockMode == crDaClockSim)
+		simTime = (unsigned long long)(cycle-1)*cyclePeriod;
+	else if (curCycle == 0)
+		originTime = CrDaClockGetHostTime() - (unsigned long long)(cycle-1)*cyclePeriod;
+
+	curCycle = cycle;
+	cycleStartHostTime = CrDaClockGetHostTime();
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+unsigned long long CrDaClockGetCycleElapsed() {
+	return CrDaClockGetHostTime() - cycleStartHostTime;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaClockWaitCycleEnd() {
+	unsigned long long dueTime;
+	struct timespec due;
+
+	if ((clockMode == crDaClockSim) || (curCycle == 0))
+		return;
+
+	dueTime = originTime + (unsigned long long)curCycle*cyclePeriod;
+	if (CrDaClockGetHostTime() > dueTime) {
+		nOfOverruns++;
+		return;
+	}
+
+	due.tv_sec = (time_t)(dueTime/1000000000ULL);
+	due.tv_nsec = (long)(dueTime%1000000000ULL);
+	while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &due, NULL) == EINTR);	/* resume the sleep after a signal */
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+unsigned long CrDaClockGetNOfOverruns() {
+	return nOfOverruns;
+}
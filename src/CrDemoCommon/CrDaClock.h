@@ -0,0 +1,151 @@
+/**
+ * @file
+ * @ingroup crDemoCommon
+ * Clock and cycle scheduler of the demo applications.
+ * The demo applications execute their control cycles with a fixed period
+ * (<code>#CR_DA_CLOCK_DEF_PERIOD</code> by default).
+ * At the start of each control cycle, they call <code>::CrDaClockStartCycle</code>
+ * and, at the end of the control cycle, they call <code>::CrDaClockWaitCycleEnd</code>.
+ * The time of the demo applications (including the time of the framework, see
+ * <code>CrFwTime.c</code>, and the time of the records of the packet recorder,
+ * see <code>CrDaPcktRecorder.h</code>) is read with <code>::CrDaClockGetTime</code>.
+ *
+ * The clock supports two modes:
+ * - In the real-time mode (the default), the time is the time of <code>CLOCK_MONOTONIC</code>
+ *   and <code>::CrDaClockWaitCycleEnd</code> sleeps until the scheduled start of the next
+ *   cycle.
+ *   Cycle <code>n</code> is scheduled to start <code>(n-1)</code> periods after the
+ *   start of the first cycle.
+ *   A cycle whose end is later than the scheduled start of the next cycle is
+ *   counted as an overrun and the next cycle starts immediately.
+ * - In the simulation mode, the time is a virtual time which is entirely determined
+ *   by the cycle number: cycle <code>n</code> starts at virtual time <code>(n-1)</code>
+ *   periods and the virtual time does not advance within a cycle.
+ *   <code>::CrDaClockWaitCycleEnd</code> returns immediately: the virtual time
+ *   advances to the start of the next cycle as soon as the application is idle.
+ * .
+ * In the simulation mode, the applications run as fast as the CPU allows and
+ * their timing does not depend on the load of the host.
+ * When the three applications are run in the loopback harness (see
+ * <code>CrDaLoopbackMain.c</code>), their runs are fully reproducible:
+ * all applications see the same virtual time in the same cycle and each cycle
+ * of the harness only starts when all applications have completed the previous one.
+ * When the applications are run as separate processes, the simulation mode still
+ * removes the waits between cycles but the interleaving of the processes depends
+ * on the host.
+ *
+ * The simulation mode is selected with <code>::CrDaClockSetMode</code>.
+ * The demo applications select it when the environment variable
+ * <code>#CR_DA_CLOCK_ENV_VAR</code> is set and the loopback harness always sets
+ * this variable.
+ * This interface only uses plain C types so that it can also be used by the
+ * loopback harness.
+ *
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the CORDET Framework.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#ifndef CRDA_CLOCK_H_
+#define CRDA_CLOCK_H_
+
+/** Name of the environment variable through which the demo applications are told to use the simulation mode */
+#define CR_DA_CLOCK_ENV_VAR "CR_DA_SIM_TIME"
+
+/** The default period in nanoseconds of the control cycles */
+#define CR_DA_CLOCK_DEF_PERIOD 1000000000ULL
+
+/** The mode of the clock */
+typedef enum {
+	/** The time is the time of the host and the cycles are executed in real-time */
+	crDaClockReal = 1,
+	/** The time is a virtual time which only depends on the cycle number */
+	crDaClockSim = 2
+} CrDaClockMode_t;
+
+/**
+ * Set the mode of the clock.
+ * The mode should be set before the first cycle is started.
+ * @param mode the mode of the clock
+ */
+void CrDaClockSetMode(CrDaClockMode_t mode);
+
+/**
+ * Return the mode of the clock.
+ * @return the mode of the clock
+ */
+CrDaClockMode_t CrDaClockGetMode();
+
+/**
+ * Set the period of the control cycles.
+ * The period should be set before the first cycle is started.
+ * @param period the period in nanoseconds (must be greater than zero)
+ */
+void CrDaClockSetPeriod(unsigned long long period);
+
+/**
+ * Return the period of the control cycles.
+ * @return the period in nanoseconds
+ */
+unsigned long long CrDaClockGetPeriod();
+
+/**
+ * Return the current time.
+ * In the real-time mode, this is the time of <code>CLOCK_MONOTONIC</code>.
+ * In the simulation mode, this is the virtual time.
+ * @return the current time in nanoseconds
+ */
+unsigned long long CrDaClockGetTime();
+
+/**
+ * Return the time of the host.
+ * This is the time of <code>CLOCK_MONOTONIC</code> in both modes of the clock: it is
+ * used to measure durations (e.g. latencies and the time spent in a cycle) which must
+ * not be affected by the simulation mode.
+ * @return the time of the host in nanoseconds
+ */
+unsigned long long CrDaClockGetHostTime();
+
+/**
+ * Return the number of the current cycle.
+ * @return the number of the current cycle (zero before the first cycle is started)
+ */
+unsigned int CrDaClockGetCycle();
+
+/**
+ * Start a control cycle.
+ * In the simulation mode, the virtual time is set to the start time of the cycle.
+ * @param cycle the cycle number (starting from 1)
+ */
+void CrDaClockStartCycle(unsigned int cycle);
+
+/**
+ * Return the time of the host which has elapsed since the start of the current cycle.
+ * In both modes, this is the time which the host has spent on the cycle so far:
+ * it is used to keep optional work within a budget of the period.
+ * @return the elapsed time in nanoseconds
+ */
+unsigned long long CrDaClockGetCycleElapsed();
+
+/**
+ * Wait until the scheduled start of the next control cycle.
+ * In the simulation mode, this function returns immediately.
+ */
+void CrDaClockWaitCycleEnd();
+
+/**
+ * Return the number of cycles which ended after the scheduled start of the
+ * next cycle (always zero in the simulation mode).
+ * @return the number of cycle overruns
+ */
+unsigned long CrDaClockGetNOfOverruns();
+
+#endif /* CRDA_CLOCK_H_ */
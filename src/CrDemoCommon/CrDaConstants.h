@@ -0,0 +1,156 @@
+/**
+ * @file
+ * @ingroup crDemoCommon
+ * Header file to define constants and types for the CORDET Demo.
+ *
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the CORDET Framework.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#ifndef CRDA_CONSTANTS_H_
+#define CRDA_CONSTANTS_H_
+
+#include "FwPrConstants.h"
+
+/** The identifier of the Master Application of the CORDET Demo */
+#define CR_DA_MASTER 1
+
+/** The identifier of the first Slave Application of the CORDET Demo */
+#define CR_DA_SLAVE_1 2
+
+/** The identifier of the first Slave Application of the CORDET Demo */
+#define CR_DA_SLAVE_2 3
+
+/** The identifier of the group destination of all Slave Applications (a packet for this destination is broadcast to all of them) */
+#define CR_DA_BROADCAST 4
+
+/** The group of the commands for the broadcast destination (the InStreams of the Slave Applications check their sequence counter separately) */
+#define CR_DA_BROADCAST_GROUP 1
+
+/** The port number for the socket port */
+#define CR_DA_SOCKET_PORT 2002
+
+/** The base port number of the UDP transport (the socket of an application is bound to this port plus its identifier) */
+#define CR_DA_UDP_PORT 2100
+
+/** The interval in nanoseconds after which the UDP transport repeats a NACK for the packets which are still missing */
+#define CR_DA_UDP_NACK_INTERVAL 10000000ULL
+
+/** The multicast address of the broadcast destination in the UDP transport (its port is the base port plus <code>#CR_DA_BROADCAST</code>) */
+#define CR_DA_UDP_MCAST_ADDR "239.255.0.1"
+
+/**
+ * The length of the hello message of a client socket.
+ * After connecting, a client socket sends a hello message to the server socket to
+ * identify its application.
+ * The hello message consists of two bytes: its length (this constant) and the
+ * identifier of the application.
+ * Since its length is shorter than the header of a packet, it cannot be mistaken for a packet.
+ */
+#define CR_DA_SOCKET_HELLO_LENGTH 2
+
+/** The initial delay in nanoseconds before a client socket retries a failed connection */
+#define CR_DA_SOCKET_MIN_BACKOFF 10000000ULL
+
+/** The maximum delay in nanoseconds before a client socket retries a failed connection */
+#define CR_DA_SOCKET_MAX_BACKOFF 1000000000ULL
+
+/** The maximum number of OutStreams which can share one socket */
+#define CR_DA_SOCKET_MAX_N_OF_OUTSTREAMS 4
+
+/** The maximum number of connections which the server socket holds until their hello message arrives */
+#define CR_DA_SOCKET_N_OF_PENDING 4
+
+/**
+ * The size in bytes of the Send Tail in which the sockets hold the bytes of a packet
+ * whose send was only partially completed (must not be smaller than the maximum length
+ * of a packet).
+ */
+#define CR_DA_SOCKET_SEND_TAIL_SIZE 256
+
+/**
+ * The size in bytes of the Framing Buffers in which the sockets accumulate the bytes
+ * received from one connection (must be larger than the maximum length of a packet).
+ */
+#define CR_DA_SOCKET_FRAME_BUFFER_SIZE 4096
+
+/** The offset of the parameter area in a packet (i.e. the length of the packet header) */
+#define CR_DA_PCKT_PAR_OFFSET 60
+
+/**
+ * The maximum length of a packet of the packet pool (see <code>CrFwPckt.c</code>).
+ * The value must be smaller than 128 because the length of a packet is held in its first byte
+ * and it must be a multiple of 4 because the packet attributes are held as 4-byte integers.
+ */
+#define CR_DA_PCKT_MAX_LENGTH 100
+
+/** The identifier of the service type supported by the demo application */
+#define CR_DA_SERV_TYPE 64
+
+/** The identifier of the service sub-type to enable temperature monitoring */
+#define CR_DA_SERV_SUBTYPE_EN 1
+
+/** The identifier of the service sub-type to disable temperature monitoring */
+#define CR_DA_SERV_SUBTYPE_DIS 2
+
+/** The identifier of the service sub-type to set the temperature limit */
+#define CR_DA_SERV_SUBTYPE_SET 3
+
+/** The identifier of the service sub-type to report a temperature violation */
+#define CR_DA_SERV_SUBTYPE_REP 4
+
+/**
+ * The identifier of the service sub-type to report an aggregated list of temperature violations.
+ * The parameter area of the aggregated report has the following layout:
+ * - the total number of channels in violation in the cycle (4 bytes, big-endian)
+ *   at offset <code>#CR_DA_AGGR_OFFSET_TOTAL</code>;
+ * - the number of (channel, temperature) pairs in the report (1 byte)
+ *   at offset <code>#CR_DA_AGGR_OFFSET_N</code>;
+ * - the (channel, temperature) pairs starting at offset <code>#CR_DA_AGGR_OFFSET_PAIRS</code>;
+ *   each pair holds the channel index (3 bytes, big-endian) followed by the temperature (1 byte).
+ * .
+ * The list of pairs has a variable length: the aggregated reports are made with packets of
+ * the maximum length (<code>#CR_DA_PCKT_MAX_LENGTH</code>) and a report holds as many pairs as
+ * fit in its parameter area (<code>#CR_DA_AGGR_MAX_N</code>).
+ * The total number of violations may be larger than the number of pairs if more channels
+ * are in violation than can be held in one report.
+ */
+#define CR_DA_SERV_SUBTYPE_REP_AGGR 5
+
+/** Offset of the total number of violations in the parameter area of an aggregated report */
+#define CR_DA_AGGR_OFFSET_TOTAL 0
+
+/** Offset of the number of (channel, temperature) pairs in the parameter area of an aggregated report */
+#define CR_DA_AGGR_OFFSET_N 4
+
+/** Offset of the first (channel, temperature) pair in the parameter area of an aggregated report */
+#define CR_DA_AGGR_OFFSET_PAIRS 5
+
+/** Size in bytes of a (channel, temperature) pair in an aggregated report */
+#define CR_DA_AGGR_PAIR_SIZE 4
+
+/** The length of the packets of the aggregated reports */
+#define CR_DA_AGGR_PCKT_LENGTH CR_DA_PCKT_MAX_LENGTH
+
+/**
+ * Return the number of (channel, temperature) pairs which fit in a parameter area.
+ * The number is limited to 255 by the size of the number of pairs in the report.
+ * @param parLength the length of the parameter area in bytes
+ */
+#define CR_DA_AGGR_CAPACITY(parLength) \
+	((((parLength)-CR_DA_AGGR_OFFSET_PAIRS)/CR_DA_AGGR_PAIR_SIZE) > 255 ? 255 : \
+	 (((parLength)-CR_DA_AGGR_OFFSET_PAIRS)/CR_DA_AGGR_PAIR_SIZE))
+
+/** The maximum number of (channel, temperature) pairs in an aggregated report */
+#define CR_DA_AGGR_MAX_N CR_DA_AGGR_CAPACITY(CR_DA_AGGR_PCKT_LENGTH-CR_DA_PCKT_PAR_OFFSET)
+
+#endif /* CRFW_USERCONSTANTS_H_ */
@@ -0,0 +1,281 @@
+/**
+ * @file
+ * @ingroup crDemoCommon
+ *
+ * Benchmark of the multi-destination fan-out of packets.
+ *
+ * This file provides the main program of the <code>cr_fanoutbench</code> tool which
+ * compares the fan-out of a report to several OutStreams with copied packets and with
+ * shared packets (see <code>CrDaPcktShare.h</code>).
+ * The tool is called as follows:
+ * <pre>
+ *   cr_fanoutbench [-n reports] [-r rate] [-q queue]
+ * </pre>
+ * The tool uses the packet pool of the demo applications (<code>CrFwPckt.c</code>) with
+ * its configured size of <code>CR_FW_MAX_NOF_PCKTS</code> packets.
+ * It sends <code>reports</code> temperature violation reports (1000 by default) to
+ * 2, 4, 8, 16, 32 and 64 destinations.
+ * Each destination is modelled by the packet queue of an OutStream of
+ * <code>queue</code> packets (10 by default, as in the demo applications):
+ * in each cycle, <code>rate</code> reports (1 by default) are made and put in the
+ * queues of all destinations and the queues are then emptied (the packets are handed
+ * over and released).
+ * The fan-out is made twice:
+ * - <b>copy</b>: each destination gets its own copy of the report, as with the
+ *   single-owner packets of <code>CrFwPckt.h</code>;
+ * - <b>shared</b>: each destination gets a reference to the report
+ *   (<code>::CrFwPcktRetain</code>).
+ * .
+ * For each fan-out and each mode, the tool prints the number of reports which reached
+ * their destinations, the number of packets which could not be allocated, the peak
+ * number of packets in use in the pool and the number of bytes copied.
+ * For the shared mode, it also prints the number of bytes which the shared references
+ * saved from being copied.
+ * At the end of each fan-out, all packets must have returned to the pool and the tool
+ * fails if a packet is leaked or if a report of the shared mode did not reach all its
+ * destinations.
+ *
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the CORDET Framework.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+/* Include demo application files */
+#include "CrDaConstants.h"
+#include "CrDaPcktShare.h"
+/* Include framework files */
+#include "CrFwConstants.h"
+#include "Pckt/CrFwPckt.h"
+
+/** The default number of reports */
+#define CR_DA_FAN_OUT_BENCH_DEF_N 1000
+
+/** The default number of reports made in each cycle */
+#define CR_DA_FAN_OUT_BENCH_DEF_RATE 1
+
+/** The default size of the packet queue of a destination */
+#define CR_DA_FAN_OUT_BENCH_DEF_QUEUE 10
+
+/** The maximum size of the packet queue of a destination */
+#define CR_DA_FAN_OUT_BENCH_MAX_QUEUE 64
+
+/** The number of fan-outs which are measured */
+#define CR_DA_FAN_OUT_BENCH_N_OF_FAN_OUTS 6
+
+/** The largest fan-out which is measured */
+#define CR_DA_FAN_OUT_BENCH_MAX_FAN_OUT 64
+
+/** The length of the reports (the parameter is the report number) */
+#define CR_DA_FAN_OUT_BENCH_PCKT_LENGTH (CR_DA_PCKT_PAR_OFFSET+4)
+
+/** The packet queue of a destination */
+typedef struct {
+	/** The packets in the queue */
+	CrFwPckt_t pckt[CR_DA_FAN_OUT_BENCH_MAX_QUEUE];
+	/** The number of packets in the queue */
+	unsigned int n;
+} CrDaFanOutBenchQueue_t;
+
+/** The result of a fan-out */
+typedef struct {
+	/** The number of reports which reached a destination */
+	unsigned long nOfDelivered;
+	/** The number of packets which could not be allocated */
+	unsigned long nOfAllocFails;
+	/** The number of packets which could not be put in a full queue */
+	unsigned long nOfQueueFulls;
+	/** The peak number of packets in use in the pool */
+	unsigned int peak;
+	/** The number of bytes copied */
+	unsigned long long bytesCopied;
+	/** The number of bytes which the shared references saved from being copied */
+	unsigned long long bytesSaved;
+	/** The number of packets still in use at the end of the fan-out */
+	unsigned int nOfLeaked;
+} CrDaFanOutBenchRes_t;
+
+/** The packet queues of the destinations */
+static CrDaFanOutBenchQueue_t queue[CR_DA_FAN_OUT_BENCH_MAX_FAN_OUT];
+
+/**
+ * Run a fan-out.
+ * @param fanOut the number of destinations
+ * @param isShared 1 if the destinations share the reports, 0 if they get copies
+ * @param n the number of reports
+ * @param rate the number of reports made in each cycle
+ * @param queueSize the size of the packet queue of a destination
+ * @param res the result of the fan-out
+ */
+static void run(unsigned int fanOut, int isShared, unsigned long n, unsigned int rate,
+                unsigned int queueSize, CrDaFanOutBenchRes_t* res);
+
+/**
+ * Put a report in the queue of a destination.
+ * @param q the queue
+ * @param pckt the report
+ * @param isShared 1 if the destination shares the report, 0 if it gets a copy
+ * @param queueSize the size of the queue
+ * @param res the result of the fan-out
+ */
+static void enqueue(CrDaFanOutBenchQueue_t* q, CrFwPckt_t pckt, int isShared, unsigned int queueSize,
+                    CrDaFanOutBenchRes_t* res);
+
+/**
+ * Update the peak number of packets in use in the pool.
+ * @param res the result of the fan-out
+ */
+static void updatePeak(CrDaFanOutBenchRes_t* res);
+
+/**
+ * Print the result of a fan-out.
+ * @param fanOut the number of destinations
+ * @param name the name of the mode
+ * @param n the number of reports
+ * @param res the result
+ */
+static void printRes(unsigned int fanOut, const char* name, unsigned long n, CrDaFanOutBenchRes_t* res);
+
+/* ---------------------------------------------------------------------------------------------*/
+int main(int argc, char* argv[]) {
+	const unsigned int fanOut[CR_DA_FAN_OUT_BENCH_N_OF_FAN_OUTS] = {2, 4, 8, 16, 32, 64};
+	CrDaFanOutBenchRes_t copy, shared;
+	unsigned long n = CR_DA_FAN_OUT_BENCH_DEF_N;
+	unsigned int rate = CR_DA_FAN_OUT_BENCH_DEF_RATE;
+	unsigned int queueSize = CR_DA_FAN_OUT_BENCH_DEF_QUEUE;
+	int opt, i, isOk = 1;
+
+	while ((opt = getopt(argc, argv, "n:r:q:")) != -1) {
+		switch (opt) {
+			case 'n':
+				n = strtoul(optarg, NULL, 10);
+				break;
+			case 'r':
+				rate = (unsigned int)atoi(optarg);
+				break;
+			case 'q':
+				queueSize = (unsigned int)atoi(optarg);
+				break;
+			default:
+				n = 0;
+				break;
+		}
+	}
+	if ((n == 0) || (rate == 0) || (queueSize == 0) || (queueSize > CR_DA_FAN_OUT_BENCH_MAX_QUEUE) ||
+	        (optind != argc)) {
+		printf("Usage: %s [-n reports] [-r rate] [-q queue]\n", argv[0]);
+		return EXIT_FAILURE;
+	}
+
+	printf("Pool of %d packets, %lu reports of %d bytes, %u reports per cycle, queues of %u packets\n",
+	       CR_FW_MAX_NOF_PCKTS, n, CR_DA_FAN_OUT_BENCH_PCKT_LENGTH, rate, queueSize);
+	printf("%6s %-6s %10s %11s %9s %12s %12s\n", "fanout", "mode", "delivered", "allocfails",
+	       "peakpool", "bytescopied", "bytessaved");
+	for (i=0; i<CR_DA_FAN_OUT_BENCH_N_OF_FAN_OUTS; i++) {
+		run(fanOut[i], 0, n, rate, queueSize, &copy);
+		run(fanOut[i], 1, n, rate, queueSize, &shared);
+		printRes(fanOut[i], "copy", n, &copy);
+		printRes(fanOut[i], "shared", n, &shared);
+		if ((copy.nOfLeaked > 0) || (shared.nOfLeaked > 0)) {
+			printf("cr_fanoutbench: %u packets leaked with a fan-out of %u\n", copy.nOfLeaked + shared.nOfLeaked,
+			       fanOut[i]);
+			isOk = 0;
+		}
+		if ((shared.nOfDelivered != n*fanOut[i]) && (rate <= queueSize)) {
+			printf("cr_fanoutbench: shared reports lost with a fan-out of %u\n", fanOut[i]);
+			isOk = 0;
+		}
+	}
+	return (isOk ? EXIT_SUCCESS : EXIT_FAILURE);
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static void run(unsigned int fanOut, int isShared, unsigned long n, unsigned int rate,
+                unsigned int queueSize, CrDaFanOutBenchRes_t* res) {
+	unsigned long long bytesSaved = CrFwPcktGetNOfBytesSaved();
+	CrFwPckt_t pckt;
+	unsigned long nr = 0;
+	unsigned int repNr, i, j, k;
+
+	memset(res, 0, sizeof(*res));
+	memset(queue, 0, sizeof(queue));
+	while (nr < n) {
+		/* Make the reports of the cycle and put them in the queues of the destinations */
+		for (i=0; (i<rate) && (nr<n); i++, nr++) {
+			pckt = CrFwPcktMake(CR_DA_FAN_OUT_BENCH_PCKT_LENGTH);
+			if (pckt == NULL) {
+				res->nOfAllocFails++;
+				continue;
+			}
+			CrFwPcktSetCmdRepType(pckt, crRepType);
+			CrFwPcktSetServType(pckt, CR_DA_SERV_TYPE);
+			CrFwPcktSetServSubType(pckt, CR_DA_SERV_SUBTYPE_REP);
+			CrFwPcktSetSrc(pckt, CR_DA_SLAVE_1);
+			CrFwPcktSetDest(pckt, CR_DA_BROADCAST);
+			repNr = (unsigned int)nr;
+			memcpy(pckt+CR_DA_PCKT_PAR_OFFSET, &repNr, sizeof(unsigned int));
+			updatePeak(res);
+			for (j=0; j<fanOut; j++)
+				enqueue(&queue[j], pckt, isShared, queueSize, res);
+			CrFwPcktRelease(pckt);	/* the destinations hold their own references or copies */
+		}
+
+		/* Hand over the packets in the queues of the destinations */
+		for (j=0; j<fanOut; j++) {
+			for (k=0; k<queue[j].n; k++)
+				CrFwPcktRelease(queue[j].pckt[k]);
+			res->nOfDelivered += queue[j].n;
+			queue[j].n = 0;
+		}
+	}
+	res->bytesSaved = CrFwPcktGetNOfBytesSaved() - bytesSaved;
+	res->nOfLeaked = CrFwPcktGetNOfAllocated();
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static void enqueue(CrDaFanOutBenchQueue_t* q, CrFwPckt_t pckt, int isShared, unsigned int queueSize,
+                    CrDaFanOutBenchRes_t* res) {
+	CrFwPckt_t copy;
+
+	if (q->n == queueSize) {
+		res->nOfQueueFulls++;
+		return;
+	}
+	if (isShared && CrFwPcktRetain(pckt)) {
+		q->pckt[q->n++] = pckt;
+		return;
+	}
+	copy = CrFwPcktMake(CrFwPcktGetLength(pckt));
+	if (copy == NULL) {
+		res->nOfAllocFails++;
+		return;
+	}
+	memcpy(copy, pckt, CrFwPcktGetLength(pckt));
+	res->bytesCopied += CrFwPcktGetLength(pckt);
+	q->pckt[q->n++] = copy;
+	updatePeak(res);
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static void updatePeak(CrDaFanOutBenchRes_t* res) {
+	if (CrFwPcktGetNOfAllocated() > res->peak)
+		res->peak = CrFwPcktGetNOfAllocated();
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static void printRes(unsigned int fanOut, const char* name, unsigned long n, CrDaFanOutBenchRes_t* res) {
+	printf("%6u %-6s %4.0f%% of %3u %11lu %5u/%-3d %12llu %12llu\n", fanOut, name,
+	       100.0*(double)res->nOfDelivered/(double)(n*fanOut), fanOut, res->nOfAllocFails, res->peak,
+	       CR_FW_MAX_NOF_PCKTS, res->bytesCopied, res->bytesSaved);
+}
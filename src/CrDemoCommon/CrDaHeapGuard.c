@@ -0,0 +1,133 @@
+/**
+ * @file
+ * @ingroup crDemoCommon
+ * Implementation of the heap guard of the demo applications.
+ *
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the CORDET Framework.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#include <stdio.h>
+#include <stddef.h>
+#include <string.h>
+#include <unistd.h>
+#include <execinfo.h>
+#include "CrDaHeapGuard.h"
+
+/** The allocator entry points of the GNU C library */
+extern void* __libc_malloc(size_t size);
+/** The allocator entry points of the GNU C library */
+extern void* __libc_calloc(size_t n, size_t size);
+/** The allocator entry points of the GNU C library */
+extern void* __libc_realloc(void* ptr, size_t size);
+/** The allocator entry points of the GNU C library */
+extern void __libc_free(void* ptr);
+
+/** Whether the heap guard is armed */
+static volatile int isArmed = 0;
+
+/** The tag with which the reports are prefixed */
+static const char* armTag = "";
+
+/** The number of trapped allocations */
+static unsigned long nOfTrapped = 0;
+
+/** The number of trapped releases */
+static unsigned long nOfTrappedFree = 0;
+
+/** Whether the current thread is reporting a trapped allocation (its own allocations are not trapped) */
+static __thread int isReporting = 0;
+
+/**
+ * Trap an allocation: count it and, if it is one of the first allocations, report it.
+ * @param func the name of the allocator function
+ * @param size the size of the allocation
+ */
+static void trap(const char* func, size_t size);
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaHeapGuardArm(const char* tag) {
+	void* frames[1];
+
+	/* The first backtrace may load the unwinder, which allocates: do it before arming */
+	backtrace(frames, 1);
+	armTag = tag;
+	isArmed = 1;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaHeapGuardDisarm() {
+	isArmed = 0;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+unsigned long CrDaHeapGuardGetNOfTrapped() {
+	return __atomic_load_n(&nOfTrapped, __ATOMIC_RELAXED);
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaHeapGuardPrintSummary(const char* tag) {
+	printf("%s: Heap guard: %lu allocations and %lu releases in the control cycles\n", tag,
+	       CrDaHeapGuardGetNOfTrapped(), __atomic_load_n(&nOfTrappedFree, __ATOMIC_RELAXED));
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void* malloc(size_t size) {
+	if (isArmed && !isReporting)
+		trap("malloc", size);
+	return __libc_malloc(size);
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void* calloc(size_t n, size_t size) {
+	if (isArmed && !isReporting)
+		trap("calloc", n*size);
+	return __libc_calloc(n, size);
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void* realloc(void* ptr, size_t size) {
+	if (isArmed && !isReporting)
+		trap("realloc", size);
+	return __libc_realloc(ptr, size);
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void free(void* ptr) {
+	if (isArmed && !isReporting && (ptr != NULL))
+		__atomic_fetch_add(&nOfTrappedFree, 1, __ATOMIC_RELAXED);
+	__libc_free(ptr);
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static void trap(const char* func, size_t size) {
+	void* frames[CR_DA_HEAP_GUARD_MAX_DEPTH];
+	char line[128];
+	unsigned long n;
+	int depth, len;
+
+	n = __atomic_fetch_add(&nOfTrapped, 1, __ATOMIC_RELAXED);
+	if (n >= CR_DA_HEAP_GUARD_MAX_N_OF_REPORTS)
+		return;
+
+	/* Report without allocating: format on the stack and write to the standard error */
+	isReporting = 1;
+	len = snprintf(line, sizeof(line), "%s: Heap guard: %s of %lu bytes in the control cycles\n",
+	               armTag, func, (unsigned long)size);
+	if (len > (int)sizeof(line)-1)
+		len = (int)sizeof(line)-1;
+	if (write(STDERR_FILENO, line, (size_t)len) < 0)
+		len = 0;
+	depth = backtrace(frames, CR_DA_HEAP_GUARD_MAX_DEPTH);
+	backtrace_symbols_fd(frames, depth, STDERR_FILENO);
+	isReporting = 0;
+}
@@ -0,0 +1,77 @@
+/**
+ * @file
+ * @ingroup crDemoCommon
+ * Heap guard which verifies that the control cycles do not allocate memory.
+ * The demo applications allocate all their memory during their initialization
+ * (see <code>CrDaStartUp.h</code>).
+ * The heap guard verifies that this remains true in the control cycles: it interposes
+ * the allocator functions (<code>malloc</code>, <code>calloc</code>, <code>realloc</code>
+ * and <code>free</code>) of the process and, once it has been armed, it traps every
+ * allocation.
+ * The first <code>#CR_DA_HEAP_GUARD_MAX_N_OF_REPORTS</code> allocations which are trapped
+ * are reported on the standard error with their size and the backtrace of the caller;
+ * the further allocations are only counted.
+ * The trapped allocations are served normally: the heap guard is a verification aid
+ * and does not change the behaviour of the application.
+ *
+ * The heap guard is only linked into the verification builds of the applications
+ * (the <code>heapguard</code> option of the application build scripts and of
+ * <code>CompileAndLinkLb.sh</code>) which are compiled with <code>CR_DA_HEAP_GUARD</code>
+ * defined.
+ * The main program of a stand-alone application arms the heap guard at the end of its
+ * initialization and disarms it at the beginning of its termination.
+ * In the loopback harness, the three applications are initialized one after the other
+ * and the harness arms the heap guard when all three have been initialized.
+ *
+ * The allocator functions are forwarded to the allocator of the C library (through its
+ * <code>__libc_malloc</code>, <code>__libc_calloc</code>, <code>__libc_realloc</code>
+ * and <code>__libc_free</code> entry points): the heap guard therefore requires the
+ * GNU C library.
+ * It can be used by several threads.
+ *
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the CORDET Framework.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#ifndef CRDA_HEAPGUARD_H_
+#define CRDA_HEAPGUARD_H_
+
+/** The maximum number of trapped allocations which are reported with their backtrace */
+#define CR_DA_HEAP_GUARD_MAX_N_OF_REPORTS 16
+
+/** The maximum depth of the backtrace of a trapped allocation */
+#define CR_DA_HEAP_GUARD_MAX_DEPTH 32
+
+/**
+ * Arm the heap guard: from now on, every allocation is trapped.
+ * @param tag the tag of the application (or of the harness) with which the reports are prefixed
+ */
+void CrDaHeapGuardArm(const char* tag);
+
+/**
+ * Disarm the heap guard: from now on, the allocations are no longer trapped.
+ */
+void CrDaHeapGuardDisarm();
+
+/**
+ * Return the number of allocations which have been trapped.
+ * @return the number of trapped allocations
+ */
+unsigned long CrDaHeapGuardGetNOfTrapped();
+
+/**
+ * Print the number of allocations and releases which have been trapped.
+ * @param tag the tag with which the line is prefixed
+ */
+void CrDaHeapGuardPrintSummary(const char* tag);
+
+#endif /* CRDA_HEAPGUARD_H_ */
@@ -0,0 +1,218 @@
+/**
+ * @file
+ * @ingroup crDemoCommon
+ *
+ * Benchmark of the lookup of the command and report kinds.
+ *
+ * This file provides the main program of the <code>cr_kindbench</code> tools which
+ * measure the cost of finding the position of a [service type, service sub-type,
+ * discriminant] triplet in a kind descriptor array (see <code>CrDaKindIndex.h</code>).
+ * A tool is built for each of the catalogues of 10, 100 and 1000 kinds which
+ * <code>GenKindCatalogue.sh</code> generates (<code>cr_kindbench_10</code>,
+ * <code>cr_kindbench_100</code> and <code>cr_kindbench_1000</code>): it is compiled with
+ * the configuration files of its catalogue and linked with the kind index tables which
+ * <code>GenKindIndex.sh</code> generates for it.
+ * The tools are called as follows:
+ * <pre>
+ *   cr_kindbench_&lt;kinds&gt; [-u percent] [-n lookups]
+ * </pre>
+ * The tool looks up <code>lookups</code> OutComponent kinds (10 million by default) of
+ * which <code>percent</code> percent (10 by default) are not supported.
+ * It finds the kinds in three ways:
+ * - with a linear search of <code>#CR_FW_OUTCMP_INIT_KIND_DESC</code>;
+ * - with a binary search of the kind keys of <code>#CR_FW_OUTCMP_INIT_KIND_DESC</code>
+ *   (which are in increasing order);
+ * - with <code>::CrDaKindIndexGetOutCmp</code>.
+ * .
+ * The tool prints the time per lookup of the three methods and the speed-up of the
+ * direct index over the linear search.
+ * It fails if the three methods do not find the same positions or if
+ * <code>::CrDaKindIndexGetInCmd</code> does not find the position of each kind of
+ * <code>#CR_FW_INCMD_INIT_KIND_DESC</code>.
+ *
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the CORDET Framework.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+/* Include demo application files */
+#include "CrDaKindIndex.h"
+#include "CrDaClock.h"
+/* Include the configuration files of the catalogue */
+#include "CrFwInFactoryUserPar.h"
+#include "CrFwOutFactoryUserPar.h"
+
+/** The default percentage of lookups of unsupported kinds */
+#define CR_DA_KIND_BENCH_DEF_UNSUPPORTED 10.0
+
+/** The default number of lookups */
+#define CR_DA_KIND_BENCH_DEF_LOOKUPS 10000000UL
+
+/** The key of the kind [servType, servSubType, discriminant] (as in <code>CrDaKindIndex.c</code>) */
+#define CR_DA_KIND_BENCH_KEY(servType, servSubType, discriminant) \
+	(((servType)*(CR_FW_MAX_SERV_SUBTYPE+1)+(servSubType))*(CR_FW_MAX_DISCRIMINANT+1)+(discriminant))
+
+/** The part of a kind descriptor which identifies the kind (the catalogue defines no other part) */
+typedef struct {
+	/** The service type */
+	CrFwServType_t servType;
+	/** The service sub-type */
+	CrFwServSubType_t servSubType;
+	/** The discriminant */
+	CrFwDiscriminant_t discriminant;
+} CrDaKindBenchDesc_t;
+
+/** The InCommand kind descriptor array of the catalogue */
+static const CrDaKindBenchDesc_t inCmdKindDesc[CR_FW_INCMD_NKINDS] = CR_FW_INCMD_INIT_KIND_DESC;
+
+/** The OutComponent kind descriptor array of the catalogue */
+static const CrDaKindBenchDesc_t outCmpKindDesc[CR_FW_OUTCMP_NKINDS] = CR_FW_OUTCMP_INIT_KIND_DESC;
+
+/** The keys of the OutComponent kinds (in the order of the kind descriptor array) */
+static unsigned int outCmpKey[CR_FW_OUTCMP_NKINDS];
+
+/**
+ * Find an OutComponent kind with a linear search of the kind descriptor array.
+ * @param servType the service type
+ * @param servSubType the service sub-type
+ * @param discriminant the discriminant
+ * @return the position of the kind or <code>#CR_FW_OUTCMP_NKINDS</code> if it is not supported
+ */
+static CrFwCmdRepKindIndex_t findLinear(CrFwServType_t servType, CrFwServSubType_t servSubType,
+                                        CrFwDiscriminant_t discriminant);
+
+/**
+ * Find an OutComponent kind with a binary search of the kind keys.
+ * @param servType the service type
+ * @param servSubType the service sub-type
+ * @param discriminant the discriminant
+ * @return the position of the kind or <code>#CR_FW_OUTCMP_NKINDS</code> if it is not supported
+ */
+static CrFwCmdRepKindIndex_t findBinary(CrFwServType_t servType, CrFwServSubType_t servSubType,
+                                        CrFwDiscriminant_t discriminant);
+
+/* ---------------------------------------------------------------------------------------------*/
+int main(int argc, char* argv[]) {
+	double unsupported = CR_DA_KIND_BENCH_DEF_UNSUPPORTED;
+	unsigned long nOfLookups = CR_DA_KIND_BENCH_DEF_LOOKUPS;
+	CrDaKindBenchDesc_t* query;
+	unsigned long long start, linearTime, binaryTime, directTime;
+	unsigned long sumLinear = 0, sumBinary = 0, sumDirect = 0;
+	unsigned long k;
+	unsigned int i;
+	int opt, isOk = 1;
+
+	while ((opt = getopt(argc, argv, "u:n:")) != -1) {
+		switch (opt) {
+			case 'u':
+				unsupported = atof(optarg);
+				break;
+			case 'n':
+				nOfLookups = strtoul(optarg, NULL, 10);
+				break;
+			default:
+				nOfLookups = 0;
+				break;
+		}
+	}
+	if ((nOfLookups == 0) || (unsupported < 0) || (unsupported > 100) || (optind != argc)) {
+		printf("Usage: %s [-u percent] [-n lookups]\n", argv[0]);
+		return EXIT_FAILURE;
+	}
+	query = malloc(nOfLookups*sizeof(CrDaKindBenchDesc_t));
+	if (query == NULL) {
+		printf("cr_kindbench: cannot allocate %lu lookups\n", nOfLookups);
+		return EXIT_FAILURE;
+	}
+
+	for (i=0; i<CR_FW_OUTCMP_NKINDS; i++)
+		outCmpKey[i] = CR_DA_KIND_BENCH_KEY(outCmpKindDesc[i].servType, outCmpKindDesc[i].servSubType,
+		                                    outCmpKindDesc[i].discriminant);
+	for (i=0; i<CR_FW_INCMD_NKINDS; i++)
+		if (CrDaKindIndexGetInCmd(inCmdKindDesc[i].servType, inCmdKindDesc[i].servSubType,
+		                          inCmdKindDesc[i].discriminant) != i)
+			isOk = 0;
+
+	/* Draw the kinds which are looked up: an unsupported kind has the sub-type of a supported
+	 * kind plus one (the catalogues leave a gap after each kind) */
+	srand(1);
+	for (k=0; k<nOfLookups; k++) {
+		query[k] = outCmpKindDesc[(unsigned int)rand() % CR_FW_OUTCMP_NKINDS];
+		if (((double)rand()/RAND_MAX*100.0 < unsupported) && (query[k].servSubType < CR_FW_MAX_SERV_SUBTYPE))
+			query[k].servSubType++;
+	}
+
+	start = CrDaClockGetHostTime();
+	for (k=0; k<nOfLookups; k++)
+		sumLinear += findLinear(query[k].servType, query[k].servSubType, query[k].discriminant);
+	linearTime = CrDaClockGetHostTime() - start;
+
+	start = CrDaClockGetHostTime();
+	for (k=0; k<nOfLookups; k++)
+		sumBinary += findBinary(query[k].servType, query[k].servSubType, query[k].discriminant);
+	binaryTime = CrDaClockGetHostTime() - start;
+
+	start = CrDaClockGetHostTime();
+	for (k=0; k<nOfLookups; k++)
+		sumDirect += CrDaKindIndexGetOutCmp(query[k].servType, query[k].servSubType, query[k].discriminant);
+	directTime = CrDaClockGetHostTime() - start;
+
+	/* Check the positions found by the three methods (the sums keep the timed loops alive) */
+	if ((sumLinear != sumBinary) || (sumLinear != sumDirect))
+		isOk = 0;
+	for (k=0; (k<nOfLookups) && isOk; k++) {
+		i = findLinear(query[k].servType, query[k].servSubType, query[k].discriminant);
+		isOk = ((findBinary(query[k].servType, query[k].servSubType, query[k].discriminant) == i) &&
+		        (CrDaKindIndexGetOutCmp(query[k].servType, query[k].servSubType, query[k].discriminant) == i));
+	}
+
+	printf("%6s %14s %14s %14s %8s\n", "kinds", "linear ns/op", "binary ns/op", "direct ns/op", "speedup");
+	printf("%6u %14.2f %14.2f %14.2f %7.1fx%s\n", (unsigned int)CR_FW_OUTCMP_NKINDS,
+	       (double)linearTime/(double)nOfLookups, (double)binaryTime/(double)nOfLookups,
+	       (double)directTime/(double)nOfLookups, (double)linearTime/(double)directTime,
+	       (isOk ? "" : "  MISMATCH"));
+
+	free(query);
+	return (isOk ? EXIT_SUCCESS : EXIT_FAILURE);
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static CrFwCmdRepKindIndex_t findLinear(CrFwServType_t servType, CrFwServSubType_t servSubType,
+                                        CrFwDiscriminant_t discriminant) {
+	CrFwCmdRepKindIndex_t i;
+
+	for (i=0; i<CR_FW_OUTCMP_NKINDS; i++)
+		if ((outCmpKindDesc[i].servType == servType) && (outCmpKindDesc[i].servSubType == servSubType) &&
+		        (outCmpKindDesc[i].discriminant == discriminant))
+			return i;
+	return CR_FW_OUTCMP_NKINDS;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static CrFwCmdRepKindIndex_t findBinary(CrFwServType_t servType, CrFwServSubType_t servSubType,
+                                        CrFwDiscriminant_t discriminant) {
+	unsigned int key = CR_DA_KIND_BENCH_KEY(servType, servSubType, discriminant);
+	unsigned int lo = 0, hi = CR_FW_OUTCMP_NKINDS, mid;
+
+	while (lo < hi) {
+		mid = (lo+hi)/2;
+		if (outCmpKey[mid] < key)
+			lo = mid+1;
+		else
+			hi = mid;
+	}
+	if ((lo < CR_FW_OUTCMP_NKINDS) && (outCmpKey[lo] == key))
+		return (CrFwCmdRepKindIndex_t)lo;
+	return CR_FW_OUTCMP_NKINDS;
+}
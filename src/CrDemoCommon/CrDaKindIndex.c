@@ -0,0 +1,87 @@
+/**
+ * @file
+ * @ingroup crDemoCommon
+ *
+ * Implementation of the direct-index lookup of command and report kinds.
+ *
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the CORDET Framework.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#include <stdlib.h>
+#include "CrDaKindIndex.h"
+/* Include configuration files */
+#include "CrFwInFactoryUserPar.h"
+#include "CrFwOutFactoryUserPar.h"
+/* Include generated files */
+#include "CrDaKindIndexTab.h"
+
+/** Number of entries in a kind index table. */
+#define CR_DA_KIND_INDEX_SIZE \
+	((CR_FW_MAX_SERV_TYPE+1)*(CR_FW_MAX_SERV_SUBTYPE+1)*(CR_FW_MAX_DISCRIMINANT+1))
+
+/** The key of the kind [servType, servSubType, discriminant] in a kind index table. */
+#define CR_DA_KIND_KEY(servType, servSubType, discriminant) \
+	(((servType)*(CR_FW_MAX_SERV_SUBTYPE+1)+(servSubType))*(CR_FW_MAX_DISCRIMINANT+1)+(discriminant))
+
+/**
+ * Initializer for one entry of a kind index table (used in <code>CrDaKindIndexTab.h</code>).
+ * Entries are stored as position plus one so that entries which are not explicitly
+ * initialized (value zero) designate unsupported kinds.
+ */
+#define CR_DA_KIND_INDEX_ENTRY(servType, servSubType, discriminant, pos) \
+	[CR_DA_KIND_KEY(servType, servSubType, discriminant)] = (pos)+1
+
+/** The InCommand kind index table. */
+static const CrFwCmdRepKindIndex_t inCmdKindIndex[CR_DA_KIND_INDEX_SIZE] = CR_DA_INCMD_KIND_INDEX_INIT;
+
+/** The OutComponent kind index table. */
+static const CrFwCmdRepKindIndex_t outCmpKindIndex[CR_DA_KIND_INDEX_SIZE] = CR_DA_OUTCMP_KIND_INDEX_INIT;
+
+/**
+ * Look up a kind in a kind index table.
+ * @param kindIndex the kind index table
+ * @param servType the service type
+ * @param servSubType the service sub-type
+ * @param discriminant the discriminant
+ * @param nOfKinds the number of kinds in the kind descriptor array
+ * @return the position of the kind or <code>nOfKinds</code> if the kind is not supported.
+ */
+static CrFwCmdRepKindIndex_t getKindIndex(const CrFwCmdRepKindIndex_t* kindIndex, CrFwServType_t servType,
+        CrFwServSubType_t servSubType, CrFwDiscriminant_t discriminant, CrFwCmdRepKindIndex_t nOfKinds);
+
+/* --------------------------------------------------------------------------------- */
+CrFwCmdRepKindIndex_t CrDaKindIndexGetInCmd(CrFwServType_t servType, CrFwServSubType_t servSubType,
+        CrFwDiscriminant_t discriminant) {
+	return getKindIndex(inCmdKindIndex, servType, servSubType, discriminant, CR_FW_INCMD_NKINDS);
+}
+
+/* --------------------------------------------------------------------------------- */
+CrFwCmdRepKindIndex_t CrDaKindIndexGetOutCmp(CrFwServType_t servType, CrFwServSubType_t servSubType,
+        CrFwDiscriminant_t discriminant) {
+	return getKindIndex(outCmpKindIndex, servType, servSubType, discriminant, CR_FW_OUTCMP_NKINDS);
+}
+
+/* --------------------------------------------------------------------------------- */
+static CrFwCmdRepKindIndex_t getKindIndex(const CrFwCmdRepKindIndex_t* kindIndex, CrFwServType_t servType,
+        CrFwServSubType_t servSubType, CrFwDiscriminant_t discriminant, CrFwCmdRepKindIndex_t nOfKinds) {
+	CrFwCmdRepKindIndex_t entry;
+
+	if ((servType > CR_FW_MAX_SERV_TYPE) || (servSubType > CR_FW_MAX_SERV_SUBTYPE) ||
+	        (discriminant > CR_FW_MAX_DISCRIMINANT))
+		return nOfKinds;
+
+	entry = kindIndex[CR_DA_KIND_KEY(servType, servSubType, discriminant)];
+	if (entry == 0)
+		return nOfKinds;
+	return (CrFwCmdRepKindIndex_t)(entry-1);
+}
@@ -0,0 +1,81 @@
+/**
+ * @file
+ * @ingroup crDemoCommon
+ * Direct-index lookup of the command and report kinds supported by an application.
+ * The kinds supported by an application are defined by the kind descriptor
+ * initializers <code>#CR_FW_INCMD_INIT_KIND_DESC</code> (see <code>CrFwInFactoryUserPar.h</code>)
+ * and <code>#CR_FW_OUTCMP_INIT_KIND_DESC</code>
+ * (see <code>CrFwOutFactoryUserPar.h</code>).
+ * These are flat arrays which must be searched to find the descriptor of a given
+ * [service type, service sub-type, discriminant] triplet.
+ *
+ * This module offers a constant-time alternative.
+ * At build time, script <code>GenKindIndex.sh</code> expands the kind descriptor
+ * initializers and generates header file <code>CrDaKindIndexTab.h</code> which holds
+ * one entry for each kind.
+ * The entries are used to initialize two tables indexed directly by the kind key:
+ * <code>(servType*(#CR_FW_MAX_SERV_SUBTYPE+1)+servSubType)*(#CR_FW_MAX_DISCRIMINANT+1)+discriminant</code>.
+ * A table entry holds the position of the kind in its kind descriptor array.
+ *
+ * The size of each table is <code>(#CR_FW_MAX_SERV_TYPE+1)*(#CR_FW_MAX_SERV_SUBTYPE+1)*(#CR_FW_MAX_DISCRIMINANT+1)</code>
+ * entries.
+ * The tables are therefore only suitable for applications where the maximum
+ * discriminant value is small.
+ *
+ * Since the content of the tables depends on the application configuration,
+ * this module is compiled separately for each application.
+ *
+ * The framework factories find the descriptor of a kind with their own search, which
+ * lives in the framework and is not replaced.
+ * The build scripts of the demo applications nevertheless generate the tables of each
+ * application: <code>GenKindIndex.sh</code> then also checks that no kind is defined
+ * twice in a kind descriptor array.
+ *
+ * The <code>cr_kindbench</code> tool (see <code>CrDaKindBenchMain.c</code>) measures the
+ * lookup in the tables which <code>GenKindIndex.sh</code> generates for catalogues of 10,
+ * 100 and 1000 kinds and compares it with a search of the kind descriptor array.
+ *
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the CORDET Framework.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#ifndef CRDA_KINDINDEX_H_
+#define CRDA_KINDINDEX_H_
+
+/* Include Framework Files */
+#include "CrFwConstants.h"
+/* Include Configuration Files */
+#include "CrFwUserConstants.h"
+
+/**
+ * Return the position of an InCommand kind in <code>#CR_FW_INCMD_INIT_KIND_DESC</code>.
+ * @param servType the service type
+ * @param servSubType the service sub-type
+ * @param discriminant the discriminant
+ * @return the position of the InCommand kind or <code>#CR_FW_INCMD_NKINDS</code> if the
+ * kind is not supported by the application.
+ */
+CrFwCmdRepKindIndex_t CrDaKindIndexGetInCmd(CrFwServType_t servType, CrFwServSubType_t servSubType,
+        CrFwDiscriminant_t discriminant);
+
+/**
+ * Return the position of an OutComponent kind in <code>#CR_FW_OUTCMP_INIT_KIND_DESC</code>.
+ * @param servType the service type
+ * @param servSubType the service sub-type
+ * @param discriminant the discriminant
+ * @return the position of the OutComponent kind or <code>#CR_FW_OUTCMP_NKINDS</code> if the
+ * kind is not supported by the application.
+ */
+CrFwCmdRepKindIndex_t CrDaKindIndexGetOutCmp(CrFwServType_t servType, CrFwServSubType_t servSubType,
+        CrFwDiscriminant_t discriminant);
+
+#endif /* CRDA_KINDINDEX_H_ */
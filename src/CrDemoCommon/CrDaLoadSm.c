@@ -0,0 +1,340 @@
+/**
+ * @file
+ * @ingroup crDemoCommon
+ * Implementation of the Load State Machine of the demo applications.
+ *
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the CORDET Framework.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#include <stdio.h>
+#include "CrDaLoadSm.h"
+#include "CrDaTrace.h"
+/* Include FW Profile files */
+#include "FwSmConstants.h"
+#include "FwSmSCreate.h"
+#include "FwSmConfig.h"
+#include "FwSmCore.h"
+/* Include configuration files */
+#include "CrFwCmpData.h"
+/* Include framework files */
+#include "CrFwConstants.h"
+#include "Pckt/CrFwPckt.h"
+#include "OutStream/CrFwOutStream.h"
+#include "OutManager/CrFwOutManager.h"
+#include "OutRegistry/CrFwOutRegistry.h"
+
+/** A low-priority OutComponent kind */
+typedef struct {
+	/** The service type of the kind */
+	CrFwServType_t servType;
+	/** The service sub-type of the kind */
+	CrFwServSubType_t servSubType;
+	/** The state from which the kind is suppressed */
+	int state;
+	/** The number of OutComponents of the kind which were suppressed */
+	unsigned long nOfSuppressed;
+} CrDaLoadKind_t;
+
+/** The statically allocated Load State Machine (3 states, 5 transitions, 4 actions, 4 guards) */
+FW_SM_INST_NOCPS(loadSm, CR_DA_LOAD_N_OF_STATES, 5, 4, 4);
+
+/** The singleton instance of the Load State Machine */
+static FwSmDesc_t loadSmDesc = NULL;
+
+/** The current state of the Load State Machine */
+static int curState = CR_DA_LOAD_NOMINAL;
+
+/** The load sampled in the last execution of the Load State Machine */
+static unsigned int load = 0;
+
+/** The peak load */
+static unsigned int peakLoad = 0;
+
+/** The registered OutStreams */
+static FwSmDesc_t outStreams[CR_DA_LOAD_MAX_N_OF_QUEUES];
+
+/** The sizes of the packet queues of the registered OutStreams */
+static unsigned int outStreamSize[CR_DA_LOAD_MAX_N_OF_QUEUES];
+
+/** The number of registered OutStreams */
+static unsigned int nOfOutStreams = 0;
+
+/** The registered OutManagers */
+static FwSmDesc_t outManagers[CR_DA_LOAD_MAX_N_OF_QUEUES];
+
+/** The sizes of the pending lists of the registered OutManagers */
+static unsigned int outManagerSize[CR_DA_LOAD_MAX_N_OF_QUEUES];
+
+/** The number of registered OutManagers */
+static unsigned int nOfOutManagers = 0;
+
+/** The registered low-priority kinds */
+static CrDaLoadKind_t kinds[CR_DA_LOAD_MAX_N_OF_KINDS];
+
+/** The number of registered low-priority kinds */
+static unsigned int nOfKinds = 0;
+
+/** The number of cycles spent in each state */
+static unsigned long nOfCycles[CR_DA_LOAD_N_OF_STATES];
+
+/** The number of state transitions */
+static unsigned long nOfTransitions = 0;
+
+/** The number of temperature violations merged into coalesced reports */
+static unsigned long nOfCoalesced = 0;
+
+/** The names of the states */
+static const char* stateName[CR_DA_LOAD_N_OF_STATES] = {"NOMINAL", "DEGRADED", "SHEDDING"};
+
+/**
+ * Entry action of state NOMINAL.
+ * @param smDesc the descriptor of the Load State Machine
+ */
+static void enterNominal(FwSmDesc_t smDesc);
+
+/**
+ * Entry action of state DEGRADED.
+ * @param smDesc the descriptor of the Load State Machine
+ */
+static void enterDegraded(FwSmDesc_t smDesc);
+
+/**
+ * Entry action of state SHEDDING.
+ * @param smDesc the descriptor of the Load State Machine
+ */
+static void enterShedding(FwSmDesc_t smDesc);
+
+/**
+ * Do-action of all states: sample the load of the application.
+ * @param smDesc the descriptor of the Load State Machine
+ */
+static void sampleLoad(FwSmDesc_t smDesc);
+
+/**
+ * Guard of the transition from NOMINAL to DEGRADED.
+ * @param smDesc the descriptor of the Load State Machine
+ * @return 1 if the load has reached <code>#CR_DA_LOAD_DEGRADED_ENTRY</code>
+ */
+static FwSmBool_t isDegradedEntry(FwSmDesc_t smDesc);
+
+/**
+ * Guard of the transition from DEGRADED to NOMINAL.
+ * @param smDesc the descriptor of the Load State Machine
+ * @return 1 if the load is below <code>#CR_DA_LOAD_DEGRADED_EXIT</code>
+ */
+static FwSmBool_t isDegradedExit(FwSmDesc_t smDesc);
+
+/**
+ * Guard of the transition from DEGRADED to SHEDDING.
+ * @param smDesc the descriptor of the Load State Machine
+ * @return 1 if the load has reached <code>#CR_DA_LOAD_SHEDDING_ENTRY</code>
+ */
+static FwSmBool_t isSheddingEntry(FwSmDesc_t smDesc);
+
+/**
+ * Guard of the transition from SHEDDING to DEGRADED.
+ * @param smDesc the descriptor of the Load State Machine
+ * @return 1 if the load is below <code>#CR_DA_LOAD_SHEDDING_EXIT</code>
+ */
+static FwSmBool_t isSheddingExit(FwSmDesc_t smDesc);
+
+/**
+ * Enter a state: enable or disable the low-priority kinds in the OutRegistry according
+ * to the new state.
+ * @param state the new state
+ */
+static void applyPolicy(int state);
+
+/* ---------------------------------------------------------------------------------------------*/
+FwSmDesc_t CrDaLoadSmMake() {
+	if (loadSmDesc != NULL)
+		return loadSmDesc;
+
+	/* Initialize the statically allocated state machine */
+	FwSmInit(&loadSm);
+	loadSmDesc = &loadSm;
+
+	/* Configure the state machine */
+	FwSmAddState(loadSmDesc, CR_DA_LOAD_NOMINAL, 1, &enterNominal, NULL, &sampleLoad, NULL);
+	FwSmAddState(loadSmDesc, CR_DA_LOAD_DEGRADED, 2, &enterDegraded, NULL, &sampleLoad, NULL);
+	FwSmAddState(loadSmDesc, CR_DA_LOAD_SHEDDING, 1, &enterShedding, NULL, &sampleLoad, NULL);
+	FwSmAddTransIpsToSta(loadSmDesc, CR_DA_LOAD_NOMINAL, NULL);
+	FwSmAddTransStaToSta(loadSmDesc, FW_TR_EXECUTE, CR_DA_LOAD_NOMINAL, CR_DA_LOAD_DEGRADED,
+	                     NULL, &isDegradedEntry);
+	FwSmAddTransStaToSta(loadSmDesc, FW_TR_EXECUTE, CR_DA_LOAD_DEGRADED, CR_DA_LOAD_SHEDDING,
+	                     NULL, &isSheddingEntry);
+	FwSmAddTransStaToSta(loadSmDesc, FW_TR_EXECUTE, CR_DA_LOAD_DEGRADED, CR_DA_LOAD_NOMINAL,
+	                     NULL, &isDegradedExit);
+	FwSmAddTransStaToSta(loadSmDesc, FW_TR_EXECUTE, CR_DA_LOAD_SHEDDING, CR_DA_LOAD_DEGRADED,
+	                     NULL, &isSheddingExit);
+
+	return loadSmDesc;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaLoadSmAddQueue(FwSmDesc_t cmp, unsigned int size) {
+	CrFwCmpData_t* cmpData = (CrFwCmpData_t*)FwSmGetData(cmp);
+
+	if (size == 0)
+		return;
+	if (cmpData->typeId == CR_FW_OUTSTREAM_TYPE) {
+		if (nOfOutStreams < CR_DA_LOAD_MAX_N_OF_QUEUES) {
+			outStreams[nOfOutStreams] = cmp;
+			outStreamSize[nOfOutStreams++] = size;
+		}
+	} else {
+		if (nOfOutManagers < CR_DA_LOAD_MAX_N_OF_QUEUES) {
+			outManagers[nOfOutManagers] = cmp;
+			outManagerSize[nOfOutManagers++] = size;
+		}
+	}
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaLoadSmAddKind(CrFwServType_t servType, CrFwServSubType_t servSubType, int state) {
+	if (nOfKinds >= CR_DA_LOAD_MAX_N_OF_KINDS)
+		return;
+	kinds[nOfKinds].servType = servType;
+	kinds[nOfKinds].servSubType = servSubType;
+	kinds[nOfKinds].state = state;
+	kinds[nOfKinds].nOfSuppressed = 0;
+	nOfKinds++;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+int CrDaLoadSmGetState() {
+	return curState;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+unsigned int CrDaLoadSmGetLoad() {
+	return load;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+CrFwBool_t CrDaLoadSmAdmit(CrFwServType_t servType, CrFwServSubType_t servSubType) {
+	unsigned int i;
+
+	for (i=0; i<nOfKinds; i++) {
+		if ((kinds[i].servType == servType) && (kinds[i].servSubType == servSubType)) {
+			if (curState < kinds[i].state)
+				return 1;
+			kinds[i].nOfSuppressed++;
+			return 0;
+		}
+	}
+	return 1;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+unsigned int CrDaLoadSmGetCoalesceInterval() {
+	if (curState == CR_DA_LOAD_SHEDDING)
+		return CR_DA_LOAD_COALESCE_SHEDDING;
+	if (curState == CR_DA_LOAD_DEGRADED)
+		return CR_DA_LOAD_COALESCE_DEGRADED;
+	return 1;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaLoadSmCountCoalesced() {
+	nOfCoalesced++;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaLoadSmPrintSummary(const char* tag) {
+	unsigned int i;
+
+	printf("%s: Load state machine: %lu cycles in NOMINAL, %lu in DEGRADED, %lu in SHEDDING (%lu transitions)\n",
+	       tag, nOfCycles[0], nOfCycles[1], nOfCycles[2], nOfTransitions);
+	printf("%s: Load state machine: peak load %u%%, %lu temperature violations coalesced\n",
+	       tag, peakLoad, nOfCoalesced);
+	for (i=0; i<nOfKinds; i++)
+		printf("%s: Load state machine: %lu OutComponents of kind (%u,%u) suppressed from %s\n",
+		       tag, kinds[i].nOfSuppressed, (unsigned int)kinds[i].servType,
+		       (unsigned int)kinds[i].servSubType, stateName[kinds[i].state-1]);
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static void enterNominal(FwSmDesc_t smDesc) {
+	(void)smDesc;
+	applyPolicy(CR_DA_LOAD_NOMINAL);
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static void enterDegraded(FwSmDesc_t smDesc) {
+	(void)smDesc;
+	applyPolicy(CR_DA_LOAD_DEGRADED);
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static void enterShedding(FwSmDesc_t smDesc) {
+	(void)smDesc;
+	applyPolicy(CR_DA_LOAD_SHEDDING);
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static void sampleLoad(FwSmDesc_t smDesc) {
+	unsigned int i, occupancy;
+	(void)smDesc;
+
+	load = (unsigned int)CrFwPcktGetNOfAllocated()*100/CR_FW_MAX_NOF_PCKTS;
+	for (i=0; i<nOfOutStreams; i++) {
+		occupancy = (unsigned int)CrFwOutStreamGetNOfPendingPckts(outStreams[i])*100/outStreamSize[i];
+		if (occupancy > load)
+			load = occupancy;
+	}
+	for (i=0; i<nOfOutManagers; i++) {
+		occupancy = (unsigned int)CrFwOutManagerGetNOfPendingOutCmp(outManagers[i])*100/outManagerSize[i];
+		if (occupancy > load)
+			load = occupancy;
+	}
+	if (load > peakLoad)
+		peakLoad = load;
+	nOfCycles[curState-1]++;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static FwSmBool_t isDegradedEntry(FwSmDesc_t smDesc) {
+	(void)smDesc;
+	return (load >= CR_DA_LOAD_DEGRADED_ENTRY);
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static FwSmBool_t isDegradedExit(FwSmDesc_t smDesc) {
+	(void)smDesc;
+	return (load < CR_DA_LOAD_DEGRADED_EXIT);
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static FwSmBool_t isSheddingEntry(FwSmDesc_t smDesc) {
+	(void)smDesc;
+	return (load >= CR_DA_LOAD_SHEDDING_ENTRY);
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static FwSmBool_t isSheddingExit(FwSmDesc_t smDesc) {
+	(void)smDesc;
+	return (load < CR_DA_LOAD_SHEDDING_EXIT);
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static void applyPolicy(int state) {
+	unsigned int i;
+
+	if (state != curState)
+		nOfTransitions++;
+	curState = state;
+	for (i=0; i<nOfKinds; i++)
+		CrFwOutRegistrySetEnable(kinds[i].servType, kinds[i].servSubType, 0, (state < kinds[i].state));
+	CrDaTraceInstant(stateName[state-1], (int)load);
+}
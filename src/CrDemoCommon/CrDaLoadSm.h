@@ -0,0 +1,184 @@
+/**
+ * @file
+ * @ingroup crDemoCommon
+ * Load State Machine of the demo applications.
+ * The Load State Machine is embedded in state NORMAL of the Application State Machine
+ * (see <code>CrFwAppSmUserPar.h</code>) and sheds the low-priority traffic of the
+ * application when its packet resources fill up so that the critical traffic keeps
+ * flowing instead of failing to allocate its packets.
+ *
+ * The Load State Machine has three states:
+ * - NOMINAL: all OutComponent kinds are generated and every temperature violation is
+ *   reported;
+ * - DEGRADED: the temperature violation reports and the aggregated temperature violation
+ *   reports are coalesced over <code>#CR_DA_LOAD_COALESCE_DEGRADED</code> cycles;
+ * - SHEDDING: in addition, the commands which set the temperature limit are suppressed
+ *   and the temperature violation reports and the aggregated temperature violation
+ *   reports are coalesced over <code>#CR_DA_LOAD_COALESCE_SHEDDING</code> cycles.
+ * .
+ * The commands which enable or disable temperature monitoring are never suppressed.
+ *
+ * The load of the application is the highest occupancy (in percent) of the packet
+ * pool (see <code>CrFwPckt.c</code>), of the packet queues of the registered OutStreams
+ * and of the pending lists of the registered OutManagers.
+ * It is sampled by the do-action of the states in every execution of the state machine
+ * and drives its transitions with a hysteresis:
+ * - NOMINAL to DEGRADED when the load reaches <code>#CR_DA_LOAD_DEGRADED_ENTRY</code>;
+ * - DEGRADED to SHEDDING when the load reaches <code>#CR_DA_LOAD_SHEDDING_ENTRY</code>;
+ * - SHEDDING to DEGRADED when the load falls below <code>#CR_DA_LOAD_SHEDDING_EXIT</code>;
+ * - DEGRADED to NOMINAL when the load falls below <code>#CR_DA_LOAD_DEGRADED_EXIT</code>.
+ * .
+ *
+ * The low-priority kinds which an application generates are registered with
+ * <code>::CrDaLoadSmAddKind</code> together with the state from which they are suppressed
+ * (they must be kinds of the OutRegistry of the application).
+ * The suppression is applied at two points:
+ * - the generators of the OutComponents ask <code>::CrDaLoadSmAdmit</code> before
+ *   making an OutComponent so that no packet is allocated for a suppressed kind;
+ * - the entry actions of the states disable the suppressed kinds in the OutRegistry
+ *   so that the OutComponents of these kinds which are already pending in the
+ *   OutManagers are aborted by their Enable Check and release their packets.
+ * .
+ *
+ * The demo applications start the Application State Machine at the end of their
+ * initialization and execute it at the start of each control cycle (before the traffic
+ * of the cycle is generated).
+ * The Load State Machine is therefore started when the Application State Machine
+ * enters NORMAL and it samples the load which the previous cycles left behind.
+ *
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the CORDET Framework.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#ifndef CRDA_LOADSM_H_
+#define CRDA_LOADSM_H_
+
+/* Include FW Profile files */
+#include "FwSmConstants.h"
+/* Include framework files */
+#include "CrFwConstants.h"
+/* Include configuration files */
+#include "CrFwUserConstants.h"
+
+/** State identifier for state NOMINAL of the Load State Machine */
+#define CR_DA_LOAD_NOMINAL 1
+
+/** State identifier for state DEGRADED of the Load State Machine */
+#define CR_DA_LOAD_DEGRADED 2
+
+/** State identifier for state SHEDDING of the Load State Machine */
+#define CR_DA_LOAD_SHEDDING 3
+
+/** The number of states of the Load State Machine */
+#define CR_DA_LOAD_N_OF_STATES 3
+
+/** The load (in percent) at which the Load State Machine enters DEGRADED from NOMINAL */
+#define CR_DA_LOAD_DEGRADED_ENTRY 60
+
+/** The load (in percent) below which the Load State Machine returns to NOMINAL from DEGRADED */
+#define CR_DA_LOAD_DEGRADED_EXIT 40
+
+/** The load (in percent) at which the Load State Machine enters SHEDDING from DEGRADED */
+#define CR_DA_LOAD_SHEDDING_ENTRY 85
+
+/** The load (in percent) below which the Load State Machine returns to DEGRADED from SHEDDING */
+#define CR_DA_LOAD_SHEDDING_EXIT 70
+
+/** The number of cycles over which the temperature violation reports are coalesced in DEGRADED */
+#define CR_DA_LOAD_COALESCE_DEGRADED 4
+
+/** The number of cycles over which the temperature violation reports are coalesced in SHEDDING */
+#define CR_DA_LOAD_COALESCE_SHEDDING 16
+
+/** The maximum number of OutStreams and of OutManagers whose occupancy is sampled */
+#define CR_DA_LOAD_MAX_N_OF_QUEUES 4
+
+/** The maximum number of low-priority OutComponent kinds */
+#define CR_DA_LOAD_MAX_N_OF_KINDS 4
+
+/**
+ * Factory function for the Load State Machine.
+ * The first time this function is called, it creates and configures the state machine.
+ * Subsequent calls return the same instance.
+ * This function is called by the Application State Machine through the adaptation point
+ * <code>#CR_FW_APPSM_NORMAL_ESM</code>.
+ * @return the descriptor of the Load State Machine
+ */
+FwSmDesc_t CrDaLoadSmMake();
+
+/**
+ * Register an OutStream or an OutManager whose occupancy contributes to the load.
+ * At most <code>#CR_DA_LOAD_MAX_N_OF_QUEUES</code> OutStreams and as many OutManagers
+ * are registered.
+ * @param cmp the OutStream or OutManager
+ * @param size the size of the packet queue of the OutStream or of the pending list
+ * of the OutManager
+ */
+void CrDaLoadSmAddQueue(FwSmDesc_t cmp, unsigned int size);
+
+/**
+ * Register a low-priority OutComponent kind which is suppressed in a given state of the
+ * Load State Machine and in the states of higher load.
+ * At most <code>#CR_DA_LOAD_MAX_N_OF_KINDS</code> kinds are registered.
+ * @param servType the service type of the kind
+ * @param servSubType the service sub-type of the kind
+ * @param state the state from which the kind is suppressed (<code>#CR_DA_LOAD_DEGRADED</code>
+ * or <code>#CR_DA_LOAD_SHEDDING</code>)
+ */
+void CrDaLoadSmAddKind(CrFwServType_t servType, CrFwServSubType_t servSubType, int state);
+
+/**
+ * Return the current state of the Load State Machine.
+ * Before the Load State Machine is started, this function returns
+ * <code>#CR_DA_LOAD_NOMINAL</code>.
+ * @return the current state of the Load State Machine
+ */
+int CrDaLoadSmGetState();
+
+/**
+ * Return the load of the application which was sampled in the last execution of the
+ * Load State Machine.
+ * @return the load in percent
+ */
+unsigned int CrDaLoadSmGetLoad();
+
+/**
+ * Check whether an OutComponent of a given kind may be made in the current state of the
+ * Load State Machine.
+ * If the kind is suppressed, the suppression is counted.
+ * @param servType the service type of the OutComponent
+ * @param servSubType the service sub-type of the OutComponent
+ * @return 1 if the OutComponent may be made, 0 if its kind is suppressed
+ */
+CrFwBool_t CrDaLoadSmAdmit(CrFwServType_t servType, CrFwServSubType_t servSubType);
+
+/**
+ * Return the number of cycles over which the temperature violation reports are coalesced
+ * in the current state of the Load State Machine.
+ * @return the number of cycles (1 in NOMINAL)
+ */
+unsigned int CrDaLoadSmGetCoalesceInterval();
+
+/**
+ * Count a temperature violation, or a cycle of channel violations, which was merged into
+ * a coalesced report.
+ */
+void CrDaLoadSmCountCoalesced();
+
+/**
+ * Print the number of cycles spent in each state of the Load State Machine, the number of
+ * transitions, the peak load and the number of suppressed and coalesced OutComponents.
+ * @param tag the tag of the application with which the lines of the summary are prefixed
+ */
+void CrDaLoadSmPrintSummary(const char* tag);
+
+#endif /* CRDA_LOADSM_H_ */
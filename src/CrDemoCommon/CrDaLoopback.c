@@ -0,0 +1,129 @@
+/**
+ * @file
+ * @ingroup crDemoCommon
+ * Implementation of the loopback adapter.
+ *
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the CORDET Framework.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "CrDaLoopback.h"
+#include "CrDaLoopbackBus.h"
+#include "CrDaConstants.h"
+#include "CrDaPcktRecorder.h"
+#include "CrDaStats.h"
+#include "CrDaBackpressure.h"
+/* Include FW Profile files */
+#include "FwSmConfig.h"
+#include "FwPrConfig.h"
+/* Include configuration files */
+#include "CrFwCmpData.h"
+/* Include framework files */
+#include "InStream/CrFwInStream.h"
+#include "OutStream/CrFwOutStream.h"
+#include "BaseCmp/CrFwBaseCmp.h"
+#include "Pckt/CrFwPckt.h"
+
+/** The Read Buffer */
+static unsigned char readBuffer[CR_DA_LOOPBACK_BUS_SLOT_SIZE];
+
+/** The length of the packet in the Read Buffer (zero if the Read Buffer is empty) */
+static unsigned int readLength = 0;
+
+/**
+ * Read the oldest packet in the bus queue of the host application into the
+ * Read Buffer if the Read Buffer is empty.
+ */
+static void fillReadBuffer();
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaLoopbackConfigAction(FwPrDesc_t prDesc) {
+	CrFwCmpData_t* streamData = (CrFwCmpData_t*)FwPrGetData(prDesc);
+
+	/* Clear Read Buffer */
+	readLength = 0;
+
+	if (streamData->typeId == CR_FW_INSTREAM_TYPE)
+		CrFwInStreamDefConfigAction(prDesc);
+	else
+		CrFwOutStreamDefConfigAction(prDesc);
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaLoopbackPoll() {
+	FwSmDesc_t inStream;
+
+	fillReadBuffer();
+	if (readLength == 0)
+		return;
+
+	inStream = CrFwInStreamGet(CrFwPcktGetSrc((CrFwPckt_t)readBuffer));
+	CrFwInStreamPcktAvail(inStream);
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+CrFwPckt_t CrDaLoopbackPcktCollect(CrFwDestSrc_t src) {
+	CrFwPckt_t pckt;
+
+	if (readLength == 0)
+		return NULL;
+	if (CrFwPcktGetSrc((CrFwPckt_t)readBuffer) != src)
+		return NULL;
+	if (CrDaBackpressureIsFull(src))
+		return NULL;
+
+	pckt = CrFwPcktMake((CrFwPcktLength_t)readLength);
+	if (pckt == NULL)
+		return NULL;
+	memcpy(pckt, readBuffer, readLength);
+	readLength = 0;
+	CrDaPcktRecorderRecord(crDaPcktRecIn, src, pckt);
+	CrDaStatsPcktIn(src, CrFwPcktGetLength(pckt));
+	return pckt;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+CrFwBool_t CrDaLoopbackIsPcktAvail(CrFwDestSrc_t src) {
+	/* Leave the packets in the bus while the InStream of the source cannot take them */
+	if (CrDaBackpressureIsFull(src))
+		return 0;
+	fillReadBuffer();
+	if (readLength == 0)
+		return 0;
+	return (CrFwPcktGetSrc((CrFwPckt_t)readBuffer) == src);
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+CrFwBool_t CrDaLoopbackPcktHandover(CrFwPckt_t pckt) {
+	CrFwDestSrc_t dest = CrFwPcktGetDest(pckt);
+	CrFwDestSrc_t link;
+
+	if (CR_FW_HOST_APP_ID == CR_DA_SLAVE_1)
+		link = (dest == CR_DA_MASTER) ? CR_DA_MASTER : CR_DA_SLAVE_2;
+	else
+		link = CR_DA_SLAVE_1;
+
+	if (!CrDaLoopbackBusWrite(link, (unsigned char*)pckt, CrFwPcktGetLength(pckt)))
+		return 0;
+
+	CrDaPcktRecorderRecord(crDaPcktRecOut, dest, pckt);
+	CrDaStatsPcktOut(dest, CrFwPcktGetLength(pckt));
+	return 1;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static void fillReadBuffer() {
+	if (readLength == 0)
+		readLength = CrDaLoopbackBusRead(CR_FW_HOST_APP_ID, readBuffer, sizeof(readBuffer));
+}
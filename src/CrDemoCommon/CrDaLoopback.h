@@ -0,0 +1,112 @@
+/**
+ * @file
+ * @ingroup crDemoCommon
+ * Interface for the loopback adapter used in the loopback configuration of the CORDET Demo.
+ * In the loopback configuration, the three demo applications are linked into
+ * one single executable and exchange their packets through the in-memory bus
+ * of <code>CrDaLoopbackBus.h</code> (see <code>CrDaLoopbackMain.c</code>).
+ * The InStreams and OutStreams of the demo applications are configured to use
+ * this module in place of the sockets when the demo applications are compiled
+ * with <code>CR_DA_LOOPBACK</code> defined (see the InStream and OutStream
+ * configuration files of the demo applications).
+ * More precisely:
+ * - Function <code>::CrDaLoopbackConfigAction</code> should be used as the configuration
+ *   action for the InStreams and OutStreams.
+ * - Function <code>::CrDaLoopbackPcktCollect</code> should be used as the Packet Collect
+ *   operation for the InStreams.
+ * - Function <code>::CrDaLoopbackIsPcktAvail</code> should be used as the Packet Available
+ *   Check operation for the InStreams.
+ * - Function <code>::CrDaLoopbackPcktHandover</code> should be used as the Packet Hand-Over
+ *   operation for the OutStreams.
+ * .
+ * The remaining adaptation points of the InStreams and OutStreams are the framework defaults.
+ *
+ * The adapter reproduces the physical links of the socket-based demo: the Slave 1
+ * Application writes the packets for the Master Application to the bus queue of
+ * the Master Application and all other packets to the bus queue of the Slave 2
+ * Application, while the Master and Slave 2 Applications write all their packets
+ * to the bus queue of the Slave 1 Application.
+ * Packets from the Master Application to the Slave 2 Application (and vice versa)
+ * are therefore routed through the Slave 1 Application as in the socket-based demo.
+ *
+ * Like the sockets, the adapter assumes a polling approach for incoming packets:
+ * function <code>::CrDaLoopbackPoll</code> should be called once in every cycle.
+ * This function reads the oldest packet from the bus queue of the host application
+ * into a Read Buffer and signals its arrival to the InStream of its source.
+ * This causes all pending packets from that source to be collected by the InStream.
+ * Packets which are collected or handed over are recorded by the packet recorder
+ * (see <code>CrDaPcktRecorder.h</code>).
+ *
+ * Unlike the other demo application common files, this module depends on the
+ * identifier of the host application and it is therefore compiled with the
+ * configuration files of each application.
+ *
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the CORDET Framework.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#ifndef CRDA_LOOPBACK_H_
+#define CRDA_LOOPBACK_H_
+
+/* Include Framework Files */
+#include "CrFwConstants.h"
+/* Include Configuration Files */
+#include "CrFwUserConstants.h"
+/* Include FW Profile files */
+#include "FwSmConstants.h"
+#include "FwPrConstants.h"
+
+/**
+ * Configuration action for the InStreams and OutStreams.
+ * This function clears the Read Buffer and then executes the default
+ * configuration action of the InStream or OutStream.
+ * @param prDesc the configuration procedure descriptor
+ */
+void CrDaLoopbackConfigAction(FwPrDesc_t prDesc);
+
+/**
+ * Poll the bus queue of the host application.
+ * If the Read Buffer is empty, the oldest packet in the bus queue of the host
+ * application is read into it.
+ * If the Read Buffer holds a packet, function <code>::CrFwInStreamPcktAvail</code>
+ * is called on the InStream of its source.
+ */
+void CrDaLoopbackPoll();
+
+/**
+ * Collect the packet in the Read Buffer if it comes from the argument source.
+ * The packet is left in the Read Buffer if the packet queue of the InStream of the
+ * source is full (see <code>CrDaBackpressure.h</code>).
+ * @param src the source
+ * @return the packet or NULL if no packet from the argument source is available
+ */
+CrFwPckt_t CrDaLoopbackPcktCollect(CrFwDestSrc_t src);
+
+/**
+ * Check whether a packet from the argument source is available.
+ * If the Read Buffer is empty, the oldest packet in the bus queue of the host
+ * application is first read into it.
+ * If the packet queue of the InStream of the source is full (see <code>CrDaBackpressure.h</code>),
+ * this function returns 0 without reading from the bus queue.
+ * @param src the source
+ * @return 1 if the Read Buffer holds a packet from the argument source, 0 otherwise
+ */
+CrFwBool_t CrDaLoopbackIsPcktAvail(CrFwDestSrc_t src);
+
+/**
+ * Write a packet to the bus queue of the next application on its route.
+ * @param pckt the packet
+ * @return 1 if the packet was written, 0 if the bus queue is full
+ */
+CrFwBool_t CrDaLoopbackPcktHandover(CrFwPckt_t pckt);
+
+#endif /* CRDA_LOOPBACK_H_ */
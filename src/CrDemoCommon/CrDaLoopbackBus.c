@@ -0,0 +1,103 @@
+/**
+ * @file
+ * @ingroup crDemoCommon
+ * Implementation of the in-memory packet bus of the loopback harness.
+ *
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the CORDET Framework.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#include <string.h>
+/* Include demo application files */
+#include "CrDaLoopbackBus.h"
+
+/** The queue of packets of one application. */
+typedef struct {
+	/** The packets in the queue */
+	unsigned char slot[CR_DA_LOOPBACK_BUS_N_OF_SLOTS][CR_DA_LOOPBACK_BUS_SLOT_SIZE];
+	/** The lengths of the packets in the queue */
+	unsigned int len[CR_DA_LOOPBACK_BUS_N_OF_SLOTS];
+	/** The position of the oldest packet in the queue */
+	unsigned int head;
+	/** The number of packets in the queue */
+	unsigned int nOfPckts;
+} CrDaLoopbackQueue_t;
+
+/** The queues of the applications */
+static CrDaLoopbackQueue_t queue[CR_DA_LOOPBACK_BUS_N_OF_APPS];
+
+/** The number of packets which have been written to the bus */
+static unsigned long nOfWritten = 0;
+
+/** The number of packets which have been rejected by the bus */
+static unsigned long nOfRejected = 0;
+
+/* ---------------------------------------------------------------------------------------------*/
+int CrDaLoopbackBusWrite(unsigned int appId, const unsigned char* pckt, unsigned int len) {
+	CrDaLoopbackQueue_t* q;
+	unsigned int pos;
+
+	if ((appId >= CR_DA_LOOPBACK_BUS_N_OF_APPS) || (len == 0) || (len > CR_DA_LOOPBACK_BUS_SLOT_SIZE)) {
+		nOfRejected++;
+		return 0;
+	}
+	q = &queue[appId];
+	if (q->nOfPckts == CR_DA_LOOPBACK_BUS_N_OF_SLOTS) {
+		nOfRejected++;
+		return 0;
+	}
+
+	pos = (q->head + q->nOfPckts) % CR_DA_LOOPBACK_BUS_N_OF_SLOTS;
+	memcpy(q->slot[pos], pckt, len);
+	q->len[pos] = len;
+	q->nOfPckts++;
+	nOfWritten++;
+	return 1;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+unsigned int CrDaLoopbackBusRead(unsigned int appId, unsigned char* buffer, unsigned int maxLen) {
+	CrDaLoopbackQueue_t* q;
+	unsigned int len;
+
+	if (appId >= CR_DA_LOOPBACK_BUS_N_OF_APPS)
+		return 0;
+	q = &queue[appId];
+	if (q->nOfPckts == 0)
+		return 0;
+
+	len = q->len[q->head];
+	if (len > maxLen)
+		len = 0;	/* the packet does not fit the buffer: it is dropped */
+	else
+		memcpy(buffer, q->slot[q->head], len);
+	q->head = (q->head + 1) % CR_DA_LOOPBACK_BUS_N_OF_SLOTS;
+	q->nOfPckts--;
+	return len;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+unsigned int CrDaLoopbackBusGetNOfPckts(unsigned int appId) {
+	if (appId >= CR_DA_LOOPBACK_BUS_N_OF_APPS)
+		return 0;
+	return queue[appId].nOfPckts;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+unsigned long CrDaLoopbackBusGetNOfWritten() {
+	return nOfWritten;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+unsigned long CrDaLoopbackBusGetNOfRejected() {
+	return nOfRejected;
+}
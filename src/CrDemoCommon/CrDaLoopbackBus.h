@@ -0,0 +1,87 @@
+/**
+ * @file
+ * @ingroup crDemoCommon
+ * In-memory packet bus of the loopback harness.
+ * In the loopback configuration of the CORDET Demo, the Master, Slave 1 and
+ * Slave 2 Applications are linked into one single executable (see
+ * <code>CrDaLoopbackMain.c</code>) and exchange their packets through this bus
+ * instead of through sockets.
+ *
+ * The bus holds one FIFO queue of packets for each application.
+ * A packet is written to the queue of its destination application by the
+ * loopback adapter of the sending application (see <code>CrDaLoopback.h</code>)
+ * and it is read from the queue by the loopback adapter of the destination application.
+ * Each queue holds up to <code>#CR_DA_LOOPBACK_BUS_N_OF_SLOTS</code> packets of up
+ * to <code>#CR_DA_LOOPBACK_BUS_SLOT_SIZE</code> bytes and the packets are copied
+ * into and out of the queue.
+ *
+ * The bus is the only module which is shared by the three applications.
+ * Each application is linked with its own copy of the framework, of the framework
+ * configuration and of the demo application files and all the symbols of these
+ * copies are local to the application.
+ * For this reason, the interface of the bus only uses plain C types.
+ *
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the CORDET Framework.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#ifndef CRDA_LOOPBACKBUS_H_
+#define CRDA_LOOPBACKBUS_H_
+
+/** The number of queues of the bus (the application identifiers must be smaller than this value) */
+#define CR_DA_LOOPBACK_BUS_N_OF_APPS 4
+
+/** The number of packets which can be held in the queue of an application */
+#define CR_DA_LOOPBACK_BUS_N_OF_SLOTS 64
+
+/** The maximum length in bytes of a packet on the bus */
+#define CR_DA_LOOPBACK_BUS_SLOT_SIZE 256
+
+/**
+ * Write a packet to the queue of an application.
+ * @param appId the identifier of the destination application
+ * @param pckt the packet
+ * @param len the length of the packet in bytes
+ * @return 1 if the packet was written, 0 if the queue is full or the arguments are invalid
+ */
+int CrDaLoopbackBusWrite(unsigned int appId, const unsigned char* pckt, unsigned int len);
+
+/**
+ * Read the oldest packet from the queue of an application.
+ * @param appId the identifier of the application
+ * @param buffer the buffer where the packet is copied
+ * @param maxLen the size of the buffer in bytes
+ * @return the length of the packet or zero if the queue is empty
+ */
+unsigned int CrDaLoopbackBusRead(unsigned int appId, unsigned char* buffer, unsigned int maxLen);
+
+/**
+ * Return the number of packets in the queue of an application.
+ * @param appId the identifier of the application
+ * @return the number of packets in the queue
+ */
+unsigned int CrDaLoopbackBusGetNOfPckts(unsigned int appId);
+
+/**
+ * Return the total number of packets which have been written to the bus.
+ * @return the number of written packets
+ */
+unsigned long CrDaLoopbackBusGetNOfWritten();
+
+/**
+ * Return the total number of packets which could not be written to the bus
+ * because the queue of their destination was full.
+ * @return the number of rejected packets
+ */
+unsigned long CrDaLoopbackBusGetNOfRejected();
+
+#endif /* CRDA_LOOPBACKBUS_H_ */
@@ -0,0 +1,191 @@
+/**
+ * @file
+ * @ingroup crDemoCommon
+ *
+ * Loopback harness for the demo applications.
+ *
+ * This file provides the main program of the <code>cr_loopback</code> executable
+ * which runs the Master, Slave 1 and Slave 2 Applications in one single process.
+ * The harness is called as follows:
+ * <pre>
+ *   cr_loopback [-n cycles] [-p period] [-c commands] [-v probability] [-m channels]
+ *               [-k violating] [-l payload] [-s seed] [-r headroom] [-q] [-f file]
+ * </pre>
+ * where the options define the run profile of the three applications (see
+ * <code>CrDaProfile.h</code>): the harness passes its command line to each application.
+ *
+ * The three applications are built with <code>CR_DA_LOOPBACK</code> defined
+ * (see the <code>loopback</code> option of the application build scripts).
+ * In that configuration:
+ * - The InStreams and OutStreams of the applications exchange their packets
+ *   through the in-memory bus of <code>CrDaLoopbackBus.h</code> (see
+ *   <code>CrDaLoopback.h</code>): no socket is opened and the applications
+ *   do not wait for each other to start.
+ * - Each application is linked with its own copy of the framework, of its
+ *   configuration files and of the demo application common files into one
+ *   relocatable object in which all symbols except its initialization, control
+ *   cycle and termination functions (see <code>CrMaMain.h</code>,
+ *   <code>CrS1Main.h</code> and <code>CrS2Main.h</code>) are made local.
+ *   The global state of the framework (its components, its packet pool and its
+ *   error counters) is therefore private to each application.
+ * .
+ * The harness initializes the three applications and then, in every cycle,
+ * executes one control cycle of the Slave 1, Master and Slave 2 Applications
+ * in this order and without waiting between cycles.
+ * The applications use the simulation clock (see <code>CrDaClock.h</code>): their
+ * time is the virtual time of the current cycle and their runs are reproducible.
+ * At the end, each application prints the summary of its run statistics (see
+ * <code>CrDaStats.h</code>) and the harness reports the time taken by the control
+ * cycles and the number of packets which were exchanged.
+ *
+ * When the harness is built with <code>CR_DA_HEAP_GUARD</code> defined (executable
+ * <code>cr_loopback_heapguard</code>, see the <code>soak</code> target of the Makefile),
+ * the heap guard of <code>CrDaHeapGuard.h</code> is armed for the duration of the control
+ * cycles and the harness fails if any control cycle of the three applications allocated
+ * memory.
+ *
+ * With the <code>-q</code> option, the standard output of the applications (their
+ * trace of the control cycles and their run statistics) is discarded and the harness
+ * only prints its own summary and, if it is built in, the summary of the heap guard.
+ * Error messages on the standard error (e.g. the reports of the heap guard) are kept.
+ * This is used by long runs such as the <code>soak</code> target of the Makefile.
+ *
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the CORDET Framework.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <fcntl.h>
+#include <unistd.h>
+/* Include demo application files */
+#include "CrDaLoopbackBus.h"
+#include "CrDaClock.h"
+#include "CrDaProfile.h"
+#include "CrDaHeapGuard.h"
+#include "CrMaMain.h"
+#include "CrS1Main.h"
+#include "CrS2Main.h"
+
+/**
+ * Redirect the standard output to <code>/dev/null</code>.
+ * @return a duplicate of the original standard output or -1 if the standard output
+ * could not be redirected
+ */
+static int muteStdout();
+
+/**
+ * Restore the standard output after <code>::muteStdout</code>.
+ * @param savedFd the duplicate of the original standard output returned by
+ * <code>::muteStdout</code> (nothing is done if it is -1)
+ */
+static void restoreStdout(int savedFd);
+
+/**
+ * Main program of the loopback harness.
+ * @param argc the number of command line arguments
+ * @param argv the command line arguments
+ * @return EXIT_SUCCESS if the applications were run (without allocations in the control
+ * cycles if the heap guard is built in), EXIT_FAILURE otherwise
+ */
+int main(int argc, char* argv[]) {
+	struct timespec startTime, endTime;
+	int nOfCycles;
+	int i;
+	double elapsed;
+	int savedFd = -1;
+
+	if (!CrDaProfileParse(argc, argv, 0))
+		return EXIT_FAILURE;
+	nOfCycles = (int)CrDaProfileGet()->nOfCycles;
+	if (CrDaProfileGet()->isQuiet)
+		savedFd = muteStdout();
+
+	/* The applications read the clock mode from the environment */
+	setenv(CR_DA_CLOCK_ENV_VAR, "1", 1);
+
+	if (!CrS1AppInit(argc, argv)) {
+		restoreStdout(savedFd);
+		printf("LB: Initialization of the Slave 1 Application failed\n");
+		return EXIT_FAILURE;
+	}
+	if (!CrMaAppInit(argc, argv)) {
+		restoreStdout(savedFd);
+		printf("LB: Initialization of the Master Application failed\n");
+		return EXIT_FAILURE;
+	}
+	if (!CrS2AppInit(argc, argv)) {
+		restoreStdout(savedFd);
+		printf("LB: Initialization of the Slave 2 Application failed\n");
+		return EXIT_FAILURE;
+	}
+
+	/* Execute control cycles */
+	clock_gettime(CLOCK_MONOTONIC, &startTime);
+#ifdef CR_DA_HEAP_GUARD
+	CrDaHeapGuardArm("LB");
+#endif
+	for (i=1; i<=nOfCycles; i++) {
+		CrS1AppExecCycle(i);
+		CrMaAppExecCycle(i);
+		CrS2AppExecCycle(i);
+	}
+#ifdef CR_DA_HEAP_GUARD
+	CrDaHeapGuardDisarm();
+#endif
+	clock_gettime(CLOCK_MONOTONIC, &endTime);
+
+	CrS2AppTerm();
+	CrMaAppTerm();
+	CrS1AppTerm();
+	restoreStdout(savedFd);
+
+	elapsed = (double)(endTime.tv_sec - startTime.tv_sec) + (double)(endTime.tv_nsec - startTime.tv_nsec)/1e9;
+	printf("LB: %d cycles executed in %.3f ms\n", nOfCycles, elapsed*1e3);
+	printf("LB: %lu packets exchanged (%lu rejected by the bus)\n",
+	       CrDaLoopbackBusGetNOfWritten(), CrDaLoopbackBusGetNOfRejected());
+#ifdef CR_DA_HEAP_GUARD
+	CrDaHeapGuardPrintSummary("LB");
+	if (CrDaHeapGuardGetNOfTrapped() > 0)
+		return EXIT_FAILURE;
+#endif
+	return EXIT_SUCCESS;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static int muteStdout() {
+	int savedFd, nullFd;
+
+	fflush(stdout);
+	savedFd = dup(STDOUT_FILENO);
+	nullFd = open("/dev/null", O_WRONLY);
+	if ((savedFd < 0) || (nullFd < 0) || (dup2(nullFd, STDOUT_FILENO) < 0)) {
+		printf("LB: cannot discard the output of the applications\n");
+		if (nullFd >= 0)
+			close(nullFd);
+		if (savedFd >= 0)
+			close(savedFd);
+		return -1;
+	}
+	close(nullFd);
+	return savedFd;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static void restoreStdout(int savedFd) {
+	if (savedFd < 0)
+		return;
+	fflush(stdout);
+	dup2(savedFd, STDOUT_FILENO);
+	close(savedFd);
+}
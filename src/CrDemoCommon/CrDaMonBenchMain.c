@@ -0,0 +1,214 @@
+/**
+ * @file
+ * @ingroup crDemoCommon
+ *
+ * Benchmark of the multi-channel temperature monitoring.
+ *
+ * This file provides the main program of the <code>cr_monbench</code> tool which
+ * measures the cost of the comparison of the temperature channels against their
+ * limits (see <code>CrDaTempChannelMonitor.h</code>).
+ * The tool is called as follows:
+ * <pre>
+ *   cr_monbench [-v percent] [-i channels]
+ * </pre>
+ * The tool monitors arrays of 1000, 10000, 100000 and 1000000 channels in which
+ * <code>percent</code> percent of the channels (1 by default) are in violation.
+ * For each array, it builds the violation bitmask with
+ * <code>::CrDaTempChannelMonitorCheck</code> (whose SIMD implementation is selected at
+ * compile time, see <code>::CrDaTempChannelMonitorGetImpl</code>) and with a reference
+ * loop which compares the channels one by one and it collects the violating channels
+ * from the bitmask with <code>::CrDaTempChannelMonitorNextViolation</code>.
+ * Each measurement is repeated until about <code>channels</code> channels
+ * (100 million by default) have been processed.
+ * The tool prints the time per cycle (i.e. per check of all channels) and per channel
+ * of both comparisons and the speed-up of the monitor over the reference loop.
+ * It fails if the bitmasks of the two comparisons differ.
+ *
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the CORDET Framework.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+/* Include demo application files */
+#include "CrDaTempChannelMonitor.h"
+#include "CrDaClock.h"
+
+/** The number of channel arrays which are measured */
+#define CR_DA_MON_BENCH_N_OF_SIZES 4
+
+/** The default percentage of channels in violation */
+#define CR_DA_MON_BENCH_DEF_VIOLATIONS 1.0
+
+/** The default number of channels which are processed by each measurement */
+#define CR_DA_MON_BENCH_DEF_CHANNELS 100000000UL
+
+/** The temperature of the channels which are not in violation */
+#define CR_DA_MON_BENCH_LOW_TEMP 10
+
+/** The temperature of the channels in violation */
+#define CR_DA_MON_BENCH_HIGH_TEMP 90
+
+/** The lower limit of the channels */
+#define CR_DA_MON_BENCH_LOWER_LIMIT 0
+
+/** The upper limit of the channels */
+#define CR_DA_MON_BENCH_UPPER_LIMIT 50
+
+/**
+ * Build the violation bitmask of the channels by comparing them one by one.
+ * @param channels the channel descriptor
+ * @param mask the bitmask (array of size <code>CR_DA_TEMP_CHANNEL_MASK_SIZE(nOfChannels)</code>)
+ * @return the number of channels in violation
+ */
+static unsigned int checkRef(CrDaTempChannels_t* channels, unsigned int* mask);
+
+/**
+ * Measure the monitoring of an array of channels.
+ * @param nOfChannels the number of channels
+ * @param violations the percentage of channels in violation
+ * @param total the number of channels to be processed by each measurement
+ * @return 1 if the bitmasks of the monitor and of the reference loop are equal, 0 otherwise
+ */
+static int run(unsigned int nOfChannels, double violations, unsigned long total);
+
+/* ---------------------------------------------------------------------------------------------*/
+int main(int argc, char* argv[]) {
+	const unsigned int size[CR_DA_MON_BENCH_N_OF_SIZES] = {1000, 10000, 100000, 1000000};
+	double violations = CR_DA_MON_BENCH_DEF_VIOLATIONS;
+	unsigned long total = CR_DA_MON_BENCH_DEF_CHANNELS;
+	int opt, i, isOk = 1;
+
+	while ((opt = getopt(argc, argv, "v:i:")) != -1) {
+		switch (opt) {
+			case 'v':
+				violations = atof(optarg);
+				break;
+			case 'i':
+				total = strtoul(optarg, NULL, 10);
+				break;
+			default:
+				total = 0;
+				break;
+		}
+	}
+	if ((total == 0) || (violations < 0) || (violations > 100) || (optind != argc)) {
+		printf("Usage: %s [-v percent] [-i channels]\n", argv[0]);
+		return EXIT_FAILURE;
+	}
+
+	printf("Monitor implementation: %s, %.2f%% of the channels in violation\n",
+	       CrDaTempChannelMonitorGetImpl(), violations);
+	printf("%9s %11s %12s %12s %11s %11s %12s %8s\n", "channels", "violations", "ref us/cyc",
+	       "mon us/cyc", "ref ns/ch", "mon ns/ch", "scan us/cyc", "speedup");
+	for (i=0; i<CR_DA_MON_BENCH_N_OF_SIZES; i++)
+		if (!run(size[i], violations, total))
+			isOk = 0;
+	return (isOk ? EXIT_SUCCESS : EXIT_FAILURE);
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static int run(unsigned int nOfChannels, double violations, unsigned long total) {
+	CrDaTempChannels_t channels;
+	signed char* temp = malloc(nOfChannels);
+	signed char* lowerLimit = malloc(nOfChannels);
+	signed char* upperLimit = malloc(nOfChannels);
+	unsigned int* mask = malloc(CR_DA_TEMP_CHANNEL_MASK_SIZE(nOfChannels)*sizeof(unsigned int));
+	unsigned int* refMask = malloc(CR_DA_TEMP_CHANNEL_MASK_SIZE(nOfChannels)*sizeof(unsigned int));
+	unsigned int* pendingMask = malloc(CR_DA_TEMP_CHANNEL_MASK_SIZE(nOfChannels)*sizeof(unsigned int));
+	signed char* pendingTemp = malloc(nOfChannels);
+	unsigned long nOfCycles = total/nOfChannels;
+	unsigned long long start, refTime, monTime, scanTime;
+	unsigned int nOfViolations = 0, nOfScanned, channel, i;
+	unsigned long k;
+	int isOk;
+
+	if ((temp == NULL) || (lowerLimit == NULL) || (upperLimit == NULL) || (mask == NULL) || (refMask == NULL) ||
+	        (pendingMask == NULL) || (pendingTemp == NULL)) {
+		printf("cr_monbench: cannot allocate %u channels\n", nOfChannels);
+		free(temp);
+		free(lowerLimit);
+		free(upperLimit);
+		free(mask);
+		free(refMask);
+		free(pendingMask);
+		free(pendingTemp);
+		return 0;
+	}
+	if (nOfCycles < 10)
+		nOfCycles = 10;
+
+	/* Spread the violating channels evenly over the array */
+	CrDaTempChannelMonitorInit(&channels, nOfChannels, temp, lowerLimit, upperLimit, mask, pendingMask, pendingTemp);
+	for (i=0; i<nOfChannels; i++) {
+		CrDaTempChannelMonitorSetLimits(&channels, i, CR_DA_MON_BENCH_LOWER_LIMIT, CR_DA_MON_BENCH_UPPER_LIMIT);
+		if ((unsigned int)((double)(i+1)*violations/100.0) != (unsigned int)((double)i*violations/100.0))
+			temp[i] = CR_DA_MON_BENCH_HIGH_TEMP;
+		else
+			temp[i] = CR_DA_MON_BENCH_LOW_TEMP;
+	}
+
+	start = CrDaClockGetHostTime();
+	for (k=0; k<nOfCycles; k++)
+		nOfViolations = checkRef(&channels, refMask);
+	refTime = CrDaClockGetHostTime() - start;
+
+	start = CrDaClockGetHostTime();
+	for (k=0; k<nOfCycles; k++)
+		CrDaTempChannelMonitorCheck(&channels);
+	monTime = CrDaClockGetHostTime() - start;
+
+	/* Collect the violating channels as the report generation does */
+	nOfScanned = 0;
+	start = CrDaClockGetHostTime();
+	for (k=0; k<nOfCycles; k++) {
+		nOfScanned = 0;
+		for (channel=CrDaTempChannelMonitorNextViolation(&channels, 0); channel<nOfChannels;
+		        channel=CrDaTempChannelMonitorNextViolation(&channels, channel+1))
+			nOfScanned++;
+	}
+	scanTime = CrDaClockGetHostTime() - start;
+
+	isOk = (memcmp(mask, refMask, CR_DA_TEMP_CHANNEL_MASK_SIZE(nOfChannels)*sizeof(unsigned int)) == 0) &&
+	       (channels.nOfViolations == nOfViolations) && (nOfScanned == nOfViolations);
+	printf("%9u %11u %12.2f %12.2f %11.3f %11.3f %12.2f %7.1fx%s\n", nOfChannels, nOfViolations,
+	       (double)refTime/(double)nOfCycles/1000.0, (double)monTime/(double)nOfCycles/1000.0,
+	       (double)refTime/(double)nOfCycles/(double)nOfChannels,
+	       (double)monTime/(double)nOfCycles/(double)nOfChannels,
+	       (double)scanTime/(double)nOfCycles/1000.0, (double)refTime/(double)monTime,
+	       (isOk ? "" : "  MISMATCH"));
+
+	free(temp);
+	free(lowerLimit);
+	free(upperLimit);
+	free(mask);
+	free(refMask);
+	free(pendingMask);
+	free(pendingTemp);
+	return isOk;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static unsigned int checkRef(CrDaTempChannels_t* channels, unsigned int* mask) {
+	unsigned int nOfViolations = 0;
+	unsigned int i;
+
+	memset(mask, 0, CR_DA_TEMP_CHANNEL_MASK_SIZE(channels->nOfChannels)*sizeof(unsigned int));
+	for (i=0; i<channels->nOfChannels; i++)
+		if ((channels->temp[i] < channels->lowerLimit[i]) || (channels->temp[i] > channels->upperLimit[i])) {
+			mask[i/32] |= (1u << (i%32));
+			nOfViolations++;
+		}
+	return nOfViolations;
+}
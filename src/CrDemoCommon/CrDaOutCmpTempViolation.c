@@ -1,6 +1,6 @@
 /**
  * @file
- * @ingroup crDemoSlave1
+ * @ingroup crDemoCommon
  * Implementation of the command to set the temperature limit.
  *
  * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
@@ -36,17 +36,36 @@
 #include "FwSmDCreate.h"
 #include "FwPrCore.h"
 
-/** The limit violating temperature */
-static char limitViolatingTemp = 0;
-
 /*-----------------------------------------------------------------------------------------*/
-void CrDaOutCmpTempViolationSerialize(FwSmDesc_t smDesc) {
+void CrDaOutCmpTempViolationSetTemp(FwSmDesc_t smDesc, char temp) {
 	char* pcktPar = CrFwOutCmpGetParStart(smDesc);
-	CrFwOutCmpDefSerialize(smDesc);
-	pcktPar[0] = limitViolatingTemp;
+	pcktPar[0] = temp;
 }
 
 /*-----------------------------------------------------------------------------------------*/
-void CrDaOutCmpTempViolationSetTemp(char temp) {
-	limitViolatingTemp = temp;
+void CrDaOutCmpTempViolationAggrInit(FwSmDesc_t smDesc, unsigned int nOfViolations) {
+	unsigned char* pcktPar = (unsigned char*)CrFwOutCmpGetParStart(smDesc);
+	pcktPar[CR_DA_AGGR_OFFSET_TOTAL] = (unsigned char)(nOfViolations >> 24);
+	pcktPar[CR_DA_AGGR_OFFSET_TOTAL+1] = (unsigned char)(nOfViolations >> 16);
+	pcktPar[CR_DA_AGGR_OFFSET_TOTAL+2] = (unsigned char)(nOfViolations >> 8);
+	pcktPar[CR_DA_AGGR_OFFSET_TOTAL+3] = (unsigned char)nOfViolations;
+	pcktPar[CR_DA_AGGR_OFFSET_N] = 0;
+}
+
+/*-----------------------------------------------------------------------------------------*/
+CrFwBool_t CrDaOutCmpTempViolationAggrAdd(FwSmDesc_t smDesc, unsigned int channel, char temp) {
+	unsigned char* pcktPar = (unsigned char*)CrFwOutCmpGetParStart(smDesc);
+	unsigned char n = pcktPar[CR_DA_AGGR_OFFSET_N];
+	unsigned char* pair;
+
+	/* The list ends where the parameter area of the packet of the OutComponent ends */
+	if (n >= CR_DA_AGGR_CAPACITY(CrFwOutCmpGetParLength(smDesc)))
+		return 0;
+	pair = pcktPar + CR_DA_AGGR_OFFSET_PAIRS + n*CR_DA_AGGR_PAIR_SIZE;
+	pair[0] = (unsigned char)(channel >> 16);
+	pair[1] = (unsigned char)(channel >> 8);
+	pair[2] = (unsigned char)channel;
+	pair[3] = (unsigned char)temp;
+	pcktPar[CR_DA_AGGR_OFFSET_N] = (unsigned char)(n+1);
+	return 1;
 }
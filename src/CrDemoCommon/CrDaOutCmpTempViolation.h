@@ -0,0 +1,78 @@
+/**
+ * @file
+ * @ingroup crDemoCommon
+ * OutComponent encapsulating a report generated by a Slave Application when a temperature
+ * violation has been detected.
+ * An OutComponent is defined by defining the functions which override its
+ * adaptation points, namely (see <code>CrFwOutCmp.h</code>):
+ * - The Enable Check Operation
+ * - The Ready Check Operation
+ * - The Serialize Operation
+ * .
+ * These operations are defined as follows for the temperature violation report:
+ * - Enable Check Operation: the default Enable Check Operation of
+ *   <code>CrFwOutCmpDefEnableCheck.h</code> is used.
+ * - Ready Check Operation: the default Ready Check Operation of
+ *   <code>CrFwSmCheckAlwaysTrue.h</code> is used.
+ * - Serialize Operation: the default Serialize Operation of
+ *   <code>CrFwOutCmpDefSerialize.h</code> is used.
+ * .
+ * The report parameters are not held by this module.
+ * They are written directly into the parameter area of the packet of each OutComponent
+ * instance when the OutComponent is created and before it is loaded into the OutLoader.
+ * Several reports can therefore be pending in the OutManager at the same time, each
+ * carrying its own parameters.
+ *
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the CORDET Framework.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#ifndef CRMA_OUTCMP_TEMP_VIOLATION_H_
+#define CRMA_OUTCMP_TEMP_VIOLATION_H_
+
+/* Include framework components */
+#include "CrFwConstants.h"
+/* Include FW Profile components */
+#include "FwSmCore.h"
+
+/**
+ * Set the value of the limit violating temperature in a temperature violation report.
+ * The temperature is written in the first byte of the parameter area of the
+ * packet of the OutComponent.
+ * @param smDesc the descriptor of the OutComponent state machine
+ * @param temp the limit violating temperature (an integer in the range -128 to 127)
+ */
+void CrDaOutCmpTempViolationSetTemp(FwSmDesc_t smDesc, char temp);
+
+/**
+ * Initialize the parameter area of an aggregated temperature violation report.
+ * The aggregated report (service sub-type <code>#CR_DA_SERV_SUBTYPE_REP_AGGR</code>)
+ * uses the default Serialize Operation: its parameters are written directly into the
+ * packet of the OutComponent before the OutComponent is loaded.
+ * This function sets the total number of violations and empties the list
+ * of (channel, temperature) pairs.
+ * @param smDesc the descriptor of the OutComponent state machine
+ * @param nOfViolations the total number of channels in violation
+ */
+void CrDaOutCmpTempViolationAggrInit(FwSmDesc_t smDesc, unsigned int nOfViolations);
+
+/**
+ * Append a (channel, temperature) pair to an aggregated temperature violation report.
+ * @param smDesc the descriptor of the OutComponent state machine
+ * @param channel the index of the channel in violation (smaller than 2^24)
+ * @param temp the temperature of the channel
+ * @return 1 if the pair was appended, 0 if the parameter area of the report is full
+ * (see <code>#CR_DA_AGGR_CAPACITY</code>)
+ */
+CrFwBool_t CrDaOutCmpTempViolationAggrAdd(FwSmDesc_t smDesc, unsigned int channel, char temp);
+
+#endif /* CRMA_OUTCMP_TEMP_VIOLATION_H_ */
@@ -0,0 +1,188 @@
+/**
+ * @file
+ * @ingroup crDemoCommon
+ * Implementation of the priority lanes for the OutComponents of the demo applications.
+ *
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the CORDET Framework.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#include <stdio.h>
+#include "CrDaOutLane.h"
+#include "CrDaConstants.h"
+#include "CrDaClock.h"
+#include "CrDaTrace.h"
+/* Include FW Profile files */
+#include "FwSmConstants.h"
+#include "FwSmConfig.h"
+/* Include framework files */
+#include "CrFwConstants.h"
+#include "BaseCmp/CrFwBaseCmp.h"
+#include "OutCmp/CrFwOutCmp.h"
+#include "OutManager/CrFwOutManager.h"
+
+/** An OutComponent of a lane whose latency is being measured */
+typedef struct {
+	/** The OutComponent */
+	FwSmDesc_t outCmp;
+	/** The instance identifier of the OutComponent when it was loaded */
+	CrFwInstanceId_t instanceId;
+	/** The host time at which the OutComponent was loaded */
+	unsigned long long loadTime;
+} CrDaOutLanePending_t;
+
+/** The state of a lane */
+typedef struct {
+	/** The OutComponents of the lane which are pending in its OutManager */
+	CrDaOutLanePending_t pending[CR_DA_OUT_LANE_MAX_N_OF_PENDING];
+	/** The number of entries in <code>pending</code> */
+	unsigned int nOfPending;
+	/** The number of OutComponents which have been sent */
+	unsigned long nOfSent;
+	/** The number of OutComponents which have been aborted */
+	unsigned long nOfAborted;
+	/** The number of OutComponents whose latency could not be measured because <code>pending</code> was full */
+	unsigned long nOfUntracked;
+	/** The total latency in nanoseconds of the OutComponents which have been sent */
+	unsigned long long totalLatency;
+	/** The maximum latency in nanoseconds of the OutComponents which have been sent */
+	unsigned long long maxLatency;
+	/** The number of cycles in which the lane was skipped */
+	unsigned long nOfSkips;
+} CrDaOutLane_t;
+
+/** The lanes */
+static CrDaOutLane_t lanes[CR_DA_OUT_LANE_N];
+
+/** The number of consecutive cycles in which the bulk lane has been skipped */
+static unsigned int nOfConsecutiveSkips = 0;
+
+/**
+ * Return the lane of an OutComponent kind.
+ * @param servType the service type of the OutComponent
+ * @param servSubType the service sub-type of the OutComponent
+ * @return the lane of the OutComponent
+ */
+static CrFwInstanceId_t getLane(CrFwServType_t servType, CrFwServSubType_t servSubType);
+
+/**
+ * Execute the OutManager of a lane and update the latency of the OutComponents which
+ * have left the lane.
+ * An OutComponent has left the lane when it is no longer in state LOADED or PENDING or
+ * when its instance identifier has changed (i.e. the OutFactory has re-used it).
+ * The latency of the OutComponents which were sent (state TERMINATED) is measured and
+ * the other OutComponents are counted as aborted.
+ * @param lane the lane
+ */
+static void execLane(CrFwInstanceId_t lane);
+
+/* ---------------------------------------------------------------------------------------------*/
+FwSmDesc_t CrDaOutLaneSelect(FwSmDesc_t outCmp) {
+	CrFwInstanceId_t lane;
+	FwSmDesc_t outManager;
+	CrDaOutLane_t* l;
+
+	lane = getLane(CrFwOutCmpGetServType(outCmp), CrFwOutCmpGetServSubType(outCmp));
+	outManager = CrFwOutManagerMake(lane);
+
+	/* An OutComponent which does not fit in the POCL is released by the OutManager */
+	if (CrFwOutManagerGetNOfPendingOutCmp(outManager) >= CrFwOutManagerGetPOCLSize(outManager))
+		return outManager;
+	l = &lanes[lane];
+	if (l->nOfPending < CR_DA_OUT_LANE_MAX_N_OF_PENDING) {
+		l->pending[l->nOfPending].outCmp = outCmp;
+		l->pending[l->nOfPending].instanceId = CrFwCmpGetInstanceId(outCmp);
+		l->pending[l->nOfPending].loadTime = CrDaClockGetHostTime();
+		l->nOfPending++;
+	} else
+		l->nOfUntracked++;
+	return outManager;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaOutLaneExec() {
+	unsigned long long budget;
+
+	execLane(CR_DA_OUT_LANE_HIGH);
+
+	budget = CrDaClockGetPeriod()/100*CR_DA_OUT_LANE_BULK_BUDGET;
+	if ((CrDaClockGetCycleElapsed() < budget) || (nOfConsecutiveSkips >= CR_DA_OUT_LANE_MAX_BULK_SKIPS)) {
+		execLane(CR_DA_OUT_LANE_BULK);
+		nOfConsecutiveSkips = 0;
+	} else {
+		CrDaTraceInstant("bulk lane skipped", (int)lanes[CR_DA_OUT_LANE_BULK].nOfPending);
+		lanes[CR_DA_OUT_LANE_BULK].nOfSkips++;
+		nOfConsecutiveSkips++;
+	}
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaOutLanePrintSummary(const char* tag) {
+	static const char* laneName[CR_DA_OUT_LANE_N] = {"high", "bulk"};
+	CrDaOutLane_t* l;
+	int i;
+
+	for (i=0; i<CR_DA_OUT_LANE_N; i++) {
+		l = &lanes[i];
+		printf("%s: OutManager lane %s: %lu OutComponents sent, %lu aborted, latency avg %.1f us, max %.1f us "
+		       "(%lu not measured), %lu cycles skipped\n",
+		       tag, laneName[i], l->nOfSent, l->nOfAborted,
+		       (l->nOfSent > 0 ? (double)l->totalLatency/l->nOfSent/1000.0 : 0.0),
+		       (double)l->maxLatency/1000.0, l->nOfUntracked, l->nOfSkips);
+	}
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static CrFwInstanceId_t getLane(CrFwServType_t servType, CrFwServSubType_t servSubType) {
+	if (servType != CR_DA_SERV_TYPE)
+		return CR_DA_OUT_LANE_BULK;
+	if ((servSubType == CR_DA_SERV_SUBTYPE_REP) || (servSubType == CR_DA_SERV_SUBTYPE_REP_AGGR) ||
+	        (servSubType == CR_DA_SERV_SUBTYPE_EN) || (servSubType == CR_DA_SERV_SUBTYPE_DIS))
+		return CR_DA_OUT_LANE_HIGH;
+	return CR_DA_OUT_LANE_BULK;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static void execLane(CrFwInstanceId_t lane) {
+	FwSmDesc_t outManager = CrFwOutManagerMake(lane);
+	CrDaOutLane_t* l = &lanes[lane];
+	CrDaOutLanePending_t* p;
+	unsigned long long now, latency;
+	unsigned int k;
+
+	CrDaTraceBegin("OutManager", (int)lane);
+	FwSmExecute(outManager);
+	CrDaTraceEnd("OutManager");
+
+	/* The OutComponents may leave the POCL in any order: each one is checked individually */
+	now = CrDaClockGetHostTime();
+	k = 0;
+	while (k < l->nOfPending) {
+		p = &l->pending[k];
+		if ((CrFwCmpGetInstanceId(p->outCmp) == p->instanceId) &&
+		        (CrFwOutCmpIsInLoaded(p->outCmp) || CrFwOutCmpIsInPending(p->outCmp))) {
+			k++;
+			continue;
+		}
+		if ((CrFwCmpGetInstanceId(p->outCmp) == p->instanceId) && CrFwOutCmpIsInTerminated(p->outCmp)) {
+			latency = now - p->loadTime;
+			l->totalLatency += latency;
+			if (latency > l->maxLatency)
+				l->maxLatency = latency;
+			l->nOfSent++;
+		} else
+			l->nOfAborted++;
+		/* Fill the gap with the last entry */
+		l->nOfPending--;
+		l->pending[k] = l->pending[l->nOfPending];
+	}
+}
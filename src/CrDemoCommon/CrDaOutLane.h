@@ -0,0 +1,100 @@
+/**
+ * @file
+ * @ingroup crDemoCommon
+ * Priority lanes for the OutComponents of the demo applications.
+ * Each demo application has two OutManagers which act as two lanes:
+ * - the high-priority lane (OutManager <code>#CR_DA_OUT_LANE_HIGH</code>) carries the
+ *   urgent OutComponents: the single and the aggregated temperature violation reports of
+ *   the slave applications and the commands of the Master Application which enable or
+ *   disable temperature monitoring;
+ * - the bulk lane (OutManager <code>#CR_DA_OUT_LANE_BULK</code>) carries all other
+ *   OutComponents (the commands which set the temperature limit and the OutComponents
+ *   of other services).
+ * .
+ * The lane of an OutComponent is selected by the OutManager Selection Operation of the
+ * OutLoader (<code>::CrDaOutLaneSelect</code>) from the service type and sub-type of the
+ * OutComponent.
+ *
+ * In each control cycle, <code>::CrDaOutLaneExec</code> executes the OutManager of the
+ * high-priority lane and then, if the time which the host has spent on the cycle is
+ * still within <code>#CR_DA_OUT_LANE_BULK_BUDGET</code> percent of the period, the
+ * OutManager of the bulk lane.
+ * An urgent OutComponent is therefore sent in the cycle in which it is loaded whatever
+ * the number of OutComponents which are pending in the bulk lane.
+ * When the bulk lane is skipped, its OutComponents stay in the Pending OutComponent
+ * List of its OutManager and are sent in a later cycle.
+ * The bulk lane is not skipped in more than <code>#CR_DA_OUT_LANE_MAX_BULK_SKIPS</code>
+ * consecutive cycles so that it is not starved.
+ *
+ * For each lane, the module measures the latency of the OutComponents from the time
+ * they are loaded to the end of the execution of the OutManager which sends them.
+ * The load time of each OutComponent is held with its instance identifier: after each
+ * execution of the OutManager, the OutComponents which have left its Pending OutComponent
+ * List are found individually (an OutComponent which is not ready stays pending while the
+ * ones behind it are sent) and only the OutComponents which were sent contribute to the
+ * latency; the aborted ones are counted separately.
+ * The latency is measured with the time of the host and is printed in the summary of
+ * <code>::CrDaOutLanePrintSummary</code>.
+ * The <code>lanes</code> target of the Makefile measures it under a saturating bulk load.
+ *
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the CORDET Framework.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#ifndef CRDA_OUTLANE_H_
+#define CRDA_OUTLANE_H_
+
+/* Include FW Profile files */
+#include "FwSmCore.h"
+
+/** The instance identifier of the OutManager of the high-priority lane */
+#define CR_DA_OUT_LANE_HIGH 0
+
+/** The instance identifier of the OutManager of the bulk lane */
+#define CR_DA_OUT_LANE_BULK 1
+
+/** The number of lanes (the applications must define this number of OutManagers) */
+#define CR_DA_OUT_LANE_N 2
+
+/** The budget of a cycle (in percent of the period) within which the bulk lane is executed */
+#define CR_DA_OUT_LANE_BULK_BUDGET 50
+
+/** The maximum number of consecutive cycles in which the bulk lane is skipped */
+#define CR_DA_OUT_LANE_MAX_BULK_SKIPS 4
+
+/** The maximum number of OutComponents per lane whose load time is held */
+#define CR_DA_OUT_LANE_MAX_N_OF_PENDING 64
+
+/**
+ * OutManager Selection Operation of the OutLoader.
+ * This function returns the OutManager of the lane of an OutComponent and records the
+ * time at which the OutComponent is loaded.
+ * @param outCmp the OutComponent which is loaded
+ * @return the OutManager of the lane of the OutComponent
+ */
+FwSmDesc_t CrDaOutLaneSelect(FwSmDesc_t outCmp);
+
+/**
+ * Execute the OutManagers of the lanes for one control cycle.
+ * The OutManager of the high-priority lane is always executed and the OutManager of
+ * the bulk lane is executed if the cycle is within its budget.
+ */
+void CrDaOutLaneExec();
+
+/**
+ * Print the number of OutComponents sent and aborted in each lane, the average and maximum
+ * latency of the sent OutComponents and the number of cycles in which the bulk lane was skipped.
+ * @param tag the tag of the application with which the lines of the summary are prefixed
+ */
+void CrDaOutLanePrintSummary(const char* tag);
+
+#endif /* CRDA_OUTLANE_H_ */
@@ -0,0 +1,319 @@
+/**
+ * @file
+ * @ingroup crDemoCommon
+ *
+ * Implementation of the sidecar index of the segment files of a packet capture.
+ *
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the CORDET Framework.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "CrDaPcktIndex.h"
+#include "CrDaPcktRecorder.h"
+/* Include framework files */
+#include "Pckt/CrFwPckt.h"
+
+/** The maximum length of the name of an index file */
+#define CR_DA_IDX_MAX_NAME_LENGTH 512
+
+/** A (key, record offset) pair from which the posting lists are built */
+typedef struct {
+	/** The key */
+	unsigned int key;
+	/** The record offset */
+	unsigned int offset;
+} CrDaPcktIdxPosting_t;
+
+/**
+ * Map a file for reading.
+ * @param path the path of the file
+ * @param size the size of the file
+ * @return the start of the mapped file or NULL if the file could not be mapped
+ */
+static unsigned char* mapFile(const char* path, unsigned long* size);
+
+/**
+ * Compare two postings by key and then by offset (for use with <code>qsort</code>).
+ * @param p1 the first posting
+ * @param p2 the second posting
+ * @return a negative, zero or positive value as the first posting is smaller than,
+ * equal to or greater than the second one
+ */
+static int comparePostings(const void* p1, const void* p2);
+
+/**
+ * Write the sections of an index to a file.
+ * @param path the path of the index file
+ * @param header the index header
+ * @param buckets the time buckets
+ * @param keys the key directory
+ * @param postings the postings
+ * @return 1 if the file was written, 0 otherwise
+ */
+static CrFwBool_t writeIndex(const char* path, CrDaPcktIdxHeader_t* header, unsigned int* buckets,
+                             CrDaPcktIdxKey_t* keys, unsigned int* postings);
+
+/* ---------------------------------------------------------------------------------------------*/
+CrFwBool_t CrDaPcktIndexBuild(const char* segPath) {
+	char idxPath[CR_DA_IDX_MAX_NAME_LENGTH];
+	CrDaPcktRecSegHeader_t* segHeader;
+	CrDaPcktIdxHeader_t header;
+	CrDaPcktRec_t* rec;
+	CrDaPcktIdxPosting_t* pairs = NULL;
+	CrDaPcktIdxKey_t* keys = NULL;
+	unsigned int* buckets = NULL;
+	unsigned int* postings = NULL;
+	unsigned char* seg;
+	unsigned long segSize;
+	unsigned long long end, off, k;
+	unsigned int i, nOfPairs = 0, bucket = 0;
+	CrFwPckt_t pckt;
+	CrFwBool_t outcome = 0;
+
+	if (strlen(segPath) + sizeof(CR_DA_IDX_SUFFIX) > CR_DA_IDX_MAX_NAME_LENGTH)
+		return 0;
+	seg = mapFile(segPath, &segSize);
+	if (seg == NULL)
+		return 0;
+	segHeader = (CrDaPcktRecSegHeader_t*)seg;
+	if ((segSize < sizeof(CrDaPcktRecSegHeader_t)) ||
+	        (memcmp(segHeader->magic, CR_DA_REC_MAGIC, sizeof(segHeader->magic)) != 0)) {
+		munmap(seg, segSize);
+		return 0;
+	}
+	end = segHeader->committed;
+	if (end > segSize)
+		end = segSize;
+
+	/* Count the records and find the time span of the segment */
+	memset(&header, 0, sizeof(header));
+	memcpy(header.magic, CR_DA_IDX_MAGIC, sizeof(header.magic));
+	header.version = CR_DA_IDX_VERSION;
+	header.segIndex = segHeader->index;
+	header.bucketWidth = CR_DA_IDX_BUCKET_WIDTH;
+	for (off=sizeof(CrDaPcktRecSegHeader_t); off+sizeof(CrDaPcktRec_t)<=end; off+=CR_DA_REC_SIZE(rec->len)) {
+		rec = (CrDaPcktRec_t*)(seg+off);
+		if (header.nOfRecs == 0)
+			header.firstTime = rec->time;
+		header.lastTime = rec->time;
+		header.nOfRecs++;
+	}
+	if (header.nOfRecs > 0)
+		header.nOfBuckets = (unsigned int)((header.lastTime - header.firstTime)/header.bucketWidth) + 1;
+
+	buckets = malloc((header.nOfBuckets+1)*sizeof(unsigned int));
+	pairs = malloc((2*header.nOfRecs+1)*sizeof(CrDaPcktIdxPosting_t));
+	if ((buckets == NULL) || (pairs == NULL))
+		goto done;
+
+	/* Fill the time buckets and collect the postings */
+	for (off=sizeof(CrDaPcktRecSegHeader_t); off+sizeof(CrDaPcktRec_t)<=end; off+=CR_DA_REC_SIZE(rec->len)) {
+		rec = (CrDaPcktRec_t*)(seg+off);
+		k = (rec->time - header.firstTime)/header.bucketWidth;
+		while (bucket <= k)
+			buckets[bucket++] = (unsigned int)off;
+		pckt = (CrFwPckt_t)(rec+1);
+		pairs[nOfPairs].key = CR_DA_IDX_KEY(CR_DA_IDX_KIND_SERV, CrFwPcktGetServType(pckt),
+		                                    CrFwPcktGetServSubType(pckt));
+		pairs[nOfPairs++].offset = (unsigned int)off;
+		pairs[nOfPairs].key = CR_DA_IDX_KEY(CR_DA_IDX_KIND_SRC, CrFwPcktGetSrc(pckt), 0);
+		pairs[nOfPairs++].offset = (unsigned int)off;
+	}
+	while (bucket <= header.nOfBuckets)
+		buckets[bucket++] = (unsigned int)off;
+
+	/* Build the key directory and the postings */
+	qsort(pairs, nOfPairs, sizeof(CrDaPcktIdxPosting_t), comparePostings);
+	for (i=0; i<nOfPairs; i++)
+		if ((i == 0) || (pairs[i].key != pairs[i-1].key))
+			header.nOfKeys++;
+	header.nOfPostings = nOfPairs;
+	keys = malloc((header.nOfKeys+1)*sizeof(CrDaPcktIdxKey_t));
+	postings = malloc((nOfPairs+1)*sizeof(unsigned int));
+	if ((keys == NULL) || (postings == NULL))
+		goto done;
+	header.nOfKeys = 0;
+	for (i=0; i<nOfPairs; i++) {
+		if ((i == 0) || (pairs[i].key != pairs[i-1].key)) {
+			keys[header.nOfKeys].key = pairs[i].key;
+			keys[header.nOfKeys].first = i;
+			keys[header.nOfKeys].count = 0;
+			header.nOfKeys++;
+		}
+		keys[header.nOfKeys-1].count++;
+		postings[i] = pairs[i].offset;
+	}
+
+	snprintf(idxPath, sizeof(idxPath), "%s%s", segPath, CR_DA_IDX_SUFFIX);
+	outcome = writeIndex(idxPath, &header, buckets, keys, postings);
+
+done:
+	free(buckets);
+	free(pairs);
+	free(keys);
+	free(postings);
+	munmap(seg, segSize);
+	return outcome;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+CrFwBool_t CrDaPcktIndexOpen(const char* segPath, CrDaPcktIdx_t* idx) {
+	char idxPath[CR_DA_IDX_MAX_NAME_LENGTH];
+	const CrDaPcktIdxHeader_t* header;
+	unsigned long expSize;
+
+	snprintf(idxPath, sizeof(idxPath), "%s%s", segPath, CR_DA_IDX_SUFFIX);
+	idx->base = mapFile(idxPath, &idx->size);
+	if (idx->base == NULL)
+		return 0;
+
+	header = (const CrDaPcktIdxHeader_t*)idx->base;
+	if ((idx->size < sizeof(CrDaPcktIdxHeader_t)) ||
+	        (memcmp(header->magic, CR_DA_IDX_MAGIC, sizeof(header->magic)) != 0) ||
+	        (header->version != CR_DA_IDX_VERSION)) {
+		CrDaPcktIndexClose(idx);
+		return 0;
+	}
+	expSize = sizeof(CrDaPcktIdxHeader_t) + (header->nOfBuckets+1)*sizeof(unsigned int) +
+	          header->nOfKeys*sizeof(CrDaPcktIdxKey_t) + header->nOfPostings*sizeof(unsigned int);
+	if (idx->size != expSize) {
+		CrDaPcktIndexClose(idx);
+		return 0;
+	}
+
+	idx->header = header;
+	idx->buckets = (const unsigned int*)(header+1);
+	idx->keys = (const CrDaPcktIdxKey_t*)(idx->buckets + header->nOfBuckets + 1);
+	idx->postings = (const unsigned int*)(idx->keys + header->nOfKeys);
+	return 1;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaPcktIndexClose(CrDaPcktIdx_t* idx) {
+	if (idx->base != NULL)
+		munmap((void*)idx->base, idx->size);
+	idx->base = NULL;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+const unsigned int* CrDaPcktIndexGetPostings(const CrDaPcktIdx_t* idx, unsigned int key, unsigned int* count) {
+	unsigned int lo = 0;
+	unsigned int hi = idx->header->nOfKeys;
+	unsigned int mid;
+
+	/* Binary search of the key directory */
+	while (lo < hi) {
+		mid = (lo + hi)/2;
+		if (idx->keys[mid].key < key)
+			lo = mid + 1;
+		else
+			hi = mid;
+	}
+	if ((lo == idx->header->nOfKeys) || (idx->keys[lo].key != key)) {
+		*count = 0;
+		return idx->postings;
+	}
+	*count = idx->keys[lo].count;
+	return idx->postings + idx->keys[lo].first;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaPcktIndexGetRange(const CrDaPcktIdx_t* idx, unsigned long long startTime, unsigned long long endTime,
+                           unsigned int* startOffset, unsigned int* endOffset) {
+	const CrDaPcktIdxHeader_t* header = idx->header;
+	unsigned long long b;
+
+	if ((header->nOfRecs == 0) || (endTime < header->firstTime) || (startTime > header->lastTime) ||
+	        (startTime > endTime)) {
+		*startOffset = idx->buckets[header->nOfBuckets];
+		*endOffset = *startOffset;
+		return;
+	}
+
+	if (startTime <= header->firstTime)
+		*startOffset = idx->buckets[0];
+	else
+		*startOffset = idx->buckets[(startTime - header->firstTime)/header->bucketWidth];
+
+	b = (endTime - header->firstTime)/header->bucketWidth + 1;
+	if (b >= header->nOfBuckets)
+		*endOffset = idx->buckets[header->nOfBuckets];
+	else
+		*endOffset = idx->buckets[b];
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static unsigned char* mapFile(const char* path, unsigned long* size) {
+	struct stat st;
+	void* base;
+	int fd;
+
+	fd = open(path, O_RDONLY);
+	if (fd < 0)
+		return NULL;
+	if ((fstat(fd, &st) < 0) || (st.st_size == 0)) {
+		close(fd);
+		return NULL;
+	}
+	base = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+	close(fd);
+	if (base == MAP_FAILED)
+		return NULL;
+	*size = (unsigned long)st.st_size;
+	return (unsigned char*)base;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static int comparePostings(const void* p1, const void* p2) {
+	const CrDaPcktIdxPosting_t* a = (const CrDaPcktIdxPosting_t*)p1;
+	const CrDaPcktIdxPosting_t* b = (const CrDaPcktIdxPosting_t*)p2;
+
+	if (a->key != b->key)
+		return (a->key < b->key) ? -1 : 1;
+	if (a->offset != b->offset)
+		return (a->offset < b->offset) ? -1 : 1;
+	return 0;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static CrFwBool_t writeIndex(const char* path, CrDaPcktIdxHeader_t* header, unsigned int* buckets,
+                             CrDaPcktIdxKey_t* keys, unsigned int* postings) {
+	char tmpPath[CR_DA_IDX_MAX_NAME_LENGTH+8];
+	FILE* f;
+	int ok;
+
+	/* The index is written to a temporary file which is then renamed so that readers never see a partial index */
+	snprintf(tmpPath, sizeof(tmpPath), "%s.tmp", path);
+	f = fopen(tmpPath, "wb");
+	if (f == NULL) {
+		perror("CrDaPcktIndexBuild, Create index file");
+		return 0;
+	}
+	ok = (fwrite(header, sizeof(CrDaPcktIdxHeader_t), 1, f) == 1);
+	ok = ok && (fwrite(buckets, sizeof(unsigned int), header->nOfBuckets+1, f) == header->nOfBuckets+1);
+	ok = ok && (fwrite(keys, sizeof(CrDaPcktIdxKey_t), header->nOfKeys, f) == header->nOfKeys);
+	ok = ok && (fwrite(postings, sizeof(unsigned int), header->nOfPostings, f) == header->nOfPostings);
+	ok = (fclose(f) == 0) && ok;
+	if (!ok || (rename(tmpPath, path) != 0)) {
+		perror("CrDaPcktIndexBuild, Write index file");
+		unlink(tmpPath);
+		return 0;
+	}
+	return 1;
+}
@@ -0,0 +1,181 @@
+/**
+ * @file
+ * @ingroup crDemoCommon
+ * Sidecar index of the segment files of a packet capture.
+ * The index of the segment file <code>seg</code> of a capture (see
+ * <code>CrDaPcktRecorder.h</code>) is held in file <code>seg.idx</code>.
+ * It allows the records which match a query on time, service type and sub-type
+ * and packet source to be located without scanning the segment.
+ *
+ * An index file consists of the following sections:
+ * - The index header of type <code>::CrDaPcktIdxHeader_t</code>.
+ * - The time buckets: an array of <code>nOfBuckets+1</code> record offsets.
+ *   Element <code>b</code> is the offset of the first record whose time is not
+ *   smaller than <code>firstTime+b*bucketWidth</code> and the last element is the end
+ *   of the last record in the segment.
+ * - The key directory: an array of <code>nOfKeys</code> entries of type
+ *   <code>::CrDaPcktIdxKey_t</code>, sorted by key.
+ *   Each entry identifies the posting list of one service type and sub-type or
+ *   of one packet source.
+ * - The postings: an array of <code>nOfPostings</code> record offsets.
+ *   The posting list of a key is the range of the postings given by its directory
+ *   entry and it holds the offsets of all the records of the key in increasing order.
+ * .
+ * All offsets are byte offsets from the start of the segment file and are of
+ * type <code>unsigned int</code> (segment files must therefore be smaller than 4 GB).
+ * The service type, sub-type and source of a record are those of its packet
+ * as returned by the accessors of <code>CrFwPckt.h</code>.
+ *
+ * An index is written by <code>::CrDaPcktIndexBuild</code> once its segment is
+ * complete.
+ * The indexes are built offline, outside the control cycles of the recording
+ * application: the query tool (see <code>CrDaPcktQueryMain.c</code>) builds the
+ * index of every closed segment which does not yet have one.
+ *
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the CORDET Framework.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#ifndef CRDA_PCKTINDEX_H_
+#define CRDA_PCKTINDEX_H_
+
+/* Include Framework Files */
+#include "CrFwConstants.h"
+/* Include Configuration Files */
+#include "CrFwUserConstants.h"
+
+/** The magic string at the start of an index file */
+#define CR_DA_IDX_MAGIC "CRDAIDX1"
+
+/** The version of the index format */
+#define CR_DA_IDX_VERSION 1
+
+/** The suffix which is appended to the name of a segment file to form the name of its index file */
+#define CR_DA_IDX_SUFFIX ".idx"
+
+/** The width in nanoseconds of a time bucket */
+#define CR_DA_IDX_BUCKET_WIDTH 100000000ULL
+
+/** The key kind of the posting lists by service type and sub-type */
+#define CR_DA_IDX_KIND_SERV 1
+
+/** The key kind of the posting lists by packet source */
+#define CR_DA_IDX_KIND_SRC 2
+
+/**
+ * Return the key of a posting list.
+ * @param kind the key kind (<code>#CR_DA_IDX_KIND_SERV</code> or <code>#CR_DA_IDX_KIND_SRC</code>)
+ * @param a the service type (kind <code>#CR_DA_IDX_KIND_SERV</code>) or the source
+ * (kind <code>#CR_DA_IDX_KIND_SRC</code>)
+ * @param b the service sub-type (kind <code>#CR_DA_IDX_KIND_SERV</code>) or zero
+ * (kind <code>#CR_DA_IDX_KIND_SRC</code>)
+ */
+#define CR_DA_IDX_KEY(kind, a, b) ((((unsigned int)(kind)) << 16) | (((unsigned int)(a) & 0xFF) << 8) | \
+                                   ((unsigned int)(b) & 0xFF))
+
+/** The header of an index file (64 bytes). */
+typedef struct {
+	/** The magic string <code>#CR_DA_IDX_MAGIC</code> (not null-terminated) */
+	char magic[8];
+	/** The version of the index format */
+	unsigned int version;
+	/** The index of the segment */
+	unsigned int segIndex;
+	/** The time of the first record in the segment */
+	unsigned long long firstTime;
+	/** The time of the last record in the segment */
+	unsigned long long lastTime;
+	/** The width in nanoseconds of a time bucket */
+	unsigned long long bucketWidth;
+	/** The number of records in the segment */
+	unsigned int nOfRecs;
+	/** The number of time buckets */
+	unsigned int nOfBuckets;
+	/** The number of entries in the key directory */
+	unsigned int nOfKeys;
+	/** The number of postings */
+	unsigned int nOfPostings;
+	/** Reserved (set to zero) */
+	unsigned char reserved[8];
+} CrDaPcktIdxHeader_t;
+
+/** An entry of the key directory of an index file. */
+typedef struct {
+	/** The key of the posting list (see <code>#CR_DA_IDX_KEY</code>) */
+	unsigned int key;
+	/** The position of the first posting of the posting list */
+	unsigned int first;
+	/** The number of postings in the posting list */
+	unsigned int count;
+} CrDaPcktIdxKey_t;
+
+/** An index file which has been mapped for reading. */
+typedef struct {
+	/** The start of the mapped index file */
+	const unsigned char* base;
+	/** The size of the mapped index file */
+	unsigned long size;
+	/** The index header */
+	const CrDaPcktIdxHeader_t* header;
+	/** The time buckets */
+	const unsigned int* buckets;
+	/** The key directory */
+	const CrDaPcktIdxKey_t* keys;
+	/** The postings */
+	const unsigned int* postings;
+} CrDaPcktIdx_t;
+
+/**
+ * Build the index of a complete segment file and write it to its index file.
+ * @param segPath the path of the segment file
+ * @return 1 if the index was written, 0 otherwise
+ */
+CrFwBool_t CrDaPcktIndexBuild(const char* segPath);
+
+/**
+ * Map the index file of a segment file for reading.
+ * @param segPath the path of the segment file
+ * @param idx the mapped index
+ * @return 1 if the index file exists and is valid, 0 otherwise
+ */
+CrFwBool_t CrDaPcktIndexOpen(const char* segPath, CrDaPcktIdx_t* idx);
+
+/**
+ * Unmap an index file which was mapped by <code>::CrDaPcktIndexOpen</code>.
+ * @param idx the mapped index
+ */
+void CrDaPcktIndexClose(CrDaPcktIdx_t* idx);
+
+/**
+ * Return the posting list of a key.
+ * @param idx the mapped index
+ * @param key the key of the posting list
+ * @param count the number of postings in the posting list (zero if the key is not in the index)
+ * @return the first posting of the posting list
+ */
+const unsigned int* CrDaPcktIndexGetPostings(const CrDaPcktIdx_t* idx, unsigned int key, unsigned int* count);
+
+/**
+ * Return the offset range of the records which may have been recorded in a time interval.
+ * All the records recorded between <code>startTime</code> and <code>endTime</code>
+ * (included) have an offset in the range <code>[*startOffset, *endOffset)</code>.
+ * The range may also hold records recorded just before or after the interval.
+ * @param idx the mapped index
+ * @param startTime the start of the time interval
+ * @param endTime the end of the time interval
+ * @param startOffset the start of the offset range
+ * @param endOffset the end of the offset range
+ */
+void CrDaPcktIndexGetRange(const CrDaPcktIdx_t* idx, unsigned long long startTime, unsigned long long endTime,
+                           unsigned int* startOffset, unsigned int* endOffset);
+
+#endif /* CRDA_PCKTINDEX_H_ */
@@ -0,0 +1,311 @@
+/**
+ * @file
+ * @ingroup crDemoCommon
+ *
+ * Query tool for packet captures.
+ *
+ * This file provides the main program of the <code>cr_pcktquery</code> tool which
+ * lists the records of a packet capture (see <code>CrDaPcktRecorder.h</code>) which
+ * match a query.
+ * The tool is called as follows:
+ * <pre>
+ *   cr_pcktquery [-t type] [-s subType] [-a src] [-d in|out] [-b t1] [-e t2] capturePath appId
+ * </pre>
+ * where <code>capturePath</code> and <code>appId</code> identify the capture and the
+ * options restrict the query to the packets of a given service type and sub-type,
+ * to the packets from a given source, to the packets in a given direction and
+ * to the packets recorded between times <code>t1</code> and <code>t2</code> (in
+ * seconds from the first record of the capture).
+ * For instance, the query "all type 64/4 reports from Slave 2 between 10 and 20 s
+ * into the capture of the Master Application" is:
+ * <pre>
+ *   cr_pcktquery -t 64 -s 4 -a 3 -b 10 -e 20 capture 1
+ * </pre>
+ *
+ * The segment files of the capture are memory-mapped and, for the segments which
+ * have a sidecar index (see <code>CrDaPcktIndex.h</code>), only the records
+ * which are candidates for the query are read: segments outside the time interval
+ * are skipped, the time buckets bound the range of record offsets and the
+ * shortest applicable posting list gives the candidate records.
+ * The tool builds the missing index of a closed segment (a segment whose file has been
+ * truncated to its committed offset) with <code>::CrDaPcktIndexBuild</code> before it
+ * queries it: the packet recorder leaves the building of the indexes to the tool so that
+ * the control cycles of the recording application are not loaded with it.
+ * Segments without an index (e.g. the segment which is still being written) are scanned.
+ * The packets are decoded with the accessors of <code>CrFwPckt.h</code>.
+ *
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the CORDET Framework.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <glob.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+/* Include demo application files */
+#include "CrDaPcktRecorder.h"
+#include "CrDaPcktIndex.h"
+/* Include framework files */
+#include "Pckt/CrFwPckt.h"
+
+/** A query on the records of a capture */
+typedef struct {
+	/** Whether the query is restricted to a service type */
+	CrFwBool_t hasType;
+	/** The service type */
+	unsigned int type;
+	/** Whether the query is restricted to a service sub-type */
+	CrFwBool_t hasSubType;
+	/** The service sub-type */
+	unsigned int subType;
+	/** Whether the query is restricted to a packet source */
+	CrFwBool_t hasSrc;
+	/** The packet source */
+	unsigned int src;
+	/** The direction of the records (zero for both directions) */
+	unsigned int dir;
+	/** The start of the time interval (absolute record time) */
+	unsigned long long startTime;
+	/** The end of the time interval (absolute record time) */
+	unsigned long long endTime;
+} CrDaPcktQuery_t;
+
+/** The time of the first record of the capture */
+static unsigned long long captureStartTime = 0;
+
+/** The number of records which have been examined */
+static unsigned long nOfExamined = 0;
+
+/** The number of records which match the query */
+static unsigned long nOfMatches = 0;
+
+/**
+ * Check a record against the query and print it if it matches.
+ * @param query the query
+ * @param rec the record
+ */
+static void checkRec(const CrDaPcktQuery_t* query, const CrDaPcktRec_t* rec);
+
+/**
+ * Run the query on a segment.
+ * @param query the query
+ * @param segPath the path of the segment file
+ */
+static void querySeg(const CrDaPcktQuery_t* query, const char* segPath);
+
+/**
+ * Return the time of the first record of a segment.
+ * @param segPath the path of the segment file
+ * @param time the time of the first record
+ * @return 1 if the segment holds at least one record, 0 otherwise
+ */
+static CrFwBool_t getFirstRecTime(const char* segPath, unsigned long long* time);
+
+/**
+ * Main program of the query tool.
+ * @param argc the number of command line arguments
+ * @param argv the command line arguments
+ * @return EXIT_SUCCESS if the query was run, EXIT_FAILURE otherwise
+ */
+int main(int argc, char* argv[]) {
+	CrDaPcktQuery_t query;
+	double t1 = -1, t2 = -1;
+	const char* capturePath;
+	char pattern[512];
+	glob_t segFiles;
+	size_t i;
+	int opt;
+
+	memset(&query, 0, sizeof(query));
+	while ((opt = getopt(argc, argv, "t:s:a:d:b:e:")) != -1) {
+		switch (opt) {
+			case 't':
+				query.hasType = 1;
+				query.type = (unsigned int)atoi(optarg);
+				break;
+			case 's':
+				query.hasSubType = 1;
+				query.subType = (unsigned int)atoi(optarg);
+				break;
+			case 'a':
+				query.hasSrc = 1;
+				query.src = (unsigned int)atoi(optarg);
+				break;
+			case 'd':
+				query.dir = (strcmp(optarg, "out") == 0) ? crDaPcktRecOut : crDaPcktRecIn;
+				break;
+			case 'b':
+				t1 = atof(optarg);
+				break;
+			case 'e':
+				t2 = atof(optarg);
+				break;
+			default:
+				optind = argc + 1;
+				break;
+		}
+	}
+	if (optind + 2 != argc) {
+		printf("Usage: %s [-t type] [-s subType] [-a src] [-d in|out] [-b t1] [-e t2] capturePath appId\n",
+		       argv[0]);
+		return EXIT_FAILURE;
+	}
+	capturePath = argv[optind];
+
+	snprintf(pattern, sizeof(pattern), "%s.%s.[0-9][0-9][0-9][0-9][0-9][0-9]", capturePath, argv[optind+1]);
+	if (glob(pattern, 0, NULL, &segFiles) != 0) {
+		printf("No capture files matching %s\n", pattern);
+		return EXIT_FAILURE;
+	}
+
+	/* Convert the time interval to absolute record times */
+	for (i=0; i<segFiles.gl_pathc; i++)
+		if (getFirstRecTime(segFiles.gl_pathv[i], &captureStartTime))
+			break;
+	query.startTime = (t1 < 0) ? 0 : captureStartTime + (unsigned long long)(t1*1e9);
+	query.endTime = (t2 < 0) ? ~0ULL : captureStartTime + (unsigned long long)(t2*1e9);
+
+	for (i=0; i<segFiles.gl_pathc; i++)
+		querySeg(&query, segFiles.gl_pathv[i]);
+	globfree(&segFiles);
+
+	fprintf(stderr, "%lu matching records (%lu records examined)\n", nOfMatches, nOfExamined);
+	return EXIT_SUCCESS;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static void querySeg(const CrDaPcktQuery_t* query, const char* segPath) {
+	const CrDaPcktRecSegHeader_t* header;
+	const unsigned int* postings = NULL;
+	const unsigned int* list;
+	unsigned int nOfPostings = 0, n, lo, hi, lower, upper, mid;
+	unsigned long long off, end;
+	const unsigned char* seg;
+	CrDaPcktIdx_t idx;
+	struct stat st;
+	int fd;
+
+	fd = open(segPath, O_RDONLY);
+	if (fd < 0)
+		return;
+	if ((fstat(fd, &st) < 0) || ((size_t)st.st_size < sizeof(CrDaPcktRecSegHeader_t))) {
+		close(fd);
+		return;
+	}
+	seg = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+	close(fd);
+	if (seg == MAP_FAILED)
+		return;
+	header = (const CrDaPcktRecSegHeader_t*)seg;
+	end = __atomic_load_n(&header->committed, __ATOMIC_ACQUIRE);
+	if (end > (unsigned long long)st.st_size)
+		end = (unsigned long long)st.st_size;
+
+	/* A closed segment is indexed the first time it is queried */
+	if (!CrDaPcktIndexOpen(segPath, &idx) &&
+	        ((end != (unsigned long long)st.st_size) || !CrDaPcktIndexBuild(segPath) || !CrDaPcktIndexOpen(segPath, &idx))) {
+		/* No index: scan the segment */
+		fprintf(stderr, "No index for %s: scanning the segment\n", segPath);
+		for (off=sizeof(CrDaPcktRecSegHeader_t); off+sizeof(CrDaPcktRec_t)<=end;
+		        off+=CR_DA_REC_SIZE(((const CrDaPcktRec_t*)(seg+off))->len))
+			checkRec(query, (const CrDaPcktRec_t*)(seg+off));
+		munmap((void*)seg, (size_t)st.st_size);
+		return;
+	}
+
+	/* Restrict the query to the offset range of its time interval */
+	CrDaPcktIndexGetRange(&idx, query->startTime, query->endTime, &lo, &hi);
+
+	/* Select the shortest applicable posting list */
+	if (query->hasType && query->hasSubType)
+		postings = CrDaPcktIndexGetPostings(&idx, CR_DA_IDX_KEY(CR_DA_IDX_KIND_SERV, query->type, query->subType),
+		                                    &nOfPostings);
+	if (query->hasSrc) {
+		list = CrDaPcktIndexGetPostings(&idx, CR_DA_IDX_KEY(CR_DA_IDX_KIND_SRC, query->src, 0), &n);
+		if ((postings == NULL) || (n < nOfPostings)) {
+			postings = list;
+			nOfPostings = n;
+		}
+	}
+
+	if (postings == NULL) {
+		/* No posting list applies: scan the offset range */
+		for (off=lo; off<hi; off+=CR_DA_REC_SIZE(((const CrDaPcktRec_t*)(seg+off))->len))
+			checkRec(query, (const CrDaPcktRec_t*)(seg+off));
+	} else {
+		/* Find the postings in the offset range */
+		lower = 0;
+		upper = nOfPostings;
+		while (lower < upper) {
+			mid = (lower + upper)/2;
+			if (postings[mid] < lo)
+				lower = mid + 1;
+			else
+				upper = mid;
+		}
+		for (; (lower < nOfPostings) && (postings[lower] < hi); lower++)
+			checkRec(query, (const CrDaPcktRec_t*)(seg+postings[lower]));
+	}
+
+	CrDaPcktIndexClose(&idx);
+	munmap((void*)seg, (size_t)st.st_size);
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static void checkRec(const CrDaPcktQuery_t* query, const CrDaPcktRec_t* rec) {
+	CrFwPckt_t pckt = (CrFwPckt_t)(rec+1);
+
+	nOfExamined++;
+	if ((rec->time < query->startTime) || (rec->time > query->endTime))
+		return;
+	if ((query->dir != 0) && (rec->dir != query->dir))
+		return;
+	if (query->hasType && (CrFwPcktGetServType(pckt) != query->type))
+		return;
+	if (query->hasSubType && (CrFwPcktGetServSubType(pckt) != query->subType))
+		return;
+	if (query->hasSrc && (CrFwPcktGetSrc(pckt) != query->src))
+		return;
+
+	nOfMatches++;
+	printf("%12.6f %-3s peer=%u type=%u/%u disc=%u src=%u dest=%u seq=%lu len=%u\n",
+	       (double)(rec->time - captureStartTime)/1e9, (rec->dir == crDaPcktRecIn) ? "in" : "out",
+	       rec->peer, (unsigned int)CrFwPcktGetServType(pckt), (unsigned int)CrFwPcktGetServSubType(pckt),
+	       (unsigned int)CrFwPcktGetDiscriminant(pckt), (unsigned int)CrFwPcktGetSrc(pckt),
+	       (unsigned int)CrFwPcktGetDest(pckt), (unsigned long)CrFwPcktGetSeqCnt(pckt),
+	       (unsigned int)CrFwPcktGetLength(pckt));
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static CrFwBool_t getFirstRecTime(const char* segPath, unsigned long long* time) {
+	struct {
+		CrDaPcktRecSegHeader_t header;
+		CrDaPcktRec_t rec;
+	} head;
+	CrFwBool_t outcome = 0;
+	int fd;
+
+	fd = open(segPath, O_RDONLY);
+	if (fd < 0)
+		return 0;
+	if ((read(fd, &head, sizeof(head)) == (ssize_t)sizeof(head)) &&
+	        (head.header.committed >= sizeof(head))) {
+		*time = head.rec.time;
+		outcome = 1;
+	}
+	close(fd);
+	return outcome;
+}
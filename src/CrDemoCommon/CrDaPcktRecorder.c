@@ -0,0 +1,315 @@
+/**
+ * @file
+ * @ingroup crDemoCommon
+ *
+ * Implementation of the packet recorder.
+ *
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the CORDET Framework.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include "CrDaPcktRecorder.h"
+#include "CrDaPcktIndex.h"
+#include "CrDaClock.h"
+/* Include framework files */
+#include "Pckt/CrFwPckt.h"
+
+/** The maximum length of the base path of the capture files */
+#define CR_DA_REC_MAX_PATH_LENGTH 256
+
+/** The maximum length of a segment file name (base path plus application and segment suffixes) */
+#define CR_DA_REC_MAX_NAME_LENGTH (CR_DA_REC_MAX_PATH_LENGTH+32)
+
+/** A memory-mapped segment file */
+typedef struct {
+	/** The start of the mapped segment (NULL if the segment is not mapped) */
+	unsigned char* base;
+	/** The file descriptor of the segment file */
+	int fd;
+	/** The index of the segment */
+	unsigned int index;
+} CrDaPcktRecSeg_t;
+
+/** The base path of the capture files */
+static char basePath[CR_DA_REC_MAX_PATH_LENGTH];
+
+/** The identifier of the recording application */
+static CrFwDestSrc_t recAppId = 0;
+
+/** The size of a segment */
+static unsigned long long segmentSize = 0;
+
+/** The maximum number of segments which are kept */
+static unsigned int maxSegments = 0;
+
+/** The segment which is currently being written */
+static CrDaPcktRecSeg_t curSeg = {NULL, -1, 0};
+
+/** The segment which has been prepared in advance (not mapped if not yet prepared) */
+static CrDaPcktRecSeg_t nextSeg = {NULL, -1, 0};
+
+/** The offset in the current segment at which the next record is written */
+static unsigned long long curOffset = 0;
+
+/** The full segment which has been left by the recorder and not yet closed (not mapped if there is none) */
+static CrDaPcktRecSeg_t prevSeg = {NULL, -1, 0};
+
+/** The committed offset of the full segment which has not yet been closed */
+static unsigned long long prevOffset = 0;
+
+/** The index of the oldest segment file which has not yet been deleted by the retention */
+static unsigned int firstKeptSeg = 0;
+
+/** The number of packets which could not be recorded */
+static unsigned long nOfDropped = 0;
+
+/**
+ * Build the name of a segment file.
+ * @param name the buffer where the name is written
+ * @param index the index of the segment
+ */
+static void segName(char* name, unsigned int index);
+
+/**
+ * Create and map a segment file and initialize its header.
+ * @param seg the segment to be created
+ * @param index the index of the segment
+ * @return 1 if the segment was created, 0 otherwise
+ */
+static CrFwBool_t segCreate(CrDaPcktRecSeg_t* seg, unsigned int index);
+
+/**
+ * Unmap a segment, truncate its file to the given length and close it.
+ * @param seg the segment to be closed
+ * @param length the length to which the segment file is truncated
+ */
+static void segClose(CrDaPcktRecSeg_t* seg, unsigned long long length);
+
+/**
+ * Close the full segment which has been left by the recorder (if any).
+ */
+static void segClosePrev();
+
+/**
+ * Delete the closed segment files which have fallen out of the retention window.
+ * The segment which is being written and the <code>maxSegments</code> segments
+ * which precede it are kept.
+ * This function does nothing if the maximum number of segments is not set.
+ */
+static void segRetire();
+
+/**
+ * Continue writing in the segment which has been prepared in advance.
+ * The full segment is only handed over to <code>::CrDaPcktRecorderMaintain</code>
+ * which closes it: this function does no system calls.
+ * @return 1 if the next segment was ready, 0 otherwise
+ */
+static CrFwBool_t segRotate();
+
+/* ---------------------------------------------------------------------------------------------*/
+CrFwBool_t CrDaPcktRecorderOpen(const char* path, CrFwDestSrc_t appId, unsigned long long size,
+                                unsigned int maxSeg) {
+	CrDaPcktRecorderClose();
+
+	if (strlen(path) >= CR_DA_REC_MAX_PATH_LENGTH) {
+		printf("CrDaPcktRecorderOpen: capture path too long\n");
+		return 0;
+	}
+	if (size < sizeof(CrDaPcktRecSegHeader_t) + CR_DA_REC_SIZE(CrFwPcktGetMaxLength())) {
+		printf("CrDaPcktRecorderOpen: segment size too small\n");
+		return 0;
+	}
+	if (size > 0xFFFFFFFFULL) {	/* Record offsets in the segment index are 32-bit */
+		printf("CrDaPcktRecorderOpen: segment size too large\n");
+		return 0;
+	}
+
+	strcpy(basePath, path);
+	recAppId = appId;
+	segmentSize = size;
+	maxSegments = maxSeg;
+	nOfDropped = 0;
+	firstKeptSeg = 0;
+	if (!segCreate(&curSeg, 0))
+		return 0;
+	curOffset = sizeof(CrDaPcktRecSegHeader_t);
+	return 1;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaPcktRecorderClose() {
+	char name[CR_DA_REC_MAX_NAME_LENGTH];
+
+	if (curSeg.base == NULL)
+		return;
+
+	segClosePrev();
+	segClose(&curSeg, curOffset);
+	if (nextSeg.base != NULL) {
+		segClose(&nextSeg, 0);
+		segName(name, nextSeg.index);
+		unlink(name);
+	}
+	segRetire();
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+CrFwBool_t CrDaPcktRecorderIsOpen() {
+	return (curSeg.base != NULL);
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaPcktRecorderRecord(CrDaPcktRecDir_t dir, CrFwDestSrc_t peer, CrFwPckt_t pckt) {
+	CrDaPcktRec_t* rec;
+	CrFwPcktLength_t len;
+	unsigned long long recSize;
+
+	if (curSeg.base == NULL)
+		return;
+
+	len = CrFwPcktGetLength(pckt);
+	recSize = CR_DA_REC_SIZE(len);
+	if (curOffset + recSize > segmentSize)
+		if (!segRotate()) {
+			nOfDropped++;
+			return;
+		}
+
+	rec = (CrDaPcktRec_t*)(curSeg.base + curOffset);
+	rec->time = CrDaClockGetTime();
+	rec->dir = (unsigned char)dir;
+	rec->peer = (unsigned char)peer;
+	rec->len = (unsigned short)len;
+	rec->reserved = 0;
+	memcpy(rec+1, pckt, len);
+	curOffset += recSize;
+
+	/* Publish the record to readers of the segment */
+	__atomic_store_n(&((CrDaPcktRecSegHeader_t*)curSeg.base)->committed, curOffset, __ATOMIC_RELEASE);
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaPcktRecorderMaintain() {
+	if (curSeg.base == NULL)
+		return;
+	segClosePrev();
+	segRetire();
+	if (nextSeg.base != NULL)
+		return;
+	if (curOffset < segmentSize/2)
+		return;
+	segCreate(&nextSeg, curSeg.index+1);
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+unsigned long CrDaPcktRecorderGetNOfDropped() {
+	return nOfDropped;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static void segName(char* name, unsigned int index) {
+	snprintf(name, CR_DA_REC_MAX_NAME_LENGTH, "%s.%u.%06u", basePath, recAppId, index);
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static CrFwBool_t segCreate(CrDaPcktRecSeg_t* seg, unsigned int index) {
+	char name[CR_DA_REC_MAX_NAME_LENGTH];
+	CrDaPcktRecSegHeader_t* header;
+	void* base;
+	int fd;
+
+	segName(name, index);
+	fd = open(name, O_RDWR | O_CREAT | O_TRUNC, 0644);
+	if (fd < 0) {
+		perror("CrDaPcktRecorder, Create segment file");
+		return 0;
+	}
+	if (ftruncate(fd, (off_t)segmentSize) < 0) {
+		perror("CrDaPcktRecorder, Size segment file");
+		close(fd);
+		return 0;
+	}
+	base = mmap(NULL, (size_t)segmentSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	if (base == MAP_FAILED) {
+		perror("CrDaPcktRecorder, Map segment file");
+		close(fd);
+		return 0;
+	}
+
+	header = (CrDaPcktRecSegHeader_t*)base;
+	memset(header, 0, sizeof(CrDaPcktRecSegHeader_t));
+	memcpy(header->magic, CR_DA_REC_MAGIC, sizeof(header->magic));
+	header->version = CR_DA_REC_VERSION;
+	header->index = index;
+	header->size = segmentSize;
+	header->committed = sizeof(CrDaPcktRecSegHeader_t);
+	header->appId = recAppId;
+
+	seg->base = (unsigned char*)base;
+	seg->fd = fd;
+	seg->index = index;
+	return 1;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static void segClose(CrDaPcktRecSeg_t* seg, unsigned long long length) {
+	munmap(seg->base, (size_t)segmentSize);
+	if (ftruncate(seg->fd, (off_t)length) < 0)
+		perror("CrDaPcktRecorder, Truncate segment file");
+	close(seg->fd);
+	seg->base = NULL;
+	seg->fd = -1;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static void segClosePrev() {
+	if (prevSeg.base == NULL)
+		return;
+	segClose(&prevSeg, prevOffset);
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static void segRetire() {
+	char name[CR_DA_REC_MAX_NAME_LENGTH];
+
+	if (maxSegments == 0)
+		return;
+	while (firstKeptSeg + maxSegments < curSeg.index) {
+		segName(name, firstKeptSeg);
+		unlink(name);
+		strcat(name, CR_DA_IDX_SUFFIX);
+		unlink(name);
+		firstKeptSeg++;
+	}
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static CrFwBool_t segRotate() {
+	/* Drop the record rather than doing system calls if the next segment is not ready or
+	 * if the previous full segment has not yet been closed */
+	if ((nextSeg.base == NULL) || (prevSeg.base != NULL))
+		return 0;
+
+	prevSeg = curSeg;
+	prevOffset = curOffset;
+	curSeg = nextSeg;
+	nextSeg.base = NULL;
+	nextSeg.fd = -1;
+	curOffset = sizeof(CrDaPcktRecSegHeader_t);
+	return 1;
+}
@@ -0,0 +1,181 @@
+/**
+ * @file
+ * @ingroup crDemoCommon
+ * Append-only recorder for the packets which cross the socket adapters.
+ * When the recorder is open, every packet which is collected from a socket
+ * (direction "in") or handed over to a socket (direction "out") is appended
+ * to a capture made up of memory-mapped segment files.
+ *
+ * The capture of application <code>appId</code> with base path <code>base</code>
+ * is made up of files <code>base.appId.NNNNNN</code> where <code>NNNNNN</code> is
+ * the segment index.
+ * Each segment file has a fixed size and starts with a segment header of type
+ * <code>::CrDaPcktRecSegHeader_t</code> which is followed by a sequence of records.
+ * Each record consists of a record header of type <code>::CrDaPcktRec_t</code>
+ * followed by the raw packet bytes and it is padded to a multiple of 8 bytes.
+ * Records are never split across segments.
+ *
+ * The segment header holds the <code>committed</code> offset: the end of the last
+ * record which has been completely written.
+ * The recorder updates it with a release store after each record so that a reader
+ * which maps the segment (possibly while it is being written) only ever sees
+ * complete records.
+ * When a segment is closed, its file is truncated to the committed offset.
+ *
+ * Recording is done by the control thread without locks and without system calls:
+ * a record is written with one read of the demo clock (see <code>CrDaClock.h</code>)
+ * and one <code>memcpy</code> into the mapped segment.
+ * All system calls are done by <code>::CrDaPcktRecorderMaintain</code> which should be
+ * called once per control cycle: it closes the segment which the recorder has filled up,
+ * deletes the segments which have fallen out of the retention window and creates the
+ * next segment in advance.
+ * When the current segment fills up, the record function switches to the segment which
+ * has been prepared in advance.
+ * If no segment is ready (because the current segment filled up within one control cycle
+ * or because the segment file could not be created), packets are counted as dropped and
+ * not recorded: the record function never creates a segment itself.
+ *
+ * If a maximum number of segments is set, the retention only deletes closed segments:
+ * the segment which is being written and the <code>maxSegments</code> segments which
+ * precede it are kept.
+ *
+ * The recorder does not build the sidecar indexes of the segments (see
+ * <code>CrDaPcktIndex.h</code>): building an index allocates memory, sorts the postings
+ * and writes a file, which has no place in a control cycle.
+ * The indexes of the closed segments are built offline by the query tool (see
+ * <code>CrDaPcktQueryMain.c</code>).
+ *
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the CORDET Framework.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#ifndef CRDA_PCKTRECORDER_H_
+#define CRDA_PCKTRECORDER_H_
+
+/* Include Framework Files */
+#include "CrFwConstants.h"
+/* Include Configuration Files */
+#include "CrFwUserConstants.h"
+
+/** Name of the environment variable through which the demo applications are told to record their packets */
+#define CR_DA_REC_ENV_VAR "CR_DA_RECORD"
+
+/** Default size in bytes of a segment file */
+#define CR_DA_REC_SEGMENT_SIZE (16*1024*1024)
+
+/** Default maximum number of closed segment files which are kept for one capture */
+#define CR_DA_REC_MAX_SEGMENTS 8
+
+/** The magic string at the start of a segment file */
+#define CR_DA_REC_MAGIC "CRDAREC1"
+
+/** The version of the capture format */
+#define CR_DA_REC_VERSION 1
+
+/** The direction of a recorded packet */
+typedef enum {
+	/** Packet collected from a socket */
+	crDaPcktRecIn = 1,
+	/** Packet handed over to a socket */
+	crDaPcktRecOut = 2
+} CrDaPcktRecDir_t;
+
+/** The header of a segment file (64 bytes). */
+typedef struct {
+	/** The magic string <code>#CR_DA_REC_MAGIC</code> (not null-terminated) */
+	char magic[8];
+	/** The version of the capture format */
+	unsigned int version;
+	/** The index of the segment within its capture */
+	unsigned int index;
+	/** The size of the segment file when it is being written */
+	unsigned long long size;
+	/** The offset from the start of the segment of the end of the last complete record */
+	unsigned long long committed;
+	/** The identifier of the application which recorded the segment */
+	unsigned int appId;
+	/** Reserved (set to zero) */
+	unsigned char reserved[28];
+} CrDaPcktRecSegHeader_t;
+
+/** The header of a record (16 bytes), followed by the packet bytes. */
+typedef struct {
+	/** The time at which the packet was recorded (time of <code>CrDaClock.h</code> in ns) */
+	unsigned long long time;
+	/** The direction of the packet (a value of type <code>::CrDaPcktRecDir_t</code>) */
+	unsigned char dir;
+	/** The source (direction "in") or destination (direction "out") of the packet */
+	unsigned char peer;
+	/** The length of the packet in bytes */
+	unsigned short len;
+	/** Reserved (set to zero) */
+	unsigned int reserved;
+} CrDaPcktRec_t;
+
+/**
+ * Return the size of a record holding a packet of the given length.
+ * @param len the packet length
+ */
+#define CR_DA_REC_SIZE(len) ((sizeof(CrDaPcktRec_t)+(len)+7) & ~(unsigned long long)7)
+
+/**
+ * Open the recorder and create the first segment of a capture.
+ * If the recorder is already open, it is first closed.
+ * @param basePath the base path of the capture files
+ * @param appId the identifier of the recording application
+ * @param segmentSize the size of a segment file in bytes (smaller than 4 GB)
+ * @param maxSegments the maximum number of closed segment files which are kept in addition
+ * to the segment which is being written (zero for no limit)
+ * @return 1 if the recorder was opened, 0 otherwise
+ */
+CrFwBool_t CrDaPcktRecorderOpen(const char* basePath, CrFwDestSrc_t appId, unsigned long long segmentSize,
+                                unsigned int maxSegments);
+
+/**
+ * Close the recorder.
+ * The segment files are truncated to their committed offset, a segment which was
+ * prepared in advance and not yet used is deleted and the retention is applied.
+ * This function does nothing if the recorder is not open.
+ */
+void CrDaPcktRecorderClose();
+
+/**
+ * Return true if the recorder is open.
+ * @return 1 if the recorder is open, 0 otherwise
+ */
+CrFwBool_t CrDaPcktRecorderIsOpen();
+
+/**
+ * Append a packet to the capture.
+ * This function does nothing if the recorder is not open.
+ * @param dir the direction of the packet
+ * @param peer the source (direction "in") or destination (direction "out") of the packet
+ * @param pckt the packet
+ */
+void CrDaPcktRecorderRecord(CrDaPcktRecDir_t dir, CrFwDestSrc_t peer, CrFwPckt_t pckt);
+
+/**
+ * Close the segment which the recorder has filled up, apply the retention and prepare the next segment of the capture if the current segment is more
+ * than half full.
+ * It should be called once per control cycle.
+ * This function does nothing if the recorder is not open.
+ */
+void CrDaPcktRecorderMaintain();
+
+/**
+ * Return the number of packets which could not be recorded because no segment
+ * was ready when the current segment filled up.
+ * @return the number of dropped packets
+ */
+unsigned long CrDaPcktRecorderGetNOfDropped();
+
+#endif /* CRDA_PCKTRECORDER_H_ */
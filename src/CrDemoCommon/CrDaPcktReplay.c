@@ -0,0 +1,306 @@
+/**
+ * @file
+ * @ingroup crDemoCommon
+ *
+ * Implementation of the replay of a packet capture.
+ *
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the CORDET Framework.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <time.h>
+#include <errno.h>
+#include <glob.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "CrDaPcktReplay.h"
+#include "CrDaPcktRecorder.h"
+/* Include FW Profile files */
+#include "FwSmConstants.h"
+/* Include framework files */
+#include "InStream/CrFwInStream.h"
+#include "Pckt/CrFwPckt.h"
+
+/** The segment files of the capture */
+static glob_t segFiles;
+
+/** Whether a capture is open */
+static CrFwBool_t isOpen = 0;
+
+/** The timing mode of the replay */
+static CrDaPcktReplayMode_t replayMode = crDaPcktReplayAsFast;
+
+/** The position in <code>segFiles</code> of the segment which is currently mapped */
+static size_t segPos = 0;
+
+/** The start of the segment which is currently mapped (NULL if no segment is mapped) */
+static unsigned char* segBase = NULL;
+
+/** The size of the mapping of the current segment */
+static size_t segMapSize = 0;
+
+/** The end of the committed records in the current segment */
+static unsigned long long segEnd = 0;
+
+/** The next record with direction "in" (NULL at the end of the capture) */
+static CrDaPcktRec_t* nextRec = NULL;
+
+/** The offset of the next record in the current segment */
+static unsigned long long nextOffset = 0;
+
+/** The recording time of the first record of the capture */
+static unsigned long long firstRecTime = 0;
+
+/** The time at which the replay was opened */
+static unsigned long long startTime = 0;
+
+/** The number of packets collected from the capture */
+static unsigned long nOfCollected = 0;
+
+/** The number of packets handed over to OutStreams */
+static unsigned long nOfHandedOver = 0;
+
+/**
+ * Return the current time from <code>CLOCK_MONOTONIC</code> in nanoseconds.
+ * @return the current time
+ */
+static unsigned long long getMonotonicTime();
+
+/**
+ * Map the segment at the given position in <code>segFiles</code> and unmap the
+ * current segment.
+ * @param pos the position of the segment file
+ * @return 1 if the segment was mapped, 0 otherwise
+ */
+static CrFwBool_t segMap(size_t pos);
+
+/**
+ * Unmap the current segment.
+ */
+static void segUnmap();
+
+/**
+ * Move <code>nextRec</code> to the first record with direction "in" at or after
+ * <code>nextOffset</code>, mapping further segments as needed.
+ * At the end of the capture, <code>nextRec</code> is set to NULL.
+ */
+static void seekNextInRec();
+
+/* ---------------------------------------------------------------------------------------------*/
+CrFwBool_t CrDaPcktReplayOpen(const char* basePath, CrFwDestSrc_t appId, CrDaPcktReplayMode_t mode) {
+	char pattern[512];
+
+	CrDaPcktReplayClose();
+
+	snprintf(pattern, sizeof(pattern), "%s.%u.[0-9][0-9][0-9][0-9][0-9][0-9]", basePath, appId);
+	if (glob(pattern, 0, NULL, &segFiles) != 0) {
+		printf("CrDaPcktReplayOpen: no capture files matching %s\n", pattern);
+		return 0;
+	}
+
+	isOpen = 1;
+	replayMode = mode;
+	nOfCollected = 0;
+	nOfHandedOver = 0;
+	segPos = 0;
+	nextOffset = 0;
+	if (!segMap(0)) {
+		CrDaPcktReplayClose();
+		return 0;
+	}
+	seekNextInRec();
+	if (nextRec != NULL)
+		firstRecTime = nextRec->time;
+	startTime = getMonotonicTime();
+	return 1;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaPcktReplayClose() {
+	if (!isOpen)
+		return;
+	segUnmap();
+	globfree(&segFiles);
+	nextRec = NULL;
+	isOpen = 0;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+CrFwBool_t CrDaPcktReplayIsAtEnd() {
+	return (nextRec == NULL);
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaPcktReplayWait() {
+	unsigned long long due;
+	struct timespec dueTime;
+
+	if ((nextRec == NULL) || (replayMode == crDaPcktReplayAsFast))
+		return;
+
+	due = startTime + (nextRec->time - firstRecTime);
+	dueTime.tv_sec = (time_t)(due / 1000000000ULL);
+	dueTime.tv_nsec = (long)(due % 1000000000ULL);
+	while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &dueTime, NULL) == EINTR);	/* resume the sleep after a signal */
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaPcktReplayPoll() {
+	CrDaPcktRec_t* rec;
+	FwSmDesc_t inStream;
+
+	while ((nextRec != NULL) && CrDaPcktReplayIsPcktAvail(nextRec->peer)) {
+		rec = nextRec;
+		inStream = CrFwInStreamGet(rec->peer);
+		if (inStream == NULL) {	/* No InStream for the packet source: skip the packet */
+			nextOffset += CR_DA_REC_SIZE(rec->len);
+			seekNextInRec();
+			continue;
+		}
+		CrFwInStreamPcktAvail(inStream);
+		if (nextRec == rec)	/* The InStream did not accept the packet */
+			return;
+	}
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+CrFwPckt_t CrDaPcktReplayPcktCollect(CrFwDestSrc_t src) {
+	CrFwPckt_t pckt;
+
+	if (!CrDaPcktReplayIsPcktAvail(src))
+		return NULL;
+
+	pckt = CrFwPcktMake((CrFwPcktLength_t)nextRec->len);
+	if (pckt == NULL)
+		return NULL;
+	memcpy(pckt, nextRec+1, nextRec->len);
+	nOfCollected++;
+
+	nextOffset += CR_DA_REC_SIZE(nextRec->len);
+	seekNextInRec();
+	return pckt;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+CrFwBool_t CrDaPcktReplayIsPcktAvail(CrFwDestSrc_t src) {
+	if (nextRec == NULL)
+		return 0;
+	if (nextRec->peer != src)
+		return 0;
+	if (replayMode == crDaPcktReplayAsFast)
+		return 1;
+	return (getMonotonicTime() - startTime >= nextRec->time - firstRecTime);
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+CrFwBool_t CrDaPcktReplayPcktHandover(CrFwPckt_t pckt) {
+	(void)pckt;
+	nOfHandedOver++;
+	return 1;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+unsigned long CrDaPcktReplayGetNOfCollected() {
+	return nOfCollected;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+unsigned long CrDaPcktReplayGetNOfHandedOver() {
+	return nOfHandedOver;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static unsigned long long getMonotonicTime() {
+	struct timespec now;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return (unsigned long long)now.tv_sec*1000000000ULL + (unsigned long long)now.tv_nsec;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static CrFwBool_t segMap(size_t pos) {
+	CrDaPcktRecSegHeader_t* header;
+	struct stat st;
+	void* base;
+	int fd;
+
+	segUnmap();
+	segPos = pos;
+
+	fd = open(segFiles.gl_pathv[pos], O_RDONLY);
+	if (fd < 0) {
+		perror("CrDaPcktReplay, Open segment file");
+		return 0;
+	}
+	if ((fstat(fd, &st) < 0) || ((size_t)st.st_size < sizeof(CrDaPcktRecSegHeader_t))) {
+		printf("CrDaPcktReplay: invalid segment file %s\n", segFiles.gl_pathv[pos]);
+		close(fd);
+		return 0;
+	}
+	base = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+	close(fd);
+	if (base == MAP_FAILED) {
+		perror("CrDaPcktReplay, Map segment file");
+		return 0;
+	}
+
+	header = (CrDaPcktRecSegHeader_t*)base;
+	if ((memcmp(header->magic, CR_DA_REC_MAGIC, sizeof(header->magic)) != 0) ||
+	        (header->version != CR_DA_REC_VERSION)) {
+		printf("CrDaPcktReplay: invalid segment header in %s\n", segFiles.gl_pathv[pos]);
+		munmap(base, (size_t)st.st_size);
+		return 0;
+	}
+
+	segBase = (unsigned char*)base;
+	segMapSize = (size_t)st.st_size;
+	segEnd = __atomic_load_n(&header->committed, __ATOMIC_ACQUIRE);
+	if (segEnd > segMapSize)
+		segEnd = segMapSize;
+	nextOffset = sizeof(CrDaPcktRecSegHeader_t);
+	return 1;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static void segUnmap() {
+	if (segBase == NULL)
+		return;
+	munmap(segBase, segMapSize);
+	segBase = NULL;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static void seekNextInRec() {
+	CrDaPcktRec_t* rec;
+
+	while (segBase != NULL) {
+		while (nextOffset + sizeof(CrDaPcktRec_t) <= segEnd) {
+			rec = (CrDaPcktRec_t*)(segBase + nextOffset);
+			if (nextOffset + CR_DA_REC_SIZE(rec->len) > segEnd)
+				break;
+			if (rec->dir == crDaPcktRecIn) {
+				nextRec = rec;
+				return;
+			}
+			nextOffset += CR_DA_REC_SIZE(rec->len);
+		}
+		if ((segPos + 1 >= segFiles.gl_pathc) || !segMap(segPos + 1))
+			break;
+	}
+	segUnmap();
+	nextRec = NULL;
+}
@@ -0,0 +1,136 @@
+/**
+ * @file
+ * @ingroup crDemoCommon
+ * Replay of a packet capture through the InStream adapter interface.
+ * This module reads a capture written by the packet recorder (see
+ * <code>CrDaPcktRecorder.h</code>) and serves the packets which the recording
+ * application had collected from its sockets (the records with direction "in")
+ * to the InStreams of the replaying application.
+ * It offers a packet collect function and a packet available check function
+ * with the same signatures as the socket adapters and the InStreams are
+ * configured to use them in place of the socket when the demo applications are
+ * compiled with <code>CR_DA_REPLAY</code> defined (see the InStream and OutStream
+ * configuration files of the demo applications).
+ * In that configuration, packets handed over to an OutStream are discarded by
+ * <code>::CrDaPcktReplayPcktHandover</code>.
+ *
+ * Packets are served in the order in which they were recorded.
+ * Only the oldest packet which has not yet been served can be collected: it is
+ * available to the InStream whose source is equal to the peer of its record.
+ * Two timing modes are supported:
+ * - In the "as-recorded" mode, a packet becomes available when the time elapsed
+ *   since the replay was opened is at least equal to the time elapsed between the
+ *   first record of the capture and its own record.
+ * - In the "as-fast-as-possible" mode, a packet is available as soon as all
+ *   the packets recorded before it have been collected.
+ * .
+ * The segment files of the capture are mapped read-only one at a time and
+ * are processed in the order of their segment index.
+ *
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the CORDET Framework.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#ifndef CRDA_PCKTREPLAY_H_
+#define CRDA_PCKTREPLAY_H_
+
+/* Include Framework Files */
+#include "CrFwConstants.h"
+/* Include Configuration Files */
+#include "CrFwUserConstants.h"
+
+/** The timing mode of a replay */
+typedef enum {
+	/** Packets are served with the timing with which they were recorded */
+	crDaPcktReplayAsRecorded = 1,
+	/** Packets are served as fast as they are collected */
+	crDaPcktReplayAsFast = 2
+} CrDaPcktReplayMode_t;
+
+/**
+ * Open a capture for replay.
+ * If a capture is already open, it is first closed.
+ * @param basePath the base path of the capture files
+ * @param appId the identifier of the application which recorded the capture
+ * @param mode the timing mode of the replay
+ * @return 1 if the capture was opened and holds at least one segment, 0 otherwise
+ */
+CrFwBool_t CrDaPcktReplayOpen(const char* basePath, CrFwDestSrc_t appId, CrDaPcktReplayMode_t mode);
+
+/**
+ * Close the capture.
+ * This function does nothing if no capture is open.
+ */
+void CrDaPcktReplayClose();
+
+/**
+ * Return true if all the packets in the capture have been served (or if no
+ * capture is open).
+ * @return 1 if all packets have been served, 0 otherwise
+ */
+CrFwBool_t CrDaPcktReplayIsAtEnd();
+
+/**
+ * Wait until the next packet in the capture becomes available.
+ * In the "as-fast-as-possible" mode, this function returns immediately.
+ */
+void CrDaPcktReplayWait();
+
+/**
+ * Notify the InStreams of the packets which are available.
+ * This function plays the role of the socket poll functions: it calls
+ * <code>CrFwInStreamPcktAvail</code> on the InStream whose source matches the
+ * next packet until the next packet is not available or its InStream cannot
+ * accept it.
+ * Packets from a source for which the application has no InStream are skipped.
+ */
+void CrDaPcktReplayPoll();
+
+/**
+ * Collect the next packet of the capture if it is available and it comes from
+ * the argument source.
+ * This function is an InStream packet collect function.
+ * @param src the source
+ * @return the packet or NULL if no packet from the argument source is available
+ */
+CrFwPckt_t CrDaPcktReplayPcktCollect(CrFwDestSrc_t src);
+
+/**
+ * Check whether the next packet of the capture is available and comes from the
+ * argument source.
+ * This function is an InStream packet available check function.
+ * @param src the source
+ * @return 1 if a packet is available, 0 otherwise
+ */
+CrFwBool_t CrDaPcktReplayIsPcktAvail(CrFwDestSrc_t src);
+
+/**
+ * Discard a packet handed over by an OutStream.
+ * This function is an OutStream packet hand-over function.
+ * @param pckt the packet
+ * @return always returns 1
+ */
+CrFwBool_t CrDaPcktReplayPcktHandover(CrFwPckt_t pckt);
+
+/**
+ * Return the number of packets which have been collected from the capture.
+ * @return the number of collected packets
+ */
+unsigned long CrDaPcktReplayGetNOfCollected();
+
+/**
+ * Return the number of packets which have been handed over to an OutStream.
+ * @return the number of discarded packets
+ */
+unsigned long CrDaPcktReplayGetNOfHandedOver();
+
+#endif /* CRDA_PCKTREPLAY_H_ */
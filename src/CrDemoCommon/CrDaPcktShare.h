@@ -0,0 +1,82 @@
+/**
+ * @file
+ * @ingroup crDemoCommon
+ * Reference-counted packets of the packet pool of the demo applications.
+ * The packet interface of <code>CrFwPckt.h</code> only has single-owner packets:
+ * a component which sends one packet to several destinations (e.g. a report which is
+ * sent to several OutStreams) must make and copy the packet once per destination.
+ * The implementation of the packet interface of the demo applications
+ * (<code>CrFwPckt.c</code>) counts the references to its packets and the functions
+ * which this file declares extend the packet interface so that the destinations can
+ * share one serialized packet:
+ * - <code>::CrFwPcktMake</code> returns a packet with one reference;
+ * - <code>::CrFwPcktRetain</code> adds a reference to a packet in use in place of a copy;
+ * - <code>::CrFwPcktRelease</code> removes a reference and the packet returns to the pool
+ *   when its last reference has been released.
+ * .
+ * A shared packet is immutable: its owners must not modify it (e.g. set its sequence
+ * counter) as long as it has more than one reference.
+ *
+ * The pool counts the references which have been added and the packet bytes which they
+ * saved from being copied.
+ * The <code>cr_fanoutbench</code> tool (see <code>CrDaFanOutBenchMain.c</code>) compares
+ * the pool usage and the copied bytes of a fan-out with copied and with shared packets.
+ *
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the CORDET Framework.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#ifndef CRDA_PCKTSHARE_H_
+#define CRDA_PCKTSHARE_H_
+
+/* Include Framework Files */
+#include "CrFwConstants.h"
+/* Include Configuration Files */
+#include "CrFwUserConstants.h"
+
+/** The maximum number of references to a packet (the range of <code>::CrFwCounterU1_t</code>) */
+#define CR_DA_PCKT_SHARE_MAX_REFS 255
+
+/**
+ * Add a reference to a packet in use.
+ * The packet is not returned to the pool until this reference has been released
+ * through a call to <code>::CrFwPcktRelease</code>.
+ * If the packet is not in use or if it already has <code>#CR_DA_PCKT_SHARE_MAX_REFS</code>
+ * references, no reference is added and the application error code is set to
+ * <code>crPcktRetainErr</code>: the caller then owns no reference to the packet (it may
+ * fall back to a copy).
+ * @param pckt the packet
+ * @return 1 if the reference was added; 0 otherwise
+ */
+CrFwBool_t CrFwPcktRetain(CrFwPckt_t pckt);
+
+/**
+ * Return the number of references to a packet.
+ * @param pckt the packet
+ * @return the number of references to the packet (zero if the packet is not in use)
+ */
+CrFwCounterU1_t CrFwPcktGetRefCount(CrFwPckt_t pckt);
+
+/**
+ * Return the number of references which have been added to packets through
+ * <code>::CrFwPcktRetain</code> (the number of packet copies which were saved).
+ * @return the number of added references
+ */
+unsigned long CrFwPcktGetNOfRetains();
+
+/**
+ * Return the number of packet bytes which the added references saved from being copied.
+ * @return the number of saved bytes
+ */
+unsigned long long CrFwPcktGetNOfBytesSaved();
+
+#endif /* CRDA_PCKTSHARE_H_ */
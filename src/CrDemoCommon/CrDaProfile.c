@@ -0,0 +1,200 @@
+/**
+ * @file
+ * @ingroup crDemoCommon
+ * Implementation of the run profile of the demo applications.
+ *
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the CORDET Framework.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "CrDaProfile.h"
+
+/** The run profile */
+static CrDaProfile_t profile;
+
+/** The state of the random generator */
+static unsigned long long rngState = 1;
+
+/**
+ * Set a parameter of the run profile.
+ * @param key the key of the parameter (see <code>CrDaProfile.h</code>)
+ * @param value the value of the parameter
+ * @return 1 if the key and the value are valid, 0 otherwise
+ */
+static int setPar(const char* key, const char* value);
+
+/* ---------------------------------------------------------------------------------------------*/
+int CrDaProfileParse(int argc, char* argv[], unsigned int stream) {
+	int opt;
+	int outcome = 1;
+
+	profile.nOfCycles = CR_DA_PROFILE_DEF_N_OF_CYCLES;
+	profile.period = CR_DA_PROFILE_DEF_PERIOD;
+	profile.nOfCmdsPerCycle = -1;
+	profile.violationProb = -1;
+	profile.nOfChannels = 0;
+	profile.nOfViolatingChannels = -1;
+	profile.payloadSize = 0;
+	profile.seed = 1;
+	profile.headroom = CR_DA_PROFILE_DEF_HEADROOM;
+	profile.isQuiet = 0;
+
+	optind = 1;
+	while ((opt = getopt(argc, argv, CR_DA_PROFILE_OPTIONS)) != -1) {
+		switch (opt) {
+			case 'n':
+				outcome = setPar("cycles", optarg);
+				break;
+			case 'p':
+				outcome = setPar("period", optarg);
+				break;
+			case 'c':
+				outcome = setPar("commands", optarg);
+				break;
+			case 'v':
+				outcome = setPar("violation", optarg);
+				break;
+			case 'm':
+				outcome = setPar("channels", optarg);
+				break;
+			case 'k':
+				outcome = setPar("violating", optarg);
+				break;
+			case 'l':
+				outcome = setPar("payload", optarg);
+				break;
+			case 's':
+				outcome = setPar("seed", optarg);
+				break;
+			case 'r':
+				outcome = setPar("headroom", optarg);
+				break;
+			case 'q':
+				profile.isQuiet = 1;
+				break;
+			case 'f':
+				outcome = CrDaProfileLoad(optarg);
+				break;
+			default:
+				outcome = 0;
+				break;
+		}
+		if (!outcome)
+			break;
+	}
+	if (outcome && (optind != argc))
+		outcome = 0;
+
+	if (!outcome) {
+		printf("Usage: %s [-n cycles] [-p period] [-c commands] [-v probability] [-m channels]"
+		       " [-k violating] [-l payload] [-s seed] [-r headroom] [-q] [-f file]\n",
+		       argv[0]);
+		return 0;
+	}
+
+	/* Seed the random generator (its state must not be zero) */
+	rngState = ((unsigned long long)profile.seed << 8) + stream + 1;
+	return 1;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+int CrDaProfileLoad(const char* path) {
+	FILE* file;
+	char line[256];
+	char key[64], value[64];
+	int lineNmb = 0;
+	int outcome = 1;
+
+	file = fopen(path, "r");
+	if (file == NULL) {
+		printf("CrDaProfileLoad: cannot open %s\n", path);
+		return 0;
+	}
+	while (outcome && (fgets(line, sizeof(line), file) != NULL)) {
+		lineNmb++;
+		if (sscanf(line, " %63[^= \t\n] = %63s", key, value) != 2) {
+			if ((sscanf(line, " %63s", key) == 1) && (key[0] != '#')) {
+				printf("CrDaProfileLoad: invalid line %d in %s\n", lineNmb, path);
+				outcome = 0;
+			}
+			continue;
+		}
+		if (key[0] == '#')
+			continue;
+		outcome = setPar(key, value);
+	}
+	fclose(file);
+	return outcome;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+const CrDaProfile_t* CrDaProfileGet() {
+	return &profile;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+double CrDaProfileRandom() {
+	rngState ^= rngState >> 12;
+	rngState ^= rngState << 25;
+	rngState ^= rngState >> 27;
+	return (double)((rngState * 2685821657736338717ULL) >> 11)/9007199254740992.0;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static int setPar(const char* key, const char* value) {
+	char* end;
+	long n;
+	double p;
+
+	if (strcmp(key, "violation") == 0) {
+		p = strtod(value, &end);
+		if ((*end != '\0') || (p < 0) || (p > 1)) {
+			printf("CrDaProfile: invalid violation probability %s\n", value);
+			return 0;
+		}
+		profile.violationProb = p;
+		return 1;
+	}
+
+	n = strtol(value, &end, 10);
+	if ((*end != '\0') || (n < 0)) {
+		printf("CrDaProfile: invalid value %s for %s\n", value, key);
+		return 0;
+	}
+	if ((strcmp(key, "cycles") == 0) && (n > 0))
+		profile.nOfCycles = (unsigned int)n;
+	else if ((strcmp(key, "period") == 0) && (n > 0))
+		profile.period = (unsigned int)n;
+	else if (strcmp(key, "commands") == 0)
+		profile.nOfCmdsPerCycle = (int)n;
+	else if (strcmp(key, "channels") == 0)
+		profile.nOfChannels = (unsigned int)n;
+	else if (strcmp(key, "violating") == 0)
+		profile.nOfViolatingChannels = (int)n;
+	else if (strcmp(key, "payload") == 0)
+		profile.payloadSize = (unsigned int)n;
+	else if (strcmp(key, "seed") == 0)
+		profile.seed = (unsigned int)n;
+	else if (strcmp(key, "headroom") == 0)
+		profile.headroom = (unsigned int)n;
+	else if ((strcmp(key, "quiet") == 0) && (n <= 1))
+		profile.isQuiet = (unsigned int)n;
+	else {
+		printf("CrDaProfile: invalid parameter %s = %s\n", key, value);
+		return 0;
+	}
+	return 1;
+}
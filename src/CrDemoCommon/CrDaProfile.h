@@ -0,0 +1,139 @@
+/**
+ * @file
+ * @ingroup crDemoCommon
+ * Run profile of the demo applications.
+ * The run profile defines the number and period of the control cycles of a run
+ * and the traffic which the demo applications generate in each cycle.
+ * By default, the demo applications run the 99 cycles of one second of the
+ * original demo with its fixed command schedule and temperature pattern.
+ * The run profile allows the same applications to be used as load generators for
+ * soak and throughput tests.
+ *
+ * The run profile is set from the command line of the demo applications
+ * (and of the loopback harness, see <code>CrDaLoopbackMain.c</code>) with the
+ * following options:
+ * - <code>-n cycles</code>: the number of control cycles (default: 99).
+ * - <code>-p period</code>: the period of the control cycles in milliseconds (default: 1000).
+ * - <code>-c commands</code>: the number of commands which the Master Application
+ *   sends in each cycle (default: the fixed command schedule of the demo).
+ *   In the first cycle, the Master Application enables temperature monitoring in
+ *   both slave applications.
+ *   In all cycles, it then sends the given number of commands to set the
+ *   temperature limit, alternately to the Slave 1 and the Slave 2 Application.
+ * - <code>-v probability</code>: the probability that the temperature in a slave
+ *   application violates its limit in a cycle (default: the fixed temperature pattern
+ *   of the demo).
+ * - <code>-m channels</code>: the number of temperature channels which each slave
+ *   application monitors in addition to its temperature (default: 0, no channel array is
+ *   monitored and no aggregated temperature violation report is generated).
+ * - <code>-k violating</code>: the number of temperature channels of each slave application
+ *   which violate their limit in a cycle with a temperature violation (default: one
+ *   channel in every 64 channels).
+ * - <code>-l payload</code>: the size in bytes of the parameter area of the commands
+ *   sent by the Master Application (default: the size of the command kind).
+ * - <code>-s seed</code>: the seed of the random generator (default: 1).
+ * - <code>-r headroom</code>: the headroom in percent of the high-water marks with which
+ *   the sizing report recommends the sizes of the pools and queues (default: 25, see
+ *   <code>CrDaSizing.h</code>).
+ * - <code>-q</code>: quiet run: the loopback harness discards the output of the
+ *   applications and only prints its own summary (see <code>CrDaLoopbackMain.c</code>);
+ *   the option has no effect on the applications when they run as separate processes.
+ * - <code>-f file</code>: a configuration file from which the run profile is loaded.
+ * .
+ * The configuration file holds one <code>key = value</code> line per parameter
+ * with keys <code>cycles</code>, <code>period</code>, <code>commands</code>,
+ * <code>violation</code>, <code>channels</code>, <code>violating</code>, <code>payload</code>, <code>seed</code>,
+ * <code>headroom</code> and <code>quiet</code> (0 or 1).
+ * Empty lines and lines starting with <code>#</code> are ignored.
+ * The options are applied in the order in which they are given: options which
+ * follow a <code>-f</code> option override the values of the configuration file.
+ *
+ * The random generator is a deterministic xorshift generator: runs with the same
+ * run profile in simulation mode (see <code>CrDaClock.h</code>) are reproducible.
+ * This interface only uses plain C types so that it can also be used by the
+ * loopback harness.
+ *
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the CORDET Framework.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#ifndef CRDA_PROFILE_H_
+#define CRDA_PROFILE_H_
+
+/** The default number of control cycles */
+#define CR_DA_PROFILE_DEF_N_OF_CYCLES 99
+
+/** The default period of the control cycles in milliseconds */
+#define CR_DA_PROFILE_DEF_PERIOD 1000
+
+/** The default headroom of the sizing report in percent */
+#define CR_DA_PROFILE_DEF_HEADROOM 25
+
+/** The command line options of the run profile (in the format of <code>getopt</code>) */
+#define CR_DA_PROFILE_OPTIONS "n:p:c:v:m:k:l:s:r:qf:"
+
+/** The run profile of the demo applications. */
+typedef struct {
+	/** The number of control cycles */
+	unsigned int nOfCycles;
+	/** The period of the control cycles in milliseconds */
+	unsigned int period;
+	/** The number of commands per cycle (negative for the fixed command schedule) */
+	int nOfCmdsPerCycle;
+	/** The probability of a temperature violation in a cycle (negative for the fixed pattern) */
+	double violationProb;
+	/** The number of temperature channels monitored by each slave application (zero for none) */
+	unsigned int nOfChannels;
+	/** The number of channels in violation in a cycle with a violation (negative for the fixed pattern) */
+	int nOfViolatingChannels;
+	/** The size of the parameter area of the commands (zero for the size of the command kind) */
+	unsigned int payloadSize;
+	/** The seed of the random generator */
+	unsigned int seed;
+	/** The headroom of the sizing report in percent of the high-water marks */
+	unsigned int headroom;
+	/** 1 if the output of the applications is discarded by the loopback harness, 0 otherwise */
+	unsigned int isQuiet;
+} CrDaProfile_t;
+
+/**
+ * Set the run profile from the command line.
+ * The run profile is first reset to its default values.
+ * If an option is invalid, a usage message is printed.
+ * @param argc the number of command line arguments
+ * @param argv the command line arguments
+ * @param stream the identifier of the random stream of the caller (the random
+ * generators of callers with different identifiers produce different sequences)
+ * @return 1 if the command line is valid, 0 otherwise
+ */
+int CrDaProfileParse(int argc, char* argv[], unsigned int stream);
+
+/**
+ * Load the run profile from a configuration file.
+ * @param path the path of the configuration file
+ * @return 1 if the configuration file was loaded, 0 otherwise
+ */
+int CrDaProfileLoad(const char* path);
+
+/**
+ * Return the run profile.
+ * @return the run profile
+ */
+const CrDaProfile_t* CrDaProfileGet();
+
+/**
+ * Return the next value of the random generator.
+ * @return a random value uniformly distributed in [0, 1)
+ */
+double CrDaProfileRandom();
+
+#endif /* CRDA_PROFILE_H_ */
@@ -0,0 +1,220 @@
+/**
+ * @file
+ * @ingroup crDemoCommon
+ *
+ * Benchmark of the packet recorder.
+ *
+ * This file provides the main program of the <code>cr_recbench</code> tool which
+ * measures the overhead of recording the packets which cross the socket adapters
+ * (see <code>CrDaPcktRecorder.h</code>).
+ * The tool is called as follows:
+ * <pre>
+ *   cr_recbench [-b burst] [-n cycles] [-s segment]
+ * </pre>
+ * The tool records packets of 16 bytes, 50 bytes and of the maximum packet length in
+ * a capture in a temporary directory.
+ * In each of <code>cycles</code> control cycles (200 by default), it records a burst
+ * of <code>burst</code> packets (1000 by default) and then calls
+ * <code>::CrDaPcktRecorderMaintain</code> as the demo applications do at the end of
+ * their control cycles.
+ * The segment files have a size of <code>segment</code> KB (1024 by default) and the
+ * capture keeps at most 2 closed segments so that the runs exercise the rotation and
+ * the retention of the segments.
+ *
+ * For each packet length, the tool prints the average time per record, the maximum time
+ * of a burst, the average and maximum time of the maintenance function, the number of
+ * records which were dropped because no segment was ready and the number of segments
+ * which were written.
+ * It fails if the capture directory does not hold the segments which the retention
+ * should have kept.
+ *
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the CORDET Framework.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <dirent.h>
+/* Include Framework Files */
+#include "CrFwConstants.h"
+#include "Pckt/CrFwPckt.h"
+/* Include demo application files */
+#include "CrDaPcktRecorder.h"
+#include "CrDaPcktIndex.h"
+#include "CrDaClock.h"
+
+/** The number of packet lengths which are measured */
+#define CR_DA_REC_BENCH_N_OF_LENGTHS 3
+
+/** The default number of packets recorded in each cycle */
+#define CR_DA_REC_BENCH_DEF_BURST 1000
+
+/** The default number of cycles of each measurement */
+#define CR_DA_REC_BENCH_DEF_CYCLES 200
+
+/** The default size of the segment files in KB */
+#define CR_DA_REC_BENCH_DEF_SEGMENT 1024
+
+/** The number of closed segments which are kept by the capture */
+#define CR_DA_REC_BENCH_MAX_SEGMENTS 2
+
+/** The application identifier under which the packets are recorded */
+#define CR_DA_REC_BENCH_APP_ID 1
+
+/**
+ * Delete the files of the capture directory.
+ * @param dir the capture directory
+ * @param nOfSegments the number of segment files which were found (not counting the
+ * index files)
+ */
+static void cleanDir(const char* dir, unsigned int* nOfSegments);
+
+/**
+ * Measure the recording of packets of one length.
+ * @param dir the capture directory
+ * @param len the packet length
+ * @param burst the number of packets recorded in each cycle
+ * @param nOfCycles the number of cycles
+ * @param segmentSize the size of the segment files in bytes
+ * @return 1 if the retention kept the expected segments, 0 otherwise
+ */
+static int run(const char* dir, CrFwPcktLength_t len, unsigned int burst, unsigned int nOfCycles,
+               unsigned long long segmentSize);
+
+/* ---------------------------------------------------------------------------------------------*/
+int main(int argc, char* argv[]) {
+	CrFwPcktLength_t len[CR_DA_REC_BENCH_N_OF_LENGTHS] = {16, 50, 0};
+	unsigned int burst = CR_DA_REC_BENCH_DEF_BURST;
+	unsigned int nOfCycles = CR_DA_REC_BENCH_DEF_CYCLES;
+	unsigned long segment = CR_DA_REC_BENCH_DEF_SEGMENT;
+	char dir[] = "/tmp/cr_recbench.XXXXXX";
+	int opt, i, isOk = 1;
+
+	while ((opt = getopt(argc, argv, "b:n:s:")) != -1) {
+		switch (opt) {
+			case 'b':
+				burst = (unsigned int)strtoul(optarg, NULL, 10);
+				break;
+			case 'n':
+				nOfCycles = (unsigned int)strtoul(optarg, NULL, 10);
+				break;
+			case 's':
+				segment = strtoul(optarg, NULL, 10);
+				break;
+			default:
+				burst = 0;
+				break;
+		}
+	}
+	if ((burst == 0) || (nOfCycles == 0) || (segment == 0) || (optind != argc)) {
+		printf("Usage: %s [-b burst] [-n cycles] [-s segment]\n", argv[0]);
+		return EXIT_FAILURE;
+	}
+	if (mkdtemp(dir) == NULL) {
+		perror("cr_recbench, Create capture directory");
+		return EXIT_FAILURE;
+	}
+
+	len[CR_DA_REC_BENCH_N_OF_LENGTHS-1] = CrFwPcktGetMaxLength();
+	printf("%u packets per cycle, %u cycles, segments of %lu KB\n", burst, nOfCycles, segment);
+	printf("%6s %10s %13s %15s %15s %9s %9s\n", "length", "ns/record", "max burst us",
+	       "maintain us/cyc", "max maintain us", "dropped", "segments");
+	for (i=0; i<CR_DA_REC_BENCH_N_OF_LENGTHS; i++)
+		if (!run(dir, len[i], burst, nOfCycles, (unsigned long long)segment*1024))
+			isOk = 0;
+
+	rmdir(dir);
+	return (isOk ? EXIT_SUCCESS : EXIT_FAILURE);
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static int run(const char* dir, CrFwPcktLength_t len, unsigned int burst, unsigned int nOfCycles,
+               unsigned long long segmentSize) {
+	char basePath[256];
+	CrFwPckt_t pckt;
+	unsigned long long start, burstTime, recTime = 0, maxBurstTime = 0;
+	unsigned long long maintainTime, totMaintainTime = 0, maxMaintainTime = 0;
+	unsigned long long nOfRecorded, recsPerSegment;
+	unsigned int cycle, k, nOfKept, nOfExpected, nOfSegments;
+
+	snprintf(basePath, sizeof(basePath), "%s/cap", dir);
+	pckt = CrFwPcktMake(len);
+	if (pckt == NULL) {
+		printf("cr_recbench: cannot make a packet of %u bytes\n", (unsigned int)len);
+		return 0;
+	}
+	CrFwPcktSetServType(pckt, 3);
+	CrFwPcktSetServSubType(pckt, 25);
+	CrFwPcktSetSrc(pckt, 2);
+	if (!CrDaPcktRecorderOpen(basePath, CR_DA_REC_BENCH_APP_ID, segmentSize, CR_DA_REC_BENCH_MAX_SEGMENTS)) {
+		CrFwPcktRelease(pckt);
+		return 0;
+	}
+
+	for (cycle=0; cycle<nOfCycles; cycle++) {
+		start = CrDaClockGetHostTime();
+		for (k=0; k<burst; k++)
+			CrDaPcktRecorderRecord(((k & 1) ? crDaPcktRecOut : crDaPcktRecIn), 2, pckt);
+		burstTime = CrDaClockGetHostTime() - start;
+		recTime += burstTime;
+		if (burstTime > maxBurstTime)
+			maxBurstTime = burstTime;
+
+		start = CrDaClockGetHostTime();
+		CrDaPcktRecorderMaintain();
+		maintainTime = CrDaClockGetHostTime() - start;
+		totMaintainTime += maintainTime;
+		if (maintainTime > maxMaintainTime)
+			maxMaintainTime = maintainTime;
+	}
+	CrDaPcktRecorderClose();
+	CrFwPcktRelease(pckt);
+
+	/* All segments but the last one are full with the records which were not dropped */
+	nOfRecorded = (unsigned long long)burst*nOfCycles - CrDaPcktRecorderGetNOfDropped();
+	recsPerSegment = (segmentSize - sizeof(CrDaPcktRecSegHeader_t))/CR_DA_REC_SIZE(len);
+	nOfSegments = (nOfRecorded == 0 ? 1 : (unsigned int)((nOfRecorded + recsPerSegment - 1)/recsPerSegment));
+	nOfExpected = (nOfSegments > CR_DA_REC_BENCH_MAX_SEGMENTS+1 ? CR_DA_REC_BENCH_MAX_SEGMENTS+1 : nOfSegments);
+	cleanDir(dir, &nOfKept);
+
+	printf("%6u %10.1f %13.1f %15.1f %15.1f %9lu %9u%s\n", (unsigned int)len,
+	       (double)recTime/((double)burst*nOfCycles), (double)maxBurstTime/1000.0,
+	       (double)totMaintainTime/nOfCycles/1000.0, (double)maxMaintainTime/1000.0,
+	       CrDaPcktRecorderGetNOfDropped(), nOfSegments,
+	       (nOfKept == nOfExpected ? "" : "  RETENTION MISMATCH"));
+	return (nOfKept == nOfExpected);
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static void cleanDir(const char* dir, unsigned int* nOfSegments) {
+	char name[512];
+	DIR* d;
+	struct dirent* entry;
+	size_t nameLen, suffixLen = strlen(CR_DA_IDX_SUFFIX);
+
+	*nOfSegments = 0;
+	d = opendir(dir);
+	if (d == NULL)
+		return;
+	while ((entry = readdir(d)) != NULL) {
+		if (entry->d_name[0] == '.')
+			continue;
+		nameLen = strlen(entry->d_name);
+		if ((nameLen < suffixLen) || (strcmp(entry->d_name+nameLen-suffixLen, CR_DA_IDX_SUFFIX) != 0))
+			(*nOfSegments)++;
+		snprintf(name, sizeof(name), "%s/%s", dir, entry->d_name);
+		unlink(name);
+	}
+	closedir(d);
+}
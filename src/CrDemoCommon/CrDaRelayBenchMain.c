@@ -0,0 +1,431 @@
+/**
+ * @file
+ * @ingroup crDemoCommon
+ *
+ * Benchmark of the packet relay of the Slave 1 Application.
+ *
+ * This file provides the main program of the <code>cr_relaybench</code> tool which
+ * measures the throughput of the relay of the Slave 1 Application and the latency
+ * which it adds to the traffic between the Slave 2 Application and the Master Application
+ * (see the cut-through relay in <code>CrDaServerSocket.h</code>).
+ * The tool is called as follows:
+ * <pre>
+ *   cr_relaybench [-h host] [-P port] [-n packets] [-w window] [-t timeout]
+ * </pre>
+ * The tool connects to the server socket of a running Slave 1 Application (by default
+ * on <code>localhost</code> and on port <code>#CR_DA_SOCKET_PORT</code>) twice: once
+ * as the Slave 2 Application and once as the Master Application.
+ * The Master and Slave 2 Applications must therefore not be running.
+ * It then sends <code>packets</code> temperature violation reports (10000 by default)
+ * from its Slave 2 connection to the Master Application and receives them on its Master
+ * connection.
+ * At most <code>window</code> reports (1 by default) are in transit at any time:
+ * a window of 1 measures the latency of the relay and a large window measures its
+ * throughput.
+ * The other packets which the Master connection receives (e.g. the reports of the Slave 1
+ * Application itself) are discarded.
+ * The benchmark stops when all reports have been received or when no report has been
+ * received for <code>timeout</code> milliseconds (2000 by default); the reports which
+ * have not been received are counted as lost.
+ *
+ * The same measurement is first made over a direct TCP connection on the loopback
+ * interface (the <i>baseline</i>).
+ * The tool prints the throughput and the latency (minimum, average, median, 99th
+ * percentile and maximum) of the baseline and of the relay and the latency which the
+ * relay adds to the baseline.
+ * The Slave 1 Application reads its socket once per control cycle: the latency
+ * of the relay therefore includes the wait for the next cycle and the Slave 1 Application
+ * should be started with a short period (e.g. <code>-p 1</code>) for the benchmark.
+ *
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the CORDET Framework.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <poll.h>
+#include <netdb.h>
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+/* Include demo application files */
+#include "CrDaConstants.h"
+#include "CrDaClock.h"
+/* Include framework files */
+#include "CrFwConstants.h"
+#include "Pckt/CrFwPckt.h"
+
+/** The default number of reports sent by the benchmark */
+#define CR_DA_RELAY_BENCH_DEF_N 10000
+
+/** The default timeout in milliseconds after which the reports in transit are lost */
+#define CR_DA_RELAY_BENCH_DEF_TIMEOUT 2000
+
+/** The length of the reports sent by the benchmark (the parameter is the report number) */
+#define CR_DA_RELAY_BENCH_PCKT_LENGTH (CR_DA_PCKT_PAR_OFFSET+4)
+
+/** The size of the buffer in which the received bytes are framed */
+#define CR_DA_RELAY_BENCH_RX_SIZE 4096
+
+/** The result of a measurement */
+typedef struct {
+	/** The number of reports sent */
+	unsigned long nOfSent;
+	/** The number of reports received */
+	unsigned long nOfRcvd;
+	/** The time from the first send to the last receive in nanoseconds */
+	unsigned long long elapsed;
+	/** The minimum latency in nanoseconds */
+	unsigned long long min;
+	/** The average latency in nanoseconds */
+	unsigned long long avg;
+	/** The median latency in nanoseconds */
+	unsigned long long p50;
+	/** The 99th percentile of the latency in nanoseconds */
+	unsigned long long p99;
+	/** The maximum latency in nanoseconds */
+	unsigned long long max;
+} CrDaRelayBenchRes_t;
+
+/** The report which is sent (the report number is written in its parameter area) */
+static unsigned char txPckt[CR_DA_RELAY_BENCH_PCKT_LENGTH];
+
+/**
+ * Build the report which is sent by the benchmark.
+ * @return 1 if the report was built, 0 otherwise
+ */
+static int buildPckt();
+
+/**
+ * Open the two connections of the baseline over the loopback interface.
+ * @param txFd the connection on which the reports are sent
+ * @param rxFd the connection on which the reports are received
+ * @return 1 if the connections were opened, 0 otherwise
+ */
+static int openBaseline(int* txFd, int* rxFd);
+
+/**
+ * Connect to the server socket of the Slave 1 Application as a client and send the
+ * hello message of the client.
+ * @param host the host of the Slave 1 Application
+ * @param port the port of the server socket
+ * @param appId the identifier of the application as which the tool connects
+ * @return the connection or -1 if the connection failed
+ */
+static int openClient(const char* host, int port, unsigned char appId);
+
+/**
+ * Send the reports on one connection and receive them on the other.
+ * @param txFd the connection on which the reports are sent
+ * @param rxFd the connection on which the reports are received
+ * @param n the number of reports
+ * @param window the maximum number of reports in transit
+ * @param timeout the timeout in milliseconds
+ * @param res the result of the measurement
+ */
+static void run(int txFd, int rxFd, unsigned long n, unsigned long window, int timeout,
+                CrDaRelayBenchRes_t* res);
+
+/**
+ * Print the result of a measurement.
+ * @param name the name of the measurement
+ * @param res the result
+ */
+static void printRes(const char* name, CrDaRelayBenchRes_t* res);
+
+/**
+ * Compare two latencies (for <code>qsort</code>).
+ * @param a the first latency
+ * @param b the second latency
+ * @return a negative, zero or positive value as the first latency is smaller than,
+ * equal to or larger than the second
+ */
+static int cmpLatency(const void* a, const void* b);
+
+/* ---------------------------------------------------------------------------------------------*/
+int main(int argc, char* argv[]) {
+	const char* host = "localhost";
+	int port = CR_DA_SOCKET_PORT;
+	unsigned long n = CR_DA_RELAY_BENCH_DEF_N;
+	unsigned long window = 1;
+	int timeout = CR_DA_RELAY_BENCH_DEF_TIMEOUT;
+	int opt, txFd, rxFd;
+	CrDaRelayBenchRes_t base, relay;
+
+	while ((opt = getopt(argc, argv, "h:P:n:w:t:")) != -1) {
+		switch (opt) {
+			case 'h':
+				host = optarg;
+				break;
+			case 'P':
+				port = atoi(optarg);
+				break;
+			case 'n':
+				n = strtoul(optarg, NULL, 10);
+				break;
+			case 'w':
+				window = strtoul(optarg, NULL, 10);
+				break;
+			case 't':
+				timeout = atoi(optarg);
+				break;
+			default:
+				n = 0;
+				break;
+		}
+	}
+	if ((n == 0) || (window == 0) || (timeout <= 0) || (optind != argc)) {
+		printf("Usage: %s [-h host] [-P port] [-n packets] [-w window] [-t timeout]\n", argv[0]);
+		return EXIT_FAILURE;
+	}
+	if (!buildPckt()) {
+		printf("cr_relaybench: cannot build the report\n");
+		return EXIT_FAILURE;
+	}
+
+	/* Baseline: direct connection over the loopback interface */
+	if (!openBaseline(&txFd, &rxFd))
+		return EXIT_FAILURE;
+	run(txFd, rxFd, n, window, timeout, &base);
+	close(txFd);
+	close(rxFd);
+
+	/* Relay: Slave 2 to Master through the Slave 1 Application */
+	rxFd = openClient(host, port, CR_DA_MASTER);
+	if (rxFd < 0)
+		return EXIT_FAILURE;
+	txFd = openClient(host, port, CR_DA_SLAVE_2);
+	if (txFd < 0) {
+		close(rxFd);
+		return EXIT_FAILURE;
+	}
+	run(txFd, rxFd, n, window, timeout, &relay);
+	close(txFd);
+	close(rxFd);
+
+	printf("%-9s %8s %8s %10s %9s %9s %9s %9s %9s\n", "", "sent", "lost", "pckt/s",
+	       "min us", "avg us", "p50 us", "p99 us", "max us");
+	printRes("baseline", &base);
+	printRes("relay", &relay);
+	printf("Latency added by the relay: avg %.1f us, p50 %.1f us, p99 %.1f us\n",
+	       ((double)relay.avg - (double)base.avg)/1000.0, ((double)relay.p50 - (double)base.p50)/1000.0,
+	       ((double)relay.p99 - (double)base.p99)/1000.0);
+	return (relay.nOfRcvd == relay.nOfSent ? EXIT_SUCCESS : EXIT_FAILURE);
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static int buildPckt() {
+	CrFwPckt_t pckt;
+
+	pckt = CrFwPcktMake(CR_DA_RELAY_BENCH_PCKT_LENGTH);
+	if (pckt == NULL)
+		return 0;
+	CrFwPcktSetCmdRepType(pckt, crRepType);
+	CrFwPcktSetServType(pckt, CR_DA_SERV_TYPE);
+	CrFwPcktSetServSubType(pckt, CR_DA_SERV_SUBTYPE_REP);
+	CrFwPcktSetDiscriminant(pckt, 0);
+	CrFwPcktSetSrc(pckt, CR_DA_SLAVE_2);
+	CrFwPcktSetDest(pckt, CR_DA_MASTER);
+	CrFwPcktSetGroup(pckt, 0);
+	CrFwPcktSetSeqCnt(pckt, 0);
+	memcpy(txPckt, pckt, CR_DA_RELAY_BENCH_PCKT_LENGTH);
+	CrFwPcktRelease(pckt);
+	return 1;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static int openBaseline(int* txFd, int* rxFd) {
+	struct sockaddr_in addr;
+	socklen_t addrLen = sizeof(addr);
+	int listenFd, noDelay = 1;
+
+	listenFd = socket(AF_INET, SOCK_STREAM, 0);
+	if (listenFd < 0) {
+		perror("cr_relaybench, Socket creation");
+		return 0;
+	}
+	memset(&addr, 0, sizeof(addr));
+	addr.sin_family = AF_INET;
+	addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+	addr.sin_port = 0;
+	if ((bind(listenFd, (struct sockaddr*)&addr, sizeof(addr)) < 0) || (listen(listenFd, 1) < 0) ||
+	        (getsockname(listenFd, (struct sockaddr*)&addr, &addrLen) < 0)) {
+		perror("cr_relaybench, Listen on loopback interface");
+		close(listenFd);
+		return 0;
+	}
+	*txFd = socket(AF_INET, SOCK_STREAM, 0);
+	if ((*txFd < 0) || (connect(*txFd, (struct sockaddr*)&addr, sizeof(addr)) < 0)) {
+		perror("cr_relaybench, Connect on loopback interface");
+		close(listenFd);
+		return 0;
+	}
+	*rxFd = accept(listenFd, NULL, NULL);
+	close(listenFd);
+	if (*rxFd < 0) {
+		perror("cr_relaybench, Accept on loopback interface");
+		close(*txFd);
+		return 0;
+	}
+	setsockopt(*txFd, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay));
+	setsockopt(*rxFd, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay));
+	return 1;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static int openClient(const char* host, int port, unsigned char appId) {
+	struct addrinfo hints, *res;
+	unsigned char hello[CR_DA_SOCKET_HELLO_LENGTH];
+	char service[16];
+	int fd, noDelay = 1;
+
+	memset(&hints, 0, sizeof(hints));
+	hints.ai_family = AF_INET;
+	hints.ai_socktype = SOCK_STREAM;
+	snprintf(service, sizeof(service), "%d", port);
+	if (getaddrinfo(host, service, &hints, &res) != 0) {
+		printf("cr_relaybench: unknown host %s\n", host);
+		return -1;
+	}
+	fd = socket(res->ai_family, res->ai_socktype, res->ai_protocol);
+	if ((fd < 0) || (connect(fd, res->ai_addr, res->ai_addrlen) < 0)) {
+		perror("cr_relaybench, Connect to the Slave 1 Application");
+		freeaddrinfo(res);
+		if (fd >= 0)
+			close(fd);
+		return -1;
+	}
+	freeaddrinfo(res);
+	setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay));
+
+	hello[0] = CR_DA_SOCKET_HELLO_LENGTH;
+	hello[1] = appId;
+	if (send(fd, hello, CR_DA_SOCKET_HELLO_LENGTH, MSG_NOSIGNAL) != CR_DA_SOCKET_HELLO_LENGTH) {
+		perror("cr_relaybench, Send hello message");
+		close(fd);
+		return -1;
+	}
+	return fd;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static void run(int txFd, int rxFd, unsigned long n, unsigned long window, int timeout,
+                CrDaRelayBenchRes_t* res) {
+	unsigned long long* sendTime = malloc(n*sizeof(unsigned long long));
+	unsigned long long* latency = malloc(n*sizeof(unsigned long long));
+	unsigned char rxBuffer[CR_DA_RELAY_BENCH_RX_SIZE];
+	unsigned char* p;
+	int rxStart = 0, rxEnd = 0;
+	unsigned long long start, now, total = 0;
+	unsigned int nr;
+	unsigned long i;
+	struct pollfd pfd;
+	int k;
+
+	memset(res, 0, sizeof(*res));
+	if ((sendTime == NULL) || (latency == NULL)) {
+		free(sendTime);
+		free(latency);
+		return;
+	}
+	start = CrDaClockGetHostTime();
+	now = start;
+	while (res->nOfRcvd < n) {
+		/* Send the reports which fit in the window */
+		while ((res->nOfSent < n) && (res->nOfSent - res->nOfRcvd < window)) {
+			nr = (unsigned int)res->nOfSent;
+			memcpy(txPckt+CR_DA_PCKT_PAR_OFFSET, &nr, sizeof(nr));
+			CrFwPcktSetSeqCnt((CrFwPckt_t)txPckt, (CrFwSeqCnt_t)(nr+1));
+			sendTime[nr] = CrDaClockGetHostTime();
+			if (send(txFd, txPckt, CR_DA_RELAY_BENCH_PCKT_LENGTH, MSG_NOSIGNAL) != CR_DA_RELAY_BENCH_PCKT_LENGTH) {
+				perror("cr_relaybench, Send report");
+				n = res->nOfSent;
+				break;
+			}
+			res->nOfSent++;
+		}
+
+		/* Wait for the next bytes */
+		pfd.fd = rxFd;
+		pfd.events = POLLIN;
+		if (poll(&pfd, 1, timeout) <= 0)
+			break;	/* the reports in transit are lost */
+		if (rxStart > 0) {
+			memmove(rxBuffer, rxBuffer+rxStart, rxEnd-rxStart);
+			rxEnd -= rxStart;
+			rxStart = 0;
+		}
+		k = (int)recv(rxFd, rxBuffer+rxEnd, CR_DA_RELAY_BENCH_RX_SIZE-rxEnd, 0);
+		if (k <= 0) {
+			printf("cr_relaybench: connection closed\n");
+			break;
+		}
+		rxEnd += k;
+		now = CrDaClockGetHostTime();
+
+		/* Frame the received packets and match the reports of the benchmark */
+		while (rxEnd - rxStart > 0) {
+			p = rxBuffer + rxStart;
+			if (p[0] == 0) {
+				printf("cr_relaybench: invalid packet received\n");
+				rxStart = rxEnd;
+				break;
+			}
+			if (rxEnd - rxStart < p[0])
+				break;
+			rxStart += p[0];
+			if ((p[0] != CR_DA_RELAY_BENCH_PCKT_LENGTH) || (CrFwPcktGetSrc((CrFwPckt_t)p) != CR_DA_SLAVE_2) ||
+			        (CrFwPcktGetServType((CrFwPckt_t)p) != CR_DA_SERV_TYPE))
+				continue;
+			memcpy(&nr, p+CR_DA_PCKT_PAR_OFFSET, sizeof(nr));
+			if (nr >= res->nOfSent)
+				continue;
+			latency[res->nOfRcvd] = now - sendTime[nr];
+			total += latency[res->nOfRcvd];
+			res->nOfRcvd++;
+		}
+	}
+
+	res->elapsed = now - start;
+	if (res->nOfRcvd > 0) {
+		qsort(latency, res->nOfRcvd, sizeof(unsigned long long), &cmpLatency);
+		res->min = latency[0];
+		res->avg = total/res->nOfRcvd;
+		res->p50 = latency[res->nOfRcvd/2];
+		i = (res->nOfRcvd*99)/100;
+		res->p99 = latency[(i < res->nOfRcvd ? i : res->nOfRcvd-1)];
+		res->max = latency[res->nOfRcvd-1];
+	}
+	free(sendTime);
+	free(latency);
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static void printRes(const char* name, CrDaRelayBenchRes_t* res) {
+	double rate = (res->elapsed > 0 ? (double)res->nOfRcvd*1e9/(double)res->elapsed : 0.0);
+
+	printf("%-9s %8lu %8lu %10.0f %9.1f %9.1f %9.1f %9.1f %9.1f\n", name, res->nOfSent,
+	       res->nOfSent - res->nOfRcvd, rate, res->min/1000.0, res->avg/1000.0, res->p50/1000.0,
+	       res->p99/1000.0, res->max/1000.0);
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static int cmpLatency(const void* a, const void* b) {
+	unsigned long long x = *(const unsigned long long*)a;
+	unsigned long long y = *(const unsigned long long*)b;
+
+	return (x > y) - (x < y);
+}
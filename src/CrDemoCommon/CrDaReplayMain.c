@@ -0,0 +1,201 @@
+/**
+ * @file
+ * @ingroup crDemoCommon
+ *
+ * Replay driver for the demo applications.
+ *
+ * This file provides the main program of the replay version of a demo application.
+ * The replay version is built by compiling the framework, the application
+ * configuration and this file with <code>CR_DA_REPLAY</code> defined (see the
+ * <code>replay</code> option of the application build scripts).
+ * In the replay version, the InStreams collect their packets from a packet capture
+ * through the functions of <code>CrDaPcktReplay.h</code> and the OutStreams discard
+ * their packets: no socket is opened.
+ *
+ * The replay driver is called as follows:
+ * <pre>
+ *   cr_xxx_replay [-f] capturePath [appId]
+ * </pre>
+ * where <code>capturePath</code> is the base path of a capture written by the packet
+ * recorder (see <code>CrDaPcktRecorder.h</code>) and <code>appId</code> is the
+ * identifier of the application which recorded it (by default, the host application).
+ * Without the <code>-f</code> option, the packets are replayed with the timing with
+ * which they were recorded.
+ * With the <code>-f</code> option, they are replayed as fast as the application can
+ * ingest them: this measures the maximum ingest throughput of the InLoader and
+ * InManagers of the application independently of the network.
+ *
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the CORDET Framework.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+/* Include demo application files */
+#include "CrDaConstants.h"
+#include "CrDaPcktReplay.h"
+/* Include FW Profile files */
+#include "FwSmConstants.h"
+#include "FwSmConfig.h"
+#include "FwSmCore.h"
+/* Include framework files */
+#include "Aux/CrFwAux.h"
+#include "BaseCmp/CrFwBaseCmp.h"
+#include "OutFactory/CrFwOutFactory.h"
+#include "OutLoader/CrFwOutLoader.h"
+#include "OutManager/CrFwOutManager.h"
+#include "OutRegistry/CrFwOutRegistry.h"
+#include "OutStream/CrFwOutStream.h"
+#include "InFactory/CrFwInFactory.h"
+#include "InLoader/CrFwInLoader.h"
+#include "InManager/CrFwInManager.h"
+#include "InRegistry/CrFwInRegistry.h"
+#include "InStream/CrFwInStream.h"
+#include "UtilityFunctions/CrFwUtilityFunctions.h"
+/* Include configuration files */
+#include "CrFwInStreamUserPar.h"
+#include "CrFwOutStreamUserPar.h"
+#include "CrFwInManagerUserPar.h"
+#include "CrFwOutManagerUserPar.h"
+
+/**
+ * Initialize and reset a framework component.
+ * @param cmp the component
+ * @return 1 if the component is in state CONFIGURED, 0 otherwise
+ */
+static CrFwBool_t startCmp(FwSmDesc_t cmp);
+
+/**
+ * Main program of the replay driver.
+ * This Main Program performs the following actions:
+ * - It checks the consistency of the configuration parameters using
+ *   <code>::CrFwAuxConfigCheck</code>.
+ * - It opens the packet capture.
+ * - It initializes and configures the InStreams, the OutStreams and all other
+ *   framework components used by the application.
+ * - It executes a loop until all the packets in the capture have been served.
+ *   In every cycle of the loop, the InStreams are notified of the available packets
+ *   through <code>::CrDaPcktReplayPoll</code>, the InLoader is executed on all
+ *   InStreams and then all InManagers and OutManagers are executed.
+ * - It reports the number of packets which were replayed and the replay throughput.
+ * .
+ * @param argc the number of command line arguments
+ * @param argv the command line arguments
+ * @return EXIT_SUCCESS if the capture was replayed, EXIT_FAILURE otherwise
+ */
+int main(int argc, char* argv[]) {
+	FwSmDesc_t inStream[CR_FW_NOF_INSTREAM];
+	CrFwConfigCheckOutcome_t configCheckOutcome;
+	CrDaPcktReplayMode_t mode = crDaPcktReplayAsRecorded;
+	CrFwDestSrc_t appId = CR_FW_HOST_APP_ID;
+	const char* capturePath = NULL;
+	struct timespec startTime, endTime;
+	unsigned long nOfCycles = 0;
+	double elapsed;
+	int i;
+
+	/* Parse command line */
+	for (i=1; i<argc; i++) {
+		if (strcmp(argv[i], "-f") == 0)
+			mode = crDaPcktReplayAsFast;
+		else if (capturePath == NULL)
+			capturePath = argv[i];
+		else
+			appId = (CrFwDestSrc_t)atoi(argv[i]);
+	}
+	if (capturePath == NULL) {
+		printf("Usage: %s [-f] capturePath [appId]\n", argv[0]);
+		return EXIT_FAILURE;
+	}
+
+	/* Check consistency of configuration parameters */
+	configCheckOutcome = CrFwAuxConfigCheck();
+	if (configCheckOutcome != crConsistencyCheckSuccess) {
+		printf("RP: Consistency check of configuration parameters failed with outcome %d\n",
+		       configCheckOutcome);
+		return EXIT_FAILURE;
+	}
+
+	/* Open the capture */
+	if (!CrDaPcktReplayOpen(capturePath, appId, mode))
+		return EXIT_FAILURE;
+
+	/* Initialize and configure the InStreams and OutStreams */
+	for (i=0; i<CR_FW_NOF_INSTREAM; i++) {
+		inStream[i] = CrFwInStreamMake((CrFwInstanceId_t)i);
+		if (!startCmp(inStream[i]))
+			return EXIT_FAILURE;
+	}
+	for (i=0; i<CR_FW_NOF_OUTSTREAM; i++)
+		if (!startCmp(CrFwOutStreamMake((CrFwInstanceId_t)i)))
+			return EXIT_FAILURE;
+
+	/* Initialize and configure the other framework components */
+	if (!startCmp(CrFwOutFactoryMake()) || !startCmp(CrFwInFactoryMake()) ||
+	        !startCmp(CrFwInLoaderMake()) || !startCmp(CrFwInRegistryMake()) ||
+	        !startCmp(CrFwOutLoaderMake()) || !startCmp(CrFwOutRegistryMake()))
+		return EXIT_FAILURE;
+	for (i=0; i<CR_FW_NOF_INMANAGER; i++)
+		if (!startCmp(CrFwInManagerMake((CrFwInstanceId_t)i)))
+			return EXIT_FAILURE;
+	for (i=0; i<CR_FW_NOF_OUTMANAGER; i++)
+		if (!startCmp(CrFwOutManagerMake((CrFwInstanceId_t)i)))
+			return EXIT_FAILURE;
+
+	printf("RP: Replaying capture %s of application %u %s\n", capturePath, appId,
+	       (mode == crDaPcktReplayAsFast) ? "as fast as possible" : "as recorded");
+
+	/* Execute replay cycles */
+	clock_gettime(CLOCK_MONOTONIC, &startTime);
+	while (!CrDaPcktReplayIsAtEnd()) {
+		CrDaPcktReplayWait();
+		CrDaPcktReplayPoll();
+
+		/* Load packets from the InStreams */
+		for (i=0; i<CR_FW_NOF_INSTREAM; i++) {
+			CrFwInLoaderSetInStream(inStream[i]);
+			FwSmExecute(CrFwInLoaderMake());
+		}
+
+		/* Execute Managers */
+		for (i=0; i<CR_FW_NOF_INMANAGER; i++)
+			FwSmExecute(CrFwInManagerMake((CrFwInstanceId_t)i));
+		for (i=0; i<CR_FW_NOF_OUTMANAGER; i++)
+			FwSmExecute(CrFwOutManagerMake((CrFwInstanceId_t)i));
+
+		nOfCycles++;
+	}
+	clock_gettime(CLOCK_MONOTONIC, &endTime);
+	CrDaPcktReplayClose();
+
+	/* Report replay statistics */
+	elapsed = (double)(endTime.tv_sec - startTime.tv_sec) + (double)(endTime.tv_nsec - startTime.tv_nsec)/1e9;
+	printf("RP: Replayed %lu packets in %lu cycles and %.6f s (%.0f packets/s)\n",
+	       CrDaPcktReplayGetNOfCollected(), nOfCycles, elapsed,
+	       (elapsed > 0) ? (double)CrDaPcktReplayGetNOfCollected()/elapsed : 0.0);
+	printf("RP: Discarded %lu packets handed over to the OutStreams\n", CrDaPcktReplayGetNOfHandedOver());
+	if (CrFwGetAppErrCode() != crNoAppErr)
+		printf("RP: Application Error Code is set and is equal to: %d\n", CrFwGetAppErrCode());
+
+	return EXIT_SUCCESS;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static CrFwBool_t startCmp(FwSmDesc_t cmp) {
+	CrFwCmpInit(cmp);
+	if (!CrFwCmpIsInInitialized(cmp))
+		return 0;
+	CrFwCmpReset(cmp);
+	return CrFwCmpIsInConfigured(cmp);
+}
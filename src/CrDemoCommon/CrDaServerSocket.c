@@ -0,0 +1,663 @@
+/**
+ * @file
+ * @ingroup crDemoCommon
+ * Implementation of interface to server socket.
+ *
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the CORDET Framework.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <errno.h>
+#include "CrDaServerSocket.h"
+#include "CrDaConstants.h"
+#include "CrDaPcktRecorder.h"
+#include "CrDaStats.h"
+#include "CrDaBackpressure.h"
+#include "CrDaTrace.h"
+/* Include FW Profile files */
+#include "FwSmConstants.h"
+#include "FwSmConfig.h"
+#include "FwSmCore.h"
+#include "FwPrConfig.h"
+#include "FwPrCore.h"
+#include "FwPrConstants.h"
+/* Include configuration files */
+#include "CrFwOutStreamUserPar.h"
+#include "CrFwCmpData.h"
+/* Include framework files */
+#include "InStream/CrFwInStream.h"
+#include "OutStream/CrFwOutStream.h"
+#include "BaseCmp/CrFwBaseCmp.h"
+#include "Pckt/CrFwPckt.h"
+#include "CrFwTime.h"
+#include "CrFwRepErr.h"
+#include "UtilityFunctions/CrFwUtilityFunctions.h"
+/* Include file for socket implementation */
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <string.h>
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <netdb.h>
+#include <fcntl.h>
+#include <errno.h>
+
+/** Set the port number (must be same as the port number specified in <code>CrDaServerSocket.c</code> */
+static int portno = 0;
+
+/** The file descriptors for the socket */
+static int sockfd = 0;
+
+/**
+ * The file descriptors for the client sockets of the Master Application (first element) and
+ * of the Slave 2 Application (second element) or -1 if the client socket is not connected
+ */
+static int newsockfd[2] = {-1, -1};
+
+/** The file descriptors of the accepted connections whose hello message has not yet arrived (or -1) */
+static int pendingfd[CR_DA_SOCKET_N_OF_PENDING];
+
+/** The instance identifiers of the OutStreams which use the server socket */
+static CrFwInstanceId_t outStreamIds[CR_DA_SOCKET_MAX_N_OF_OUTSTREAMS];
+
+/** The number of OutStreams which use the server socket */
+static int nOfOutStreams = 0;
+
+/** The maximum size of an incoming packet */
+static int pcktMaxLength;
+
+/** The Framing Buffers (one for each client) */
+static unsigned char frameBuffer[2][CR_DA_SOCKET_FRAME_BUFFER_SIZE];
+
+/** The offsets in the Framing Buffers of the first byte which has not yet been consumed */
+static int frameStart[2];
+
+/** The offsets in the Framing Buffers of the first byte which has not yet been filled */
+static int frameEnd[2];
+
+/** The Send Tails (one for each client): the bytes of the last packet which the client socket has not yet accepted */
+static unsigned char sendTail[2][CR_DA_SOCKET_SEND_TAIL_SIZE];
+
+/** The number of bytes in the Send Tails */
+static int sendTailLength[2];
+
+/**
+ * For each client, the sources of the packets to the client which have fallen back to the
+ * InStream since cut-through was last allowed (bit <code>1 << src</code> is set for source
+ * <code>src</code>): the cut-through relay to the client is suspended while this is not zero.
+ */
+static unsigned int fallbackSrcs[2];
+
+/**
+ * Accept the pending connections on the listening socket and identify the clients
+ * of the accepted connections from their hello message (see <code>#CR_DA_SOCKET_HELLO_LENGTH</code>).
+ * When a client is identified, its connection replaces any previous connection of the
+ * same client and the OutStreams which use the server socket are notified through
+ * <code>::CrFwOutStreamConnectionAvail</code> so that they hand over the packets which they
+ * have buffered while the client was not connected.
+ */
+static void serverSocketAccept();
+
+/**
+ * Close the connection of one of the two clients.
+ * @param i the index of the client (0 for the Master Application, 1 for the Slave 2 Application)
+ */
+static void serverSocketClose(int i);
+
+/**
+ * Return the packet at the head of the Framing Buffer of one of the two clients.
+ * The complete packets at the head of the Framing Buffer which are not destined to the
+ * host application are first relayed to their destination (see <code>serverSocketRelay</code>).
+ * If the packet at the head of the Framing Buffer is incomplete, one non-blocking read
+ * is made from the socket of the client.
+ * @param i the index of the client
+ * @return the packet at the head of the Framing Buffer or NULL if no complete packet is available
+ */
+static unsigned char* serverSocketHeadPckt(int i);
+
+/**
+ * Relay a packet which is not destined to the host application straight from the Framing
+ * Buffer to the connection of its destination.
+ * The packet is not relayed if its destination is not one of the clients, if the client
+ * is not connected or if its socket cannot accept the packet: the packet is then processed
+ * by the InStream like the packets destined to the host application and the framework
+ * re-routes it to the OutStream of its destination.
+ * @param pckt the packet at the head of a Framing Buffer
+ * @return 1 if the packet was relayed (and must be removed from the Framing Buffer); 0 otherwise
+ */
+static int serverSocketRelay(unsigned char* pckt);
+
+/**
+ * Check whether the packets to one of the two clients which have fallen back to the InStream
+ * have all been handed over to its socket and, if so, allow the cut-through relay to the
+ * client again.
+ * The packets have been handed over when the InStreams of their sources and the OutStream
+ * of the client hold no packets.
+ * @param i the index of the client
+ * @param dest the identifier of the client
+ * @return 1 if the cut-through relay to the client is allowed; 0 otherwise
+ */
+static int isFallbackDrained(int i, CrFwDestSrc_t dest);
+
+/**
+ * Send the bytes of the Send Tail of one of the two clients which its socket accepts.
+ * @param i the index of the client
+ * @return 1 if the Send Tail is empty; 0 otherwise
+ */
+static int flushSendTail(int i);
+
+/**
+ * Take over the bytes of a packet which the socket of a client has not accepted into
+ * the Send Tail of the client.
+ * @param i the index of the client
+ * @param pckt the packet
+ * @param n the number of bytes of the packet which the socket has accepted
+ */
+static void holdSendTail(int i, unsigned char* pckt, int n);
+
+/**
+ * Poll the socket for data from one of the two clients.
+ * @param i the index of the client which is to be polled
+ */
+static void serverSocketPoll(int i);
+
+/**
+ * Check whether a packet from the argument source is available.
+ * @param src the source
+ * @param i the index of the client which is to be polled
+ * @return 1 if a packet is avaiable; 0 otherwise
+ */
+static CrFwBool_t serverSocketIsPcktAvail(CrFwDestSrc_t src, int i);
+
+/**
+ * Collect a packet from the argument source.
+ * @param src the source
+ * @param i the index of the client from which the packet is read
+ * @return the packet collected from the argument source
+ */
+static CrFwPckt_t serverSocketPcktCollect(CrFwDestSrc_t src, int i);
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaServerSocketInitAction(FwPrDesc_t prDesc) {
+	CrFwCmpData_t* streamData = (CrFwCmpData_t*)FwPrGetData(prDesc);
+	struct sockaddr_in serv_addr;
+	int flags, i;
+	int reuse = 1;
+
+	/* Register the OutStream so that it can be notified when a client connects */
+	if (streamData->typeId == CR_FW_OUTSTREAM_TYPE) {
+		for (i=0; i<nOfOutStreams; i++)
+			if (outStreamIds[i] == streamData->instanceId)
+				break;
+		if ((i == nOfOutStreams) && (nOfOutStreams < CR_DA_SOCKET_MAX_N_OF_OUTSTREAMS))
+			outStreamIds[nOfOutStreams++] = streamData->instanceId;
+	}
+
+	/* Check if server socket has already been initialized */
+	if (sockfd != 0) {
+		if (streamData->typeId == CR_FW_INSTREAM_TYPE)
+			CrFwInStreamDefInitAction(prDesc);
+		else
+			CrFwOutStreamDefInitAction(prDesc);
+		return;
+	}
+
+	pcktMaxLength = (int)CrFwPcktGetMaxLength();
+	newsockfd[0] = -1;
+	newsockfd[1] = -1;
+	for (i=0; i<CR_DA_SOCKET_N_OF_PENDING; i++)
+		pendingfd[i] = -1;
+
+	/* Create the socket */
+	sockfd = socket(AF_INET, SOCK_STREAM, 0);
+	if (sockfd < 0) {
+		perror("CrDaServerSocketInitAction, Socket creation");
+		streamData->outcome = 0;
+		return;
+	}
+
+	/* Allow a restarted server to bind to the port while old connections are closing */
+	setsockopt(sockfd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+
+	/* Set the socket to non-blocking mode (connections are accepted by the poll function) */
+	flags = fcntl(sockfd, F_GETFL, 0);
+	if ((flags < 0) || (fcntl(sockfd, F_SETFL, flags | O_NONBLOCK) < 0)) {
+		perror("CrDaServerSocketInitAction, Set socket attributes");
+		streamData->outcome = 0;
+		return;
+	}
+
+	bzero((char*) &serv_addr, sizeof(serv_addr));
+	serv_addr.sin_family = AF_INET;
+	serv_addr.sin_addr.s_addr = INADDR_ANY;
+	serv_addr.sin_port = htons(portno);
+	if (bind(sockfd, (struct sockaddr*) &serv_addr, sizeof(serv_addr)) < 0) {
+		perror("CrDaServerSocketInitAction, Bind Socket");
+		streamData->outcome = 0;
+		return;
+	}
+	listen(sockfd,5);
+
+	/* Execute default initialization action for OutStream/InStream */
+	if (streamData->typeId == CR_FW_INSTREAM_TYPE)
+		CrFwInStreamDefInitAction(prDesc);
+	else
+		CrFwOutStreamDefInitAction(prDesc);
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaServerSocketShutdownAction(FwSmDesc_t smDesc) {
+	CrFwCmpData_t* streamData = (CrFwCmpData_t*)FwSmGetData(smDesc);
+	int i;
+
+	if (streamData->typeId == CR_FW_INSTREAM_TYPE)
+		CrFwInStreamDefShutdownAction(smDesc);
+	else
+		CrFwOutStreamDefShutdownAction(smDesc);
+
+	if (sockfd != 0) {
+		if (newsockfd[0] >= 0)
+			close(newsockfd[0]);
+		if (newsockfd[1] >= 0)
+			close(newsockfd[1]);
+		newsockfd[0] = -1;
+		newsockfd[1] = -1;
+		for (i=0; i<CR_DA_SOCKET_N_OF_PENDING; i++)
+			if (pendingfd[i] >= 0)
+				close(pendingfd[i]);
+		close(sockfd);
+		sockfd = 0;
+		nOfOutStreams = 0;
+	}
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaServerSocketConfigAction(FwPrDesc_t prDesc) {
+	CrFwCmpData_t* streamData = (CrFwCmpData_t*)FwPrGetData(prDesc);
+
+	/* Clear Framing Buffers */
+	frameStart[0] = 0;
+	frameEnd[0] = 0;
+	frameStart[1] = 0;
+	frameEnd[1] = 0;
+
+	if (streamData->typeId == CR_FW_INSTREAM_TYPE)
+		CrFwInStreamDefConfigAction(prDesc);
+	else
+		CrFwOutStreamDefConfigAction(prDesc);
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaServerSocketPoll() {
+	int i, j;
+
+	serverSocketAccept();
+
+	/* Complete the sends of the last packets and let the OutStreams hand over the packets they buffered meanwhile */
+	for (i=0; i<2; i++)
+		if ((sendTailLength[i] > 0) && flushSendTail(i))
+			for (j=0; j<nOfOutStreams; j++)
+				CrFwOutStreamConnectionAvail(CrFwOutStreamMake(outStreamIds[j]));
+
+	serverSocketPoll(0);
+	serverSocketPoll(1);
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static void serverSocketAccept() {
+	unsigned char hello[CR_DA_SOCKET_HELLO_LENGTH];
+	int fd, flags, i, j, n;
+	int noDelay = 1;
+
+	/* Accept the pending connections */
+	for (;;) {
+		CrDaTraceBegin("accept", -1);
+		fd = accept(sockfd, NULL, NULL);
+		CrDaTraceEnd("accept");
+		if (fd < 0)
+			break;
+		flags = fcntl(fd, F_GETFL, 0);
+		if ((flags < 0) || (fcntl(fd, F_SETFL, flags | O_NONBLOCK) < 0)) {
+			perror("CrDaServerSocketPoll, Set socket attributes");
+			close(fd);
+			continue;
+		}
+		/* Relayed packets are small and must not wait for the acknowledgement of earlier ones */
+		setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay));
+		for (i=0; i<CR_DA_SOCKET_N_OF_PENDING; i++)
+			if (pendingfd[i] < 0)
+				break;
+		if (i == CR_DA_SOCKET_N_OF_PENDING) {
+			close(fd);
+			continue;
+		}
+		pendingfd[i] = fd;
+	}
+
+	/* Identify the clients of the accepted connections from their hello message */
+	for (i=0; i<CR_DA_SOCKET_N_OF_PENDING; i++) {
+		if (pendingfd[i] < 0)
+			continue;
+		CrDaTraceBegin("recv", -1);
+		n = recv(pendingfd[i], hello, CR_DA_SOCKET_HELLO_LENGTH, MSG_PEEK);
+		CrDaTraceEnd("recv");
+		if ((n < 0) && ((errno == EAGAIN) || (errno == EWOULDBLOCK)))
+			continue;	/* the hello message has not yet arrived */
+		if ((n > 0) && (n < CR_DA_SOCKET_HELLO_LENGTH))
+			continue;	/* the hello message has only partially arrived */
+		if ((n != CR_DA_SOCKET_HELLO_LENGTH) || (hello[0] != CR_DA_SOCKET_HELLO_LENGTH) ||
+		        ((hello[1] != CR_DA_MASTER) && (hello[1] != CR_DA_SLAVE_2))) {
+			printf("CrDaServerSocketPoll: invalid hello message from client socket\n");
+			close(pendingfd[i]);
+			pendingfd[i] = -1;
+			continue;
+		}
+		n = read(pendingfd[i], hello, CR_DA_SOCKET_HELLO_LENGTH);
+		j = (hello[1] == CR_DA_MASTER ? 0 : 1);
+		serverSocketClose(j);
+		newsockfd[j] = pendingfd[i];
+		pendingfd[i] = -1;
+		if (j == 0)
+			printf("S1: Client socket in Master Application successfully connected.\n");
+		else
+			printf("S1: Client socket in Slave 2 Application successfully connected.\n");
+
+		/* Let the OutStreams hand over the packets they buffered while the client was not connected */
+		for (n=0; n<nOfOutStreams; n++)
+			CrFwOutStreamConnectionAvail(CrFwOutStreamMake(outStreamIds[n]));
+	}
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static void serverSocketClose(int i) {
+	if (newsockfd[i] < 0)
+		return;
+	close(newsockfd[i]);
+	newsockfd[i] = -1;
+	frameStart[i] = 0;
+	frameEnd[i] = 0;
+	sendTailLength[i] = 0;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static unsigned char* serverSocketHeadPckt(int i) {
+	unsigned char* head;
+	int n, isRead = 0;
+
+	for (;;) {
+		head = frameBuffer[i] + frameStart[i];
+		n = frameEnd[i] - frameStart[i];
+		if ((n > 0) && ((head[0] == 0) || (head[0] > pcktMaxLength))) {
+			printf("CrDaServerSocketPoll: invalid packet received from socket\n");
+			frameStart[i] = 0;
+			frameEnd[i] = 0;
+			return NULL;
+		}
+		if ((n > 0) && (n >= head[0])) {	/* a complete packet is at the head */
+			if (!serverSocketRelay(head))
+				return head;
+			frameStart[i] += head[0];
+			continue;
+		}
+
+		if (isRead || (newsockfd[i] < 0))	/* one read per call or the client is not connected */
+			return NULL;
+
+		/* Move the incomplete packet to the start of the buffer and read the next bytes */
+		memmove(frameBuffer[i], head, n);
+		frameStart[i] = 0;
+		frameEnd[i] = n;
+		CrDaTraceBegin("read", i);
+		n = read(newsockfd[i], frameBuffer[i]+frameEnd[i], CR_DA_SOCKET_FRAME_BUFFER_SIZE-frameEnd[i]);
+		CrDaTraceEnd("read");
+		isRead = 1;
+		if (n == -1) {	/* no data are available from the socket */
+			if ((errno != EAGAIN) && (errno != EWOULDBLOCK))
+				serverSocketClose(i);
+			return NULL;
+		}
+		if (n == 0)	{
+			printf("CrDaServerSocketPoll: connection closed by client socket\n");
+			serverSocketClose(i);
+			return NULL;
+		}
+		frameEnd[i] += n;
+	}
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static int serverSocketRelay(unsigned char* pckt) {
+	CrFwDestSrc_t dest = CrFwPcktGetDest((CrFwPckt_t)pckt);
+	CrFwDestSrc_t src;
+	int len = pckt[0];
+	int n, j;
+
+	if (dest == CR_DA_MASTER)
+		j = 0;
+	else if (dest == CR_DA_SLAVE_2)
+		j = 1;
+	else
+		return 0;
+	if (newsockfd[j] < 0)
+		return 0;
+	/* Once a packet to the client has fallen back, the next ones follow it until it has been sent */
+	if ((fallbackSrcs[j] != 0) && !isFallbackDrained(j, dest))
+		return 0;
+	/* The bytes of the previous packet must be sent first */
+	if (!flushSendTail(j))
+		return 0;
+
+	CrDaTraceBegin("relay", (int)dest);
+	n = send(newsockfd[j], pckt, len, MSG_NOSIGNAL);
+	CrDaTraceEnd("relay");
+	if (n < 0) {
+		if ((errno != EAGAIN) && (errno != EWOULDBLOCK))
+			serverSocketClose(j);
+		return 0;
+	}
+	if (n < len)	/* the socket accepted part of the packet: its other bytes are sent from the Send Tail */
+		holdSendTail(j, pckt, n);
+
+	src = CrFwPcktGetSrc((CrFwPckt_t)pckt);
+	CrDaPcktRecorderRecord(crDaPcktRecIn, src, (CrFwPckt_t)pckt);
+	CrDaPcktRecorderRecord(crDaPcktRecOut, dest, (CrFwPckt_t)pckt);
+	CrDaStatsPcktIn(src, (unsigned int)len);
+	CrDaStatsPcktOut(dest, (unsigned int)len);
+	return 1;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static int isFallbackDrained(int i, CrFwDestSrc_t dest) {
+	CrFwDestSrc_t src;
+
+	for (src=0; (fallbackSrcs[i] >> src) != 0; src++)
+		if (((fallbackSrcs[i] >> src) & 1) && (CrFwInStreamGetNOfPendingPckts(CrFwInStreamGet(src)) > 0))
+			return 0;
+	if (CrFwOutStreamGetNOfPendingPckts(CrFwOutStreamGet(dest)) > 0)
+		return 0;
+	fallbackSrcs[i] = 0;
+	return 1;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static int flushSendTail(int i) {
+	int n;
+
+	if (sendTailLength[i] == 0)
+		return 1;
+	CrDaTraceBegin("send", i);
+	n = send(newsockfd[i], sendTail[i], sendTailLength[i], MSG_NOSIGNAL);
+	CrDaTraceEnd("send");
+	if (n < 0) {
+		if ((errno != EAGAIN) && (errno != EWOULDBLOCK))
+			serverSocketClose(i);
+		return 0;
+	}
+	sendTailLength[i] -= n;
+	memmove(sendTail[i], sendTail[i]+n, sendTailLength[i]);
+	return (sendTailLength[i] == 0);
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static void holdSendTail(int i, unsigned char* pckt, int n) {
+	sendTailLength[i] = pckt[0]-n;
+	memcpy(sendTail[i], pckt+n, sendTailLength[i]);
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static void serverSocketPoll(int i) {
+	unsigned char* pckt;
+
+	pckt = serverSocketHeadPckt(i);
+	if (pckt != NULL)
+		CrFwInStreamPcktAvail(CrFwInStreamGet(CrFwPcktGetSrc((CrFwPckt_t)pckt)));
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+CrFwPckt_t CrDaServerSocketPcktCollect(CrFwDestSrc_t src) {
+	CrFwPckt_t pckt;
+
+	pckt = serverSocketPcktCollect(src, 0);
+	if (pckt != NULL)
+		return pckt;
+	pckt = serverSocketPcktCollect(src, 1);
+	if (pckt != NULL)
+		return pckt;
+
+	return NULL;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static  CrFwPckt_t serverSocketPcktCollect(CrFwDestSrc_t src, int i) {
+	CrFwPckt_t pckt;
+	CrFwDestSrc_t dest;
+	unsigned char* head;
+
+	head = serverSocketHeadPckt(i);
+	if (head == NULL)
+		return NULL;
+	if (CrFwPcktGetSrc((CrFwPckt_t)head) != src)
+		return NULL;
+	if (CrDaBackpressureIsFull(src))
+		return NULL;
+	pckt = CrFwPcktMake((CrFwPcktLength_t)head[0]);
+	if (pckt == NULL)
+		return NULL;
+	memcpy(pckt, head, head[0]);
+	frameStart[i] += head[0];
+	/* A packet to a client has fallen back from the cut-through relay */
+	dest = CrFwPcktGetDest(pckt);
+	if (dest == CR_DA_MASTER)
+		fallbackSrcs[0] |= (1u << src);
+	else if (dest == CR_DA_SLAVE_2)
+		fallbackSrcs[1] |= (1u << src);
+	CrDaPcktRecorderRecord(crDaPcktRecIn, src, pckt);
+	CrDaStatsPcktIn(src, CrFwPcktGetLength(pckt));
+	return pckt;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+CrFwBool_t CrDaServerSocketIsPcktAvail(CrFwDestSrc_t src) {
+	if (serverSocketIsPcktAvail(src, 0))
+		return 1;
+
+	if (serverSocketIsPcktAvail(src, 1))
+		return 1;
+
+	return 0;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static CrFwBool_t serverSocketIsPcktAvail(CrFwDestSrc_t src, int i) {
+	unsigned char* head;
+
+	head = serverSocketHeadPckt(i);
+	if (head == NULL)
+		return 0;
+	if (CrFwPcktGetSrc((CrFwPckt_t)head) != src)
+		return 0;
+	/* The packet stays at the head (and the next ones in the socket) while the InStream is full */
+	if (CrDaBackpressureIsFull(src))
+		return 0;
+	return 1;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+CrFwBool_t CrDaServerSocketPcktHandover(CrFwPckt_t pckt) {
+	int len = (int)CrFwPcktGetLength(pckt);
+	int n, i;
+	CrFwDestSrc_t dest;
+
+	dest = CrFwPcktGetDest(pckt);
+	if (dest == CR_DA_MASTER)
+		i = 0;
+	else
+		i = 1;
+
+	/* The OutStream buffers the packet until the client is connected */
+	if (newsockfd[i] < 0)
+		return 0;
+	/* The bytes of the previous packet must be sent first */
+	if (!flushSendTail(i))
+		return 0;
+
+	CrDaTraceBegin("send", (int)dest);
+	n = send(newsockfd[i], pckt, len, MSG_NOSIGNAL);
+	CrDaTraceEnd("send");
+	if (n < 0) {
+		if ((errno != EAGAIN) && (errno != EWOULDBLOCK))
+			serverSocketClose(i);
+		return 0;
+	}
+
+	if (n < len)	/* the socket accepted part of the packet: its other bytes are sent from the Send Tail */
+		holdSendTail(i, (unsigned char*)pckt, n);
+
+	CrDaPcktRecorderRecord(crDaPcktRecOut, dest, pckt);
+	CrDaStatsPcktOut(dest, CrFwPcktGetLength(pckt));
+	return 1;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaServerSocketInitCheck(FwPrDesc_t prDesc) {
+	CrFwCmpData_t* outStreamData = (CrFwCmpData_t*)FwPrGetData(prDesc);
+
+	if (portno < 2000)
+		outStreamData->outcome = 0;
+	else
+		outStreamData->outcome = 1;
+
+	return;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaServerSocketConfigCheck(FwPrDesc_t prDesc) {
+	CrFwCmpData_t* outStreamData = (CrFwCmpData_t*)FwPrGetData(prDesc);
+
+	/* The connections from the client sockets are accepted later by the poll function */
+	if (sockfd > 0)
+		outStreamData->outcome = 1;
+	else
+		outStreamData->outcome = 0;
+
+	return;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaServerSocketSetPort(int n) {
+	portno = n;
+}
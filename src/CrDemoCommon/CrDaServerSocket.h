@@ -1,6 +1,6 @@
 /**
  * @file
- * @ingroup crDemoSlave2
+ * @ingroup crDemoCommon
  * Interface for the server socket used in the CORDET Demo.
  * The CORDET Demo consists of three applications which communicate with each other via sockets.
  * The physical connections of the applications are shown in the figure below.
@@ -39,10 +39,20 @@
  * The socket must be initialized with the port number for its socket (this is defined through
  * functions <code>::CrDaClientSocketSetPort</code>.
  *
- * In the initialization process of this module, a socket is bound and listening starts on it.
- * A thread is then spawned which waits for incoming connections from its two client sockets.
- * When the incoming connections have been accepted, the socket is ready to complete
- * its configuration.
+ * In the initialization process of this module, a non-blocking socket is bound and
+ * listening starts on it.
+ * The incoming connections from its two client sockets are accepted by the poll function
+ * <code>::CrDaServerSocketPoll</code>: the clients can therefore connect in any order and
+ * at any time after the initialization of the server socket.
+ * An accepted connection is associated to its client (the Master or the Slave 2 Application)
+ * when the hello message of the client arrives (see <code>#CR_DA_SOCKET_HELLO_LENGTH</code>).
+ * If a client reconnects (e.g. because it was restarted), its new connection replaces
+ * the old one.
+ * When a connection is closed by its client, it is closed by the server socket and the
+ * packet hand-over operation for that client fails (and the OutStreams buffer their
+ * packets) until the client reconnects.
+ * When a client connects, the OutStreams which use the server socket are notified through
+ * <code>::CrFwOutStreamConnectionAvail</code> and hand over their buffered packets.
  *
  * The socket assumes a polling approach for incoming packets: function
  * <code>::CrDaServerSocketPoll</code> should be called periodically
@@ -55,20 +65,36 @@
  * This causes all pending packets from that source to be collected by the InStream and
  * stored in its Packet Queue.
  *
- * The implementation of this module assumes that, at each read operation, an entire
- * packet is received.
- * The situation where the packet is split into fragments during the transmission
- * process is not handled.
- * In practice, this socket is intended for the case where the socket is local
- * to the host platform (i.e. where the host name is "localhost" and both sender
- * and receiver of a packet are located on the same platform).
+ * The bytes which are read from the socket of a client are accumulated in a buffer
+ * (the <i>Framing Buffer</i>) of <code>#CR_DA_SOCKET_FRAME_BUFFER_SIZE</code> bytes.
+ * Two Framing Buffers are statically allocated, one for each client.
+ * The packets are delimited in the Framing Buffer by their length (the first byte of
+ * a packet): one read operation may therefore deliver several packets or only part of
+ * a packet and the incomplete packet at the end of the Framing Buffer is completed by
+ * the next read operation.
+ * A read operation is only made when the packet at the head of the Framing Buffer is
+ * incomplete.
  *
- * Packets which are read from the socket are stored in a buffer (the <i>Read Buffer</i>).
- * This is an array of bytes whose size is equal to the maximum size of a
- * middleware packet.
- * The Read Buffer can be either "full" (if its first byte is different from zero)
- * or "empty" (if its first byte has been cleared).
- * Two Read Buffers are instantiated, one for each client.
+ * The Slave 1 Application relays the traffic between the Master Application and the
+ * Slave 2 Application.
+ * A complete packet at the head of a Framing Buffer whose destination is the other
+ * client is relayed straight from the Framing Buffer to the connection of that client
+ * (the <i>cut-through relay</i>): it is neither copied to the packet pool nor processed
+ * by the InStream, the InLoader and the OutStream.
+ * A packet is relayed in the same call to <code>::CrDaServerSocketPoll</code> in which it is
+ * read and the relayed packets are counted and recorded like the packets which are received
+ * and sent by the host application.
+ * If the destination client is not connected or its socket does not accept the packet,
+ * the packet (and all packets behind it in the Framing Buffer) takes the normal path:
+ * it is collected by the InStream of its source and re-routed by the framework to the
+ * OutStream of its destination, which buffers it until the client is connected again.
+ * Once a packet to a client has fallen back to the InStream, the cut-through relay to that
+ * client is suspended: the next packets to the client take the normal path behind it until
+ * the InStreams of their sources and the OutStream of the client hold no packets, i.e. until
+ * all packets which fell back have been handed over to the socket of the client.
+ * The packets to a client are therefore not re-ordered.
+ * The connections accepted by the server socket use <code>TCP_NODELAY</code> so that
+ * the relayed packets are not delayed by the TCP stack.
  *
  * The packet hand-over operation for OutStreams is implemented in function
  * <code>::CrDaServerSocketPcktHandover</code> which performs a non-blocking write
@@ -132,11 +158,11 @@
  * Initialization action for the server socket.
  * If the server socket has already been initialized, this function calls the
  * Initialization Action of the base InStream/OutStream and then returns.
+ * In both cases, if the caller is an OutStream, it is registered for notification when
+ * a client socket connects.
  * If the server socket has not yet been initialized, this action:
- * - creates and binds the socket
+ * - creates and binds the socket as a non-blocking socket
  * - start listening on the socket
- * - spawns a thread which waits for an incoming connection from, first, the client socket
- *   of the Master Application and, then, the client socket of the Slave 2 Application
  * - execute the Initialization Action of the base InStream/OutStream
  * .
  * The function sets the outcome to "success" if all these operations are successful.
@@ -153,8 +179,8 @@ void CrDaServerSocketInitCheck(FwPrDesc_t prDesc);
 
 /**
  * Configuration check for the server socket.
- * The check is successful if the connection from the matching client socket has been successfully
- * accepted.
+ * The check is successful if the server socket is listening (the connections from the client
+ * sockets are accepted later by <code>::CrDaServerSocketPoll</code>).
  * @param prDesc the initialization procedure descriptor.
  */
 void CrDaServerSocketConfigCheck(FwPrDesc_t prDesc);
@@ -183,7 +209,7 @@ CrFwBool_t CrDaServerSocketPcktHandover(CrFwPckt_t pckt);
 
 /**
  * Configuration action for the server socket.
- * This action clears the Read Buffer and executes the Configuration Action of
+ * This action clears the Framing Buffers and executes the Configuration Action of
  * the base InStream/OutStream.
  * @param prDesc the configuration procedure descriptor.
  */
@@ -193,12 +219,12 @@ void CrDaServerSocketConfigAction(FwPrDesc_t prDesc);
  * Poll the server socket to check whether a new packet has arrived from either
  * client.
  * This function should be called periodically by an external scheduler.
- * If there is a pending packet (i.e. if a Read Buffer is full), its source
- * is determined, and then function <code>::CrFwInStreamPcktAvail</code> is
- * called on the InStream associated to that packet source.
- * If there is no pending packet, a non-blocking read is performed from each
- * client to check whether a packet is available from that client.
- * If a packet is available, it is placed into the Read Buffer, its source
+ * It first accepts the pending connections from the client sockets and identifies
+ * the clients of the accepted connections from their hello message.
+ * For each client, the packets at the head of its Framing Buffer which are destined to
+ * the other client are relayed and, if the Framing Buffer holds no complete packet,
+ * a non-blocking read is performed from the client.
+ * If a complete packet remains at the head of the Framing Buffer, its source
  * is determined, and then function <code>::CrFwInStreamPcktAvail</code> is
  * called on the InStream associated to that packet source.
  */
@@ -206,18 +232,17 @@ void CrDaServerSocketPoll();
 
 /**
  * Function implementing the Packet Collect Operation for the server socket.
- * If the packet in the first Read Buffer has a source attribute equal to
- * <code>pcktSrc</code>, this function:
+ * If the packet at the head of the first Framing Buffer (after the relayed packets
+ * have been removed) has a source attribute equal to <code>pcktSrc</code>, this function:
  * - creates a packet instance through a call to <code>CrFwPcktMake</code>
- * - copies the content of the Read Buffer into the newly created packet instance
- * - clears the Read Buffer
+ * - copies the packet from the Framing Buffer into the newly created packet instance
+ * - removes the packet from the Framing Buffer
  * - returns the packet instance
  * .
- * If the packet in the first Read Buffer has a source attribute different from
- * <code>pcktSrc</code>, the same logic as above is applied to the second Read Buffer.
- * If neither Read Buffer holds a packet from <code>pcktSrc</code>, this function returns NULL.
- * Note that the logic of the server socket module guarantees that at least one Read Buffer
- * will always be full when this function is called.
+ * Otherwise, the same logic as above is applied to the second Framing Buffer.
+ * If neither Framing Buffer holds a packet from <code>pcktSrc</code> or if the packet queue of
+ * the InStream of <code>pcktSrc</code> is full (see <code>CrDaBackpressure.h</code>), this
+ * function returns NULL.
  * @param pcktSrc the source associated to the InStream
  * @return the packet collected from the argument source
  */
@@ -225,22 +250,16 @@ CrFwPckt_t CrDaServerSocketPcktCollect(CrFwDestSrc_t pcktSrc);
 
 /**
  * Function implementing the Packet Available Check Operation for the server socket.
- * This function implements the following logic:
- * - The function begins by checking the first Read Buffer.
- * - If it is full and the source attribute of the packet it contains is equal
- *   to <code>pcktSrc</code>, the function returns 1.
- * - If the Read Buffer is not full or it is full but the source attribute of the
- *   packet it contains is not equal to <code>pcktSrc</code>, the function
- *   performs a non-blocking read on the socket.
- * - If the read operation returns a packet with a source attribute equal to
- *   <code>pcktSrc</code>, the function stores it in the Read Buffer and then
- *   returns 1.
- * - If the read operation returns nothing or returns a packet with a source
- *   attribute other than <code>pcktSrc</code>, the above logic is applied to
- *   the second Read Buffer.
- * - If no packet for the argument destination is found from either Read Buffer,
- *   the function returns 0.
- * .
+ * This function returns 1 if the packet at the head of either Framing Buffer has
+ * a source attribute equal to <code>pcktSrc</code>.
+ * If the packet at the head of a Framing Buffer is incomplete, a non-blocking read is
+ * first performed from the client and the packets which it delivers are relayed if
+ * they are destined to the other client.
+ * If the packet queue of the InStream of <code>pcktSrc</code> is full (see
+ * <code>CrDaBackpressure.h</code>), this function returns 0: the packet stays at the head of
+ * its Framing Buffer, no further reads are made from its client and the flow control of TCP
+ * slows the client down.
+ * Note that the packets to be relayed which follow the packet held back are held back with it.
  * @param pcktSrc the source associated to the InStream
  * @return the value of a predefined flag
  */
@@ -0,0 +1,315 @@
+/**
+ * @file
+ * @ingroup crDemoCommon
+ * Implementation of the sizing report of the demo applications.
+ *
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the CORDET Framework.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "CrDaSizing.h"
+#include "CrDaStats.h"
+#include "CrDaStatsPage.h"
+
+/** The maximum number of sized items (one per pool and one per tracked queue or list) */
+#define CR_DA_SIZING_MAX_N_OF_ITEMS (4+4*CR_DA_STATS_N_OF_INSTANCES)
+
+/** The maximum length of a line of a configuration file */
+#define CR_DA_SIZING_MAX_LINE_LENGTH 1024
+
+/** A sized item: a pool, or the queue or list of one instance of a component. */
+typedef struct {
+	/** The name of the configuration parameter which defines the size of the item */
+	const char* name;
+	/** The index of the item in the parameter (negative if the parameter is not an array) */
+	int index;
+	/** The current size of the item */
+	unsigned int size;
+	/** The high-water mark of the item */
+	unsigned int hwm;
+	/** The number of times the item was found full */
+	unsigned long long nOfOverflows;
+} CrDaSizingItem_t;
+
+/** A configuration parameter and the configuration file where it is defined. */
+typedef struct {
+	/** The name of the configuration parameter */
+	const char* name;
+	/** The name of the configuration file */
+	const char* file;
+} CrDaSizingPar_t;
+
+/** The configuration parameters which define the sizes of the items */
+static const CrDaSizingPar_t sizingPars[] = {
+	{"CR_FW_MAX_NOF_PCKTS", "CrFwUserConstants.h"},
+	{"CR_FW_OUTFACTORY_MAX_NOF_OUTCMP", "CrFwOutFactoryUserPar.h"},
+	{"CR_FW_INFACTORY_MAX_NOF_INCMD", "CrFwInFactoryUserPar.h"},
+	{"CR_FW_INFACTORY_MAX_NOF_INREP", "CrFwInFactoryUserPar.h"},
+	{"CR_FW_INSTREAM_PQSIZE", "CrFwInStreamUserPar.h"},
+	{"CR_FW_OUTSTREAM_PQSIZE", "CrFwOutStreamUserPar.h"},
+	{"CR_FW_INMANAGER_PCRLSIZE", "CrFwInManagerUserPar.h"},
+	{"CR_FW_OUTMANAGER_POCLSIZE", "CrFwOutManagerUserPar.h"}
+};
+
+/** The number of configuration parameters which define the sizes of the items */
+#define CR_DA_SIZING_N_OF_PARS (sizeof(sizingPars)/sizeof(sizingPars[0]))
+
+/**
+ * Collect the sized items from the statistics page.
+ * @param items the array where the items are stored
+ * @return the number of items
+ */
+static int collectItems(CrDaSizingItem_t* items);
+
+/**
+ * Add the queues or lists of the tracked instances of a component type to the sized items.
+ * @param items the array where the items are stored
+ * @param n the number of items already in the array
+ * @param name the name of the configuration parameter which defines the sizes
+ * @param occ the occupancies of the instances
+ * @return the number of items
+ */
+static int addOccItems(CrDaSizingItem_t* items, int n, const char* name, const CrDaStatsOcc_t* occ);
+
+/**
+ * Return whether a sized item is saturated.
+ * @param item the sized item
+ * @return 1 if the item is saturated, 0 otherwise
+ */
+static int isSaturated(const CrDaSizingItem_t* item);
+
+/**
+ * Return the recommended size of a sized item.
+ * @param item the sized item
+ * @param headroom the headroom in percent of the high-water mark
+ * @return the recommended size
+ */
+static unsigned int getRecommendedSize(const CrDaSizingItem_t* item, unsigned int headroom);
+
+/**
+ * Write the sized copy of a configuration file.
+ * @param path the path of the configuration file
+ * @param items the sized items
+ * @param nOfItems the number of sized items
+ * @param headroom the headroom in percent of the high-water marks
+ * @return 1 if the sized copy was written, 0 otherwise
+ */
+static int writeHeader(const char* path, const CrDaSizingItem_t* items, int nOfItems, unsigned int headroom);
+
+/**
+ * Write the definition of a configuration parameter with the recommended sizes.
+ * If the configuration parameter is an array, the elements which have no sized item
+ * keep the value of the original definition.
+ * @param file the file to which the definition is written
+ * @param name the name of the configuration parameter
+ * @param value the value of the original definition
+ * @param items the sized items
+ * @param nOfItems the number of sized items
+ * @param headroom the headroom in percent of the high-water marks
+ */
+static void writeDefine(FILE* file, const char* name, const char* value, const CrDaSizingItem_t* items,
+                        int nOfItems, unsigned int headroom);
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaSizingPrintReport(const char* tag, unsigned int headroom) {
+	CrDaSizingItem_t items[CR_DA_SIZING_MAX_N_OF_ITEMS];
+	char name[64];
+	int nOfItems, i;
+
+	nOfItems = collectItems(items);
+	printf("%s: ---- Sizing report (headroom %u%%) ----\n", tag, headroom);
+	printf("%s: %-36s %6s %6s %10s %6s\n", tag, "PARAMETER", "SIZE", "HWM", "OVERFLOWS", "REC");
+	for (i=0; i<nOfItems; i++) {
+		if (items[i].index < 0)
+			snprintf(name, sizeof(name), "%s", items[i].name);
+		else
+			snprintf(name, sizeof(name), "%s[%d]", items[i].name, items[i].index);
+		printf("%s: %-36s %6u %6u %10llu %6u%s\n", tag, name, items[i].size, items[i].hwm,
+		       items[i].nOfOverflows, getRecommendedSize(&items[i], headroom),
+		       (isSaturated(&items[i]) ? " (saturated)" : ""));
+	}
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+int CrDaSizingWriteHeaders(const char* srcDir, const char* cnfDir, unsigned int headroom) {
+	CrDaSizingItem_t items[CR_DA_SIZING_MAX_N_OF_ITEMS];
+	char path[512];
+	int nOfItems;
+	unsigned int i, j;
+	int outcome = 1;
+
+	nOfItems = collectItems(items);
+	for (i=0; i<CR_DA_SIZING_N_OF_PARS; i++) {
+		/* Each configuration file is written once */
+		for (j=0; j<i; j++)
+			if (strcmp(sizingPars[j].file, sizingPars[i].file) == 0)
+				break;
+		if (j < i)
+			continue;
+		snprintf(path, sizeof(path), "%s/%s/%s", srcDir, cnfDir, sizingPars[i].file);
+		if (!writeHeader(path, items, nOfItems, headroom))
+			outcome = 0;
+	}
+	return outcome;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static int collectItems(CrDaSizingItem_t* items) {
+	const CrDaStatsPage_t* page = CrDaStatsGetPage();
+	int n = 0;
+
+	items[n].name = "CR_FW_MAX_NOF_PCKTS";
+	items[n].index = -1;
+	items[n].size = page->pcktPoolSize;
+	items[n].hwm = page->pcktHwm;
+	items[n++].nOfOverflows = page->nOfPcktAllocFails;
+	items[n].name = "CR_FW_OUTFACTORY_MAX_NOF_OUTCMP";
+	items[n].index = -1;
+	items[n].size = page->outCmpPoolSize;
+	items[n].hwm = page->outCmpHwm;
+	items[n++].nOfOverflows = 0;
+	items[n].name = "CR_FW_INFACTORY_MAX_NOF_INCMD";
+	items[n].index = -1;
+	items[n].size = page->inCmdPoolSize;
+	items[n].hwm = page->inCmdHwm;
+	items[n++].nOfOverflows = 0;
+	items[n].name = "CR_FW_INFACTORY_MAX_NOF_INREP";
+	items[n].index = -1;
+	items[n].size = page->inRepPoolSize;
+	items[n].hwm = page->inRepHwm;
+	items[n++].nOfOverflows = 0;
+
+	n = addOccItems(items, n, "CR_FW_INSTREAM_PQSIZE", page->inStream);
+	n = addOccItems(items, n, "CR_FW_OUTSTREAM_PQSIZE", page->outStream);
+	n = addOccItems(items, n, "CR_FW_INMANAGER_PCRLSIZE", page->inManager);
+	n = addOccItems(items, n, "CR_FW_OUTMANAGER_POCLSIZE", page->outManager);
+	return n;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static int addOccItems(CrDaSizingItem_t* items, int n, const char* name, const CrDaStatsOcc_t* occ) {
+	int i;
+
+	for (i=0; i<CR_DA_STATS_N_OF_INSTANCES; i++) {
+		if (occ[i].size == 0)
+			continue;
+		items[n].name = name;
+		items[n].index = i;
+		items[n].size = occ[i].size;
+		items[n].hwm = occ[i].hwm;
+		items[n].nOfOverflows = occ[i].nOfOverflows;
+		n++;
+	}
+	return n;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static int isSaturated(const CrDaSizingItem_t* item) {
+	return ((item->nOfOverflows > 0) || ((item->size > 0) && (item->hwm >= item->size)));
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static unsigned int getRecommendedSize(const CrDaSizingItem_t* item, unsigned int headroom) {
+	unsigned int needed, recommended;
+
+	needed = (isSaturated(item) ? 2*item->size : item->hwm);
+	recommended = needed + (needed*headroom + 99)/100;
+	if (recommended < 1)
+		recommended = 1;
+	return recommended;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static int writeHeader(const char* path, const CrDaSizingItem_t* items, int nOfItems, unsigned int headroom) {
+	char sizedPath[520];
+	char line[CR_DA_SIZING_MAX_LINE_LENGTH];
+	char name[64], value[CR_DA_SIZING_MAX_LINE_LENGTH];
+	FILE* in;
+	FILE* out;
+	unsigned int i;
+
+	in = fopen(path, "r");
+	if (in == NULL) {
+		printf("CrDaSizingWriteHeaders: cannot open %s\n", path);
+		return 0;
+	}
+	snprintf(sizedPath, sizeof(sizedPath), "%s.sized", path);
+	out = fopen(sizedPath, "w");
+	if (out == NULL) {
+		printf("CrDaSizingWriteHeaders: cannot create %s\n", sizedPath);
+		fclose(in);
+		return 0;
+	}
+
+	while (fgets(line, sizeof(line), in) != NULL) {
+		if (sscanf(line, "#define %63s %1023[^\n]", name, value) == 2) {
+			for (i=0; i<CR_DA_SIZING_N_OF_PARS; i++)
+				if (strcmp(name, sizingPars[i].name) == 0)
+					break;
+			if (i < CR_DA_SIZING_N_OF_PARS) {
+				writeDefine(out, name, value, items, nOfItems, headroom);
+				continue;
+			}
+		}
+		fputs(line, out);
+	}
+
+	fclose(in);
+	fclose(out);
+	printf("CrDaSizingWriteHeaders: sized configuration written to %s\n", sizedPath);
+	return 1;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static void writeDefine(FILE* file, const char* name, const char* value, const CrDaSizingItem_t* items,
+                        int nOfItems, unsigned int headroom) {
+	const char* p;
+	char* end;
+	long element;
+	int index, i;
+
+	/* A scalar parameter */
+	if (value[0] != '{') {
+		for (i=0; i<nOfItems; i++)
+			if ((strcmp(items[i].name, name) == 0) && (items[i].index < 0)) {
+				fprintf(file, "#define %s %u\n", name, getRecommendedSize(&items[i], headroom));
+				return;
+			}
+		fprintf(file, "#define %s %s\n", name, value);
+		return;
+	}
+
+	/* An array parameter: replace the elements which have a sized item */
+	fprintf(file, "#define %s {", name);
+	p = value+1;
+	for (index=0; ; index++) {
+		element = strtol(p, &end, 10);
+		if (end == p)
+			break;
+		for (i=0; i<nOfItems; i++)
+			if ((strcmp(items[i].name, name) == 0) && (items[i].index == index))
+				break;
+		if (index > 0)
+			fprintf(file, ",");
+		if (i < nOfItems)
+			fprintf(file, "%u", getRecommendedSize(&items[i], headroom));
+		else
+			fprintf(file, "%ld", element);
+		p = end;
+		while ((*p == ' ') || (*p == ','))
+			p++;
+	}
+	fprintf(file, "}\n");
+}
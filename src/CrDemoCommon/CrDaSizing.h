@@ -0,0 +1,73 @@
+/**
+ * @file
+ * @ingroup crDemoCommon
+ * Sizing report of the demo applications.
+ * The sizes of the pools and queues of the framework components are configuration
+ * parameters of the applications which are defined in their <code>CrFwXxxUserPar.h</code>
+ * and <code>CrFwUserConstants.h</code> files:
+ * - <code>CR_FW_MAX_NOF_PCKTS</code>: the size of the packet pool;
+ * - <code>CR_FW_OUTFACTORY_MAX_NOF_OUTCMP</code>: the size of the pool of the OutFactory;
+ * - <code>CR_FW_INFACTORY_MAX_NOF_INCMD</code> and <code>CR_FW_INFACTORY_MAX_NOF_INREP</code>:
+ *   the sizes of the pools of the InFactory;
+ * - <code>CR_FW_INSTREAM_PQSIZE</code> and <code>CR_FW_OUTSTREAM_PQSIZE</code>: the sizes of
+ *   the packet queues of the InStreams and OutStreams;
+ * - <code>CR_FW_INMANAGER_PCRLSIZE</code> and <code>CR_FW_OUTMANAGER_POCLSIZE</code>: the sizes
+ *   of the pending lists of the InManagers and OutManagers.
+ * .
+ * At the end of a run, the sizing report compares each of these sizes with the high-water
+ * mark which was observed during the run (see <code>CrDaStats.h</code>) and recommends
+ * a size equal to the high-water mark plus a headroom (a percentage of the high-water mark,
+ * rounded up; the recommended size is at least 1).
+ * A pool, queue or list which was exhausted during the run (i.e. whose high-water mark
+ * is equal to its size or which overflowed) is flagged as saturated: its real peak
+ * occupancy is unknown and the recommendation is based on twice its current size.
+ * The run should then be repeated with the recommended size.
+ * The queues and lists of streams and managers which were not registered with the run
+ * statistics keep their current size.
+ *
+ * The report can also emit the configuration files with the recommended sizes:
+ * <code>::CrDaSizingWriteHeaders</code> reads each configuration file which defines one of
+ * the above parameters and writes a copy of it with suffix <code>.sized</code> in which
+ * the values of the parameters are replaced by the recommended sizes.
+ * The demo applications emit the configuration files when the environment variable
+ * <code>#CR_DA_SIZING_ENV_VAR</code> is set to the source directory of the demo
+ * applications.
+ *
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the CORDET Framework.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#ifndef CRDA_SIZING_H_
+#define CRDA_SIZING_H_
+
+/** Name of the environment variable through which the demo applications are told to emit their sized configuration files */
+#define CR_DA_SIZING_ENV_VAR "CR_DA_SIZING"
+
+/**
+ * Print the sizing report.
+ * @param tag the tag of the application with which the lines of the report are prefixed
+ * @param headroom the headroom in percent of the high-water marks
+ */
+void CrDaSizingPrintReport(const char* tag, unsigned int headroom);
+
+/**
+ * Write the configuration files of an application with the recommended sizes.
+ * The configuration files are read from directory <code>srcDir/cnfDir</code> and
+ * their sized copies are written to the same directory.
+ * @param srcDir the source directory of the demo applications
+ * @param cnfDir the name of the directory of the configuration files of the application
+ * @param headroom the headroom in percent of the high-water marks
+ * @return 1 if all configuration files were written, 0 otherwise
+ */
+int CrDaSizingWriteHeaders(const char* srcDir, const char* cnfDir, unsigned int headroom);
+
+#endif /* CRDA_SIZING_H_ */
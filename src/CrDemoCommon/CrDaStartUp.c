@@ -0,0 +1,60 @@
+/**
+ * @file
+ * @ingroup crDemoCommon
+ * Implementation of the start-up benchmark of the demo applications.
+ *
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the CORDET Framework.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#include <stdio.h>
+#include <malloc.h>
+#include "CrDaStartUp.h"
+#include "CrDaClock.h"
+
+/** The host time in nanoseconds at which the start-up began */
+static unsigned long long beginTime = 0;
+
+/** The number of bytes allocated from the heap when the start-up began */
+static unsigned long long beginHeap = 0;
+
+/**
+ * Return the number of bytes which are currently allocated from the heap.
+ * @return the number of allocated bytes
+ */
+static unsigned long long getHeapInUse();
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaStartUpBegin() {
+	beginHeap = getHeapInUse();
+	beginTime = CrDaClockGetHostTime();
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaStartUpEnd(const char* tag) {
+	unsigned long long elapsed = CrDaClockGetHostTime() - beginTime;
+	unsigned long long heap = getHeapInUse();
+
+	printf("%s: Start-up completed in %.1f us, %llu bytes allocated from the heap\n", tag,
+	       (double)elapsed/1000.0, (heap > beginHeap ? heap - beginHeap : 0));
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static unsigned long long getHeapInUse() {
+#if defined(__GLIBC__) && ((__GLIBC__ > 2) || (__GLIBC_MINOR__ >= 33))
+	struct mallinfo2 info = mallinfo2();
+	return (unsigned long long)info.uordblks + (unsigned long long)info.hblkhd;
+#else
+	struct mallinfo info = mallinfo();
+	return (unsigned long long)(unsigned int)info.uordblks + (unsigned long long)(unsigned int)info.hblkhd;
+#endif
+}
@@ -0,0 +1,45 @@
+/**
+ * @file
+ * @ingroup crDemoCommon
+ * Start-up benchmark of the demo applications.
+ * The demo applications lay out their state machines, procedures, buffers and pools in
+ * static storage as far as the framework allows it (see the Application Start-Up, Reset
+ * and Shutdown Procedures and the socket modules).
+ * This module measures the cost of the start-up of an application: its main program calls
+ * <code>::CrDaStartUpBegin</code> when it starts its initialization and
+ * <code>::CrDaStartUpEnd</code> when the initialization is complete.
+ * <code>::CrDaStartUpEnd</code> prints the time which the start-up took (measured with the
+ * host clock) and the number of bytes which were allocated from the heap during the start-up
+ * and are still allocated at its end.
+ * This number covers the allocations of the framework components whose state machines and
+ * procedures are created dynamically by the framework and of the C library.
+ *
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the CORDET Framework.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#ifndef CRDA_STARTUP_H_
+#define CRDA_STARTUP_H_
+
+/**
+ * Mark the beginning of the start-up of the host application.
+ */
+void CrDaStartUpBegin();
+
+/**
+ * Mark the end of the start-up of the host application and print the time which
+ * it took and the number of bytes which it allocated from the heap.
+ * @param tag the tag of the application with which the line is prefixed
+ */
+void CrDaStartUpEnd(const char* tag);
+
+#endif /* CRDA_STARTUP_H_ */
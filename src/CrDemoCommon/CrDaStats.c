@@ -0,0 +1,387 @@
+/**
+ * @file
+ * @ingroup crDemoCommon
+ * Implementation of the run statistics of the demo applications.
+ *
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the CORDET Framework.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include "CrDaStats.h"
+#include "CrDaStatsPage.h"
+#include "CrDaClock.h"
+/* Include FW Profile files */
+#include "FwSmConstants.h"
+#include "FwSmConfig.h"
+#include "FwPrConstants.h"
+/* Include configuration files */
+#include "CrFwCmpData.h"
+/* Include framework files */
+#include "CrFwConstants.h"
+#include "Pckt/CrFwPckt.h"
+#include "InStream/CrFwInStream.h"
+#include "OutStream/CrFwOutStream.h"
+#include "InManager/CrFwInManager.h"
+#include "OutManager/CrFwOutManager.h"
+#include "OutFactory/CrFwOutFactory.h"
+#include "InFactory/CrFwInFactory.h"
+#include "UtilityFunctions/CrFwUtilityFunctions.h"
+
+/** The private statistics page (used when the shared-memory page is not open) */
+static CrDaStatsPage_t privatePage;
+
+/** The statistics page */
+static CrDaStatsPage_t* page = &privatePage;
+
+/** The name of the shared-memory statistics page (empty if the page is not open) */
+static char shmName[32] = "";
+
+/** The registered InStreams */
+static FwSmDesc_t inStreams[CR_DA_STATS_N_OF_LINKS];
+
+/** The number of registered InStreams */
+static unsigned int nOfInStreams = 0;
+
+/** The registered OutStreams */
+static FwSmDesc_t outStreams[CR_DA_STATS_N_OF_LINKS];
+
+/** The number of registered OutStreams */
+static unsigned int nOfOutStreams = 0;
+
+/** The registered InManagers */
+static FwSmDesc_t inManagers[CR_DA_STATS_N_OF_INSTANCES];
+
+/** The number of registered InManagers */
+static unsigned int nOfInManagers = 0;
+
+/** The registered OutManagers */
+static FwSmDesc_t outManagers[CR_DA_STATS_N_OF_INSTANCES];
+
+/** The number of registered OutManagers */
+static unsigned int nOfOutManagers = 0;
+
+/** The host time in nanoseconds at which the current control cycle was started */
+static unsigned long long cycleStartTime = 0;
+
+/**
+ * Update the high-water mark of a queue or list.
+ * @param occ the occupancy of the queue or list
+ * @param depth the current number of items in the queue or list
+ */
+static void updateHwm(CrDaStatsOcc_t* occ, unsigned int depth);
+
+/**
+ * Reset the high-water marks and the overflow counters of a set of queues or lists
+ * (their sizes are kept).
+ * @param occ the occupancies of the queues or lists
+ */
+static void resetOcc(CrDaStatsOcc_t* occ);
+
+/* ---------------------------------------------------------------------------------------------*/
+int CrDaStatsOpen(unsigned int appId) {
+	CrDaStatsPage_t* shmPage;
+	int fd;
+
+	CrDaStatsClose();
+	snprintf(shmName, sizeof(shmName), CR_DA_STATS_SHM_NAME, appId);
+	shm_unlink(shmName);
+	fd = shm_open(shmName, O_CREAT | O_RDWR, 0644);
+	if (fd < 0) {
+		perror("CrDaStatsOpen, shm_open");
+		shmName[0] = '\0';
+		return 0;
+	}
+	if (ftruncate(fd, sizeof(CrDaStatsPage_t)) < 0) {
+		perror("CrDaStatsOpen, ftruncate");
+		close(fd);
+		shm_unlink(shmName);
+		shmName[0] = '\0';
+		return 0;
+	}
+	shmPage = mmap(NULL, sizeof(CrDaStatsPage_t), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	close(fd);
+	if (shmPage == MAP_FAILED) {
+		perror("CrDaStatsOpen, mmap");
+		shm_unlink(shmName);
+		shmName[0] = '\0';
+		return 0;
+	}
+
+	/* The magic number is written last so that readers only see an initialized page */
+	memcpy(shmPage, page, sizeof(CrDaStatsPage_t));
+	shmPage->magic = 0;
+	shmPage->version = CR_DA_STATS_VERSION;
+	shmPage->appId = appId;
+	shmPage->pid = (uint32_t)getpid();
+	shmPage->magic = CR_DA_STATS_MAGIC;
+	page = shmPage;
+	return 1;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaStatsClose() {
+	if (page == &privatePage)
+		return;
+	memcpy(&privatePage, page, sizeof(CrDaStatsPage_t));
+	munmap(page, sizeof(CrDaStatsPage_t));
+	shm_unlink(shmName);
+	shmName[0] = '\0';
+	page = &privatePage;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaStatsAddStream(FwSmDesc_t stream, unsigned int pqSize) {
+	CrFwCmpData_t* streamData = (CrFwCmpData_t*)FwSmGetData(stream);
+
+	if (streamData->typeId == CR_FW_INSTREAM_TYPE) {
+		if (nOfInStreams < CR_DA_STATS_N_OF_LINKS)
+			inStreams[nOfInStreams++] = stream;
+		if (streamData->instanceId < CR_DA_STATS_N_OF_INSTANCES)
+			page->inStream[streamData->instanceId].size = pqSize;
+	} else {
+		if (nOfOutStreams < CR_DA_STATS_N_OF_LINKS)
+			outStreams[nOfOutStreams++] = stream;
+		if (streamData->instanceId < CR_DA_STATS_N_OF_INSTANCES)
+			page->outStream[streamData->instanceId].size = pqSize;
+	}
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaStatsAddManager(FwSmDesc_t manager, unsigned int listSize) {
+	CrFwCmpData_t* managerData = (CrFwCmpData_t*)FwSmGetData(manager);
+
+	if (managerData->instanceId >= CR_DA_STATS_N_OF_INSTANCES)
+		return;
+	if (managerData->typeId == CR_FW_INMANAGER_TYPE) {
+		inManagers[nOfInManagers++] = manager;
+		page->inManager[managerData->instanceId].size = listSize;
+	} else {
+		outManagers[nOfOutManagers++] = manager;
+		page->outManager[managerData->instanceId].size = listSize;
+	}
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaStatsStart() {
+	page->updateCnt = 0;
+	page->nOfCycles = 0;
+	page->lastCycleTime = 0;
+	page->maxCycleTime = 0;
+	page->totalCycleTime = 0;
+	page->nOfOverruns = 0;
+	page->nOfErrs = 0;
+	memset(page->nOfErrsByCode, 0, sizeof(page->nOfErrsByCode));
+	page->nOfCmdFails = 0;
+	page->appErrCode = 0;
+	page->nOfAllocatedPckts = CrFwPcktGetNOfAllocated();
+	page->pcktHwm = page->nOfAllocatedPckts;
+	page->pcktPoolSize = CR_FW_MAX_NOF_PCKTS;
+	page->outCmpHwm = 0;
+	page->outCmpPoolSize = CrFwOutFactoryGetMaxNOfOutCmp();
+	page->inCmdHwm = 0;
+	page->inCmdPoolSize = CrFwInFactoryGetMaxNOfInCmd();
+	page->inRepHwm = 0;
+	page->inRepPoolSize = CrFwInFactoryGetMaxNOfInRep();
+	memset(page->link, 0, sizeof(page->link));
+	page->nOfPcktAllocFails = 0;
+	resetOcc(page->inStream);
+	resetOcc(page->outStream);
+	resetOcc(page->inManager);
+	resetOcc(page->outManager);
+	page->startTime = CrDaClockGetHostTime();
+	page->updateTime = page->startTime;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaStatsStartCycle() {
+	cycleStartTime = CrDaClockGetHostTime();
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaStatsPcktIn(unsigned int src, unsigned int length) {
+	if (src >= CR_DA_STATS_N_OF_LINKS)
+		return;
+	page->link[src].pcktsIn++;
+	page->link[src].bytesIn += length;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaStatsPcktOut(unsigned int dest, unsigned int length) {
+	if (dest >= CR_DA_STATS_N_OF_LINKS)
+		return;
+	page->link[dest].pcktsOut++;
+	page->link[dest].bytesOut += length;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaStatsSetNOfAllocatedPckts(unsigned int nOfAllocated) {
+	page->nOfAllocatedPckts = nOfAllocated;
+	if (nOfAllocated > page->pcktHwm)
+		page->pcktHwm = nOfAllocated;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaStatsPcktAllocFail() {
+	page->nOfPcktAllocFails++;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaStatsRepErr(int errCode, int typeId, int instanceId) {
+	page->nOfErrs++;
+	if ((errCode >= 0) && (errCode < CR_DA_STATS_N_OF_ERR_CODES))
+		page->nOfErrsByCode[errCode]++;
+
+	/* Count the overflows of the queues and lists */
+	if ((instanceId < 0) || (instanceId >= CR_DA_STATS_N_OF_INSTANCES))
+		return;
+	if ((errCode == crInStreamPQFull) && (typeId == CR_FW_INSTREAM_TYPE))
+		page->inStream[instanceId].nOfOverflows++;
+	else if ((errCode == crOutStreamPQFull) && (typeId == CR_FW_OUTSTREAM_TYPE))
+		page->outStream[instanceId].nOfOverflows++;
+	else if ((errCode == crInManagerPcrlFull) && (typeId == CR_FW_INMANAGER_TYPE))
+		page->inManager[instanceId].nOfOverflows++;
+	else if ((errCode == crOutManagerPoclFull) && (typeId == CR_FW_OUTMANAGER_TYPE))
+		page->outManager[instanceId].nOfOverflows++;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaStatsCmdFail() {
+	page->nOfCmdFails++;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaStatsSample() {
+	CrFwCmpData_t* cmpData;
+	CrDaStatsLink_t* link;
+	unsigned int i, peer, depth;
+
+	/* Sample the packet queues of the streams */
+	for (i=0; i<nOfInStreams; i++) {
+		depth = CrFwInStreamGetNOfPendingPckts(inStreams[i]);
+		cmpData = (CrFwCmpData_t*)FwSmGetData(inStreams[i]);
+		if (cmpData->instanceId < CR_DA_STATS_N_OF_INSTANCES)
+			updateHwm(&page->inStream[cmpData->instanceId], depth);
+		peer = CrFwInStreamGetSrc(inStreams[i]);
+		if (peer >= CR_DA_STATS_N_OF_LINKS)
+			continue;
+		link = &page->link[peer];
+		link->inQueueDepth = depth;
+		if (link->inQueueDepth > link->inQueueHwm)
+			link->inQueueHwm = link->inQueueDepth;
+	}
+	for (i=0; i<nOfOutStreams; i++) {
+		depth = CrFwOutStreamGetNOfPendingPckts(outStreams[i]);
+		cmpData = (CrFwCmpData_t*)FwSmGetData(outStreams[i]);
+		if (cmpData->instanceId < CR_DA_STATS_N_OF_INSTANCES)
+			updateHwm(&page->outStream[cmpData->instanceId], depth);
+		peer = CrFwOutStreamGetDest(outStreams[i]);
+		if (peer >= CR_DA_STATS_N_OF_LINKS)
+			continue;
+		link = &page->link[peer];
+		link->outQueueDepth = depth;
+		if (link->outQueueDepth > link->outQueueHwm)
+			link->outQueueHwm = link->outQueueDepth;
+	}
+
+	/* Sample the pending lists of the managers */
+	for (i=0; i<nOfInManagers; i++) {
+		cmpData = (CrFwCmpData_t*)FwSmGetData(inManagers[i]);
+		updateHwm(&page->inManager[cmpData->instanceId], CrFwInManagerGetNOfPendingInCmp(inManagers[i]));
+	}
+	for (i=0; i<nOfOutManagers; i++) {
+		cmpData = (CrFwCmpData_t*)FwSmGetData(outManagers[i]);
+		updateHwm(&page->outManager[cmpData->instanceId], CrFwOutManagerGetNOfPendingOutCmp(outManagers[i]));
+	}
+
+	/* Sample the pools of the factories */
+	if (CrFwOutFactoryGetNOfAllocatedOutCmp() > page->outCmpHwm)
+		page->outCmpHwm = CrFwOutFactoryGetNOfAllocatedOutCmp();
+	if (CrFwInFactoryGetNOfAllocatedInCmd() > page->inCmdHwm)
+		page->inCmdHwm = CrFwInFactoryGetNOfAllocatedInCmd();
+	if (CrFwInFactoryGetNOfAllocatedInRep() > page->inRepHwm)
+		page->inRepHwm = CrFwInFactoryGetNOfAllocatedInRep();
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaStatsEndCycle() {
+	unsigned long long now = CrDaClockGetHostTime();
+
+	/* Measure the duration of the cycle */
+	page->nOfCycles++;
+	if (cycleStartTime != 0) {
+		page->lastCycleTime = now - cycleStartTime;
+		page->totalCycleTime += page->lastCycleTime;
+		if (page->lastCycleTime > page->maxCycleTime)
+			page->maxCycleTime = page->lastCycleTime;
+	}
+
+	CrDaStatsSample();
+
+	page->nOfOverruns = CrDaClockGetNOfOverruns();
+	page->appErrCode = (uint32_t)CrFwGetAppErrCode();
+	page->updateTime = now;
+	page->updateCnt++;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+const CrDaStatsPage_t* CrDaStatsGetPage() {
+	return page;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaStatsPrintSummary(const char* tag) {
+	unsigned long pcktsIn = 0, pcktsOut = 0;
+	double elapsed;
+	int i;
+
+	for (i=0; i<CR_DA_STATS_N_OF_LINKS; i++) {
+		pcktsIn += page->link[i].pcktsIn;
+		pcktsOut += page->link[i].pcktsOut;
+	}
+	elapsed = (double)(CrDaClockGetHostTime() - page->startTime)/1e9;
+	printf("%s: ---- Run summary ----\n", tag);
+	printf("%s: %lu cycles in %.3f s (%lu overruns, max cycle time %.3f ms)\n", tag,
+	       (unsigned long)page->nOfCycles, elapsed, (unsigned long)page->nOfOverruns, page->maxCycleTime/1e6);
+	if (elapsed > 0)
+		printf("%s: %lu packets received (%.1f/s), %lu packets sent (%.1f/s)\n", tag,
+		       pcktsIn, pcktsIn/elapsed, pcktsOut, pcktsOut/elapsed);
+	printf("%s: high-water marks: packets %u/%u, OutComponents %u/%u, InCommands %u/%u, InReports %u/%u\n", tag,
+	       page->pcktHwm, page->pcktPoolSize, page->outCmpHwm, page->outCmpPoolSize,
+	       page->inCmdHwm, page->inCmdPoolSize, page->inRepHwm, page->inRepPoolSize);
+	printf("%s: queue-full errors: OutStream %lu, InStream %lu, OutManager %lu, InManager %lu, no packet %lu\n", tag,
+	       (unsigned long)page->nOfErrsByCode[crOutStreamPQFull], (unsigned long)page->nOfErrsByCode[crInStreamPQFull],
+	       (unsigned long)page->nOfErrsByCode[crOutManagerPoclFull], (unsigned long)page->nOfErrsByCode[crInManagerPcrlFull],
+	       (unsigned long)page->nOfErrsByCode[crOutStreamNoMorePckt]);
+	printf("%s: %lu errors reported, %lu commands not generated\n", tag,
+	       (unsigned long)page->nOfErrs, (unsigned long)page->nOfCmdFails);
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static void updateHwm(CrDaStatsOcc_t* occ, unsigned int depth) {
+	if (depth > occ->hwm)
+		occ->hwm = depth;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static void resetOcc(CrDaStatsOcc_t* occ) {
+	int i;
+
+	for (i=0; i<CR_DA_STATS_N_OF_INSTANCES; i++) {
+		occ[i].hwm = 0;
+		occ[i].nOfOverflows = 0;
+	}
+}
@@ -0,0 +1,182 @@
+/**
+ * @file
+ * @ingroup crDemoCommon
+ * Run statistics of the demo applications.
+ * The run statistics are collected during a run of a demo application and are
+ * printed in a summary at its end.
+ * They are intended for soak and throughput tests in which the demo applications
+ * are driven by a run profile (see <code>CrDaProfile.h</code>).
+ *
+ * The run statistics cover:
+ * - The number of packets and bytes received from and sent to each peer application
+ *   (they are counted by the socket and loopback adapters together with their recording,
+ *   see <code>CrDaPcktRecorder.h</code>) and the resulting packet rates.
+ * - The depths and high-water marks of the packet queues of the InStreams and OutStreams
+ *   and of the pending lists of the InManagers and OutManagers, and the number of times
+ *   each of them was found full.
+ * - The number of allocated packets and the high-water marks of the packet pool (see
+ *   <code>CrFwPckt.c</code>) and of the pools of the OutFactory and of the InFactory.
+ * - The duration of the control cycles and the number of cycle overruns (see
+ *   <code>CrDaClock.h</code>).
+ * - The number of errors reported through <code>CrFwRepErr.h</code> per error code
+ *   (including the errors which indicate that a queue was full) and the application
+ *   error code.
+ * - The number of commands which could not be generated because the pool of the
+ *   OutFactory was exhausted and the number of packets which could not be allocated
+ *   because the packet pool was exhausted.
+ * .
+ * The occupancy of the queues and lists is sampled with <code>::CrDaStatsSample</code>.
+ * Since they fill and drain within a control cycle, the demo applications sample them
+ * at the points of the cycle where they are fullest: after the socket poll (the queues
+ * of the InStreams), after the InLoaders (the lists of the InManagers), before the
+ * OutManagers (their lists) and at the end of the cycle (the queues of the OutStreams).
+ * The high-water marks are the basis of the sizing report of <code>CrDaSizing.h</code>.
+ *
+ * The packet rates and the cycle durations are computed with the time of the host:
+ * in the simulation mode of the clock, they are the rates at which the host processes
+ * the packets.
+ *
+ * The run statistics are held in a shared-memory page (see <code>CrDaStatsPage.h</code>)
+ * which is opened with <code>::CrDaStatsOpen</code>.
+ * The counters are updated with plain stores and the page can be sampled at any time
+ * by an external tool (see <code>CrDaStatsMain.c</code>) without any cost for the
+ * application.
+ * If the page cannot be opened, the run statistics are held in a private page and are
+ * only available through the summary.
+ *
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the CORDET Framework.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#ifndef CRDA_STATS_H_
+#define CRDA_STATS_H_
+
+/* Include FW Profile files */
+#include "FwSmConstants.h"
+/* Include demo application files */
+#include "CrDaStatsPage.h"
+
+/**
+ * Open the shared-memory statistics page of an application.
+ * The page is created (or re-created) with the name <code>#CR_DA_STATS_SHM_NAME</code>.
+ * This function should be called at the start of the initialization of the application.
+ * @param appId the identifier of the application
+ * @return 1 if the shared-memory page was opened, 0 if the statistics are held in a private page
+ */
+int CrDaStatsOpen(unsigned int appId);
+
+/**
+ * Close the shared-memory statistics page and remove its name.
+ * The run statistics are then held in a private page.
+ */
+void CrDaStatsClose();
+
+/**
+ * Register an InStream or an OutStream whose packet queue is sampled.
+ * The peer application of the stream is its source (for an InStream) or its destination
+ * (for an OutStream).
+ * @param stream the InStream or OutStream
+ * @param pqSize the size of the packet queue of the stream (as configured in
+ * <code>CrFwInStreamUserPar.h</code> or <code>CrFwOutStreamUserPar.h</code>)
+ */
+void CrDaStatsAddStream(FwSmDesc_t stream, unsigned int pqSize);
+
+/**
+ * Register an InManager or an OutManager whose pending list is sampled.
+ * @param manager the InManager or OutManager
+ * @param listSize the size of the Pending Command/Report List of the InManager or of the
+ * Pending OutComponent List of the OutManager (as configured in <code>CrFwInManagerUserPar.h</code>
+ * or <code>CrFwOutManagerUserPar.h</code>)
+ */
+void CrDaStatsAddManager(FwSmDesc_t manager, unsigned int listSize);
+
+/**
+ * Reset the run statistics and start the measurement of the run time.
+ * This function is called at the end of the initialization of the application.
+ */
+void CrDaStatsStart();
+
+/**
+ * Start the measurement of the duration of a control cycle.
+ * This function is called at the start of each control cycle.
+ */
+void CrDaStatsStartCycle();
+
+/**
+ * Count a packet received by the application.
+ * @param src the identifier of the application from which the packet was received
+ * @param length the length of the packet in bytes
+ */
+void CrDaStatsPcktIn(unsigned int src, unsigned int length);
+
+/**
+ * Count a packet sent by the application.
+ * @param dest the identifier of the application to which the packet was sent
+ * @param length the length of the packet in bytes
+ */
+void CrDaStatsPcktOut(unsigned int dest, unsigned int length);
+
+/**
+ * Update the number of allocated packets and the high-water mark of the packet pool.
+ * This function is called whenever a packet is allocated or released.
+ * @param nOfAllocated the number of currently allocated packets
+ */
+void CrDaStatsSetNOfAllocatedPckts(unsigned int nOfAllocated);
+
+/**
+ * Count a packet allocation which failed because the packet pool was exhausted.
+ */
+void CrDaStatsPcktAllocFail();
+
+/**
+ * Count an error reported through <code>CrFwRepErr.h</code>.
+ * The errors which indicate that the packet queue of a stream or the pending list of
+ * a manager was full are also counted as overflows of that queue or list.
+ * @param errCode the error code
+ * @param typeId the type identifier of the component which reported the error
+ * @param instanceId the instance identifier of the component which reported the error
+ */
+void CrDaStatsRepErr(int errCode, int typeId, int instanceId);
+
+/**
+ * Count a command which could not be generated.
+ */
+void CrDaStatsCmdFail();
+
+/**
+ * Sample the packet queues of the registered streams, the pending lists of the registered
+ * managers and the pools of the OutFactory and of the InFactory and update their
+ * high-water marks.
+ */
+void CrDaStatsSample();
+
+/**
+ * Count the end of a control cycle.
+ * This function measures the duration of the cycle, samples the queues, lists and pools
+ * (see <code>::CrDaStatsSample</code>), the number of cycle overruns and the application
+ * error code and increments the update counter of the statistics page.
+ */
+void CrDaStatsEndCycle();
+
+/**
+ * Return the statistics page.
+ * @return the statistics page
+ */
+const CrDaStatsPage_t* CrDaStatsGetPage();
+
+/**
+ * Print the summary of the run statistics.
+ * @param tag the tag of the application with which the lines of the summary are prefixed
+ */
+void CrDaStatsPrintSummary(const char* tag);
+
+#endif /* CRDA_STATS_H_ */
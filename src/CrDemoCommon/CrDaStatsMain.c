@@ -0,0 +1,421 @@
+/**
+ * @file
+ * @ingroup crDemoCommon
+ *
+ * Reader tool for the statistics pages of the demo applications.
+ *
+ * This file provides the main program of the <code>cr_stats</code> tool which
+ * displays the run statistics which the demo applications publish in their
+ * shared-memory statistics pages (see <code>CrDaStatsPage.h</code>).
+ * The tool is called as follows:
+ * <pre>
+ *   cr_stats [-p] [-i interval] [-n count] [appId ...]
+ * </pre>
+ * where the <code>appId</code> arguments identify the applications whose statistics
+ * are displayed (by default, the Master, Slave 1 and Slave 2 Applications).
+ * By default, the tool displays the statistics in a table which is refreshed every
+ * <code>interval</code> milliseconds (1000 by default) until it is interrupted or
+ * until it has been refreshed <code>count</code> times.
+ * The packet rates in the table are computed from the difference between
+ * successive samples.
+ * With option <code>-p</code>, the tool prints the statistics once in the text
+ * exposition format of Prometheus (for instance, to be collected through the
+ * textfile collector of the node exporter).
+ *
+ * The statistics pages are mapped read-only: the tool does not interact with the
+ * applications and sampling their statistics has no cost for them.
+ *
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the CORDET Framework.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stddef.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <time.h>
+#include <sys/mman.h>
+/* Include demo application files */
+#include "CrDaStatsPage.h"
+
+/** The maximum number of applications which can be displayed */
+#define CR_DA_STATS_MAX_N_OF_APPS 8
+
+/** The default refresh interval in milliseconds */
+#define CR_DA_STATS_DEF_INTERVAL 1000
+
+/** An application whose statistics are displayed */
+typedef struct {
+	/** The identifier of the application */
+	unsigned int appId;
+	/** The mapped statistics page (NULL if the page is not mapped) */
+	const CrDaStatsPage_t* page;
+	/** The total number of packets received and sent at the previous sample */
+	uint64_t prevPckts;
+	/** The update time of the page at the previous sample */
+	uint64_t prevTime;
+} CrDaStatsApp_t;
+
+/** The applications whose statistics are displayed */
+static CrDaStatsApp_t apps[CR_DA_STATS_MAX_N_OF_APPS];
+
+/** The number of applications whose statistics are displayed */
+static int nOfApps = 0;
+
+/**
+ * Map the statistics page of an application if it is not yet mapped.
+ * A page whose magic number or version do not match is not mapped.
+ * @param app the application
+ * @return 1 if the page is mapped, 0 otherwise
+ */
+static int mapPage(CrDaStatsApp_t* app);
+
+/**
+ * Return the total number of packets received and sent by an application.
+ * @param page the statistics page of the application
+ * @return the total number of packets
+ */
+static uint64_t getNOfPckts(const CrDaStatsPage_t* page);
+
+/**
+ * Print the statistics of the applications as a table.
+ */
+static void printTable();
+
+/**
+ * Print the statistics of the applications in the text exposition format of Prometheus.
+ */
+static void printPrometheus();
+
+/**
+ * Print one metric of the applications in the text exposition format of Prometheus.
+ * @param name the name of the metric
+ * @param type the type of the metric ("counter" or "gauge")
+ * @param help the description of the metric
+ * @param offset the offset of the metric (a 64-bit field) in the statistics page
+ */
+static void printMetric(const char* name, const char* type, const char* help, size_t offset);
+
+/**
+ * Print one 32-bit metric of the applications in the text exposition format of Prometheus.
+ * @param name the name of the metric
+ * @param help the description of the metric
+ * @param offset the offset of the metric (a 32-bit field) in the statistics page
+ */
+static void printGauge32(const char* name, const char* help, size_t offset);
+
+/**
+ * Print the occupancy of the queues or lists of one component type of the applications
+ * in the text exposition format of Prometheus.
+ * @param cmp the name of the component type
+ * @param offset the offset of the occupancies of the component type in the statistics page
+ */
+static void printOcc(const char* cmp, size_t offset);
+
+/**
+ * Main program of the statistics reader tool.
+ * @param argc the number of command line arguments
+ * @param argv the command line arguments
+ * @return EXIT_SUCCESS if the statistics were displayed, EXIT_FAILURE otherwise
+ */
+int main(int argc, char* argv[]) {
+	struct timespec interval;
+	int prometheus = 0;
+	long intervalMs = CR_DA_STATS_DEF_INTERVAL;
+	long count = -1;
+	int opt, i;
+
+	while ((opt = getopt(argc, argv, "pi:n:")) != -1) {
+		switch (opt) {
+			case 'p':
+				prometheus = 1;
+				break;
+			case 'i':
+				intervalMs = atol(optarg);
+				break;
+			case 'n':
+				count = atol(optarg);
+				break;
+			default:
+				printf("Usage: %s [-p] [-i interval] [-n count] [appId ...]\n", argv[0]);
+				return EXIT_FAILURE;
+		}
+	}
+	if (intervalMs <= 0)
+		intervalMs = CR_DA_STATS_DEF_INTERVAL;
+
+	for (i=optind; (i<argc) && (nOfApps<CR_DA_STATS_MAX_N_OF_APPS); i++)
+		apps[nOfApps++].appId = (unsigned int)atoi(argv[i]);
+	if (nOfApps == 0)
+		for (i=1; i<=3; i++)
+			apps[nOfApps++].appId = (unsigned int)i;
+
+	if (prometheus) {
+		for (i=0; i<nOfApps; i++)
+			mapPage(&apps[i]);
+		printPrometheus();
+		return EXIT_SUCCESS;
+	}
+
+	interval.tv_sec = intervalMs/1000;
+	interval.tv_nsec = (intervalMs%1000)*1000000L;
+	while (count != 0) {
+		for (i=0; i<nOfApps; i++)
+			mapPage(&apps[i]);
+		printTable();
+		if (count > 0)
+			count--;
+		if (count != 0)
+			nanosleep(&interval, NULL);
+	}
+	return EXIT_SUCCESS;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static int mapPage(CrDaStatsApp_t* app) {
+	char name[32];
+	const CrDaStatsPage_t* page;
+	int fd;
+
+	if (app->page != NULL)
+		return 1;
+
+	snprintf(name, sizeof(name), CR_DA_STATS_SHM_NAME, app->appId);
+	fd = shm_open(name, O_RDONLY, 0);
+	if (fd < 0)
+		return 0;
+	page = mmap(NULL, sizeof(CrDaStatsPage_t), PROT_READ, MAP_SHARED, fd, 0);
+	close(fd);
+	if (page == MAP_FAILED)
+		return 0;
+	if ((page->magic != CR_DA_STATS_MAGIC) || (page->version != CR_DA_STATS_VERSION)) {
+		munmap((void*)page, sizeof(CrDaStatsPage_t));
+		return 0;
+	}
+	app->page = page;
+	app->prevPckts = getNOfPckts(page);
+	app->prevTime = page->updateTime;
+	return 1;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static uint64_t getNOfPckts(const CrDaStatsPage_t* page) {
+	uint64_t n = 0;
+	int i;
+
+	for (i=0; i<CR_DA_STATS_N_OF_LINKS; i++)
+		n += page->link[i].pcktsIn + page->link[i].pcktsOut;
+	return n;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static void printTable() {
+	const CrDaStatsPage_t* page;
+	const CrDaStatsLink_t* link;
+	uint64_t nOfPckts, avgCycleTime;
+	double rate;
+	int i, j;
+
+	/* Clear the screen and move the cursor to its top-left corner */
+	printf("\033[H\033[2J");
+	printf("CORDET Demo Statistics\n\n");
+	printf("%-4s %7s %8s %9s %9s %5s %9s %10s %7s %7s %6s %7s\n", "APP", "PID", "CYCLES", "CYC(us)",
+	       "MAX(us)", "OVR", "PCKTS", "PCKT/s", "POOL", "HWM", "ERRS", "APPERR");
+	for (i=0; i<nOfApps; i++) {
+		page = apps[i].page;
+		if (page == NULL) {
+			printf("%-4u %7s (not running)\n", apps[i].appId, "-");
+			continue;
+		}
+		nOfPckts = getNOfPckts(page);
+		rate = 0;
+		if (page->updateTime > apps[i].prevTime)
+			rate = (double)(nOfPckts - apps[i].prevPckts)*1e9/(double)(page->updateTime - apps[i].prevTime);
+		apps[i].prevPckts = nOfPckts;
+		apps[i].prevTime = page->updateTime;
+		avgCycleTime = (page->nOfCycles > 0 ? page->totalCycleTime/page->nOfCycles : 0);
+		printf("%-4u %7u %8lu %9lu %9lu %5lu %9lu %10.1f %3u/%-3u %3u/%-3u %6lu %7u\n",
+		       page->appId, page->pid, (unsigned long)page->nOfCycles, (unsigned long)(avgCycleTime/1000),
+		       (unsigned long)(page->maxCycleTime/1000), (unsigned long)page->nOfOverruns,
+		       (unsigned long)nOfPckts, rate, page->nOfAllocatedPckts, page->pcktPoolSize,
+		       page->pcktHwm, page->pcktPoolSize, (unsigned long)page->nOfErrs, page->appErrCode);
+	}
+
+	printf("\n%-4s %-4s %9s %10s %9s %10s %9s %9s\n", "APP", "PEER", "PCKTS-IN", "BYTES-IN", "PCKTS-OUT",
+	       "BYTES-OUT", "INQ/HWM", "OUTQ/HWM");
+	for (i=0; i<nOfApps; i++) {
+		page = apps[i].page;
+		if (page == NULL)
+			continue;
+		for (j=0; j<CR_DA_STATS_N_OF_LINKS; j++) {
+			link = &page->link[j];
+			if ((link->pcktsIn == 0) && (link->pcktsOut == 0) && (link->inQueueHwm == 0) && (link->outQueueHwm == 0))
+				continue;
+			printf("%-4u %-4d %9lu %10lu %9lu %10lu %4u/%-4u %4u/%-4u\n", page->appId, j,
+			       (unsigned long)link->pcktsIn, (unsigned long)link->bytesIn,
+			       (unsigned long)link->pcktsOut, (unsigned long)link->bytesOut,
+			       link->inQueueDepth, link->inQueueHwm, link->outQueueDepth, link->outQueueHwm);
+		}
+	}
+	fflush(stdout);
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static void printPrometheus() {
+	const CrDaStatsPage_t* page;
+	const CrDaStatsLink_t* link;
+	int i, j;
+
+	printf("# HELP cr_da_up Whether the statistics page of the application is available\n");
+	printf("# TYPE cr_da_up gauge\n");
+	for (i=0; i<nOfApps; i++)
+		printf("cr_da_up{app=\"%u\"} %d\n", apps[i].appId, (apps[i].page != NULL));
+
+	printMetric("cr_da_updates_total", "counter", "Number of updates of the statistics page",
+	            offsetof(CrDaStatsPage_t, updateCnt));
+	printMetric("cr_da_cycles_total", "counter", "Number of executed control cycles",
+	            offsetof(CrDaStatsPage_t, nOfCycles));
+	printMetric("cr_da_cycle_time_last_ns", "gauge", "Duration of the last control cycle in nanoseconds",
+	            offsetof(CrDaStatsPage_t, lastCycleTime));
+	printMetric("cr_da_cycle_time_max_ns", "gauge", "Maximum duration of a control cycle in nanoseconds",
+	            offsetof(CrDaStatsPage_t, maxCycleTime));
+	printMetric("cr_da_cycle_time_ns_total", "counter", "Total duration of the control cycles in nanoseconds",
+	            offsetof(CrDaStatsPage_t, totalCycleTime));
+	printMetric("cr_da_cycle_overruns_total", "counter", "Number of cycle overruns",
+	            offsetof(CrDaStatsPage_t, nOfOverruns));
+	printMetric("cr_da_errors_total", "counter", "Number of errors reported through CrFwRepErr",
+	            offsetof(CrDaStatsPage_t, nOfErrs));
+	printMetric("cr_da_cmd_failures_total", "counter", "Number of commands which could not be generated",
+	            offsetof(CrDaStatsPage_t, nOfCmdFails));
+	printGauge32("cr_da_app_error_code", "Application error code at the end of the last control cycle",
+	             offsetof(CrDaStatsPage_t, appErrCode));
+	printGauge32("cr_da_pckts_allocated", "Number of allocated packets",
+	             offsetof(CrDaStatsPage_t, nOfAllocatedPckts));
+	printGauge32("cr_da_pckts_allocated_hwm", "High-water mark of the packet pool",
+	             offsetof(CrDaStatsPage_t, pcktHwm));
+	printGauge32("cr_da_pckt_pool_size", "Size of the packet pool",
+	             offsetof(CrDaStatsPage_t, pcktPoolSize));
+	printGauge32("cr_da_outcmp_hwm", "High-water mark of the pool of the OutFactory",
+	             offsetof(CrDaStatsPage_t, outCmpHwm));
+	printGauge32("cr_da_incmd_hwm", "High-water mark of the InCommand pool of the InFactory",
+	             offsetof(CrDaStatsPage_t, inCmdHwm));
+	printGauge32("cr_da_inrep_hwm", "High-water mark of the InReport pool of the InFactory",
+	             offsetof(CrDaStatsPage_t, inRepHwm));
+	printMetric("cr_da_pckt_alloc_failures_total", "counter", "Number of packets which could not be allocated",
+	            offsetof(CrDaStatsPage_t, nOfPcktAllocFails));
+
+	printf("# HELP cr_da_occupancy_size Size of the queue or list of a component\n");
+	printf("# TYPE cr_da_occupancy_size gauge\n");
+	printf("# HELP cr_da_occupancy_hwm High-water mark of the queue or list of a component\n");
+	printf("# TYPE cr_da_occupancy_hwm gauge\n");
+	printf("# HELP cr_da_occupancy_overflows_total Number of times the queue or list of a component was full\n");
+	printf("# TYPE cr_da_occupancy_overflows_total counter\n");
+	printOcc("InStream", offsetof(CrDaStatsPage_t, inStream));
+	printOcc("OutStream", offsetof(CrDaStatsPage_t, outStream));
+	printOcc("InManager", offsetof(CrDaStatsPage_t, inManager));
+	printOcc("OutManager", offsetof(CrDaStatsPage_t, outManager));
+
+	printf("# HELP cr_da_errors_by_code_total Number of errors reported through CrFwRepErr per error code\n");
+	printf("# TYPE cr_da_errors_by_code_total counter\n");
+	for (i=0; i<nOfApps; i++) {
+		page = apps[i].page;
+		if (page == NULL)
+			continue;
+		for (j=0; j<CR_DA_STATS_N_OF_ERR_CODES; j++)
+			if (page->nOfErrsByCode[j] != 0)
+				printf("cr_da_errors_by_code_total{app=\"%u\",code=\"%d\"} %lu\n", page->appId, j,
+				       (unsigned long)page->nOfErrsByCode[j]);
+	}
+
+	printf("# HELP cr_da_link_packets_total Number of packets exchanged with a peer application\n");
+	printf("# TYPE cr_da_link_packets_total counter\n");
+	printf("# HELP cr_da_link_bytes_total Number of bytes exchanged with a peer application\n");
+	printf("# TYPE cr_da_link_bytes_total counter\n");
+	printf("# HELP cr_da_link_queue_depth Number of packets in the queue of the stream of a peer application\n");
+	printf("# TYPE cr_da_link_queue_depth gauge\n");
+	printf("# HELP cr_da_link_queue_hwm High-water mark of the queue of the stream of a peer application\n");
+	printf("# TYPE cr_da_link_queue_hwm gauge\n");
+	for (i=0; i<nOfApps; i++) {
+		page = apps[i].page;
+		if (page == NULL)
+			continue;
+		for (j=0; j<CR_DA_STATS_N_OF_LINKS; j++) {
+			link = &page->link[j];
+			if ((link->pcktsIn == 0) && (link->pcktsOut == 0) && (link->inQueueHwm == 0) && (link->outQueueHwm == 0))
+				continue;
+			printf("cr_da_link_packets_total{app=\"%u\",peer=\"%d\",dir=\"in\"} %lu\n", page->appId, j,
+			       (unsigned long)link->pcktsIn);
+			printf("cr_da_link_packets_total{app=\"%u\",peer=\"%d\",dir=\"out\"} %lu\n", page->appId, j,
+			       (unsigned long)link->pcktsOut);
+			printf("cr_da_link_bytes_total{app=\"%u\",peer=\"%d\",dir=\"in\"} %lu\n", page->appId, j,
+			       (unsigned long)link->bytesIn);
+			printf("cr_da_link_bytes_total{app=\"%u\",peer=\"%d\",dir=\"out\"} %lu\n", page->appId, j,
+			       (unsigned long)link->bytesOut);
+			printf("cr_da_link_queue_depth{app=\"%u\",peer=\"%d\",dir=\"in\"} %u\n", page->appId, j,
+			       link->inQueueDepth);
+			printf("cr_da_link_queue_depth{app=\"%u\",peer=\"%d\",dir=\"out\"} %u\n", page->appId, j,
+			       link->outQueueDepth);
+			printf("cr_da_link_queue_hwm{app=\"%u\",peer=\"%d\",dir=\"in\"} %u\n", page->appId, j,
+			       link->inQueueHwm);
+			printf("cr_da_link_queue_hwm{app=\"%u\",peer=\"%d\",dir=\"out\"} %u\n", page->appId, j,
+			       link->outQueueHwm);
+		}
+	}
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static void printMetric(const char* name, const char* type, const char* help, size_t offset) {
+	int i;
+
+	printf("# HELP %s %s\n", name, help);
+	printf("# TYPE %s %s\n", name, type);
+	for (i=0; i<nOfApps; i++)
+		if (apps[i].page != NULL)
+			printf("%s{app=\"%u\"} %lu\n", name, apps[i].appId,
+			       (unsigned long)*(const uint64_t*)((const char*)apps[i].page + offset));
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static void printGauge32(const char* name, const char* help, size_t offset) {
+	int i;
+
+	printf("# HELP %s %s\n", name, help);
+	printf("# TYPE %s gauge\n", name);
+	for (i=0; i<nOfApps; i++)
+		if (apps[i].page != NULL)
+			printf("%s{app=\"%u\"} %u\n", name, apps[i].appId,
+			       *(const uint32_t*)((const char*)apps[i].page + offset));
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static void printOcc(const char* cmp, size_t offset) {
+	const CrDaStatsOcc_t* occ;
+	int i, j;
+
+	for (i=0; i<nOfApps; i++) {
+		if (apps[i].page == NULL)
+			continue;
+		occ = (const CrDaStatsOcc_t*)((const char*)apps[i].page + offset);
+		for (j=0; j<CR_DA_STATS_N_OF_INSTANCES; j++) {
+			if (occ[j].size == 0)
+				continue;
+			printf("cr_da_occupancy_size{app=\"%u\",cmp=\"%s\",instance=\"%d\"} %u\n", apps[i].appId,
+			       cmp, j, occ[j].size);
+			printf("cr_da_occupancy_hwm{app=\"%u\",cmp=\"%s\",instance=\"%d\"} %u\n", apps[i].appId,
+			       cmp, j, occ[j].hwm);
+			printf("cr_da_occupancy_overflows_total{app=\"%u\",cmp=\"%s\",instance=\"%d\"} %lu\n",
+			       apps[i].appId, cmp, j, (unsigned long)occ[j].nOfOverflows);
+		}
+	}
+}
@@ -0,0 +1,153 @@
+/**
+ * @file
+ * @ingroup crDemoCommon
+ * Layout of the shared-memory statistics page of the demo applications.
+ * Each demo application keeps its run statistics (see <code>CrDaStats.h</code>)
+ * in a page of shared memory which is created with <code>shm_open</code> under
+ * the name <code>#CR_DA_STATS_SHM_NAME</code> (formatted with the identifier of the
+ * application).
+ * The application updates the page with plain stores from its control thread and
+ * without any system call.
+ * External tools (see <code>CrDaStatsMain.c</code>) map the page read-only and
+ * sample it at any time.
+ *
+ * The page is not protected by a lock.
+ * Its counters are updated individually and a reader may see a page which is
+ * partially updated; the field <code>updateCnt</code> is incremented at the end of
+ * every control cycle and allows a reader to detect whether the application is alive.
+ * This interface only uses plain C types so that it can also be used by tools
+ * which are not linked with the framework.
+ *
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the CORDET Framework.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#ifndef CRDA_STATSPAGE_H_
+#define CRDA_STATSPAGE_H_
+
+#include <stdint.h>
+
+/** The name of the shared-memory object of the statistics page (formatted with the application identifier) */
+#define CR_DA_STATS_SHM_NAME "/cr_da_stats_%u"
+
+/** The magic number at the start of a statistics page ("CRST") */
+#define CR_DA_STATS_MAGIC 0x43525354
+
+/** The version of the layout of the statistics page */
+#define CR_DA_STATS_VERSION 3
+
+/** The number of links in a statistics page (the identifiers of the peer applications and of the broadcast destination must be smaller than this value) */
+#define CR_DA_STATS_N_OF_LINKS 5
+
+/** The number of error codes which are counted individually (larger error codes are only counted in the total) */
+#define CR_DA_STATS_N_OF_ERR_CODES 16
+
+/** The number of InStreams, OutStreams, InManagers and OutManagers whose occupancy is tracked (the instance identifiers must be smaller than this value) */
+#define CR_DA_STATS_N_OF_INSTANCES 4
+
+/** The occupancy of the packet queue of a stream or of the pending list of a manager. */
+typedef struct {
+	/** The size of the queue or list (zero if the component is not tracked) */
+	uint32_t size;
+	/** The high-water mark of the queue or list */
+	uint32_t hwm;
+	/** The number of times the queue or list was found full */
+	uint64_t nOfOverflows;
+} CrDaStatsOcc_t;
+
+/** The statistics of the link between the application and one peer application. */
+typedef struct {
+	/** The number of packets received from the peer application */
+	uint64_t pcktsIn;
+	/** The number of bytes received from the peer application */
+	uint64_t bytesIn;
+	/** The number of packets sent to the peer application */
+	uint64_t pcktsOut;
+	/** The number of bytes sent to the peer application */
+	uint64_t bytesOut;
+	/** The number of packets in the queue of the InStream from the peer application */
+	uint32_t inQueueDepth;
+	/** The high-water mark of the queue of the InStream from the peer application */
+	uint32_t inQueueHwm;
+	/** The number of packets in the queue of the OutStream to the peer application */
+	uint32_t outQueueDepth;
+	/** The high-water mark of the queue of the OutStream to the peer application */
+	uint32_t outQueueHwm;
+} CrDaStatsLink_t;
+
+/** The statistics page of an application. */
+typedef struct {
+	/** The magic number (<code>#CR_DA_STATS_MAGIC</code>) */
+	uint32_t magic;
+	/** The version of the layout (<code>#CR_DA_STATS_VERSION</code>) */
+	uint32_t version;
+	/** The identifier of the application */
+	uint32_t appId;
+	/** The process identifier of the application */
+	uint32_t pid;
+	/** The number of updates of the page (incremented at the end of every control cycle) */
+	uint64_t updateCnt;
+	/** The host time in nanoseconds at which the collection of the statistics was started */
+	uint64_t startTime;
+	/** The host time in nanoseconds of the last update of the page */
+	uint64_t updateTime;
+	/** The number of executed control cycles */
+	uint64_t nOfCycles;
+	/** The duration in nanoseconds of the last control cycle */
+	uint64_t lastCycleTime;
+	/** The maximum duration in nanoseconds of a control cycle */
+	uint64_t maxCycleTime;
+	/** The total duration in nanoseconds of the control cycles */
+	uint64_t totalCycleTime;
+	/** The number of cycle overruns */
+	uint64_t nOfOverruns;
+	/** The number of reported errors */
+	uint64_t nOfErrs;
+	/** The number of reported errors per error code */
+	uint64_t nOfErrsByCode[CR_DA_STATS_N_OF_ERR_CODES];
+	/** The number of commands which could not be generated */
+	uint64_t nOfCmdFails;
+	/** The application error code at the end of the last control cycle */
+	uint32_t appErrCode;
+	/** The number of currently allocated packets */
+	uint32_t nOfAllocatedPckts;
+	/** The high-water mark of the packet pool */
+	uint32_t pcktHwm;
+	/** The size of the packet pool */
+	uint32_t pcktPoolSize;
+	/** The high-water mark of the pool of the OutFactory */
+	uint32_t outCmpHwm;
+	/** The size of the pool of the OutFactory */
+	uint32_t outCmpPoolSize;
+	/** The high-water mark of the InCommand pool of the InFactory */
+	uint32_t inCmdHwm;
+	/** The size of the InCommand pool of the InFactory */
+	uint32_t inCmdPoolSize;
+	/** The high-water mark of the InReport pool of the InFactory */
+	uint32_t inRepHwm;
+	/** The size of the InReport pool of the InFactory */
+	uint32_t inRepPoolSize;
+	/** The statistics of the links to the peer applications (indexed by application identifier) */
+	CrDaStatsLink_t link[CR_DA_STATS_N_OF_LINKS];
+	/** The number of packet allocations which failed because the packet pool was exhausted */
+	uint64_t nOfPcktAllocFails;
+	/** The occupancy of the packet queues of the InStreams (indexed by instance identifier) */
+	CrDaStatsOcc_t inStream[CR_DA_STATS_N_OF_INSTANCES];
+	/** The occupancy of the packet queues of the OutStreams (indexed by instance identifier) */
+	CrDaStatsOcc_t outStream[CR_DA_STATS_N_OF_INSTANCES];
+	/** The occupancy of the Pending Command/Report Lists of the InManagers (indexed by instance identifier) */
+	CrDaStatsOcc_t inManager[CR_DA_STATS_N_OF_INSTANCES];
+	/** The occupancy of the Pending OutComponent Lists of the OutManagers (indexed by instance identifier) */
+	CrDaStatsOcc_t outManager[CR_DA_STATS_N_OF_INSTANCES];
+} CrDaStatsPage_t;
+
+#endif /* CRDA_STATSPAGE_H_ */
@@ -0,0 +1,222 @@
+/**
+ * @file
+ * @ingroup crDemoCommon
+ *
+ * Implementation of the multi-channel temperature monitoring logic.
+ *
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the CORDET Framework.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#include "CrDaTempChannelMonitor.h"
+
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+/**
+ * Compute the violation bits of 32 consecutive channels.
+ * @param temp the temperatures of the 32 channels
+ * @param lowerLimit the lower limits of the 32 channels
+ * @param upperLimit the upper limits of the 32 channels
+ * @return the violation bits of the 32 channels
+ */
+static unsigned int checkWord(const signed char* temp, const signed char* lowerLimit,
+                              const signed char* upperLimit);
+
+/**
+ * Compute the violation bits of up to 32 consecutive channels with scalar comparisons.
+ * @param temp the temperatures of the channels
+ * @param lowerLimit the lower limits of the channels
+ * @param upperLimit the upper limits of the channels
+ * @param n the number of channels (not greater than 32)
+ * @return the violation bits of the channels
+ */
+static unsigned int checkWordScalar(const signed char* temp, const signed char* lowerLimit,
+                                    const signed char* upperLimit, unsigned int n);
+
+/**
+ * Return the index of the first channel whose bit is set in a bitmask at or after the given channel.
+ * @param mask the bitmask
+ * @param nOfChannels the number of channels
+ * @param channel the channel from which the scan starts
+ * @return the index of the first channel whose bit is set or the number of channels if there is none
+ */
+static unsigned int nextSetBit(const unsigned int* mask, unsigned int nOfChannels, unsigned int channel);
+
+/* ---------------------------------------------------------------------- */
+void CrDaTempChannelMonitorInit(CrDaTempChannels_t* channels, unsigned int nOfChannels, signed char* temp,
+                                signed char* lowerLimit, signed char* upperLimit, unsigned int* violationMask,
+                                unsigned int* pendingMask, signed char* pendingTemp) {
+	unsigned int i;
+
+	channels->nOfChannels = nOfChannels;
+	channels->temp = temp;
+	channels->lowerLimit = lowerLimit;
+	channels->upperLimit = upperLimit;
+	channels->violationMask = violationMask;
+	channels->nOfViolations = 0;
+	channels->nextReportChannel = 0;
+	channels->pendingMask = pendingMask;
+	channels->pendingTemp = pendingTemp;
+	channels->nOfPendingViolations = 0;
+	for (i=0; i<nOfChannels; i++) {
+		temp[i] = 0;
+		lowerLimit[i] = -128;
+		upperLimit[i] = 127;
+		pendingTemp[i] = 0;
+	}
+	for (i=0; i<CR_DA_TEMP_CHANNEL_MASK_SIZE(nOfChannels); i++) {
+		violationMask[i] = 0;
+		pendingMask[i] = 0;
+	}
+}
+
+/* ---------------------------------------------------------------------- */
+void CrDaTempChannelMonitorSetLimits(CrDaTempChannels_t* channels, unsigned int channel,
+                                     signed char lowerLimit, signed char upperLimit) {
+	channels->lowerLimit[channel] = lowerLimit;
+	channels->upperLimit[channel] = upperLimit;
+}
+
+/* ---------------------------------------------------------------------- */
+unsigned int CrDaTempChannelMonitorCheck(CrDaTempChannels_t* channels) {
+	unsigned int nOfFullWords = channels->nOfChannels / 32;
+	unsigned int nOfViolations = 0;
+	unsigned int word;
+	unsigned int i;
+
+	for (i=0; i<nOfFullWords; i++) {
+		word = checkWord(channels->temp+i*32, channels->lowerLimit+i*32, channels->upperLimit+i*32);
+		channels->violationMask[i] = word;
+		nOfViolations += (unsigned int)__builtin_popcount(word);
+	}
+	if ((channels->nOfChannels % 32) != 0) {
+		word = checkWordScalar(channels->temp+i*32, channels->lowerLimit+i*32, channels->upperLimit+i*32,
+		                       channels->nOfChannels % 32);
+		channels->violationMask[i] = word;
+		nOfViolations += (unsigned int)__builtin_popcount(word);
+	}
+	channels->nOfViolations = nOfViolations;
+	return nOfViolations;
+}
+
+/* ---------------------------------------------------------------------- */
+unsigned int CrDaTempChannelMonitorNextViolation(CrDaTempChannels_t* channels, unsigned int channel) {
+	return nextSetBit(channels->violationMask, channels->nOfChannels, channel);
+}
+
+/* ---------------------------------------------------------------------- */
+unsigned int CrDaTempChannelMonitorFold(CrDaTempChannels_t* channels) {
+	unsigned int channel;
+	unsigned int word;
+	unsigned int i;
+
+	for (i=0; i<CR_DA_TEMP_CHANNEL_MASK_SIZE(channels->nOfChannels); i++) {
+		word = channels->violationMask[i];
+		channels->pendingMask[i] |= word;
+		while (word != 0) {
+			channel = i*32 + (unsigned int)__builtin_ctz(word);
+			channels->pendingTemp[channel] = channels->temp[channel];
+			word &= word - 1;
+		}
+	}
+	channels->nOfPendingViolations += channels->nOfViolations;
+	return channels->nOfPendingViolations;
+}
+
+/* ---------------------------------------------------------------------- */
+unsigned int CrDaTempChannelMonitorNextPending(CrDaTempChannels_t* channels, unsigned int channel) {
+	return nextSetBit(channels->pendingMask, channels->nOfChannels, channel);
+}
+
+/* ---------------------------------------------------------------------- */
+void CrDaTempChannelMonitorClearPending(CrDaTempChannels_t* channels) {
+	unsigned int i;
+
+	for (i=0; i<CR_DA_TEMP_CHANNEL_MASK_SIZE(channels->nOfChannels); i++)
+		channels->pendingMask[i] = 0;
+	channels->nOfPendingViolations = 0;
+}
+
+/* ---------------------------------------------------------------------- */
+const char* CrDaTempChannelMonitorGetImpl() {
+#if defined(__AVX2__)
+	return "AVX2";
+#elif defined(__SSE2__)
+	return "SSE2";
+#else
+	return "scalar";
+#endif
+}
+
+#if defined(__AVX2__)
+/* ---------------------------------------------------------------------- */
+static unsigned int checkWord(const signed char* temp, const signed char* lowerLimit,
+                              const signed char* upperLimit) {
+	__m256i t = _mm256_loadu_si256((const __m256i*)temp);
+	__m256i lo = _mm256_loadu_si256((const __m256i*)lowerLimit);
+	__m256i hi = _mm256_loadu_si256((const __m256i*)upperLimit);
+	__m256i viol = _mm256_or_si256(_mm256_cmpgt_epi8(lo, t), _mm256_cmpgt_epi8(t, hi));
+	return (unsigned int)_mm256_movemask_epi8(viol);
+}
+#elif defined(__SSE2__)
+/* ---------------------------------------------------------------------- */
+static unsigned int checkWord(const signed char* temp, const signed char* lowerLimit,
+                              const signed char* upperLimit) {
+	__m128i t0 = _mm_loadu_si128((const __m128i*)temp);
+	__m128i t1 = _mm_loadu_si128((const __m128i*)(temp+16));
+	__m128i lo0 = _mm_loadu_si128((const __m128i*)lowerLimit);
+	__m128i lo1 = _mm_loadu_si128((const __m128i*)(lowerLimit+16));
+	__m128i hi0 = _mm_loadu_si128((const __m128i*)upperLimit);
+	__m128i hi1 = _mm_loadu_si128((const __m128i*)(upperLimit+16));
+	__m128i viol0 = _mm_or_si128(_mm_cmpgt_epi8(lo0, t0), _mm_cmpgt_epi8(t0, hi0));
+	__m128i viol1 = _mm_or_si128(_mm_cmpgt_epi8(lo1, t1), _mm_cmpgt_epi8(t1, hi1));
+	return (unsigned int)_mm_movemask_epi8(viol0) | ((unsigned int)_mm_movemask_epi8(viol1) << 16);
+}
+#else
+/* ---------------------------------------------------------------------- */
+static unsigned int checkWord(const signed char* temp, const signed char* lowerLimit,
+                              const signed char* upperLimit) {
+	return checkWordScalar(temp, lowerLimit, upperLimit, 32);
+}
+#endif
+
+/* ---------------------------------------------------------------------- */
+static unsigned int checkWordScalar(const signed char* temp, const signed char* lowerLimit,
+                                    const signed char* upperLimit, unsigned int n) {
+	unsigned int word = 0;
+	unsigned int i;
+
+	for (i=0; i<n; i++)
+		if ((temp[i] < lowerLimit[i]) || (temp[i] > upperLimit[i]))
+			word |= (1u << i);
+	return word;
+}
+
+/* ---------------------------------------------------------------------- */
+static unsigned int nextSetBit(const unsigned int* mask, unsigned int nOfChannels, unsigned int channel) {
+	unsigned int i = channel / 32;
+	unsigned int word;
+
+	if (channel >= nOfChannels)
+		return nOfChannels;
+
+	word = mask[i] & (0xFFFFFFFFu << (channel % 32));
+	while (word == 0) {
+		i++;
+		if (i >= CR_DA_TEMP_CHANNEL_MASK_SIZE(nOfChannels))
+			return nOfChannels;
+		word = mask[i];
+	}
+	return i*32 + (unsigned int)__builtin_ctz(word);
+}
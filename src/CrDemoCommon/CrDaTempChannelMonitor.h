@@ -0,0 +1,164 @@
+/**
+ * @file
+ * @ingroup crDemoCommon
+ * Multi-channel temperature monitoring logic in the slave applications.
+ * This module extends the single-temperature monitoring of <code>CrDaTempMonitor.h</code>
+ * to an array of temperature channels.
+ * Each channel has its own lower and upper limit and a channel is in violation if
+ * its temperature is strictly below its lower limit or strictly above its upper limit.
+ *
+ * The channel data are held in structure-of-arrays form: the temperatures, the lower
+ * limits and the upper limits are held in three separate arrays of type
+ * <code>signed char</code> (temperatures are integers in the range -128 to 127).
+ * The storage for the arrays is provided by the user of this module.
+ * This allows the comparison of the temperatures against their limits to process 16
+ * (SSE2) or 32 (AVX2) channels with one instruction.
+ * The SIMD implementation is selected at compile time: AVX2 is used if
+ * <code>__AVX2__</code> is defined (e.g. when compiling with <code>-mavx2</code>),
+ * SSE2 is used if <code>__SSE2__</code> is defined (the default on x86-64) and
+ * a scalar implementation is used otherwise.
+ *
+ * The outcome of the comparison is a violation bitmask with one bit per channel:
+ * bit <code>(i%32)</code> of word <code>(i/32)</code> of the mask is set if channel
+ * <code>i</code> is in violation.
+ * Only the channels whose bit is set are reported to the Master Application
+ * (see <code>::CrDaTempMonitoringExecChannels</code>).
+ *
+ * This module only holds the comparison logic: it does not depend on the framework
+ * components and it is also used by the <code>cr_monbench</code> benchmark tool
+ * (see <code>CrDaMonBenchMain.c</code>).
+ *
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the CORDET Framework.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#ifndef CRDA_TEMPCHANNELMONITOR_H_
+#define CRDA_TEMPCHANNELMONITOR_H_
+
+/* Include Framework Files */
+#include "CrFwConstants.h"
+/* Include Configuration Files */
+#include "CrFwUserConstants.h"
+
+/**
+ * Return the number of words in the violation bitmask for the given number of channels.
+ * @param nOfChannels the number of channels
+ */
+#define CR_DA_TEMP_CHANNEL_MASK_SIZE(nOfChannels) (((nOfChannels)+31)/32)
+
+/** Descriptor of an array of temperature channels. */
+typedef struct {
+	/** The number of channels */
+	unsigned int nOfChannels;
+	/** The current channel temperatures (array of size <code>nOfChannels</code>) */
+	signed char* temp;
+	/** The channel lower limits (array of size <code>nOfChannels</code>) */
+	signed char* lowerLimit;
+	/** The channel upper limits (array of size <code>nOfChannels</code>) */
+	signed char* upperLimit;
+	/** The violation bitmask (array of size <code>CR_DA_TEMP_CHANNEL_MASK_SIZE(nOfChannels)</code>) */
+	unsigned int* violationMask;
+	/** The number of channels which were found in violation by the last check */
+	unsigned int nOfViolations;
+	/** The channel from which the search for channels to be reported starts in the next report */
+	unsigned int nextReportChannel;
+	/** The bitmask of the channels found in violation since the last report (same size as <code>violationMask</code>) */
+	unsigned int* pendingMask;
+	/** The last violating temperature of the channels in <code>pendingMask</code> (array of size <code>nOfChannels</code>) */
+	signed char* pendingTemp;
+	/** The running total of the channels found in violation since the last report */
+	unsigned int nOfPendingViolations;
+} CrDaTempChannels_t;
+
+/**
+ * Initialize an array of temperature channels.
+ * The temperatures of all channels are set to zero and the limits of all channels
+ * are set to the full range of a <code>signed char</code> (i.e. no channel can be in violation).
+ * No violation is pending.
+ * The arrays passed to this function must remain valid for as long as the channels are used.
+ * @param channels the channel descriptor to be initialized
+ * @param nOfChannels the number of channels
+ * @param temp the array holding the channel temperatures
+ * @param lowerLimit the array holding the channel lower limits
+ * @param upperLimit the array holding the channel upper limits
+ * @param violationMask the array holding the violation bitmask
+ * @param pendingMask the array holding the bitmask of the pending violations
+ * @param pendingTemp the array holding the temperatures of the pending violations
+ */
+void CrDaTempChannelMonitorInit(CrDaTempChannels_t* channels, unsigned int nOfChannels, signed char* temp,
+                                signed char* lowerLimit, signed char* upperLimit, unsigned int* violationMask,
+                                unsigned int* pendingMask, signed char* pendingTemp);
+
+/**
+ * Set the lower and upper limits of a channel.
+ * @param channels the channel descriptor
+ * @param channel the channel index (must be smaller than the number of channels)
+ * @param lowerLimit the lower limit
+ * @param upperLimit the upper limit
+ */
+void CrDaTempChannelMonitorSetLimits(CrDaTempChannels_t* channels, unsigned int channel,
+                                     signed char lowerLimit, signed char upperLimit);
+
+/**
+ * Compare the temperatures of all channels against their limits and build the violation bitmask.
+ * This function does not generate any reports and it does not check whether temperature
+ * monitoring is enabled.
+ * @param channels the channel descriptor
+ * @return the number of channels in violation
+ */
+unsigned int CrDaTempChannelMonitorCheck(CrDaTempChannels_t* channels);
+
+/**
+ * Return the index of the first channel in violation at or after the given channel.
+ * This function scans the violation bitmask built by the last call to
+ * <code>::CrDaTempChannelMonitorCheck</code>.
+ * @param channels the channel descriptor
+ * @param channel the channel from which the scan starts
+ * @return the index of the first channel in violation or the number of channels if there is none
+ */
+unsigned int CrDaTempChannelMonitorNextViolation(CrDaTempChannels_t* channels, unsigned int channel);
+
+/**
+ * Fold the violations found by the last call to <code>::CrDaTempChannelMonitorCheck</code>
+ * into the pending violations.
+ * The violation bitmask is merged into the bitmask of the pending violations, the
+ * temperatures of the violating channels are recorded as their pending temperatures
+ * and the number of violations is added to the running total of the pending violations.
+ * The pending violations are held until they are reported and cleared through
+ * <code>::CrDaTempChannelMonitorClearPending</code>.
+ * @param channels the channel descriptor
+ * @return the running total of the pending violations
+ */
+unsigned int CrDaTempChannelMonitorFold(CrDaTempChannels_t* channels);
+
+/**
+ * Return the index of the first channel with a pending violation at or after the given channel.
+ * @param channels the channel descriptor
+ * @param channel the channel from which the scan starts
+ * @return the index of the first channel with a pending violation or the number of channels if there is none
+ */
+unsigned int CrDaTempChannelMonitorNextPending(CrDaTempChannels_t* channels, unsigned int channel);
+
+/**
+ * Clear the pending violations and their running total.
+ * @param channels the channel descriptor
+ */
+void CrDaTempChannelMonitorClearPending(CrDaTempChannels_t* channels);
+
+/**
+ * Return the name of the implementation of the comparison which was selected at
+ * compile time.
+ * @return "AVX2", "SSE2" or "scalar"
+ */
+const char* CrDaTempChannelMonitorGetImpl();
+
+#endif /* CRDA_TEMPCHANNELMONITOR_H_ */
@@ -0,0 +1,242 @@
+/**
+ * @file
+ * @ingroup crDemoCommon
+ * Implementation of temperature monitoring module.
+ *
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the CORDET Framework.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#include <stdio.h>
+#include "CrDaServerSocket.h"
+#include "CrDaTempMonitor.h"
+#include "CrDaTempChannelMonitor.h"
+#include "CrDaConstants.h"
+#include "CrDaOutCmpTempViolation.h"
+#include "CrDaTrace.h"
+#include "CrDaLoadSm.h"
+#include "CrDaProfile.h"
+/* Include FW Profile files */
+#include "FwSmConstants.h"
+#include "FwSmConfig.h"
+#include "FwSmCore.h"
+#include "FwPrConfig.h"
+#include "FwPrCore.h"
+#include "FwPrConstants.h"
+/* Include configuration files */
+#include "CrFwOutStreamUserPar.h"
+#include "CrFwCmpData.h"
+/* Include framework files */
+#include "OutLoader/CrFwOutLoader.h"
+#include "OutFactory/CrFwOutFactory.h"
+#include "OutStream/CrFwOutStream.h"
+#include "BaseCmp/CrFwBaseCmp.h"
+#include "Pckt/CrFwPckt.h"
+#include "CrFwTime.h"
+#include "CrFwRepErr.h"
+#include "UtilityFunctions/CrFwUtilityFunctions.h"
+/* Include file for socket implementation */
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <string.h>
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <netdb.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <pthread.h>
+
+/** The temperature limit */
+static int tempLimit = 0;
+
+/** The enable status of temperature monitoring */
+static CrFwBool_t isTempMonitoringEnabled = 0;
+
+/** Whether a temperature violation is waiting for its coalesced report */
+static CrFwBool_t isViolationPending = 0;
+
+/** The highest violating temperature since the last report */
+static char pendingTemp = 0;
+
+/** The number of cycles since the last report */
+static unsigned int nOfCyclesSinceRep = 0;
+
+/** The number of cycles since the last aggregated report */
+static unsigned int nOfCyclesSinceAggrRep = 0;
+
+/**
+ * Return the instance identifier of an InCommand.
+ * @param smDesc the InCommand state machine descriptor
+ * @return the instance identifier of the InCommand
+ */
+static CrFwInstanceId_t getInstanceId(FwSmDesc_t smDesc);
+
+/* ---------------------------------------------------------------------- */
+void CrDaTempMonitoringStartAction(FwSmDesc_t smDesc) {
+	CrDaTraceInstant("cmd start", (int)getInstanceId(smDesc));
+}
+
+/* ---------------------------------------------------------------------- */
+void CrDaTempMonitoringTerminationAction(FwSmDesc_t smDesc) {
+	CrDaTraceInstant("cmd termination", (int)getInstanceId(smDesc));
+}
+
+/* ---------------------------------------------------------------------- */
+void CrDaTempMonitoringEnable(FwSmDesc_t smDesc) {
+	CrDaTraceBegin("cmd enable", (int)getInstanceId(smDesc));
+	isTempMonitoringEnabled = 1;
+	CrDaTraceEnd("cmd enable");
+}
+
+/* ---------------------------------------------------------------------- */
+void CrDaTempMonitoringDisable(FwSmDesc_t smDesc) {
+	CrDaTraceBegin("cmd disable", (int)getInstanceId(smDesc));
+	isTempMonitoringEnabled = 0;
+	CrDaTraceEnd("cmd disable");
+}
+
+/* ---------------------------------------------------------------------- */
+void CrDaTempMonitoringSetTempLimit(FwSmDesc_t smDesc) {
+	CrFwCmpData_t* cmpData = (CrFwCmpData_t*)FwSmGetData(smDesc);
+	CrFwInCmdData_t* cmpSpecificData = (CrFwInCmdData_t*)(cmpData->cmpSpecificData);
+	char* pcktPar = CrFwInCmdGetParStart(smDesc);
+	CrDaTraceBegin("cmd set limit", (int)getInstanceId(smDesc));
+	tempLimit = pcktPar[0];
+	/* The limits set by the commands of a run profile are printed for CheckStressRun.sh */
+	if (CrDaProfileGet()->nOfCmdsPerCycle >= 0) {
+		if (CrFwPcktGetDest(cmpSpecificData->pckt) == CR_DA_SLAVE_1)
+			printf("S1: Temperature limit set to %d degC\n", tempLimit);
+		else
+			printf("S2: Temperature limit set to %d degC\n", tempLimit);
+	}
+	CrDaTraceEnd("cmd set limit");
+}
+
+/* ---------------------------------------------------------------------- */
+CrFwBool_t CrDaTempMonitoringIsEnabled() {
+	return isTempMonitoringEnabled;
+}
+
+/* ---------------------------------------------------------------------- */
+void CrDaTempMonitoringExec(char temp, CrFwDestSrc_t appId) {
+	FwSmDesc_t rep;
+	if (nOfCyclesSinceRep < CR_DA_LOAD_COALESCE_SHEDDING)
+		nOfCyclesSinceRep++;
+	if (isTempMonitoringEnabled == 1) {
+		if (temp > tempLimit) {
+			/* Merge the violation into the report which is pending (if any) */
+			if (isViolationPending == 1) {
+				CrDaLoadSmCountCoalesced();
+				if (temp > pendingTemp)
+					pendingTemp = temp;
+			} else {
+				isViolationPending = 1;
+				pendingTemp = temp;
+			}
+		}
+		/* Under load, at most one report is sent per coalescing interval of the Load State Machine */
+		if ((isViolationPending == 1) && (nOfCyclesSinceRep >= CrDaLoadSmGetCoalesceInterval())) {
+			if (appId == CR_DA_SLAVE_1)
+				printf("S1: Temperature violation detected -- Sending report to Master Application\n");
+			else
+				printf("S2: Temperature violation detected -- Sending report to Master Application\n");
+			/* Create outReport reporting temperature violation */
+			rep = CrFwOutFactoryMakeOutCmp(CR_DA_SERV_TYPE,CR_DA_SERV_SUBTYPE_REP,0,0);
+			isViolationPending = 0;
+			nOfCyclesSinceRep = 0;
+			if (rep == NULL)
+				return;
+			CrDaOutCmpTempViolationSetTemp(rep, pendingTemp);
+			CrFwOutCmpSetDest(rep,CR_DA_MASTER);
+			/* Request outReport to be sent out */
+			CrFwOutLoaderLoad(rep);
+		}
+	} else
+		isViolationPending = 0;
+	return;
+}
+
+/* ---------------------------------------------------------------------- */
+void CrDaTempMonitoringExecChannels(CrDaTempChannels_t* channels, CrFwDestSrc_t appId) {
+	FwSmDesc_t rep;
+	unsigned int channel;
+	unsigned int firstChannel;
+	unsigned int nOfPending;
+	unsigned int nOfReported = 0;
+
+	if (nOfCyclesSinceAggrRep < CR_DA_LOAD_COALESCE_SHEDDING)
+		nOfCyclesSinceAggrRep++;
+	if (isTempMonitoringEnabled != 1) {
+		if (channels->nOfPendingViolations > 0)
+			CrDaTempChannelMonitorClearPending(channels);
+		return;
+	}
+
+	/* Fold the violations into the report which is pending (if any) */
+	if (CrDaTempChannelMonitorCheck(channels) > 0) {
+		if (channels->nOfPendingViolations > 0)
+			CrDaLoadSmCountCoalesced();
+		CrDaTempChannelMonitorFold(channels);
+	}
+
+	/* Under load, at most one report is sent per coalescing interval of the Load State Machine */
+	if ((channels->nOfPendingViolations == 0) || (nOfCyclesSinceAggrRep < CrDaLoadSmGetCoalesceInterval()))
+		return;
+	nOfPending = channels->nOfPendingViolations;
+	nOfCyclesSinceAggrRep = 0;
+
+	/* Create outReport reporting the temperature violations */
+	rep = CrFwOutFactoryMakeOutCmp(CR_DA_SERV_TYPE,CR_DA_SERV_SUBTYPE_REP_AGGR,0,0);
+	if (rep == NULL) {
+		CrDaTempChannelMonitorClearPending(channels);
+		return;
+	}
+	CrDaOutCmpTempViolationAggrInit(rep, nOfPending);
+
+	/* Collect the pending channels starting from where the previous report stopped */
+	channel = CrDaTempChannelMonitorNextPending(channels, channels->nextReportChannel);
+	if (channel >= channels->nOfChannels)
+		channel = CrDaTempChannelMonitorNextPending(channels, 0);
+	firstChannel = channel;
+	while (nOfReported < nOfPending) {
+		if (CrDaOutCmpTempViolationAggrAdd(rep, channel, (char)channels->pendingTemp[channel]) == 0)
+			break;
+		nOfReported++;
+		channel = CrDaTempChannelMonitorNextPending(channels, channel+1);
+		if (channel >= channels->nOfChannels)
+			channel = CrDaTempChannelMonitorNextPending(channels, 0);
+		if (channel == firstChannel)
+			break;
+	}
+	channels->nextReportChannel = channel;
+	CrDaTempChannelMonitorClearPending(channels);
+
+	/* The first reported channel is printed so that the reports can be checked (see CheckStressRun.sh) */
+	if (appId == CR_DA_SLAVE_1)
+		printf("S1: Temperature violation detected on %u channels -- Sending report from channel %u to Master Application\n",
+		       nOfPending, firstChannel);
+	else
+		printf("S2: Temperature violation detected on %u channels -- Sending report from channel %u to Master Application\n",
+		       nOfPending, firstChannel);
+
+	CrFwOutCmpSetDest(rep,CR_DA_MASTER);
+	/* Request outReport to be sent out */
+	CrFwOutLoaderLoad(rep);
+}
+
+/* ---------------------------------------------------------------------- */
+static CrFwInstanceId_t getInstanceId(FwSmDesc_t smDesc) {
+	CrFwCmpData_t* cmpData = (CrFwCmpData_t*)FwSmGetData(smDesc);
+	return cmpData->instanceId;
+}
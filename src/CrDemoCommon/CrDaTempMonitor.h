@@ -0,0 +1,152 @@
+/**
+ * @file
+ * @ingroup crDemoCommon
+ * Temperature monitoring logic in the slave applications.
+ * The slave applications are responsible for monitoring a temperature measurement.
+ * This module defines the functions through which:
+ * - Temperature monitoring is enabled
+ * - Temperature monitoring is disabled
+ * - The limit against which monitoring is performed is defined
+ * - Temperature monitoring is performed on one temperature
+ * - Temperature monitoring is performed on an array of temperature channels
+ * .
+ * Some of the functions defined in this module are used as progress actions for the commands
+ * which the Slave Applications receive from the Master Application (see customization of
+ * commands in <code>CrFwInFactoryUserPar.h</code>).
+ * They are therefore defined to comply with the <code>::CrFwInCmdProgressAction_t</code> prototype.
+ * The start and termination actions of these commands and their progress actions
+ * record their execution in the span tracer (see <code>CrDaTrace.h</code>).
+ *
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the CORDET Framework.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#ifndef CRDA_TEMPMONITORING_H_
+#define CRDA_TEMPMONITORING_H_
+
+/* Include Framework Files */
+#include "CrFwConstants.h"
+/* Include Configuration Files */
+#include "CrFwUserConstants.h"
+/* Include FW Profile files */
+#include "FwSmConstants.h"
+#include "FwSmConfig.h"
+#include "FwSmCore.h"
+#include "FwPrConfig.h"
+#include "FwPrCore.h"
+#include "FwPrConstants.h"
+/* Include demo application files */
+#include "CrDaTempChannelMonitor.h"
+
+/**
+ * Start action of the InCommands of the temperature monitoring service.
+ * This function records the start of the InCommand in the span tracer (see
+ * <code>CrDaTrace.h</code>).
+ * @param smDesc the InCommand state machine descriptor (this argument is
+ * required for compatibility with the <code>::CrFwInCmdStartAction_t</code> prototype)
+ */
+void CrDaTempMonitoringStartAction(FwSmDesc_t smDesc);
+
+/**
+ * Termination action of the InCommands of the temperature monitoring service.
+ * This function records the termination of the InCommand in the span tracer (see
+ * <code>CrDaTrace.h</code>).
+ * @param smDesc the InCommand state machine descriptor (this argument is
+ * required for compatibility with the <code>::CrFwInCmdTerminationAction_t</code> prototype)
+ */
+void CrDaTempMonitoringTerminationAction(FwSmDesc_t smDesc);
+
+/**
+ * Enable temperature monitoring.
+ * This function is intended to be used as progress action for the
+ * InCommand which enables temperature monitoring.
+ * @param smDesc the InCommand state machine descriptor (this argument is
+ * required for compatibility with the <code>::CrFwInCmdProgressAction_t</code> prototype)
+ */
+void CrDaTempMonitoringEnable(FwSmDesc_t smDesc);
+
+/**
+ * Disable temperature monitoring.
+ * This function is intended to be used as progress action for the
+ * InCommand which disables temperature monitoring.
+ * @param smDesc the InCommand state machine descriptor (this argument is
+ * required for compatibility with the <code>::CrFwInCmdProgressAction_t</code> prototype)
+ */
+void CrDaTempMonitoringDisable(FwSmDesc_t smDesc);
+
+/**
+ * Set the limit against the temperature is monitored.
+ * This function is intended to be used as progress action for the
+ * InCommand which set the temperature monitoring limit.
+ * When the run profile defines a number of commands per cycle (see <code>CrDaProfile.h</code>),
+ * the limit is printed so that it can be checked against the limit sent by the Master
+ * Application.
+ * @param smDesc the InCommand state machine descriptor (this argument is
+ * required for compatibility with the <code>::CrFwInCmdProgressAction_t</code> prototype)
+ */
+void CrDaTempMonitoringSetTempLimit(FwSmDesc_t smDesc);
+
+/**
+ * Return the enable status of temperature monitoring.
+ * @return 1 if temperature monitoring is enabled, 0 otherwise
+ */
+CrFwBool_t CrDaTempMonitoringIsEnabled();
+
+/**
+ * Execute a temperature monitoring action on the argument temperature.
+ * If temperature monitoring is disabled, this function returns without doing anything.
+ * If temperature monitoring is enabled, this function compares the argument temperature with
+ * its temperature limit and if it finds that the argument temperature exceeds its limit,
+ * it generates a "temperature limit violated" report to the Master Application.
+ *
+ * When the Load State Machine is in DEGRADED or SHEDDING (see <code>CrDaLoadSm.h</code>),
+ * the violations are coalesced: at most one report is generated per coalescing interval
+ * and it carries the highest violating temperature since the previous report.
+ *
+ * This function would normally be called periodically by the host application.
+ * @param temp the temperature to be monitored (an integer in the range 0 to 127)
+ * @param appId the identifier of the application which is performing the monitoring
+ * (either Slave 1 or Slave 2)
+ */
+void CrDaTempMonitoringExec(char temp, CrFwDestSrc_t appId);
+
+/**
+ * Execute a temperature monitoring action on an array of temperature channels.
+ * If temperature monitoring is disabled, this function returns without doing anything.
+ * If temperature monitoring is enabled, this function builds the violation bitmask of the
+ * channels through <code>::CrDaTempChannelMonitorCheck</code> and folds the violations
+ * into the pending violations (see <code>::CrDaTempChannelMonitorFold</code>).
+ * If violations are pending, it then generates one aggregated "temperature limit violated"
+ * report (service sub-type <code>#CR_DA_SERV_SUBTYPE_REP_AGGR</code>) to the Master
+ * Application and clears the pending violations.
+ * The report carries the running total of the violations since the last report and as
+ * many (channel, temperature) pairs of the pending channels as it can hold (see
+ * <code>::CrDaOutCmpTempViolationAggrAdd</code>).
+ * If more channels are pending, the channels to be reported are taken in round-robin
+ * order across reports so that no violating channel is starved.
+ *
+ * Under load, the aggregated reports are coalesced in the same way as the temperature
+ * violation reports of <code>::CrDaTempMonitoringExec</code>: at most one report is generated
+ * per coalescing interval of the Load State Machine (see
+ * <code>::CrDaLoadSmGetCoalesceInterval</code>) and the violations of the cycles in between
+ * are folded into it.
+ * No report is generated if the OutFactory has no free OutComponents (the pending
+ * violations are then discarded).
+ *
+ * This function would normally be called periodically by the host application.
+ * @param channels the channel descriptor
+ * @param appId the identifier of the application which is performing the monitoring
+ * (either Slave 1 or Slave 2)
+ */
+void CrDaTempMonitoringExecChannels(CrDaTempChannels_t* channels, CrFwDestSrc_t appId);
+
+#endif /* CRDA_TEMPMONITORING_H_ */
@@ -0,0 +1,247 @@
+/**
+ * @file
+ * @ingroup crDemoCommon
+ * Implementation of the span tracer of the demo applications.
+ *
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the CORDET Framework.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <signal.h>
+#include "CrDaTrace.h"
+#include "CrDaClock.h"
+
+/** A trace event */
+typedef struct {
+	/** The time of the event in nanoseconds */
+	unsigned long long time;
+	/** The name of the event */
+	const char* name;
+	/** The argument of the event (negative if the event has no argument) */
+	int arg;
+	/** The phase of the event ('B' for begin, 'E' for end and 'i' for instant) */
+	char phase;
+} CrDaTraceEvent_t;
+
+/** The ring of trace events of one thread */
+typedef struct {
+	/** The events */
+	CrDaTraceEvent_t event[CR_DA_TRACE_RING_SIZE];
+	/** The number of events which have been written to the ring since it was allocated */
+	unsigned long head;
+} CrDaTraceRing_t;
+
+/** The rings of the threads */
+static CrDaTraceRing_t rings[CR_DA_TRACE_MAX_N_OF_THREADS];
+
+/** The number of rings which have been allocated (may exceed the number of rings) */
+static int nOfRings = 0;
+
+/** The ring of the calling thread (NULL if no ring has been allocated to the thread) */
+static __thread CrDaTraceRing_t* threadRing = NULL;
+
+/** Whether a ring could not be allocated to the calling thread */
+static __thread int isThreadRingMissing = 0;
+
+/** Whether the tracer is open */
+static int isOpen = 0;
+
+/** The identifier of the application */
+static unsigned int traceAppId = 0;
+
+/** The directory where the dumps are written */
+static char traceDir[256];
+
+/** The sequence number of the next dump */
+static unsigned int nOfDumps = 0;
+
+/** The number of dumps which have been written for cycle overruns */
+static unsigned int nOfOverrunDumps = 0;
+
+/** Whether a dump has been requested through <code>SIGUSR1</code> */
+static volatile sig_atomic_t isDumpRequested = 0;
+
+/** The handler of <code>SIGUSR1</code> which was installed when the tracer was opened */
+static struct sigaction prevAction;
+
+/** The host time at which the current control cycle was started */
+static unsigned long long cycleStartTime = 0;
+
+/** The number of the current control cycle */
+static unsigned int traceCycle = 0;
+
+/**
+ * Write an event to the ring of the calling thread.
+ * The ring is allocated on the first event of the thread.
+ * @param phase the phase of the event
+ * @param name the name of the event
+ * @param arg the argument of the event
+ */
+static void writeEvent(char phase, const char* name, int arg);
+
+/**
+ * Handler of <code>SIGUSR1</code>.
+ * The handler requests a dump and calls the handler which was installed before.
+ * @param sig the signal number
+ */
+static void sigusr1Handler(int sig);
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaTraceOpen(unsigned int appId, const char* dir) {
+	struct sigaction action;
+
+	if (isOpen)
+		return;
+	traceAppId = appId;
+	snprintf(traceDir, sizeof(traceDir), "%s", dir);
+
+	memset(&action, 0, sizeof(action));
+	action.sa_handler = &sigusr1Handler;
+	sigemptyset(&action.sa_mask);
+	action.sa_flags = SA_RESTART;
+	sigaction(SIGUSR1, &action, &prevAction);
+	isOpen = 1;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaTraceClose() {
+	if (!isOpen)
+		return;
+	isOpen = 0;
+	sigaction(SIGUSR1, &prevAction, NULL);
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaTraceBegin(const char* name, int arg) {
+	if (isOpen)
+		writeEvent('B', name, arg);
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaTraceEnd(const char* name) {
+	if (isOpen)
+		writeEvent('E', name, -1);
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaTraceInstant(const char* name, int arg) {
+	if (isOpen)
+		writeEvent('i', name, arg);
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaTraceStartCycle(unsigned int cycle) {
+	if (!isOpen)
+		return;
+	traceCycle = cycle;
+	cycleStartTime = CrDaClockGetHostTime();
+	writeEvent('B', "cycle", (int)cycle);
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaTraceEndCycle() {
+	char reason[64];
+
+	if (!isOpen)
+		return;
+	writeEvent('E', "cycle", -1);
+
+	if (isDumpRequested) {
+		isDumpRequested = 0;
+		CrDaTraceDump("signal");
+	}
+	if ((CrDaClockGetHostTime() - cycleStartTime > CrDaClockGetPeriod()) &&
+	        (nOfOverrunDumps < CR_DA_TRACE_MAX_N_OF_OVERRUN_DUMPS)) {
+		nOfOverrunDumps++;
+		snprintf(reason, sizeof(reason), "overrun of cycle %u", traceCycle);
+		CrDaTraceDump(reason);
+	}
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+int CrDaTraceDump(const char* reason) {
+	char path[320];
+	FILE* file;
+	CrDaTraceRing_t* ring;
+	CrDaTraceEvent_t* event;
+	unsigned long head, first, i;
+	int n, j;
+
+	snprintf(path, sizeof(path), "%s/cr_trace_%u_%03u.json", traceDir, traceAppId, nOfDumps);
+	file = fopen(path, "w");
+	if (file == NULL) {
+		perror("CrDaTraceDump, Open dump file");
+		return 0;
+	}
+	nOfDumps++;
+
+	fprintf(file, "{\"otherData\":{\"reason\":\"%s\",\"app\":%u},\n\"traceEvents\":[\n", reason, traceAppId);
+	fprintf(file, "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":%u,\"tid\":0,\"args\":{\"name\":\"App %u\"}}",
+	        traceAppId, traceAppId);
+
+	n = (nOfRings < CR_DA_TRACE_MAX_N_OF_THREADS ? nOfRings : CR_DA_TRACE_MAX_N_OF_THREADS);
+	for (j=0; j<n; j++) {
+		ring = &rings[j];
+		head = ring->head;
+		first = (head > CR_DA_TRACE_RING_SIZE ? head - CR_DA_TRACE_RING_SIZE : 0);
+		for (i=first; i<head; i++) {
+			event = &ring->event[i & (CR_DA_TRACE_RING_SIZE-1)];
+			fprintf(file, ",\n{\"name\":\"%s\",\"ph\":\"%c\",\"ts\":%llu.%03llu,\"pid\":%u,\"tid\":%d",
+			        event->name, event->phase, event->time/1000, event->time%1000, traceAppId, j);
+			if (event->phase == 'i')
+				fprintf(file, ",\"s\":\"t\"");
+			if (event->arg >= 0)
+				fprintf(file, ",\"args\":{\"arg\":%d}", event->arg);
+			fprintf(file, "}");
+		}
+	}
+	fprintf(file, "\n]}\n");
+	fclose(file);
+	printf("CrDaTraceDump: trace written to %s (%s)\n", path, reason);
+	return 1;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static void writeEvent(char phase, const char* name, int arg) {
+	CrDaTraceRing_t* ring = threadRing;
+	CrDaTraceEvent_t* event;
+	int i;
+
+	if (ring == NULL) {
+		if (isThreadRingMissing)
+			return;
+		i = __sync_fetch_and_add(&nOfRings, 1);
+		if (i >= CR_DA_TRACE_MAX_N_OF_THREADS) {
+			isThreadRingMissing = 1;
+			return;
+		}
+		ring = &rings[i];
+		threadRing = ring;
+	}
+
+	event = &ring->event[ring->head & (CR_DA_TRACE_RING_SIZE-1)];
+	event->time = CrDaClockGetHostTime();
+	event->name = name;
+	event->arg = arg;
+	event->phase = phase;
+	ring->head++;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static void sigusr1Handler(int sig) {
+	isDumpRequested = 1;
+	if ((prevAction.sa_handler != SIG_DFL) && (prevAction.sa_handler != SIG_IGN) &&
+	        (prevAction.sa_handler != NULL))
+		prevAction.sa_handler(sig);
+}
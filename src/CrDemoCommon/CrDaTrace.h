@@ -0,0 +1,133 @@
+/**
+ * @file
+ * @ingroup crDemoCommon
+ * Span tracer for the control cycles of the demo applications.
+ * The tracer records begin and end events for the phases of the control cycles
+ * (the InLoaders, the InManagers, the OutManager, the socket poll, etc), for the
+ * actions of the incoming commands and reports and for the socket system calls.
+ * The recorded events show which part of a control cycle was responsible for an
+ * overrun.
+ *
+ * Each event holds its time (read from <code>CLOCK_MONOTONIC</code>, independently
+ * of the mode of the demo clock), its name (a string with static storage duration),
+ * its phase (begin, end or instant) and one optional integer argument.
+ * Events are written without locks to a ring of <code>#CR_DA_TRACE_RING_SIZE</code>
+ * events which belongs to the calling thread: once the ring is full, the oldest events
+ * are overwritten.
+ * Up to <code>#CR_DA_TRACE_MAX_N_OF_THREADS</code> threads can record events; the events
+ * of further threads are dropped.
+ * The cost of recording an event is one read of the clock and a few stores.
+ *
+ * The rings are dumped as a file in the Chrome Trace Event JSON format which can be
+ * loaded in <code>chrome://tracing</code> or in the Perfetto UI.
+ * A dump is written at the end of a control cycle (see <code>::CrDaTraceEndCycle</code>):
+ * - when the application has received signal <code>SIGUSR1</code> since the
+ *   previous cycle, or
+ * - when the duration of the cycle exceeded the period of the control cycles
+ *   (at most <code>#CR_DA_TRACE_MAX_N_OF_OVERRUN_DUMPS</code> dumps are written for
+ *   overruns in one run).
+ * .
+ * The dump of application <code>appId</code> is written to file
+ * <code>dir/cr_trace_appId_NNN.json</code> where <code>dir</code> is the directory
+ * given to <code>::CrDaTraceOpen</code> and <code>NNN</code> is the sequence number
+ * of the dump.
+ * In the dump, the process identifier of the events is the identifier of the application
+ * so that the three applications of the loopback harness (see <code>CrDaLoopbackMain.c</code>)
+ * appear as separate processes.
+ * The dump is written by the control thread while the other threads may be writing
+ * events: events which are written during the dump may be missing or incomplete.
+ *
+ * The demo applications open the tracer when the environment variable
+ * <code>#CR_DA_TRACE_ENV_VAR</code> is set to the directory where the dumps are written.
+ * When the tracer is not open, recording an event costs one test.
+ * This interface only uses plain C types so that it can be used by all demo
+ * application files.
+ *
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the CORDET Framework.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#ifndef CRDA_TRACE_H_
+#define CRDA_TRACE_H_
+
+/** Name of the environment variable through which the demo applications are told to trace their cycles */
+#define CR_DA_TRACE_ENV_VAR "CR_DA_TRACE"
+
+/** The number of events in the ring of one thread (must be a power of two) */
+#define CR_DA_TRACE_RING_SIZE 8192
+
+/** The maximum number of threads which can record events */
+#define CR_DA_TRACE_MAX_N_OF_THREADS 8
+
+/** The maximum number of dumps which are written for cycle overruns in one run */
+#define CR_DA_TRACE_MAX_N_OF_OVERRUN_DUMPS 16
+
+/**
+ * Open the tracer.
+ * After this function has been called, events are recorded and signal
+ * <code>SIGUSR1</code> requests a dump (the handler of <code>SIGUSR1</code>
+ * which was installed before is still called).
+ * @param appId the identifier of the application
+ * @param dir the directory where the dumps are written
+ */
+void CrDaTraceOpen(unsigned int appId, const char* dir);
+
+/**
+ * Close the tracer.
+ * Events are no longer recorded and the previous handler of <code>SIGUSR1</code>
+ * is restored.
+ */
+void CrDaTraceClose();
+
+/**
+ * Record the begin event of a span.
+ * @param name the name of the span (a string with static storage duration)
+ * @param arg the argument of the span (negative if the span has no argument)
+ */
+void CrDaTraceBegin(const char* name, int arg);
+
+/**
+ * Record the end event of a span.
+ * The span is the last span of the calling thread which has not yet ended.
+ * @param name the name of the span (a string with static storage duration)
+ */
+void CrDaTraceEnd(const char* name);
+
+/**
+ * Record an instant event.
+ * @param name the name of the event (a string with static storage duration)
+ * @param arg the argument of the event (negative if the event has no argument)
+ */
+void CrDaTraceInstant(const char* name, int arg);
+
+/**
+ * Record the begin event of the span of a control cycle.
+ * This function should be called at the start of each control cycle.
+ * @param cycle the cycle number
+ */
+void CrDaTraceStartCycle(unsigned int cycle);
+
+/**
+ * Record the end event of the span of a control cycle and write a dump if one
+ * was requested through signal <code>SIGUSR1</code> or if the cycle overran its period.
+ * This function should be called at the end of each control cycle.
+ */
+void CrDaTraceEndCycle();
+
+/**
+ * Write a dump of the rings.
+ * @param reason the reason of the dump (it is written to the dump)
+ * @return 1 if the dump was written, 0 otherwise
+ */
+int CrDaTraceDump(const char* reason);
+
+#endif /* CRDA_TRACE_H_ */
@@ -0,0 +1,708 @@
+/**
+ * @file
+ * @ingroup crDemoCommon
+ *
+ * Benchmark of the UDP transport under packet loss.
+ *
+ * This file provides the main program of the <code>cr_udpbench</code> tool which
+ * compares the latency of the UDP transport of <code>CrDaUdpSocket.h</code> with the
+ * latency of a TCP connection when packets are lost.
+ * The tool is called as follows:
+ * <pre>
+ *   cr_udpbench [-n packets] [-l loss] [-i interval] [-d delay] [-r rto] [-t timeout] [-s seed]
+ * </pre>
+ * The tool sends <code>packets</code> temperature violation reports (10000 by default)
+ * from a sender endpoint to a receiver endpoint at a fixed rate of one report every
+ * <code>interval</code> microseconds (100 by default) and measures the latency of each
+ * report from its send to its delivery.
+ * The sender then keeps sending reports at the same rate (they are not measured) until
+ * all measured reports have been received: the traffic is a continuous stream as in
+ * the demo applications.
+ * The reports which have not been received after <code>timeout</code> milliseconds
+ * (2000 by default) are counted as lost.
+ *
+ * Both endpoints are in the tool and their traffic passes through a lossy loopback
+ * shim which delays each packet by <code>delay</code> microseconds (250 by default)
+ * to emulate the propagation delay of a link and loses it with a probability of
+ * <code>loss</code> percent (1 by default).
+ * The measurement is made twice:
+ * - <b>udp</b>: the reports are sent as UDP datagrams on the loopback interface and
+ *   the reliability layer of <code>CrDaUdpLink.h</code> recovers the lost reports.
+ *   The shim loses the datagrams in both directions (reports, NACKs and retransmitted
+ *   reports).
+ * - <b>tcp</b>: the reports are sent on a TCP connection on the loopback interface.
+ *   The kernel tools which lose TCP segments (e.g. <code>netem</code>) are not generally
+ *   available and the shim therefore holds the lost reports as TCP recovers them:
+ *   a lost report is delivered after the third following report has reached the
+ *   receiver (the duplicate acknowledgement threshold of the fast retransmit) plus
+ *   one round-trip time and, if its retransmission is also lost, after a further
+ *   retransmission timeout of <code>rto</code> microseconds (200000 by default, the
+ *   minimum retransmission timeout of Linux).
+ *   Since TCP delivers the bytes in order, the reports which follow a lost report are
+ *   held until it has been delivered (head-of-line blocking).
+ * .
+ * The tool prints the number of lost reports and the latency (minimum, average,
+ * median, 99th percentile and maximum) of both transports, the statistics of the
+ * reliability layer and the ratio of the 99th percentiles.
+ * The <code>udpbench</code> target of the Makefile runs the tool with a loss of 0.1%,
+ * 1% and 5%.
+ * The pseudo-random losses are generated from <code>seed</code> (1 by default) so that
+ * the runs are repeatable.
+ *
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the CORDET Framework.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <time.h>
+#include <poll.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+/* Include demo application files */
+#include "CrDaConstants.h"
+#include "CrDaClock.h"
+#include "CrDaUdpLink.h"
+/* Include framework files */
+#include "CrFwConstants.h"
+#include "Pckt/CrFwPckt.h"
+
+/** The default number of measured reports */
+#define CR_DA_UDP_BENCH_DEF_N 10000
+
+/** The default loss probability in percent */
+#define CR_DA_UDP_BENCH_DEF_LOSS 1.0
+
+/** The default interval in microseconds between two reports */
+#define CR_DA_UDP_BENCH_DEF_INTERVAL 100
+
+/** The default one-way delay in microseconds of the shim */
+#define CR_DA_UDP_BENCH_DEF_DELAY 250
+
+/** The default retransmission timeout in microseconds of the TCP model */
+#define CR_DA_UDP_BENCH_DEF_RTO 200000
+
+/** The default timeout in milliseconds after which the reports in transit are lost */
+#define CR_DA_UDP_BENCH_DEF_TIMEOUT 2000
+
+/** The length of the reports sent by the benchmark (the parameter is the report number) */
+#define CR_DA_UDP_BENCH_PCKT_LENGTH (CR_DA_PCKT_PAR_OFFSET+4)
+
+/** The number of reports which follow a lost report when TCP retransmits it */
+#define CR_DA_UDP_BENCH_DUP_THRESH 3
+
+/** The number of packets which the shim can hold */
+#define CR_DA_UDP_BENCH_SHIM_SIZE 8192
+
+/** The size of the buffer in which the bytes received from the TCP connection are framed */
+#define CR_DA_UDP_BENCH_RX_SIZE 4096
+
+/** The size in bytes of the send and receive buffers of the TCP connection (larger than a full shim) */
+#define CR_DA_UDP_BENCH_TCP_BUFFER_SIZE (2*CR_DA_UDP_BENCH_SHIM_SIZE*CR_DA_UDP_BENCH_PCKT_LENGTH)
+
+/** The sender endpoint (its identifier is the source of the reports) */
+#define CR_DA_UDP_BENCH_TX_PEER CR_DA_SLAVE_2
+
+/** The receiver endpoint (its identifier is the destination of the reports) */
+#define CR_DA_UDP_BENCH_RX_PEER CR_DA_MASTER
+
+/** A packet held in the shim */
+typedef struct {
+	/** The time in nanoseconds at which the packet is delivered */
+	unsigned long long due;
+	/** The socket on which the packet is delivered */
+	int fd;
+	/** The address to which the packet is delivered (UDP only) */
+	struct sockaddr_in to;
+	/** The length of the packet */
+	unsigned int len;
+	/** Flag set if the packet was lost and is retransmitted (TCP only) */
+	int isLost;
+	/** The packet */
+	unsigned char data[CR_DA_UDP_LINK_RTX_SLOT_SIZE];
+} CrDaUdpBenchSlot_t;
+
+/** The packets held in a shim (a FIFO queue) */
+typedef struct {
+	/** The packets */
+	CrDaUdpBenchSlot_t slot[CR_DA_UDP_BENCH_SHIM_SIZE];
+	/** The number of packets which have been taken from the queue */
+	unsigned long head;
+	/** The number of packets which have been put in the queue */
+	unsigned long tail;
+} CrDaUdpBenchShim_t;
+
+/** The parameters of the benchmark */
+typedef struct {
+	/** The number of measured reports */
+	unsigned long n;
+	/** The loss probability (between 0 and 1) */
+	double loss;
+	/** The interval in nanoseconds between two reports */
+	unsigned long long interval;
+	/** The one-way delay in nanoseconds of the shim */
+	unsigned long long delay;
+	/** The retransmission timeout in nanoseconds of the TCP model */
+	unsigned long long rto;
+	/** The timeout in nanoseconds after which the reports in transit are lost */
+	unsigned long long timeout;
+	/** The seed of the pseudo-random losses */
+	unsigned short seed;
+} CrDaUdpBenchPar_t;
+
+/** The result of a measurement */
+typedef struct {
+	/** The number of measured reports sent */
+	unsigned long nOfSent;
+	/** The number of measured reports received */
+	unsigned long nOfRcvd;
+	/** The number of packets lost by the shim */
+	unsigned long nOfDropped;
+	/** The minimum latency in nanoseconds */
+	unsigned long long min;
+	/** The average latency in nanoseconds */
+	unsigned long long avg;
+	/** The median latency in nanoseconds */
+	unsigned long long p50;
+	/** The 99th percentile of the latency in nanoseconds */
+	unsigned long long p99;
+	/** The maximum latency in nanoseconds */
+	unsigned long long max;
+} CrDaUdpBenchRes_t;
+
+/** The shim of the UDP measurement */
+static CrDaUdpBenchShim_t udpShim;
+
+/** The shim of the TCP measurement */
+static CrDaUdpBenchShim_t tcpShim;
+
+/** The report which is sent (the report number is written in its parameter area) */
+static unsigned char txPckt[CR_DA_UDP_BENCH_PCKT_LENGTH];
+
+/** The state of the pseudo-random generator of the losses */
+static unsigned short randState[3];
+
+/** The send times of the measured reports */
+static unsigned long long* sendTime;
+
+/** The latencies of the measured reports */
+static unsigned long long* latency;
+
+/**
+ * Build the report which is sent by the benchmark.
+ * @return 1 if the report was built, 0 otherwise
+ */
+static int buildPckt();
+
+/**
+ * Open a non-blocking UDP socket bound to an ephemeral port of the loopback interface.
+ * @param addr the address to which the socket is bound
+ * @return the socket or -1 if the socket could not be opened
+ */
+static int openUdp(struct sockaddr_in* addr);
+
+/**
+ * Open a TCP connection over the loopback interface.
+ * The socket buffers can hold all reports in the shim: the sends never block.
+ * @param txFd the end of the connection on which the reports are sent
+ * @param rxFd the end of the connection on which the reports are received (non-blocking)
+ * @return 1 if the connection was opened, 0 otherwise
+ */
+static int openTcp(int* txFd, int* rxFd);
+
+/**
+ * Put a UDP datagram in the shim unless the shim loses it.
+ * @param fd the socket on which the datagram is sent
+ * @param to the address to which the datagram is sent
+ * @param dgram the datagram
+ * @param len the length of the datagram
+ * @param par the parameters of the benchmark
+ * @param res the result of the measurement
+ */
+static void shimUdp(int fd, struct sockaddr_in* to, const unsigned char* dgram, unsigned int len,
+                    CrDaUdpBenchPar_t* par, CrDaUdpBenchRes_t* res);
+
+/**
+ * Put a report sent on the TCP connection in the shim.
+ * If the shim loses the report, its delivery is delayed as TCP recovers it.
+ * @param fd the end of the connection on which the report is sent
+ * @param par the parameters of the benchmark
+ * @param res the result of the measurement
+ */
+static void shimTcp(int fd, CrDaUdpBenchPar_t* par, CrDaUdpBenchRes_t* res);
+
+/**
+ * Deliver the packets at the head of a shim which are due.
+ * @param shim the shim
+ * @param isTcp 1 if the packets are written to a TCP connection, 0 if they are UDP datagrams
+ * @return the time at which the packet at the head of the shim is due or zero if the shim is empty
+ */
+static unsigned long long flushShim(CrDaUdpBenchShim_t* shim, int isTcp);
+
+/**
+ * Draw whether a packet is lost.
+ * @param par the parameters of the benchmark
+ * @return 1 if the packet is lost, 0 otherwise
+ */
+static int isLost(CrDaUdpBenchPar_t* par);
+
+/**
+ * Run a measurement.
+ * @param isTcp 1 for the TCP measurement, 0 for the UDP measurement
+ * @param par the parameters of the benchmark
+ * @param res the result of the measurement
+ * @return 1 if the measurement could be made, 0 otherwise
+ */
+static int run(int isTcp, CrDaUdpBenchPar_t* par, CrDaUdpBenchRes_t* res);
+
+/**
+ * Record the delivery of a report.
+ * @param pckt the report
+ * @param now the current time in nanoseconds
+ * @param res the result of the measurement
+ * @return 1 if the report is a measured report, 0 otherwise
+ */
+static int deliver(const unsigned char* pckt, unsigned long long now, CrDaUdpBenchRes_t* res);
+
+/**
+ * Compute the latency statistics of a measurement.
+ * @param res the result of the measurement
+ */
+static void computeStats(CrDaUdpBenchRes_t* res);
+
+/**
+ * Print the result of a measurement.
+ * @param name the name of the measurement
+ * @param res the result
+ */
+static void printRes(const char* name, CrDaUdpBenchRes_t* res);
+
+/**
+ * Compare two latencies (for <code>qsort</code>).
+ * @param a the first latency
+ * @param b the second latency
+ * @return a negative, zero or positive value as the first latency is smaller than,
+ * equal to or larger than the second
+ */
+static int cmpLatency(const void* a, const void* b);
+
+/* ---------------------------------------------------------------------------------------------*/
+int main(int argc, char* argv[]) {
+	CrDaUdpBenchPar_t par;
+	CrDaUdpBenchRes_t udp, tcp;
+	int opt;
+
+	par.n = CR_DA_UDP_BENCH_DEF_N;
+	par.loss = CR_DA_UDP_BENCH_DEF_LOSS/100.0;
+	par.interval = CR_DA_UDP_BENCH_DEF_INTERVAL*1000ULL;
+	par.delay = CR_DA_UDP_BENCH_DEF_DELAY*1000ULL;
+	par.rto = CR_DA_UDP_BENCH_DEF_RTO*1000ULL;
+	par.timeout = CR_DA_UDP_BENCH_DEF_TIMEOUT*1000000ULL;
+	par.seed = 1;
+	while ((opt = getopt(argc, argv, "n:l:i:d:r:t:s:")) != -1) {
+		switch (opt) {
+			case 'n':
+				par.n = strtoul(optarg, NULL, 10);
+				break;
+			case 'l':
+				par.loss = atof(optarg)/100.0;
+				break;
+			case 'i':
+				par.interval = strtoull(optarg, NULL, 10)*1000ULL;
+				break;
+			case 'd':
+				par.delay = strtoull(optarg, NULL, 10)*1000ULL;
+				break;
+			case 'r':
+				par.rto = strtoull(optarg, NULL, 10)*1000ULL;
+				break;
+			case 't':
+				par.timeout = strtoull(optarg, NULL, 10)*1000000ULL;
+				break;
+			case 's':
+				par.seed = (unsigned short)atoi(optarg);
+				break;
+			default:
+				par.n = 0;
+				break;
+		}
+	}
+	if ((par.n == 0) || (par.loss < 0.0) || (par.loss >= 1.0) || (par.interval == 0) ||
+	        (par.timeout == 0) || (optind != argc)) {
+		printf("Usage: %s [-n packets] [-l loss] [-i interval] [-d delay] [-r rto] [-t timeout] [-s seed]\n",
+		       argv[0]);
+		return EXIT_FAILURE;
+	}
+	sendTime = malloc(par.n*sizeof(unsigned long long));
+	latency = malloc(par.n*sizeof(unsigned long long));
+	if ((sendTime == NULL) || (latency == NULL) || !buildPckt()) {
+		printf("cr_udpbench: cannot build the report\n");
+		return EXIT_FAILURE;
+	}
+
+	/* The NACKs are repeated after twice the round-trip time of the shim */
+	CrDaUdpLinkReset(4*par.delay + par.interval);
+	if (!run(0, &par, &udp) || !run(1, &par, &tcp))
+		return EXIT_FAILURE;
+
+	printf("Loss %.2f%%, one report every %llu us, one-way delay %llu us\n", par.loss*100.0,
+	       par.interval/1000, par.delay/1000);
+	printf("%-5s %8s %8s %8s %9s %9s %9s %9s %9s\n", "", "sent", "dropped", "lost",
+	       "min us", "avg us", "p50 us", "p99 us", "max us");
+	printRes("udp", &udp);
+	printRes("tcp", &tcp);
+	CrDaUdpLinkPrintSummary("udp");
+	if (udp.p99 > 0)
+		printf("p99 latency of tcp / udp: %.2f\n", (double)tcp.p99/(double)udp.p99);
+	return (udp.nOfRcvd == udp.nOfSent ? EXIT_SUCCESS : EXIT_FAILURE);
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static int buildPckt() {
+	CrFwPckt_t pckt;
+
+	pckt = CrFwPcktMake(CR_DA_UDP_BENCH_PCKT_LENGTH);
+	if (pckt == NULL)
+		return 0;
+	CrFwPcktSetCmdRepType(pckt, crRepType);
+	CrFwPcktSetServType(pckt, CR_DA_SERV_TYPE);
+	CrFwPcktSetServSubType(pckt, CR_DA_SERV_SUBTYPE_REP);
+	CrFwPcktSetDiscriminant(pckt, 0);
+	CrFwPcktSetSrc(pckt, CR_DA_UDP_BENCH_TX_PEER);
+	CrFwPcktSetDest(pckt, CR_DA_UDP_BENCH_RX_PEER);
+	CrFwPcktSetGroup(pckt, 0);
+	CrFwPcktSetSeqCnt(pckt, 0);
+	memcpy(txPckt, pckt, CR_DA_UDP_BENCH_PCKT_LENGTH);
+	CrFwPcktRelease(pckt);
+	return 1;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static int openUdp(struct sockaddr_in* addr) {
+	socklen_t addrLen = sizeof(*addr);
+	int fd;
+
+	fd = socket(AF_INET, SOCK_DGRAM, 0);
+	if (fd < 0) {
+		perror("cr_udpbench, Socket creation");
+		return -1;
+	}
+	memset(addr, 0, sizeof(*addr));
+	addr->sin_family = AF_INET;
+	addr->sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+	addr->sin_port = 0;
+	if ((bind(fd, (struct sockaddr*)addr, sizeof(*addr)) < 0) ||
+	        (getsockname(fd, (struct sockaddr*)addr, &addrLen) < 0) ||
+	        (fcntl(fd, F_SETFL, O_NONBLOCK) < 0)) {
+		perror("cr_udpbench, Bind on loopback interface");
+		close(fd);
+		return -1;
+	}
+	return fd;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static int openTcp(int* txFd, int* rxFd) {
+	struct sockaddr_in addr;
+	socklen_t addrLen = sizeof(addr);
+	int listenFd, noDelay = 1, bufSize = CR_DA_UDP_BENCH_TCP_BUFFER_SIZE;
+
+	listenFd = socket(AF_INET, SOCK_STREAM, 0);
+	if (listenFd < 0) {
+		perror("cr_udpbench, Socket creation");
+		return 0;
+	}
+	memset(&addr, 0, sizeof(addr));
+	addr.sin_family = AF_INET;
+	addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+	addr.sin_port = 0;
+	setsockopt(listenFd, SOL_SOCKET, SO_RCVBUF, &bufSize, sizeof(bufSize));
+	if ((bind(listenFd, (struct sockaddr*)&addr, sizeof(addr)) < 0) || (listen(listenFd, 1) < 0) ||
+	        (getsockname(listenFd, (struct sockaddr*)&addr, &addrLen) < 0)) {
+		perror("cr_udpbench, Listen on loopback interface");
+		close(listenFd);
+		return 0;
+	}
+	*txFd = socket(AF_INET, SOCK_STREAM, 0);
+	if (*txFd >= 0)
+		setsockopt(*txFd, SOL_SOCKET, SO_SNDBUF, &bufSize, sizeof(bufSize));
+	if ((*txFd < 0) || (connect(*txFd, (struct sockaddr*)&addr, sizeof(addr)) < 0)) {
+		perror("cr_udpbench, Connect on loopback interface");
+		close(listenFd);
+		return 0;
+	}
+	*rxFd = accept(listenFd, NULL, NULL);
+	close(listenFd);
+	if ((*rxFd < 0) || (fcntl(*rxFd, F_SETFL, O_NONBLOCK) < 0)) {
+		perror("cr_udpbench, Accept on loopback interface");
+		close(*txFd);
+		return 0;
+	}
+	setsockopt(*txFd, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay));
+	setsockopt(*rxFd, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay));
+	return 1;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static void shimUdp(int fd, struct sockaddr_in* to, const unsigned char* dgram, unsigned int len,
+                    CrDaUdpBenchPar_t* par, CrDaUdpBenchRes_t* res) {
+	CrDaUdpBenchSlot_t* slot;
+
+	if (isLost(par)) {
+		res->nOfDropped++;
+		return;
+	}
+	if (udpShim.tail - udpShim.head >= CR_DA_UDP_BENCH_SHIM_SIZE) {
+		res->nOfDropped++;
+		return;
+	}
+	slot = &udpShim.slot[udpShim.tail % CR_DA_UDP_BENCH_SHIM_SIZE];
+	slot->due = CrDaClockGetHostTime() + par->delay;
+	slot->fd = fd;
+	slot->to = *to;
+	slot->len = len;
+	memcpy(slot->data, dgram, len);
+	udpShim.tail++;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static void shimTcp(int fd, CrDaUdpBenchPar_t* par, CrDaUdpBenchRes_t* res) {
+	CrDaUdpBenchSlot_t* slot;
+	CrDaUdpBenchSlot_t* lost;
+	unsigned long long now = CrDaClockGetHostTime();
+
+	if (tcpShim.tail - tcpShim.head >= CR_DA_UDP_BENCH_SHIM_SIZE)
+		return;	/* the report stays with the sender: it is counted as lost */
+
+	/* The arrival of this report triggers the fast retransmit of a report lost before it */
+	if ((tcpShim.tail >= tcpShim.head + CR_DA_UDP_BENCH_DUP_THRESH) && (tcpShim.tail >= CR_DA_UDP_BENCH_DUP_THRESH)) {
+		lost = &tcpShim.slot[(tcpShim.tail - CR_DA_UDP_BENCH_DUP_THRESH) % CR_DA_UDP_BENCH_SHIM_SIZE];
+		if (lost->isLost) {
+			lost->due = now + 3*par->delay;
+			if (isLost(par)) {	/* the retransmission is lost too */
+				res->nOfDropped++;
+				lost->due += par->rto;
+			}
+		}
+	}
+
+	slot = &tcpShim.slot[tcpShim.tail % CR_DA_UDP_BENCH_SHIM_SIZE];
+	slot->fd = fd;
+	slot->len = CR_DA_UDP_BENCH_PCKT_LENGTH;
+	memcpy(slot->data, txPckt, CR_DA_UDP_BENCH_PCKT_LENGTH);
+	slot->isLost = isLost(par);
+	if (slot->isLost) {	/* recovered by the retransmission timeout unless three reports follow */
+		res->nOfDropped++;
+		slot->due = now + par->rto;
+	} else
+		slot->due = now + par->delay;
+	tcpShim.tail++;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static unsigned long long flushShim(CrDaUdpBenchShim_t* shim, int isTcp) {
+	CrDaUdpBenchSlot_t* slot;
+	unsigned long long now = CrDaClockGetHostTime();
+
+	while (shim->head < shim->tail) {
+		slot = &shim->slot[shim->head % CR_DA_UDP_BENCH_SHIM_SIZE];
+		if (slot->due > now)
+			return slot->due;	/* TCP: the reports behind the head are held */
+		if (isTcp) {
+			if (send(slot->fd, slot->data, slot->len, MSG_NOSIGNAL) != (int)slot->len)
+				perror("cr_udpbench, Send report");
+		} else
+			sendto(slot->fd, slot->data, slot->len, 0, (struct sockaddr*)&slot->to, sizeof(slot->to));
+		shim->head++;
+	}
+	return 0;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static int isLost(CrDaUdpBenchPar_t* par) {
+	return (erand48(randState) < par->loss);
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static int run(int isTcp, CrDaUdpBenchPar_t* par, CrDaUdpBenchRes_t* res) {
+	const unsigned char* rtx[CR_DA_UDP_LINK_N_OF_RTX_SLOTS];
+	unsigned char nack[CR_DA_UDP_LINK_NACK_LENGTH];
+	unsigned char rxBuffer[CR_DA_UDP_BENCH_RX_SIZE];
+	struct sockaddr_in txAddr, rxAddr;
+	struct pollfd pfd[2];
+	struct timespec ts;
+	unsigned long long now, nextSend, due, lastRcvd, wait;
+	unsigned long nr = 0;
+	unsigned int i, n;
+	unsigned char peer;
+	int txFd, rxFd, k, rxStart = 0, rxEnd = 0;
+
+	memset(res, 0, sizeof(*res));
+	randState[0] = 0x330E;
+	randState[1] = par->seed;
+	randState[2] = 0;
+	udpShim.head = 0;
+	udpShim.tail = 0;
+	tcpShim.head = 0;
+	tcpShim.tail = 0;
+	if (isTcp) {
+		if (!openTcp(&txFd, &rxFd))
+			return 0;
+	} else {
+		txFd = openUdp(&txAddr);
+		if (txFd < 0)
+			return 0;
+		rxFd = openUdp(&rxAddr);
+		if (rxFd < 0) {
+			close(txFd);
+			return 0;
+		}
+	}
+
+	nextSend = CrDaClockGetHostTime();
+	lastRcvd = nextSend;
+	for (;;) {
+		/* Send the reports which are due */
+		now = CrDaClockGetHostTime();
+		while (nextSend <= now) {
+			memcpy(txPckt+CR_DA_PCKT_PAR_OFFSET, &nr, sizeof(unsigned int));
+			CrFwPcktSetSeqCnt((CrFwPckt_t)txPckt, (CrFwSeqCnt_t)(nr+1));
+			if (nr < par->n) {
+				sendTime[nr] = now;
+				res->nOfSent++;
+			}
+			if (isTcp)
+				shimTcp(txFd, par, res);
+			else {
+				CrDaUdpLinkRecordSent(CR_DA_UDP_BENCH_RX_PEER, txPckt);
+				shimUdp(txFd, &rxAddr, txPckt, CR_DA_UDP_BENCH_PCKT_LENGTH, par, res);
+			}
+			nr++;
+			nextSend += par->interval;
+		}
+
+		/* Receiver: send the NACKs which are due */
+		if (!isTcp)
+			while (CrDaUdpLinkGetNack(now, &peer, nack) > 0)
+				shimUdp(rxFd, &txAddr, nack, CR_DA_UDP_LINK_NACK_LENGTH, par, res);
+
+		/* Deliver the packets held in the shim which are due */
+		due = flushShim(isTcp ? &tcpShim : &udpShim, isTcp);
+		if ((res->nOfRcvd == par->n) || (now > lastRcvd + par->timeout))
+			break;
+
+		/* Wait for the next packet or for the next send or delivery */
+		wait = nextSend - now;
+		if ((due > 0) && (due < nextSend))
+			wait = (due > now ? due - now : 0);
+		ts.tv_sec = (time_t)(wait/1000000000ULL);
+		ts.tv_nsec = (long)(wait%1000000000ULL);
+		pfd[0].fd = rxFd;
+		pfd[0].events = POLLIN;
+		pfd[1].fd = txFd;
+		pfd[1].events = POLLIN;
+		if (ppoll(pfd, (isTcp ? 1 : 2), &ts, NULL) <= 0)
+			continue;
+		now = CrDaClockGetHostTime();
+
+		if (isTcp) {
+			/* Frame the received reports */
+			if (rxStart > 0) {
+				memmove(rxBuffer, rxBuffer+rxStart, rxEnd-rxStart);
+				rxEnd -= rxStart;
+				rxStart = 0;
+			}
+			k = (int)recv(rxFd, rxBuffer+rxEnd, CR_DA_UDP_BENCH_RX_SIZE-rxEnd, 0);
+			if (k > 0)
+				rxEnd += k;
+			while ((rxEnd - rxStart > 0) && (rxEnd - rxStart >= rxBuffer[rxStart])) {
+				if (deliver(rxBuffer+rxStart, now, res))
+					lastRcvd = now;
+				rxStart += rxBuffer[rxStart];
+			}
+			continue;
+		}
+
+		/* Receiver: deliver the reports which are not duplicates */
+		while ((k = (int)recv(rxFd, rxBuffer, CR_DA_UDP_BENCH_RX_SIZE, 0)) > 0) {
+			if (CrDaUdpLinkRecordRcvd(CR_DA_UDP_BENCH_TX_PEER, rxBuffer) && deliver(rxBuffer, now, res))
+				lastRcvd = now;
+		}
+
+		/* Sender: send again the reports listed in the NACKs */
+		while ((k = (int)recv(txFd, rxBuffer, CR_DA_UDP_BENCH_RX_SIZE, 0)) > 0) {
+			if (!CrDaUdpLinkIsNack(rxBuffer, (unsigned int)k))
+				continue;
+			n = CrDaUdpLinkGetRtx(CR_DA_UDP_BENCH_RX_PEER, rxBuffer, rtx, CR_DA_UDP_LINK_N_OF_RTX_SLOTS);
+			for (i=0; i<n; i++)
+				shimUdp(txFd, &rxAddr, rtx[i], rtx[i][0], par, res);
+		}
+	}
+
+	close(txFd);
+	close(rxFd);
+	computeStats(res);
+	return 1;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static int deliver(const unsigned char* pckt, unsigned long long now, CrDaUdpBenchRes_t* res) {
+	unsigned int nr;
+
+	memcpy(&nr, pckt+CR_DA_PCKT_PAR_OFFSET, sizeof(nr));
+	if (nr >= res->nOfSent)
+		return 0;	/* a report sent after the measured reports */
+	latency[res->nOfRcvd] = now - sendTime[nr];
+	res->nOfRcvd++;
+	return 1;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static void computeStats(CrDaUdpBenchRes_t* res) {
+	unsigned long long total = 0;
+	unsigned long i;
+
+	if (res->nOfRcvd == 0)
+		return;
+	for (i=0; i<res->nOfRcvd; i++)
+		total += latency[i];
+	qsort(latency, res->nOfRcvd, sizeof(unsigned long long), &cmpLatency);
+	res->min = latency[0];
+	res->avg = total/res->nOfRcvd;
+	res->p50 = latency[res->nOfRcvd/2];
+	i = (res->nOfRcvd*99)/100;
+	res->p99 = latency[(i < res->nOfRcvd ? i : res->nOfRcvd-1)];
+	res->max = latency[res->nOfRcvd-1];
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static void printRes(const char* name, CrDaUdpBenchRes_t* res) {
+	printf("%-5s %8lu %8lu %8lu %9.1f %9.1f %9.1f %9.1f %9.1f\n", name, res->nOfSent, res->nOfDropped,
+	       res->nOfSent - res->nOfRcvd, res->min/1000.0, res->avg/1000.0, res->p50/1000.0,
+	       res->p99/1000.0, res->max/1000.0);
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static int cmpLatency(const void* a, const void* b) {
+	unsigned long long x = *(const unsigned long long*)a;
+	unsigned long long y = *(const unsigned long long*)b;
+
+	return (x > y) - (x < y);
+}
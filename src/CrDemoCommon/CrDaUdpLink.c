@@ -0,0 +1,310 @@
+/**
+ * @file
+ * @ingroup crDemoCommon
+ * Implementation of the reliability layer of the UDP transport.
+ *
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the CORDET Framework.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "CrDaUdpLink.h"
+/* Include framework files */
+#include "CrFwConstants.h"
+#include "Pckt/CrFwPckt.h"
+
+/** A sequence of packets tracked by the receiver */
+typedef struct {
+	/** The peer application from which the packets are received (zero if the entry is free) */
+	unsigned char peer;
+	/** The source of the packets */
+	unsigned char src;
+	/** The destination of the packets */
+	unsigned char dest;
+	/** The group of the packets */
+	unsigned char group;
+	/** The sequence counter of the next expected packet */
+	CrFwSeqCnt_t next;
+	/** The missing packets (bit i is set if the packet with sequence counter next-1-i is missing) */
+	unsigned int miss;
+	/** Flag set when a gap has been found and no NACK has yet been sent for it */
+	int isNackDue;
+	/** The time in nanoseconds after which the NACK is repeated */
+	unsigned long long nackTime;
+	/** The number of NACKs sent since the last gap was found */
+	unsigned int nOfNacks;
+} CrDaUdpLinkSeq_t;
+
+/** The sequences tracked by the receiver */
+static CrDaUdpLinkSeq_t seqs[CR_DA_UDP_LINK_N_OF_SEQS];
+
+/** The packets in the retransmit buffer */
+static unsigned char rtxSlot[CR_DA_UDP_LINK_N_OF_RTX_SLOTS][CR_DA_UDP_LINK_RTX_SLOT_SIZE];
+
+/** The peer applications to which the packets in the retransmit buffer were sent (zero if the slot is free) */
+static unsigned char rtxPeer[CR_DA_UDP_LINK_N_OF_RTX_SLOTS];
+
+/** The slot of the retransmit buffer where the next packet is stored */
+static unsigned int rtxNext = 0;
+
+/** The interval in nanoseconds after which a NACK is repeated */
+static unsigned long long nackInterval = 0;
+
+/** The number of packets which were found missing */
+static unsigned long nOfMissing = 0;
+
+/** The number of NACKs which were sent */
+static unsigned long nOfNacks = 0;
+
+/** The number of packets which were sent again */
+static unsigned long nOfRtx = 0;
+
+/** The number of packets listed in a NACK which were no longer in the retransmit buffer */
+static unsigned long nOfRtxMissed = 0;
+
+/** The number of missing packets which arrived */
+static unsigned long nOfRecovered = 0;
+
+/** The number of missing packets which were counted as lost */
+static unsigned long nOfLost = 0;
+
+/** The number of duplicate packets which were discarded */
+static unsigned long nOfDuplicates = 0;
+
+/**
+ * Return the sequence of a packet received from a peer.
+ * If the sequence is not yet tracked, a free entry is allocated for it.
+ * @param peer the identifier of the peer application
+ * @param pckt the packet
+ * @return the sequence or NULL if all entries are allocated
+ */
+static CrDaUdpLinkSeq_t* getSeq(unsigned char peer, const unsigned char* pckt);
+
+/**
+ * Move the window of a sequence forward.
+ * The missing packets which drop out of the window are counted as lost.
+ * @param seq the sequence
+ * @param n the number of packets by which the window is moved
+ */
+static void shiftWindow(CrDaUdpLinkSeq_t* seq, unsigned int n);
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaUdpLinkReset(unsigned long long interval) {
+	memset(seqs, 0, sizeof(seqs));
+	memset(rtxPeer, 0, sizeof(rtxPeer));
+	rtxNext = 0;
+	nackInterval = interval;
+	nOfMissing = 0;
+	nOfNacks = 0;
+	nOfRtx = 0;
+	nOfRtxMissed = 0;
+	nOfRecovered = 0;
+	nOfLost = 0;
+	nOfDuplicates = 0;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaUdpLinkRecordSent(unsigned char peer, const unsigned char* pckt) {
+	if (pckt[0] > CR_DA_UDP_LINK_RTX_SLOT_SIZE)
+		return;
+	memcpy(rtxSlot[rtxNext], pckt, pckt[0]);
+	rtxPeer[rtxNext] = peer;
+	rtxNext = (rtxNext+1) % CR_DA_UDP_LINK_N_OF_RTX_SLOTS;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+int CrDaUdpLinkRecordRcvd(unsigned char peer, const unsigned char* pckt) {
+	CrDaUdpLinkSeq_t* seq = getSeq(peer, pckt);
+	CrFwSeqCnt_t seqCnt = CrFwPcktGetSeqCnt((CrFwPckt_t)pckt);
+	unsigned int gap, bit;
+	int diff;
+
+	if (seq == NULL)	/* the packet is delivered without being tracked */
+		return 1;
+
+	diff = (int)(seqCnt - seq->next);
+	if (diff >= 0) {	/* the next expected packet or a packet after a gap */
+		gap = (unsigned int)diff;
+		shiftWindow(seq, gap+1);
+		if (gap > 0) {
+			nOfMissing += gap;
+			if (gap >= CR_DA_UDP_LINK_WINDOW) {	/* the oldest packets of the gap are outside the window */
+				nOfLost += gap - (CR_DA_UDP_LINK_WINDOW-1);
+				gap = CR_DA_UDP_LINK_WINDOW-1;
+			}
+			seq->miss |= ((1u << gap) - 1) << 1;
+			seq->isNackDue = 1;
+			seq->nOfNacks = 0;
+		}
+		seq->next = seqCnt+1;
+		return 1;
+	}
+
+	bit = (unsigned int)(-diff) - 1;
+	if ((bit >= CR_DA_UDP_LINK_WINDOW) && (seqCnt <= CR_DA_UDP_LINK_WINDOW)) {	/* the peer was restarted */
+		nOfLost += (unsigned long)__builtin_popcount(seq->miss);
+		seq->miss = 0;
+		seq->next = seqCnt+1;
+		return 1;
+	}
+	if (bit >= CR_DA_UDP_LINK_WINDOW) {	/* a late packet which was already counted as lost */
+		nOfDuplicates++;
+		return 0;
+	}
+	if ((seq->miss & (1u << bit)) != 0) {	/* a missing packet has arrived */
+		seq->miss &= ~(1u << bit);
+		nOfRecovered++;
+		return 1;
+	}
+	nOfDuplicates++;
+	return 0;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+unsigned int CrDaUdpLinkGetNack(unsigned long long now, unsigned char* peer, unsigned char* nack) {
+	CrDaUdpLinkSeq_t* seq;
+	CrFwSeqCnt_t base;
+	unsigned int i, j, hi, mask;
+
+	for (i=0; i<CR_DA_UDP_LINK_N_OF_SEQS; i++) {
+		seq = &seqs[i];
+		if ((seq->peer == 0) || (seq->miss == 0))
+			continue;
+		if (!seq->isNackDue && (now < seq->nackTime))
+			continue;
+		if (seq->nOfNacks >= CR_DA_UDP_LINK_N_OF_NACKS) {	/* give up on the missing packets */
+			nOfLost += (unsigned long)__builtin_popcount(seq->miss);
+			seq->miss = 0;
+			continue;
+		}
+
+		/* List the missing packets from the oldest one */
+		hi = 31 - (unsigned int)__builtin_clz(seq->miss);
+		base = seq->next - 1 - hi;
+		mask = 0;
+		for (j=0; j<=hi; j++)
+			if ((seq->miss & (1u << (hi-j))) != 0)
+				mask |= (1u << j);
+
+		nack[0] = 0;
+		nack[1] = seq->src;
+		nack[2] = seq->dest;
+		nack[3] = seq->group;
+		nack[4] = (unsigned char)(base >> 24);
+		nack[5] = (unsigned char)(base >> 16);
+		nack[6] = (unsigned char)(base >> 8);
+		nack[7] = (unsigned char)base;
+		nack[8] = (unsigned char)(mask >> 24);
+		nack[9] = (unsigned char)(mask >> 16);
+		nack[10] = (unsigned char)(mask >> 8);
+		nack[11] = (unsigned char)mask;
+		*peer = seq->peer;
+
+		seq->isNackDue = 0;
+		seq->nackTime = now + nackInterval;
+		seq->nOfNacks++;
+		nOfNacks++;
+		return CR_DA_UDP_LINK_NACK_LENGTH;
+	}
+	return 0;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+unsigned int CrDaUdpLinkGetRtx(unsigned char peer, const unsigned char* nack,
+                               const unsigned char** pckts, unsigned int maxN) {
+	CrFwSeqCnt_t base, seqCnt;
+	unsigned int mask, i, j, n = 0;
+	CrFwPckt_t p;
+
+	base = ((CrFwSeqCnt_t)nack[4] << 24) | ((CrFwSeqCnt_t)nack[5] << 16) |
+	       ((CrFwSeqCnt_t)nack[6] << 8) | (CrFwSeqCnt_t)nack[7];
+	mask = ((unsigned int)nack[8] << 24) | ((unsigned int)nack[9] << 16) |
+	       ((unsigned int)nack[10] << 8) | (unsigned int)nack[11];
+
+	for (i=0; (i<32) && (n<maxN); i++) {
+		if ((mask & (1u << i)) == 0)
+			continue;
+		seqCnt = base + i;
+		for (j=0; j<CR_DA_UDP_LINK_N_OF_RTX_SLOTS; j++) {
+			if (rtxPeer[j] != peer)
+				continue;
+			p = (CrFwPckt_t)rtxSlot[j];
+			if ((CrFwPcktGetSeqCnt(p) == seqCnt) && (CrFwPcktGetSrc(p) == nack[1]) &&
+			        (CrFwPcktGetDest(p) == nack[2]) && (CrFwPcktGetGroup(p) == nack[3]))
+				break;
+		}
+		if (j == CR_DA_UDP_LINK_N_OF_RTX_SLOTS) {
+			nOfRtxMissed++;
+			continue;
+		}
+		pckts[n++] = rtxSlot[j];
+		nOfRtx++;
+	}
+	return n;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+int CrDaUdpLinkIsNack(const unsigned char* dgram, unsigned int len) {
+	return ((len == CR_DA_UDP_LINK_NACK_LENGTH) && (dgram[0] == 0));
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaUdpLinkPrintSummary(const char* tag) {
+	printf("%s: UDP link: %lu packets missing, %lu NACKs sent, %lu packets sent again "
+	       "(%lu no longer buffered), %lu recovered, %lu lost, %lu duplicates\n",
+	       tag, nOfMissing, nOfNacks, nOfRtx, nOfRtxMissed, nOfRecovered, nOfLost, nOfDuplicates);
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+unsigned long CrDaUdpLinkGetNOfLost() {
+	return nOfLost;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static CrDaUdpLinkSeq_t* getSeq(unsigned char peer, const unsigned char* pckt) {
+	unsigned char src = (unsigned char)CrFwPcktGetSrc((CrFwPckt_t)pckt);
+	unsigned char dest = (unsigned char)CrFwPcktGetDest((CrFwPckt_t)pckt);
+	unsigned char group = (unsigned char)CrFwPcktGetGroup((CrFwPckt_t)pckt);
+	unsigned int i;
+
+	for (i=0; i<CR_DA_UDP_LINK_N_OF_SEQS; i++) {
+		if (seqs[i].peer == 0)
+			break;
+		if ((seqs[i].peer == peer) && (seqs[i].src == src) && (seqs[i].dest == dest) && (seqs[i].group == group))
+			return &seqs[i];
+	}
+	if (i == CR_DA_UDP_LINK_N_OF_SEQS)
+		return NULL;
+
+	/* The sequence counters start at 1: the packets which precede the first packet are missing */
+	memset(&seqs[i], 0, sizeof(seqs[i]));
+	seqs[i].peer = peer;
+	seqs[i].src = src;
+	seqs[i].dest = dest;
+	seqs[i].group = group;
+	seqs[i].next = CrFwPcktGetSeqCnt((CrFwPckt_t)pckt);
+	if (seqs[i].next <= CR_DA_UDP_LINK_WINDOW)
+		seqs[i].next = 1;
+	return &seqs[i];
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static void shiftWindow(CrDaUdpLinkSeq_t* seq, unsigned int n) {
+	if (n >= 32) {
+		nOfLost += (unsigned long)__builtin_popcount(seq->miss);
+		seq->miss = 0;
+		return;
+	}
+	nOfLost += (unsigned long)__builtin_popcount(seq->miss >> (32-n));
+	seq->miss <<= n;
+}
@@ -0,0 +1,161 @@
+/**
+ * @file
+ * @ingroup crDemoCommon
+ * Reliability layer of the UDP transport (see <code>CrDaUdpSocket.h</code>).
+ * UDP does not retransmit lost datagrams and, unlike TCP, it does not hold the
+ * packets which follow a lost packet until the lost packet has been retransmitted
+ * (head-of-line blocking).
+ * This module adds a selective retransmission to the UDP transport which only
+ * delays the lost packets.
+ *
+ * The packets are numbered by the OutStreams of the application which generates
+ * them (the sequence counter of <code>::CrFwPcktGetSeqCnt</code>) with one counter
+ * for each destination and group.
+ * The receiver of a link therefore tracks one <i>sequence</i> for each peer
+ * application from which it receives packets and for each source, destination and
+ * group of the packets (the packets relayed by the Slave 1 Application keep the
+ * sequence counter of their source).
+ * A packet whose sequence counter is larger than the next expected value reveals a
+ * gap: the packets in the gap are marked as missing and a negative acknowledgement
+ * (a <i>NACK</i>) which lists them is sent to the peer.
+ * The peer keeps a copy of the packets which it has recently sent (to a peer or to
+ * the broadcast destination) in a bounded retransmit buffer of
+ * <code>#CR_DA_UDP_LINK_N_OF_RTX_SLOTS</code> packets and it sends again the packets
+ * listed in the NACK which are still in this buffer.
+ * The buffer holds copies rather than references to the packets of the packet pool
+ * (see <code>CrDaPcktShare.h</code>) so that the packets kept for the NACK window
+ * neither deplete the pool nor count as load of the application (see
+ * <code>CrDaLoadSm.h</code>).
+ * The NACK is repeated every NACK interval until the missing packets have arrived or
+ * <code>#CR_DA_UDP_LINK_N_OF_NACKS</code> NACKs have been sent for the sequence
+ * or the missing packets have dropped out of the window of the
+ * <code>#CR_DA_UDP_LINK_WINDOW</code> packets which precede the next expected
+ * packet: the packets are then counted as lost.
+ *
+ * The packets are delivered as they arrive, including the retransmitted packets
+ * which therefore arrive out of order (the InStream reports a sequence counter error
+ * for them).
+ * A packet with a sequence counter which is not missing is a duplicate and it is
+ * discarded.
+ * Since the sequence counters start at 1, the packets which precede the first packet
+ * received for a sequence are missing if they are in the window.
+ * A packet with a sequence counter older than the window is discarded as a duplicate
+ * unless its sequence counter is in the first window: the sequence is then
+ * resynchronized (the peer was restarted).
+ * The loss of the last packets of a sequence is only detected when the next packet
+ * of the sequence arrives.
+ *
+ * A NACK is a datagram of <code>#CR_DA_UDP_LINK_NACK_LENGTH</code> bytes whose first
+ * byte is zero (the first byte of a packet holds its length and is never zero).
+ * It holds the source, destination and group of the sequence, the sequence counter
+ * of the first missing packet and a bit mask of the missing packets which follow it.
+ *
+ * The module only uses the packet functions of <code>CrFwPckt.h</code> and it is
+ * therefore also linked by the <code>cr_udpbench</code> tool (see
+ * <code>CrDaUdpBenchMain.c</code>).
+ *
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the CORDET Framework.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#ifndef CRDA_UDPLINK_H_
+#define CRDA_UDPLINK_H_
+
+/** The number of packets held in the retransmit buffer */
+#define CR_DA_UDP_LINK_N_OF_RTX_SLOTS 64
+
+/** The maximum length in bytes of a packet held in the retransmit buffer */
+#define CR_DA_UDP_LINK_RTX_SLOT_SIZE 256
+
+/** The maximum number of sequences which are tracked by the receiver */
+#define CR_DA_UDP_LINK_N_OF_SEQS 16
+
+/** The number of packets preceding the next expected packet of a sequence which may be missing */
+#define CR_DA_UDP_LINK_WINDOW 32
+
+/** The maximum number of NACKs sent for the missing packets of a sequence */
+#define CR_DA_UDP_LINK_N_OF_NACKS 8
+
+/** The length in bytes of a NACK */
+#define CR_DA_UDP_LINK_NACK_LENGTH 12
+
+/**
+ * Clear the sequences, the retransmit buffer and the statistics of the link.
+ * @param nackInterval the interval in nanoseconds after which a NACK is repeated
+ * (it should be larger than the round-trip time of the link)
+ */
+void CrDaUdpLinkReset(unsigned long long nackInterval);
+
+/**
+ * Store a copy of a packet which has been sent to a peer in the retransmit buffer.
+ * The copy replaces the oldest packet in the buffer.
+ * @param peer the identifier of the peer application
+ * @param pckt the packet
+ */
+void CrDaUdpLinkRecordSent(unsigned char peer, const unsigned char* pckt);
+
+/**
+ * Update the sequence of a packet which has been received from a peer.
+ * If the packet reveals a gap, the packets in the gap are marked as missing and
+ * a NACK for them is returned by the next call to <code>::CrDaUdpLinkGetNack</code>.
+ * @param peer the identifier of the peer application
+ * @param pckt the packet
+ * @return 1 if the packet is to be delivered; 0 if it is a duplicate
+ */
+int CrDaUdpLinkRecordRcvd(unsigned char peer, const unsigned char* pckt);
+
+/**
+ * Build the next NACK which is due.
+ * A NACK is due for a sequence with missing packets if no NACK has been sent for it
+ * since the last gap was found or since the NACK interval.
+ * This function should be called after each received packet and once in each cycle
+ * until it returns zero.
+ * @param now the current time in nanoseconds
+ * @param peer the identifier of the peer application to which the NACK is sent
+ * @param nack the buffer of <code>#CR_DA_UDP_LINK_NACK_LENGTH</code> bytes where the NACK is built
+ * @return the length of the NACK or zero if no NACK is due
+ */
+unsigned int CrDaUdpLinkGetNack(unsigned long long now, unsigned char* peer, unsigned char* nack);
+
+/**
+ * Look up the packets listed in a NACK from a peer in the retransmit buffer.
+ * @param peer the identifier of the peer application which sent the NACK
+ * @param nack the NACK
+ * @param pckts the array where the packets to be sent again are returned
+ * @param maxN the size of the array
+ * @return the number of packets to be sent again
+ */
+unsigned int CrDaUdpLinkGetRtx(unsigned char peer, const unsigned char* nack,
+                               const unsigned char** pckts, unsigned int maxN);
+
+/**
+ * Check whether a datagram is a NACK.
+ * @param dgram the datagram
+ * @param len the length of the datagram
+ * @return 1 if the datagram is a NACK; 0 otherwise
+ */
+int CrDaUdpLinkIsNack(const unsigned char* dgram, unsigned int len);
+
+/**
+ * Print the statistics of the link: the number of missing packets, of NACKs,
+ * of retransmitted packets, of recovered packets, of lost packets and of duplicates.
+ * @param tag the tag of the application with which the summary is prefixed
+ */
+void CrDaUdpLinkPrintSummary(const char* tag);
+
+/**
+ * Return the number of packets which have been counted as lost.
+ * @return the number of lost packets
+ */
+unsigned long CrDaUdpLinkGetNOfLost();
+
+#endif /* CRDA_UDPLINK_H_ */
@@ -0,0 +1,435 @@
+/**
+ * @file
+ * @ingroup crDemoCommon
+ * Implementation of the UDP transport.
+ *
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the CORDET Framework.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#include <stdlib.h>
+#include "CrDaUdpSocket.h"
+#include "CrDaUdpLink.h"
+#include "CrDaConstants.h"
+#include "CrDaPcktRecorder.h"
+#include "CrDaStats.h"
+#include "CrDaBackpressure.h"
+#include "CrDaTrace.h"
+#include "CrDaClock.h"
+/* Include FW Profile files */
+#include "FwSmConstants.h"
+#include "FwSmConfig.h"
+#include "FwSmCore.h"
+#include "FwPrConfig.h"
+#include "FwPrCore.h"
+#include "FwPrConstants.h"
+/* Include configuration files */
+#include "CrFwCmpData.h"
+/* Include framework files */
+#include "InStream/CrFwInStream.h"
+#include "OutStream/CrFwOutStream.h"
+#include "BaseCmp/CrFwBaseCmp.h"
+#include "Pckt/CrFwPckt.h"
+/* Include file for socket implementation */
+#include <stdio.h>
+#include <unistd.h>
+#include <string.h>
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <netdb.h>
+#include <fcntl.h>
+#include <errno.h>
+
+/** The base port number */
+static int portno = 0;
+
+/** The host name */
+static char* hostName = NULL;
+
+/** The identifier of the host application */
+static unsigned char appId = 0;
+
+/** The address of the host (the port is set for each datagram) */
+static struct sockaddr_in hostAddr;
+
+/** The file descriptor for the socket (-1 if the socket has not been initialized) */
+static int sockfd = -1;
+
+/** The file descriptor for the socket of the broadcast destination (-1 in the Master Application or if it has not been initialized) */
+static int mcastfd = -1;
+
+/** The maximum size of an incoming packet */
+static int pcktMaxLength;
+
+/** The Read Buffer */
+static unsigned char readBuffer[CR_DA_UDP_LINK_RTX_SLOT_SIZE];
+
+/** The length of the packet in the Read Buffer (zero if the Read Buffer is empty) */
+static int readLength = 0;
+
+/**
+ * Read the datagrams from the socket until a packet is available in the Read Buffer
+ * or no more datagrams are available.
+ * The NACKs are served from the retransmit buffer and the duplicate packets are discarded.
+ */
+static void fillReadBuffer();
+
+/**
+ * Open the socket of the broadcast destination and join its multicast group on the
+ * interface of the host.
+ * @return 1 if the socket was opened; 0 otherwise
+ */
+static int openMcast();
+
+/**
+ * Read a datagram from a socket.
+ * @param fd the socket
+ * @param peer the identifier of the application which sent the datagram
+ * @return the length of the datagram or -1 if no datagram is available
+ */
+static int readDgram(int fd, unsigned char* peer);
+
+/**
+ * Send the NACKs which are due.
+ */
+static void sendNacks();
+
+/**
+ * Send a datagram to a peer application or to the multicast group of the broadcast destination.
+ * @param peer the identifier of the peer application or <code>#CR_DA_BROADCAST</code>
+ * @param dgram the datagram
+ * @param len the length of the datagram
+ * @return 1 if the datagram was sent; 0 otherwise
+ */
+static int sendTo(unsigned char peer, const unsigned char* dgram, int len);
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaUdpSocketInitAction(FwPrDesc_t prDesc) {
+	CrFwCmpData_t* streamData = (CrFwCmpData_t*)FwPrGetData(prDesc);
+	struct sockaddr_in addr;
+	struct hostent* server;
+	int flags;
+
+	if (sockfd < 0) {	/* Check if socket is not yet initialized */
+		server = gethostbyname(hostName);
+		if (server == NULL) {
+			perror("CrDaUdpSocketInitAction, Get host name");
+			streamData->outcome = 0;
+			return;
+		}
+		bzero((char*) &hostAddr, sizeof(hostAddr));
+		hostAddr.sin_family = AF_INET;
+		bcopy((char*)server->h_addr,
+		      (char*)&hostAddr.sin_addr.s_addr,
+		      server->h_length);
+
+		/* Clear the read buffer and the reliability layer */
+		pcktMaxLength = (int)CrFwPcktGetMaxLength();
+		readLength = 0;
+		CrDaUdpLinkReset(CR_DA_UDP_NACK_INTERVAL);
+
+		sockfd = socket(AF_INET, SOCK_DGRAM, 0);
+		if (sockfd < 0) {
+			perror("CrDaUdpSocketInitAction, Socket Creation");
+			sockfd = -1;
+			streamData->outcome = 0;
+			return;
+		}
+		flags = fcntl(sockfd, F_GETFL, 0);
+		if ((flags < 0) || (fcntl(sockfd, F_SETFL, flags | O_NONBLOCK) < 0)) {
+			perror("CrDaUdpSocketInitAction, Set socket attributes");
+			close(sockfd);
+			sockfd = -1;
+			streamData->outcome = 0;
+			return;
+		}
+		addr = hostAddr;
+		addr.sin_port = htons(portno + appId);
+		if (bind(sockfd, (struct sockaddr*)&addr, sizeof(addr)) < 0) {
+			perror("CrDaUdpSocketInitAction, Socket Binding");
+			close(sockfd);
+			sockfd = -1;
+			streamData->outcome = 0;
+			return;
+		}
+
+		/* The broadcast packets leave on the interface of the host where the slave applications joined the group */
+		if (setsockopt(sockfd, IPPROTO_IP, IP_MULTICAST_IF, &hostAddr.sin_addr, sizeof(hostAddr.sin_addr)) < 0)
+			perror("CrDaUdpSocketInitAction, Set multicast interface");
+		if ((appId != CR_DA_MASTER) && !openMcast()) {
+			close(sockfd);
+			sockfd = -1;
+			streamData->outcome = 0;
+			return;
+		}
+	}
+
+	/* Execute default initialization action for OutStream/InStream */
+	if (streamData->typeId == CR_FW_INSTREAM_TYPE)
+		CrFwInStreamDefInitAction(prDesc);
+	else
+		CrFwOutStreamDefInitAction(prDesc);
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaUdpSocketShutdownAction(FwSmDesc_t smDesc) {
+	CrFwCmpData_t* streamData = (CrFwCmpData_t*)FwSmGetData(smDesc);
+
+	if (streamData->typeId == CR_FW_INSTREAM_TYPE)
+		CrFwInStreamDefShutdownAction(smDesc);
+	else
+		CrFwOutStreamDefShutdownAction(smDesc);
+
+	if (sockfd < 0) 	/* Check if socket was already shutdown */
+		return;
+	close(sockfd);
+	sockfd = -1;
+	if (mcastfd >= 0) {
+		close(mcastfd);
+		mcastfd = -1;
+	}
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaUdpSocketInitCheck(FwPrDesc_t prDesc) {
+	CrFwCmpData_t* prData = (CrFwCmpData_t*)FwPrGetData(prDesc);
+
+	if ((int)CrFwPcktGetMaxLength() > 255) {
+		prData->outcome = 0;
+		return;
+	}
+
+	if ((portno == 0) || (hostName == NULL) || (appId == 0)) {
+		prData->outcome = 0;
+		return;
+	}
+
+	prData->outcome = 1;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaUdpSocketConfigAction(FwPrDesc_t prDesc) {
+	CrFwCmpData_t* streamData = (CrFwCmpData_t*)FwPrGetData(prDesc);
+
+	/* Clear Read Buffer */
+	readLength = 0;
+
+	if (streamData->typeId == CR_FW_INSTREAM_TYPE)
+		CrFwInStreamDefConfigAction(prDesc);
+	else
+		CrFwOutStreamDefConfigAction(prDesc);
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaUdpSocketPoll() {
+	FwSmDesc_t inStream;
+
+	if (sockfd < 0)
+		return;
+
+	sendNacks();
+	fillReadBuffer();
+	if (readLength == 0)
+		return;
+
+	inStream = CrFwInStreamGet(CrFwPcktGetSrc((CrFwPckt_t)readBuffer));
+	CrFwInStreamPcktAvail(inStream);
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+CrFwPckt_t CrDaUdpSocketPcktCollect(CrFwDestSrc_t src) {
+	CrFwPckt_t pckt;
+
+	if (readLength == 0)
+		return NULL;
+	if (CrFwPcktGetSrc((CrFwPckt_t)readBuffer) != src)
+		return NULL;
+	if (CrDaBackpressureIsFull(src))
+		return NULL;
+
+	pckt = CrFwPcktMake((CrFwPcktLength_t)readLength);
+	if (pckt == NULL)
+		return NULL;
+	memcpy(pckt, readBuffer, readLength);
+	readLength = 0;
+	CrDaPcktRecorderRecord(crDaPcktRecIn, src, pckt);
+	CrDaStatsPcktIn(src, CrFwPcktGetLength(pckt));
+	return pckt;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+CrFwBool_t CrDaUdpSocketIsPcktAvail(CrFwDestSrc_t src) {
+	/* Leave the datagrams in the socket while the InStream of the source cannot take them */
+	if (CrDaBackpressureIsFull(src))
+		return 0;
+	fillReadBuffer();
+	if (readLength == 0)
+		return 0;
+	return (CrFwPcktGetSrc((CrFwPckt_t)readBuffer) == src);
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+CrFwBool_t CrDaUdpSocketPcktHandover(CrFwPckt_t pckt) {
+	CrFwDestSrc_t dest = CrFwPcktGetDest(pckt);
+	unsigned char link;
+
+	if (sockfd < 0)
+		return 0;
+
+	if (dest == CR_DA_BROADCAST)
+		link = CR_DA_BROADCAST;
+	else if (appId == CR_DA_SLAVE_1)
+		link = (dest == CR_DA_MASTER) ? CR_DA_MASTER : CR_DA_SLAVE_2;
+	else
+		link = CR_DA_SLAVE_1;
+
+	if (!sendTo(link, (unsigned char*)pckt, (int)CrFwPcktGetLength(pckt)))
+		return 0;
+	CrDaUdpLinkRecordSent(link, (unsigned char*)pckt);
+
+	CrDaPcktRecorderRecord(crDaPcktRecOut, dest, pckt);
+	CrDaStatsPcktOut(dest, CrFwPcktGetLength(pckt));
+	return 1;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaUdpSocketSetPort(int n) {
+	portno = n;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaUdpSocketSetHost(char* name) {
+	hostName = name;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrDaUdpSocketSetAppId(unsigned char id) {
+	appId = id;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static void fillReadBuffer() {
+	const unsigned char* rtx[CR_DA_UDP_LINK_N_OF_RTX_SLOTS];
+	unsigned char peer, link;
+	unsigned int i, n;
+	int len;
+
+	while ((readLength == 0) && (sockfd >= 0)) {
+		len = readDgram(sockfd, &peer);
+		if ((len < 0) && (mcastfd >= 0))
+			len = readDgram(mcastfd, &peer);
+		if (len < 0)	/* no datagrams are available from the sockets */
+			return;
+
+		/* Send again the packets listed in a NACK (the broadcast packets only to the peer which lost them) */
+		if (CrDaUdpLinkIsNack(readBuffer, (unsigned int)len)) {
+			link = (readBuffer[2] == CR_DA_BROADCAST) ? CR_DA_BROADCAST : peer;
+			n = CrDaUdpLinkGetRtx(link, readBuffer, rtx, CR_DA_UDP_LINK_N_OF_RTX_SLOTS);
+			for (i=0; i<n; i++)
+				sendTo(peer, rtx[i], rtx[i][0]);
+			continue;
+		}
+
+		if ((len == 0) || (readBuffer[0] != len) || (len > pcktMaxLength)) {
+			printf("CrDaUdpSocketPoll: invalid packet received from socket\n");
+			continue;
+		}
+		if (!CrDaUdpLinkRecordRcvd(peer, readBuffer))
+			continue;	/* duplicate packet */
+
+		/* A slave application takes the packets for the broadcast destination as its own */
+		if (CrFwPcktGetDest((CrFwPckt_t)readBuffer) == CR_DA_BROADCAST)
+			CrFwPcktSetDest((CrFwPckt_t)readBuffer, appId);
+		readLength = len;
+		sendNacks();
+	}
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static int openMcast() {
+	struct sockaddr_in addr;
+	struct ip_mreq mreq;
+	int one = 1;
+
+	mcastfd = socket(AF_INET, SOCK_DGRAM, 0);
+	if (mcastfd < 0) {
+		perror("CrDaUdpSocketInitAction, Multicast socket creation");
+		return 0;
+	}
+
+	/* All slave applications on a host bind the port of the broadcast destination */
+	bzero((char*) &addr, sizeof(addr));
+	addr.sin_family = AF_INET;
+	addr.sin_addr.s_addr = inet_addr(CR_DA_UDP_MCAST_ADDR);
+	addr.sin_port = htons(portno + CR_DA_BROADCAST);
+	mreq.imr_multiaddr = addr.sin_addr;
+	mreq.imr_interface = hostAddr.sin_addr;
+	if ((setsockopt(mcastfd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one)) < 0) ||
+	        (fcntl(mcastfd, F_SETFL, O_NONBLOCK) < 0) ||
+	        (bind(mcastfd, (struct sockaddr*)&addr, sizeof(addr)) < 0) ||
+	        (setsockopt(mcastfd, IPPROTO_IP, IP_ADD_MEMBERSHIP, &mreq, sizeof(mreq)) < 0)) {
+		perror("CrDaUdpSocketInitAction, Join multicast group");
+		close(mcastfd);
+		mcastfd = -1;
+		return 0;
+	}
+	return 1;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static int readDgram(int fd, unsigned char* peer) {
+	struct sockaddr_in addr;
+	socklen_t addrLen = sizeof(addr);
+	int len;
+
+	CrDaTraceBegin("read", -1);
+	len = (int)recvfrom(fd, readBuffer, sizeof(readBuffer), 0, (struct sockaddr*)&addr, &addrLen);
+	CrDaTraceEnd("read");
+	if (len < 0) {
+		if ((errno != EAGAIN) && (errno != EWOULDBLOCK))
+			perror("CrDaUdpSocketPoll, Read from socket");
+		return -1;
+	}
+	*peer = (unsigned char)(ntohs(addr.sin_port) - portno);
+	return len;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static void sendNacks() {
+	unsigned char nack[CR_DA_UDP_LINK_NACK_LENGTH];
+	unsigned char peer;
+	unsigned long long now = CrDaClockGetHostTime();
+
+	while (CrDaUdpLinkGetNack(now, &peer, nack) > 0)
+		sendTo(peer, nack, CR_DA_UDP_LINK_NACK_LENGTH);
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static int sendTo(unsigned char peer, const unsigned char* dgram, int len) {
+	struct sockaddr_in addr = hostAddr;
+	int n;
+
+	if (peer == CR_DA_BROADCAST)
+		addr.sin_addr.s_addr = inet_addr(CR_DA_UDP_MCAST_ADDR);
+	addr.sin_port = htons(portno + peer);
+	CrDaTraceBegin("send", (int)peer);
+	n = (int)sendto(sockfd, dgram, len, 0, (struct sockaddr*)&addr, sizeof(addr));
+	CrDaTraceEnd("send");
+	if (n < 0) {
+		if ((errno != EAGAIN) && (errno != EWOULDBLOCK))
+			perror("CrDaUdpSocketPcktHandover, Write to socket");
+		return 0;
+	}
+	return 1;
+}
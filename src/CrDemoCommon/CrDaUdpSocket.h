@@ -0,0 +1,205 @@
+/**
+ * @file
+ * @ingroup crDemoCommon
+ * Interface for the UDP transport of the CORDET Demo.
+ * The TCP sockets of <code>CrDaClientSocket.h</code> and <code>CrDaServerSocket.h</code>
+ * deliver the packets of a connection in order: a lost packet delays all the packets
+ * which follow it until it has been retransmitted (head-of-line blocking).
+ * This module exchanges the packets as UDP datagrams and recovers the lost packets
+ * through the selective retransmission of <code>CrDaUdpLink.h</code> which only delays
+ * the lost packets.
+ *
+ * The InStreams and OutStreams of the demo applications are configured to use
+ * this module in place of the TCP sockets when the demo applications are compiled
+ * with <code>CR_DA_UDP</code> defined (see the InStream and OutStream
+ * configuration files of the demo applications).
+ * More precisely:
+ * - Function <code>::CrDaUdpSocketInitAction</code> should be used as the initialization
+ *   action for the InStreams and OutStreams.
+ * - Function <code>::CrDaUdpSocketShutdownAction</code> should be used as the shutdown
+ *   action for the InStreams and OutStreams.
+ * - Function <code>::CrDaUdpSocketInitCheck</code> should be used as the initialization
+ *   check for the InStreams and OutStreams.
+ * - Function <code>::CrDaUdpSocketConfigAction</code> should be used as the configuration
+ *   action for the InStreams.
+ * - Function <code>::CrDaUdpSocketPcktCollect</code> should be used as the Packet Collect
+ *   operation for the InStreams.
+ * - Function <code>::CrDaUdpSocketIsPcktAvail</code> should be used as the Packet Available
+ *   Check operation for the InStreams.
+ * - Function <code>::CrDaUdpSocketPcktHandover</code> should be used as the Packet Hand-Over
+ *   operation for the OutStreams.
+ * .
+ *
+ * Each application binds one UDP socket to port <code>#CR_DA_UDP_PORT</code> plus
+ * its application identifier on the host set with <code>::CrDaUdpSocketSetHost</code>.
+ * The datagrams follow the links of the socket-based demo: the Slave 1 Application
+ * sends the packets for the Master Application to the Master Application and all other
+ * packets to the Slave 2 Application, while the Master and Slave 2 Applications send
+ * all their packets to the Slave 1 Application.
+ * Each datagram carries one packet or one NACK of the reliability layer.
+ * The peer application of a received datagram is identified from its source port.
+ *
+ * The packets for the broadcast destination <code>#CR_DA_BROADCAST</code> are sent
+ * once to the multicast group <code>#CR_DA_UDP_MCAST_ADDR</code> on port
+ * <code>#CR_DA_UDP_PORT</code> plus <code>#CR_DA_BROADCAST</code>, whatever the number
+ * of Slave Applications.
+ * The Slave Applications join this group on the interface of their host and read the
+ * datagrams of the group as well as those of their own port.
+ * A Slave Application takes a packet for the broadcast destination as its own: it
+ * sets the destination of the packet to its application identifier before the packet
+ * is collected by its InStream.
+ * The broadcast packets are recovered by the reliability layer like the other packets
+ * but a packet listed in a NACK is only sent again to the Slave Application which
+ * lost it.
+ *
+ * Like the TCP sockets, the module assumes a polling approach for incoming packets:
+ * function <code>::CrDaUdpSocketPoll</code> should be called once in every cycle.
+ * This function sends the NACKs which are due and reads the datagrams until a packet
+ * is available in the <i>Read Buffer</i>: the NACKs are served from the retransmit
+ * buffer of the reliability layer and the duplicate packets are discarded.
+ * It then signals the arrival of the packet to the InStream of its source.
+ * While the packet queue of this InStream is full (see <code>CrDaBackpressure.h</code>),
+ * the packet is held in the Read Buffer and the socket is not read.
+ * Since UDP has no flow control, the datagrams which then overflow the kernel buffer
+ * of the socket are lost and they are recovered by the reliability layer as long as
+ * they are held in the retransmit buffer of their sender.
+ *
+ * The sends are non-blocking: if the socket cannot accept a packet, the OutStream
+ * keeps it in its packet queue and hands it over again in the next cycle.
+ * Packets which are collected or handed over are recorded by the packet recorder
+ * (see <code>CrDaPcktRecorder.h</code>) and counted by the run statistics
+ * (see <code>CrDaStats.h</code>).
+ *
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the CORDET Framework.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#ifndef CRDA_UDPSOCKET_H_
+#define CRDA_UDPSOCKET_H_
+
+/* Include Framework Files */
+#include "CrFwConstants.h"
+/* Include Configuration Files */
+#include "CrFwUserConstants.h"
+/* Include FW Profile files */
+#include "FwSmConstants.h"
+#include "FwPrConstants.h"
+
+/**
+ * Initialization action for the UDP socket.
+ * If the UDP socket has already been initialized, this function calls the
+ * Initialization Action of the base InStream/OutStream and then returns.
+ * If the UDP socket has not yet been initialized, this action:
+ * - resolves the address of the host;
+ * - clears the Read Buffer and the reliability layer;
+ * - creates the socket as a non-blocking socket and binds it to its port;
+ * - in a Slave Application, creates the socket of the broadcast destination and joins
+ *   its multicast group;
+ * - executes the Initialization Action of the base InStream/OutStream;
+ * - sets the outcome to "success" if the previous operations are successful.
+ * .
+ * @param prDesc the initialization procedure descriptor.
+ */
+void CrDaUdpSocketInitAction(FwPrDesc_t prDesc);
+
+/**
+ * Shutdown action for the UDP socket.
+ * This action executes the Shutdown Action of the base InStream/OutStream and,
+ * if the UDP socket has not yet been shut down, it closes the socket and the socket of
+ * the broadcast destination.
+ * @param smDesc the InStream or OutStream State Machine descriptor.
+ */
+void CrDaUdpSocketShutdownAction(FwSmDesc_t smDesc);
+
+/**
+ * Initialization check for the UDP socket.
+ * The check is successful if: the maximum length of a packet (as retrieved from
+ * <code>::CrFwPcktGetMaxLength</code>) is smaller than 256; and the port number,
+ * host name and application identifier have been set.
+ * @param prDesc the initialization procedure descriptor.
+ */
+void CrDaUdpSocketInitCheck(FwPrDesc_t prDesc);
+
+/**
+ * Configuration action for the UDP socket.
+ * This action clears the Read Buffer and executes the Configuration Action of
+ * the base InStream/OutStream.
+ * @param prDesc the configuration procedure descriptor.
+ */
+void CrDaUdpSocketConfigAction(FwPrDesc_t prDesc);
+
+/**
+ * Poll the UDP socket.
+ * This function should be called periodically by an external scheduler.
+ * It sends the NACKs which are due and, if the Read Buffer is empty, it reads the
+ * datagrams from the socket until a packet is available.
+ * If the Read Buffer holds a packet, function <code>::CrFwInStreamPcktAvail</code>
+ * is called on the InStream associated to the source of the packet.
+ */
+void CrDaUdpSocketPoll();
+
+/**
+ * Function implementing the Packet Collect Operation for the UDP socket.
+ * If the packet in the Read Buffer has a source attribute equal to
+ * <code>packetSource</code>, this function copies it into a newly created packet
+ * instance, clears the Read Buffer and returns the packet instance.
+ * Otherwise, or if the packet queue of the InStream of <code>packetSource</code> is
+ * full (see <code>CrDaBackpressure.h</code>), it returns NULL.
+ * @param pcktSrc the source associated to the InStream
+ * @return the packet
+ */
+CrFwPckt_t CrDaUdpSocketPcktCollect(CrFwDestSrc_t pcktSrc);
+
+/**
+ * Function implementing the Packet Available Check Operation for the UDP socket.
+ * If the packet queue of the InStream of <code>packetSource</code> is full (see
+ * <code>CrDaBackpressure.h</code>), the function returns 0 without reading from the
+ * socket.
+ * Otherwise, if the Read Buffer is empty, the datagrams are read from the socket until
+ * a packet is available and the function returns 1 if the packet in the Read Buffer has
+ * a source attribute equal to <code>packetSource</code>.
+ * @param pcktSrc the source associated to the InStream
+ * @return the value of a predefined flag
+ */
+CrFwBool_t CrDaUdpSocketIsPcktAvail(CrFwDestSrc_t pcktSrc);
+
+/**
+ * Function implementing the hand-over operation for the UDP socket.
+ * This function sends the packet to the next application on its route, or to the
+ * multicast group if its destination is the broadcast destination, with a
+ * non-blocking send and stores a copy of it in the retransmit buffer of the
+ * reliability layer.
+ * @param pckt the packet to be sent
+ * @return 1 if the packet was sent; 0 if the socket could not accept it
+ */
+CrFwBool_t CrDaUdpSocketPcktHandover(CrFwPckt_t pckt);
+
+/**
+ * Set the base port number (the socket of an application is bound to the base port
+ * plus the application identifier).
+ * @param n the base port number.
+ */
+void CrDaUdpSocketSetPort(int n);
+
+/**
+ * Set the host name of the applications.
+ * @param name the host name.
+ */
+void CrDaUdpSocketSetHost(char* name);
+
+/**
+ * Set the identifier of the host application.
+ * @param id the application identifier.
+ */
+void CrDaUdpSocketSetAppId(unsigned char id);
+
+#endif /* CRDA_UDPSOCKET_H_ */
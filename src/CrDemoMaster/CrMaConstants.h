@@ -22,9 +22,15 @@
 #include "FwPrConstants.h"
 
 /** The number of framework components */
-#define CR_MA_N_OF_FW_CMP 9
+#define CR_MA_N_OF_FW_CMP 10
 
 /** The temperature limit */
 #define TEMP_LIMIT 50
 
+/**
+ * The number of distinct temperature limits, centred on <code>::TEMP_LIMIT</code>, which
+ * the commands of a run profile set (every command of a cycle sets a different limit).
+ */
+#define TEMP_LIMIT_RANGE 40
+
 #endif /* CRMA_CONSTANTS_H_ */
@@ -20,6 +20,7 @@
 #include <stdlib.h>
 #include <string.h>
 #include "CrDaConstants.h"
+#include "CrDaTrace.h"
 /* Include configuration files */
 #include "CrFwCmpData.h"
 /* Include framework files */
@@ -49,17 +50,76 @@ void CrMaInRepTempViolationUpdateAction(FwPrDesc_t prDesc) {
 	CrFwInRepData_t* cmpSpecificData = (CrFwInRepData_t*)(cmpData->cmpSpecificData);
 	CrFwPckt_t pckt = cmpSpecificData->pckt; /* the incoming packet */
 	char* pcktPar = CrFwPcktGetParStart(pckt);	/* the parameter area of the incoming packet */
+
+	CrDaTraceInstant("rep update", (int)cmpData->instanceId);
 	if (CrFwPcktGetSrc(pckt) == CR_DA_SLAVE_1) {
 		printf("MA: Seq. Counter %d - Limit Violation in Slave 1, Temperature = %d\n", CrFwPcktGetSeqCnt(pckt),
 		       pcktPar[0]);
 		cmpData->outcome = 1;
-		return;
-	}
-	if (CrFwPcktGetSrc(pckt) == CR_DA_SLAVE_2) {
+	} else if (CrFwPcktGetSrc(pckt) == CR_DA_SLAVE_2) {
 		printf("MA: Seq. Counter %d - Limit Violation in Slave 2, Temperature = %d\n", CrFwPcktGetSeqCnt(pckt),
 		       pcktPar[0]);
 		cmpData->outcome = 1;
+	} else
+		cmpData->outcome = 0;
+}
+
+/*-----------------------------------------------------------------------------------------*/
+CrFwBool_t CrMaInRepTempViolationAggrValidityCheck(FwPrDesc_t prDesc) {
+	CrFwCmpData_t* cmpData = (CrFwCmpData_t*)FwPrGetData(prDesc);
+	CrFwInRepData_t* cmpSpecificData = (CrFwInRepData_t*)(cmpData->cmpSpecificData);
+	CrFwPckt_t pckt = cmpSpecificData->pckt; /* the incoming packet */
+	unsigned char* pcktPar = (unsigned char*)CrFwPcktGetParStart(pckt);
+	unsigned int n;
+
+	if (CrFwPcktGetParLength(pckt) < CR_DA_AGGR_OFFSET_PAIRS)
+		return 0;
+	n = pcktPar[CR_DA_AGGR_OFFSET_N];
+	if (n > CR_DA_AGGR_CAPACITY(CrFwPcktGetParLength(pckt)))
+		return 0;
+	return 1;
+}
+
+/*-----------------------------------------------------------------------------------------*/
+void CrMaInRepTempViolationAggrUpdateAction(FwPrDesc_t prDesc) {
+	CrFwCmpData_t* cmpData = (CrFwCmpData_t*)FwPrGetData(prDesc);
+	CrFwInRepData_t* cmpSpecificData = (CrFwInRepData_t*)(cmpData->cmpSpecificData);
+	CrFwPckt_t pckt = cmpSpecificData->pckt; /* the incoming packet */
+	unsigned char* pcktPar = (unsigned char*)CrFwPcktGetParStart(pckt);
+	unsigned char* pair;
+	unsigned int nOfViolations;
+	unsigned int channel;
+	unsigned int n;
+	unsigned int i;
+	int slave;
+
+	CrDaTraceInstant("rep update", (int)cmpData->instanceId);
+	if (CrFwPcktGetSrc(pckt) == CR_DA_SLAVE_1)
+		slave = 1;
+	else if (CrFwPcktGetSrc(pckt) == CR_DA_SLAVE_2)
+		slave = 2;
+	else {
+		cmpData->outcome = 0;
 		return;
 	}
-	cmpData->outcome = 0;
+
+	nOfViolations = ((unsigned int)pcktPar[CR_DA_AGGR_OFFSET_TOTAL] << 24) |
+	                ((unsigned int)pcktPar[CR_DA_AGGR_OFFSET_TOTAL+1] << 16) |
+	                ((unsigned int)pcktPar[CR_DA_AGGR_OFFSET_TOTAL+2] << 8) |
+	                (unsigned int)pcktPar[CR_DA_AGGR_OFFSET_TOTAL+3];
+	n = pcktPar[CR_DA_AGGR_OFFSET_N];
+	if (n > 0)
+		channel = ((unsigned int)pcktPar[CR_DA_AGGR_OFFSET_PAIRS] << 16) |
+		          ((unsigned int)pcktPar[CR_DA_AGGR_OFFSET_PAIRS+1] << 8) |
+		          (unsigned int)pcktPar[CR_DA_AGGR_OFFSET_PAIRS+2];
+	else
+		channel = 0;
+	printf("MA: Seq. Counter %d - Limit Violation in Slave %d on %u channels (%u reported from channel %u)\n",
+	       CrFwPcktGetSeqCnt(pckt), slave, nOfViolations, n, channel);
+	for (i=0; i<n; i++) {
+		pair = pcktPar + CR_DA_AGGR_OFFSET_PAIRS + i*CR_DA_AGGR_PAIR_SIZE;
+		channel = ((unsigned int)pair[0] << 16) | ((unsigned int)pair[1] << 8) | (unsigned int)pair[2];
+		printf("MA:    Channel %u, Temperature = %d\n", channel, (signed char)pair[3]);
+	}
+	cmpData->outcome = 1;
 }
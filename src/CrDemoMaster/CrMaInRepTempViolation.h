@@ -16,6 +16,19 @@
  *   temperature violation.
  * .
  * This module defines functions which implement the above operations.
+ *
+ * This module also defines the operations of the Aggregated Temperature Violation
+ * InReport (service sub-type <code>#CR_DA_SERV_SUBTYPE_REP_AGGR</code>) through which a
+ * Slave Application reports all the channels in violation in one cycle (see
+ * <code>CrDaTempChannelMonitor.h</code>):
+ * - The Validity Check verifies that the number of (channel, temperature) pairs
+ *   is consistent with the length of the report packet
+ * - The Update Action Operation writes a message to standard output describing
+ *   each temperature violation in the report.
+ * .
+ * The Update Action Operations of both InReports record an instant event in the
+ * span tracer (see <code>CrDaTrace.h</code>).
+ *
  * These functions are associated to a specific kind of InReport in
  * the initializer <code>#CR_FW_INREP_INIT_KIND_DESC</code>.
  *
@@ -64,4 +77,25 @@ CrFwBool_t CrMaInRepTempViolationValidityCheck(FwPrDesc_t prDesc);
  */
 void CrMaInRepTempViolationUpdateAction(FwPrDesc_t prDesc);
 
+/**
+ * Implementation of the Validity Check Operation for the Aggregated Temperature
+ * Violation InReport.
+ * This function returns true if the (channel, temperature) pairs of the report fit
+ * within the parameter area of the report packet (see <code>#CR_DA_AGGR_CAPACITY</code>).
+ * @param prDesc the descriptor of the InReport reset procedure
+ * @return true if the report is valid, false otherwise
+ */
+CrFwBool_t CrMaInRepTempViolationAggrValidityCheck(FwPrDesc_t prDesc);
+
+/**
+ * Implementation of the Update Action Operation for the Aggregated Temperature
+ * Violation InReport.
+ * This function writes a message to <code>stdout</code> with the sequence counter,
+ * the source application and the total number of channels in violation, followed
+ * by one line for each (channel, temperature) pair in the report.
+ * The layout of the parameter area of the report is defined in <code>CrDaConstants.h</code>.
+ * @param prDesc the descriptor of the InReport procedure
+ */
+void CrMaInRepTempViolationAggrUpdateAction(FwPrDesc_t prDesc);
+
 #endif /* CRFW_INREP_SAMPLE1_H_ */
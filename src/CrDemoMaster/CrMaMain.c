@@ -57,10 +57,25 @@
 #include <unistd.h>
 /* Include Master Demo Files */
 #include "CrMaConstants.h"
+#include "CrMaMain.h"
 /* Include Common Demo Files */
 #include "CrDaConstants.h"
 #include "CrDaClientSocket.h"
 #include "CrDaServerSocket.h"
+#include "CrDaUdpSocket.h"
+#include "CrDaUdpLink.h"
+#include "CrDaPcktRecorder.h"
+#include "CrDaClock.h"
+#include "CrDaProfile.h"
+#include "CrDaStartUp.h"
+#include "CrDaHeapGuard.h"
+#include "CrDaStats.h"
+#include "CrDaTrace.h"
+#include "CrDaSizing.h"
+#include "CrDaOutLane.h"
+#include "CrDaLoadSm.h"
+#include "CrDaBackpressure.h"
+#include "CrDaLoopback.h"
 /* Include FW Profile files */
 #include "FwSmConstants.h"
 #include "FwSmConfig.h"
@@ -70,6 +85,7 @@
 #include "FwPrConstants.h"
 /* Include framework files */
 #include "OutRegistry/CrFwOutRegistry.h"
+#include "AppStartUp/CrFwAppSm.h"
 #include "Aux/CrFwAux.h"
 #include "BaseCmp/CrFwBaseCmp.h"
 #include "Pckt/CrFwPckt.h"
@@ -87,44 +103,71 @@
 #include "CrFwOutRegistryUserPar.h"
 #include "CrFwOutFactoryUserPar.h"
 #include "CrFwInFactoryUserPar.h"
+#include "CrFwInStreamUserPar.h"
+#include "CrFwOutStreamUserPar.h"
+#include "CrFwInManagerUserPar.h"
+#include "CrFwOutManagerUserPar.h"
 #include "CrFwCmpData.h"
 
+/** The InStreams from which packets are loaded in every cycle */
+static FwSmDesc_t inStreamSlave1, inStreamSlave2;
+
 /**
- * Main program for the Master Application.
- * This Main Program performs the following actions:
- * - It checks the consistency of the configuration parameters using
- *   <code>::CrFwAuxConfigCheck</code>.
- * - It initializes and configures the InStreams and OutStreams components
- *   (note that their initialization action initializes the client socket and
- *   this must be synchronized with the initialization of the server socket
- *   in the Slave 1 Application).
- * - It initializes and configures all framework components used by the
- *   Master Application.
- * - It executes a loop and in every cycle of the loop commands may be
- *   sent to the Slave Applications and reports may be received from them.
- * .
- * The schedule for sending commands to the Slave Applications is as follows:
- * - In cycles which are multiples of 5, the command to set the temperature limit
- *   in Slave 1 is sent
- * - In cycles which are multiples of 6, the command to enable temperature monitoring
- *   in Slave 1 is sent
- * - In cycles which are multiples of 90, the command to disable temperature
- *   monitoring in Slave 1 is sent
- * .
- * In all control cycles, the client socket waiting for reports from the two
- * slave applications is polled through a call to <code>::CrDaClientSocketPoll</code>.
- * @return always returns EXIT_SUCCESS
+ * Load the commands of the fixed command schedule of the demo for a control cycle.
+ * With the UDP transport, the commands to enable and disable temperature monitoring
+ * keep their schedule but they are loaded for the broadcast destination instead of
+ * one slave application: each of them therefore reaches all slave applications.
+ * @param cycle the cycle number
  */
-int main() {
+static void loadScheduledCmds(int cycle);
+
+/**
+ * Load a command to enable or disable temperature monitoring.
+ * A command for the broadcast destination <code>#CR_DA_BROADCAST</code> is put in
+ * the broadcast group <code>#CR_DA_BROADCAST_GROUP</code>.
+ * A command which cannot be created because the OutFactory is full is counted in the run
+ * statistics (see <code>CrDaStats.h</code>).
+ * @param servSubType the service sub-type of the command (enable or disable)
+ * @param dest the destination of the command
+ */
+static void loadMonitoringCmd(CrFwServSubType_t servSubType, CrFwDestSrc_t dest);
+
+/**
+ * Load the commands of the run profile for a control cycle (see <code>CrDaProfile.h</code>).
+ * In the first cycle, the commands to enable temperature monitoring in the two slave
+ * applications are loaded (with the UDP transport, a single command is loaded for the
+ * broadcast destination).
+ * In all cycles, the number of commands to set the temperature limit defined by the run
+ * profile are then loaded, alternately for the Slave 1 and the Slave 2 Application.
+ * Each command of a cycle sets a different limit (in a range of <code>::TEMP_LIMIT_RANGE</code>
+ * values centred on <code>::TEMP_LIMIT</code>) and the limit is printed so that the limits
+ * received by the slave applications can be checked against the limits sent (see
+ * <code>CheckStressRun.sh</code>).
+ * Commands which cannot be created because the OutFactory is full are counted in the run
+ * statistics (see <code>CrDaStats.h</code>).
+ * @param cycle the cycle number
+ */
+static void loadProfileCmds(int cycle);
+
+/* ---------------------------------------------------------------------------------------------*/
+int CrMaAppInit(int argc, char* argv[]) {
 	FwSmDesc_t fwCmp[CR_MA_N_OF_FW_CMP];
-	FwSmDesc_t inStreamSlave1, inStreamSlave2;
 	FwSmDesc_t outStreamSlave1, outStreamSlave2;
+#ifdef CR_DA_UDP
+	FwSmDesc_t outStreamBroadcast;
+#endif
 	CrFwConfigCheckOutcome_t configCheckOutcome;
-	FwSmDesc_t outCmd;
+	CrFwCounterU1_t inStreamPqSize[CR_FW_NOF_INSTREAM] = CR_FW_INSTREAM_PQSIZE;
+	CrFwCounterU1_t outStreamPqSize[CR_FW_NOF_OUTSTREAM] = CR_FW_OUTSTREAM_PQSIZE;
+	CrFwCounterU2_t inManagerPcrlSize[CR_FW_NOF_INMANAGER] = CR_FW_INMANAGER_PCRLSIZE;
+	CrFwCounterU2_t outManagerPoclSize[CR_FW_NOF_OUTMANAGER] = CR_FW_OUTMANAGER_POCLSIZE;
 	int i;
 
-	/* User warning about order in which demo applications are started */
-	printf("MA: The Slave 1 Application (Server Socket) must be started before the Master Application\n");
+	CrDaStartUpBegin();
+
+	/* Set the run profile from the command line */
+	if (!CrDaProfileParse(argc, argv, CR_FW_HOST_APP_ID))
+		return 0;
 
 	/* Check consistency of configuration parameters */
 	configCheckOutcome = CrFwAuxConfigCheck();
@@ -137,19 +180,56 @@ int main() {
 			printf("Consistency check of InCommand parameters in InFactory failed\n");
 		if (configCheckOutcome == crInFactoryInRepConfigParInconsistent)
 			printf("Consistency check of InRepot parameters in InFactory failed\n");
-		return EXIT_SUCCESS;
+		return 0;
 	}
 	printf("MA: Consistency check of configuration parameters ran successfully.\n");
 
+	/* Select the simulation clock if requested in the environment */
+	if (getenv(CR_DA_CLOCK_ENV_VAR) != NULL) {
+		CrDaClockSetMode(crDaClockSim);
+		printf("MA: Using the simulation clock\n");
+	}
+	CrDaClockSetPeriod((unsigned long long)CrDaProfileGet()->period*1000000ULL);
+
+	/* Open the shared-memory statistics page */
+	CrDaStatsOpen(CR_FW_HOST_APP_ID);
+
+	/* Open the span tracer if a dump directory is given in the environment */
+	if (getenv(CR_DA_TRACE_ENV_VAR) != NULL) {
+		CrDaTraceOpen(CR_FW_HOST_APP_ID, getenv(CR_DA_TRACE_ENV_VAR));
+		printf("MA: Tracing control cycles to %s\n", getenv(CR_DA_TRACE_ENV_VAR));
+	}
+
+	/* Open the packet recorder if a capture path is given in the environment */
+	if (getenv(CR_DA_REC_ENV_VAR) != NULL) {
+		if (CrDaPcktRecorderOpen(getenv(CR_DA_REC_ENV_VAR), CR_FW_HOST_APP_ID, CR_DA_REC_SEGMENT_SIZE,
+		                         CR_DA_REC_MAX_SEGMENTS))
+			printf("MA: Recording packets to %s\n", getenv(CR_DA_REC_ENV_VAR));
+	}
+
 	/* Create In- and OutStreams */
 	inStreamSlave1 = CrFwInStreamMake(0);
 	inStreamSlave2 = CrFwInStreamMake(1);
 	outStreamSlave1 = CrFwOutStreamMake(0);
 	outStreamSlave2 = CrFwOutStreamMake(1);
 
-	/* Set port number and host name */
+	/* Register the streams whose packet queues are sampled by the run statistics */
+	CrDaStatsAddStream(inStreamSlave1, inStreamPqSize[0]);
+	CrDaStatsAddStream(inStreamSlave2, inStreamPqSize[1]);
+	CrDaStatsAddStream(outStreamSlave1, outStreamPqSize[0]);
+	CrDaStatsAddStream(outStreamSlave2, outStreamPqSize[1]);
+
+#if defined(CR_DA_UDP)
+	/* Set base port number, host name and application identifier */
+	CrDaUdpSocketSetPort(CR_DA_UDP_PORT);
+	CrDaUdpSocketSetHost("localhost");
+	CrDaUdpSocketSetAppId(CR_FW_HOST_APP_ID);
+#elif !defined(CR_DA_LOOPBACK)
+	/* Set port number, host name and application identifier */
 	CrDaClientSocketSetPort(CR_DA_SOCKET_PORT);
 	CrDaClientSocketSetHost("localhost");
+	CrDaClientSocketSetAppId(CR_FW_HOST_APP_ID);
+#endif
 
 	/* Initialize the InStreams and OutStreams */
 	CrFwCmpInit(outStreamSlave1);
@@ -179,6 +259,18 @@ int main() {
 	if (!CrFwCmpIsInConfigured(outStreamSlave2))
 		return 0;
 
+#ifdef CR_DA_UDP
+	/* Create, initialize and configure the OutStream of the broadcast destination */
+	outStreamBroadcast = CrFwOutStreamMake(2);
+	CrDaStatsAddStream(outStreamBroadcast, outStreamPqSize[2]);
+	CrFwCmpInit(outStreamBroadcast);
+	if (!CrFwCmpIsInInitialized(outStreamBroadcast))
+		return 0;
+	CrFwCmpReset(outStreamBroadcast);
+	if (!CrFwCmpIsInConfigured(outStreamBroadcast))
+		return 0;
+#endif
+
 	/* Initialize and reset framework components */
 	fwCmp[0] = CrFwOutFactoryMake();
 	fwCmp[1] = CrFwInFactoryMake();
@@ -189,6 +281,7 @@ int main() {
 	fwCmp[6] = CrFwOutLoaderMake();
 	fwCmp[7] = CrFwOutRegistryMake();
 	fwCmp[8] = CrFwOutManagerMake(0);
+	fwCmp[9] = CrFwOutManagerMake(1);
 	for (i=0; i<CR_MA_N_OF_FW_CMP; i++) {
 		CrFwCmpInit(fwCmp[i]);
 		if (!CrFwCmpIsInInitialized(fwCmp[i]))
@@ -198,75 +291,335 @@ int main() {
 			return 0;
 	}
 
-	/* Execute control cycles */
-	for (i=1; i<100; i++) {
-		printf("MA: Starting cycle %d\n",i);
-		/* Set temperature limit in Slave 1 */
-		if (i == 10) {
-			CrMaOutCmpSetTempLimitSetTempLimit(TEMP_LIMIT);
-			outCmd = CrFwOutFactoryMakeOutCmp(CR_DA_SERV_TYPE,CR_DA_SERV_SUBTYPE_SET,0,0);
+	/* Register the managers whose pending lists are sampled by the run statistics */
+	CrDaStatsAddManager(CrFwInManagerMake(1), inManagerPcrlSize[1]);
+	CrDaStatsAddManager(CrFwOutManagerMake(0), outManagerPoclSize[0]);
+	CrDaStatsAddManager(CrFwOutManagerMake(1), outManagerPoclSize[1]);
+
+	/* Register the InStreams whose full packet queues hold back the packets of their source */
+	CrDaBackpressureAddInStream(inStreamSlave1, inStreamPqSize[0]);
+	CrDaBackpressureAddInStream(inStreamSlave2, inStreamPqSize[1]);
+
+	/* Register the queues and the low-priority commands of the Load State Machine */
+	CrDaLoadSmAddQueue(outStreamSlave1, outStreamPqSize[0]);
+	CrDaLoadSmAddQueue(outStreamSlave2, outStreamPqSize[1]);
+#ifdef CR_DA_UDP
+	CrDaLoadSmAddQueue(outStreamBroadcast, outStreamPqSize[2]);
+#endif
+	CrDaLoadSmAddQueue(CrFwOutManagerMake(0), outManagerPoclSize[0]);
+	CrDaLoadSmAddQueue(CrFwOutManagerMake(1), outManagerPoclSize[1]);
+	CrDaLoadSmAddKind(CR_DA_SERV_TYPE, CR_DA_SERV_SUBTYPE_SET, CR_DA_LOAD_SHEDDING);
+
+	/* Start the Application State Machine (the Load State Machine is embedded in NORMAL) */
+	FwSmStart(CrFwAppSmMake());
+
+	/* Start the collection of the run statistics */
+	CrDaStatsStart();
+
+	CrDaStartUpEnd("MA");
+#ifdef CR_DA_HEAP_GUARD
+	/* From now on, the control cycles must not allocate memory */
+	CrDaHeapGuardArm("MA");
+#endif
+	return 1;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrMaAppExecCycle(int cycle) {
+	CrDaClockStartCycle(cycle);
+	CrDaStatsStartCycle();
+	CrDaTraceStartCycle(cycle);
+	printf("MA: Starting cycle %d\n",cycle);
+	/* Execute the Application State Machine and the Load State Machine embedded in NORMAL */
+	CrDaTraceBegin("AppSm", -1);
+	FwSmExecute(CrFwAppSmMake());
+	CrDaTraceEnd("AppSm");
+	/* Load the commands of the run profile or of the fixed command schedule */
+	CrDaTraceBegin("load commands", -1);
+	if (CrDaProfileGet()->nOfCmdsPerCycle >= 0)
+		loadProfileCmds(cycle);
+	else
+		loadScheduledCmds(cycle);
+	CrDaTraceEnd("load commands");
+
+#ifdef CR_DA_LOOPBACK
+	/* Poll the bus queue for incoming packets */
+	CrDaTraceBegin("bus poll", -1);
+	CrDaLoopbackPoll();
+	CrDaTraceEnd("bus poll");
+#elif defined(CR_DA_UDP)
+	/* Poll the UDP socket for incoming reports */
+	CrDaTraceBegin("socket poll", -1);
+	CrDaUdpSocketPoll();
+	CrDaTraceEnd("socket poll");
+#else
+	/* Poll socket for incoming reports */
+	CrDaTraceBegin("socket poll", -1);
+	CrDaClientSocketPoll();
+	CrDaTraceEnd("socket poll");
+#endif
+	CrDaStatsSample();
+
+	/* Load packets from the two InStreams */
+	CrDaTraceBegin("InLoader", (int)CrFwInStreamGetSrc(inStreamSlave1));
+	CrFwInLoaderSetInStream(inStreamSlave1);
+	FwSmExecute(CrFwInLoaderMake());
+	CrDaTraceEnd("InLoader");
+	CrDaTraceBegin("InLoader", (int)CrFwInStreamGetSrc(inStreamSlave2));
+	CrFwInLoaderSetInStream(inStreamSlave2);
+	FwSmExecute(CrFwInLoaderMake());
+	CrDaTraceEnd("InLoader");
+	CrDaStatsSample();
+
+	/* Execute Managers */
+	CrDaTraceBegin("InManager", 1);
+	FwSmExecute(CrFwInManagerMake(1));	/* The first InManager is not used */
+	CrDaTraceEnd("InManager");
+	CrDaStatsSample();
+	CrDaOutLaneExec();	/* The bulk lane only runs within its budget of the cycle */
+
+	/* Check application errors */
+	if (CrFwGetAppErrCode() != crNoAppErr) {
+		printf("MA: Application Error Code is set and is equal to: %d\n",CrFwGetAppErrCode());
+	}
+
+	/* Update the run statistics */
+	CrDaTraceBegin("statistics", -1);
+	CrDaStatsEndCycle();
+	CrDaTraceEnd("statistics");
+
+	/* Prepare the next capture segment while the control thread is idle */
+	CrDaTraceBegin("recorder", -1);
+	CrDaPcktRecorderMaintain();
+	CrDaTraceEnd("recorder");
+
+	/* Dump the trace if requested or if the cycle overran its period */
+	CrDaTraceEndCycle();
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrMaAppTerm() {
+#ifdef CR_DA_HEAP_GUARD
+	CrDaHeapGuardDisarm();
+	CrDaHeapGuardPrintSummary("MA");
+#endif
+	CrDaStatsPrintSummary("MA");
+	CrDaOutLanePrintSummary("MA");
+	CrDaLoadSmPrintSummary("MA");
+	CrDaBackpressurePrintSummary("MA");
+#ifdef CR_DA_UDP
+	CrDaUdpLinkPrintSummary("MA");
+#endif
+	CrDaSizingPrintReport("MA", CrDaProfileGet()->headroom);
+	if (getenv(CR_DA_SIZING_ENV_VAR) != NULL)
+		CrDaSizingWriteHeaders(getenv(CR_DA_SIZING_ENV_VAR), "CrConfigDemoMaster", CrDaProfileGet()->headroom);
+	CrDaStatsClose();
+	CrDaTraceClose();
+	CrDaPcktRecorderClose();
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static void loadScheduledCmds(int cycle) {
+	FwSmDesc_t outCmd;
+
+	/* Set temperature limit in Slave 1 (the command is shed by the Load State Machine under load) */
+	if ((cycle == 10) && (CrDaLoadSmAdmit(CR_DA_SERV_TYPE,CR_DA_SERV_SUBTYPE_SET) == 1)) {
+		outCmd = CrFwOutFactoryMakeOutCmp(CR_DA_SERV_TYPE,CR_DA_SERV_SUBTYPE_SET,0,0);
+		if (outCmd == NULL) {
+			CrDaStatsCmdFail();
+		} else {
+			CrMaOutCmpSetTempLimitSetTempLimit(outCmd,TEMP_LIMIT);
 			CrFwOutCmpSetDest(outCmd,CR_DA_SLAVE_1);
 			CrFwOutLoaderLoad(outCmd);
 			printf("MA: Sending command to set the temperature limit in Slave 1 to %d degC\n",TEMP_LIMIT);
 		}
-		/* Set temperature limit in Slave 2 */
-		if (i == 11) {
-			CrMaOutCmpSetTempLimitSetTempLimit(TEMP_LIMIT);
-			outCmd = CrFwOutFactoryMakeOutCmp(CR_DA_SERV_TYPE,CR_DA_SERV_SUBTYPE_SET,0,0);
+	}
+	/* Set temperature limit in Slave 2 (the command is shed by the Load State Machine under load) */
+	if ((cycle == 11) && (CrDaLoadSmAdmit(CR_DA_SERV_TYPE,CR_DA_SERV_SUBTYPE_SET) == 1)) {
+		outCmd = CrFwOutFactoryMakeOutCmp(CR_DA_SERV_TYPE,CR_DA_SERV_SUBTYPE_SET,0,0);
+		if (outCmd == NULL) {
+			CrDaStatsCmdFail();
+		} else {
+			CrMaOutCmpSetTempLimitSetTempLimit(outCmd,TEMP_LIMIT);
 			CrFwOutCmpSetDest(outCmd,CR_DA_SLAVE_2);
 			CrFwOutLoaderLoad(outCmd);
 			printf("MA: Sending command to set the temperature limit in Slave 2 to %d degC\n",TEMP_LIMIT);
 		}
-		/* Enable temperature monitoring in Slave 1 in cycles which are multiples of 12 */
-		if ((i % 12) == 0) {
-			outCmd = CrFwOutFactoryMakeOutCmp(CR_DA_SERV_TYPE,CR_DA_SERV_SUBTYPE_EN,0,0);
-			CrFwOutCmpSetDest(outCmd,CR_DA_SLAVE_1);
-			CrFwOutLoaderLoad(outCmd);
-			printf("MA: Sending command to enable temperature monitoring in Slave 1\n");
-		}
-		/* Enable temperature monitoring in Slave 2 in cycles which are multiples of 15 */
-		if ((i % 15) == 0) {
-			outCmd = CrFwOutFactoryMakeOutCmp(CR_DA_SERV_TYPE,CR_DA_SERV_SUBTYPE_EN,0,0);
-			CrFwOutCmpSetDest(outCmd,CR_DA_SLAVE_2);
-			CrFwOutLoaderLoad(outCmd);
-			printf("MA: Sending command to enable temperature monitoring in Slave 2\n");
-		}
-		/* Disable temperature monitoring in Slave 1 in cycles which are multiples of 18 */
-		if ((i % 18) == 0) {
-			outCmd = CrFwOutFactoryMakeOutCmp(CR_DA_SERV_TYPE,CR_DA_SERV_SUBTYPE_DIS,0,0);
-			CrFwOutCmpSetDest(outCmd,CR_DA_SLAVE_1);
-			CrFwOutLoaderLoad(outCmd);
-			printf("MA: Sending command to disable temperature monitoring in Slave 1\n");
-		}
-		/* Disable temperature monitoring in Slave 2 in cycles which are multiples of 60 */
-		if ((i % 60) == 0) {
-			outCmd = CrFwOutFactoryMakeOutCmp(CR_DA_SERV_TYPE,CR_DA_SERV_SUBTYPE_DIS,0,0);
-			CrFwOutCmpSetDest(outCmd,CR_DA_SLAVE_2);
-			CrFwOutLoaderLoad(outCmd);
-			printf("MA: Sending command to disable temperature monitoring in Slave 2\n");
-		}
-		/* Poll socket for incoming reports */
-		CrDaClientSocketPoll();
-
-		/* Load packets from the two InStreams */
-		CrFwInLoaderSetInStream(inStreamSlave1);
-		FwSmExecute(CrFwInLoaderMake());
-		CrFwInLoaderSetInStream(inStreamSlave2);
-		FwSmExecute(CrFwInLoaderMake());
-
-		/* Execute Managers */
-		FwSmExecute(CrFwInManagerMake(1));	/* The first InManager is not used */
-		FwSmExecute(CrFwOutManagerMake(0));
-
-		/* Check application errors */
-		if (CrFwGetAppErrCode() != crNoAppErr) {
-			printf("MA: Application Error Code is set and is equal to: %d\n",CrFwGetAppErrCode());
+	}
+#ifdef CR_DA_UDP
+	/* Enable temperature monitoring in cycles which are multiples of 12 (multicast to all slaves) */
+	if ((cycle % 12) == 0) {
+		loadMonitoringCmd(CR_DA_SERV_SUBTYPE_EN, CR_DA_BROADCAST);
+		printf("MA: Sending command to enable temperature monitoring in all slaves\n");
+	}
+	/* Enable temperature monitoring in cycles which are multiples of 15 (multicast to all slaves) */
+	if ((cycle % 15) == 0) {
+		loadMonitoringCmd(CR_DA_SERV_SUBTYPE_EN, CR_DA_BROADCAST);
+		printf("MA: Sending command to enable temperature monitoring in all slaves\n");
+	}
+	/* Disable temperature monitoring in cycles which are multiples of 18 (multicast to all slaves) */
+	if ((cycle % 18) == 0) {
+		loadMonitoringCmd(CR_DA_SERV_SUBTYPE_DIS, CR_DA_BROADCAST);
+		printf("MA: Sending command to disable temperature monitoring in all slaves\n");
+	}
+	/* Disable temperature monitoring in cycles which are multiples of 60 (multicast to all slaves) */
+	if ((cycle % 60) == 0) {
+		loadMonitoringCmd(CR_DA_SERV_SUBTYPE_DIS, CR_DA_BROADCAST);
+		printf("MA: Sending command to disable temperature monitoring in all slaves\n");
+	}
+#else
+	/* Enable temperature monitoring in Slave 1 in cycles which are multiples of 12 */
+	if ((cycle % 12) == 0) {
+		loadMonitoringCmd(CR_DA_SERV_SUBTYPE_EN, CR_DA_SLAVE_1);
+		printf("MA: Sending command to enable temperature monitoring in Slave 1\n");
+	}
+	/* Enable temperature monitoring in Slave 2 in cycles which are multiples of 15 */
+	if ((cycle % 15) == 0) {
+		loadMonitoringCmd(CR_DA_SERV_SUBTYPE_EN, CR_DA_SLAVE_2);
+		printf("MA: Sending command to enable temperature monitoring in Slave 2\n");
+	}
+	/* Disable temperature monitoring in Slave 1 in cycles which are multiples of 18 */
+	if ((cycle % 18) == 0) {
+		loadMonitoringCmd(CR_DA_SERV_SUBTYPE_DIS, CR_DA_SLAVE_1);
+		printf("MA: Sending command to disable temperature monitoring in Slave 1\n");
+	}
+	/* Disable temperature monitoring in Slave 2 in cycles which are multiples of 60 */
+	if ((cycle % 60) == 0) {
+		loadMonitoringCmd(CR_DA_SERV_SUBTYPE_DIS, CR_DA_SLAVE_2);
+		printf("MA: Sending command to disable temperature monitoring in Slave 2\n");
+	}
+#endif
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static void loadMonitoringCmd(CrFwServSubType_t servSubType, CrFwDestSrc_t dest) {
+	FwSmDesc_t outCmd;
+
+	outCmd = CrFwOutFactoryMakeOutCmp(CR_DA_SERV_TYPE,servSubType,0,0);
+	if (outCmd == NULL) {
+		CrDaStatsCmdFail();
+		return;
+	}
+	CrFwOutCmpSetDest(outCmd,dest);
+	if (dest == CR_DA_BROADCAST)
+		CrFwOutCmpSetGroup(outCmd,CR_DA_BROADCAST_GROUP);
+	CrFwOutLoaderLoad(outCmd);
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static void loadProfileCmds(int cycle) {
+	const CrDaProfile_t* profile = CrDaProfileGet();
+	FwSmDesc_t outCmd;
+	CrFwPcktLength_t length = 0;
+	CrFwDestSrc_t dest;
+	char tempLimit;
+	int i;
+
+	/* Enable temperature monitoring in both slave applications in the first cycle */
+	if (cycle == 1) {
+#ifdef CR_DA_UDP
+		/* The command is serialized once and multicast to all slave applications */
+		loadMonitoringCmd(CR_DA_SERV_SUBTYPE_EN, CR_DA_BROADCAST);
+#else
+		loadMonitoringCmd(CR_DA_SERV_SUBTYPE_EN, CR_DA_SLAVE_1);
+		loadMonitoringCmd(CR_DA_SERV_SUBTYPE_EN, CR_DA_SLAVE_2);
+#endif
+	}
+
+	/* Compute the packet length for the payload size of the run profile */
+	if (profile->payloadSize > 0) {
+		if (profile->payloadSize > (unsigned int)(CrFwPcktGetMaxLength() - CR_DA_PCKT_PAR_OFFSET))
+			length = CrFwPcktGetMaxLength();
+		else
+			length = (CrFwPcktLength_t)(CR_DA_PCKT_PAR_OFFSET + profile->payloadSize);
+	}
+
+	/* Set the temperature limit alternately in Slave 1 and Slave 2 (each command sets a different limit) */
+	for (i=0; i<profile->nOfCmdsPerCycle; i++) {
+		/* The commands are shed by the Load State Machine under load */
+		if (CrDaLoadSmAdmit(CR_DA_SERV_TYPE,CR_DA_SERV_SUBTYPE_SET) == 0)
+			continue;
+		outCmd = CrFwOutFactoryMakeOutCmp(CR_DA_SERV_TYPE,CR_DA_SERV_SUBTYPE_SET,0,length);
+		if (outCmd == NULL) {
+			CrDaStatsCmdFail();
+			continue;
 		}
+		tempLimit = (char)(TEMP_LIMIT - TEMP_LIMIT_RANGE/2 + (cycle*profile->nOfCmdsPerCycle + i) % TEMP_LIMIT_RANGE);
+		dest = ((cycle+i)%2 == 0 ? CR_DA_SLAVE_2 : CR_DA_SLAVE_1);
+		CrMaOutCmpSetTempLimitSetTempLimit(outCmd,tempLimit);
+		CrFwOutCmpSetDest(outCmd,dest);
+		CrFwOutLoaderLoad(outCmd);
+		printf("MA: Sending command to set the temperature limit in Slave %d to %d degC\n",
+		       (dest == CR_DA_SLAVE_1 ? 1 : 2), tempLimit);
+	}
+}
+
+#ifndef CR_DA_LOOPBACK
+/**
+ * Main program for the Master Application.
+ * This Main Program performs the following actions:
+ * - It checks the consistency of the configuration parameters using
+ *   <code>::CrFwAuxConfigCheck</code>.
+ * - It initializes and configures the InStreams and OutStreams components
+ *   (note that their initialization action starts the connection of the client
+ *   socket to the server socket in the Slave 1 Application: the connection is
+ *   completed, and re-established if it is lost, by the socket poll function and
+ *   the applications can therefore be started in any order).
+ * - It initializes and configures all framework components used by the
+ *   Master Application.
+ * - It executes a loop and in every cycle of the loop commands may be
+ *   sent to the Slave Applications and reports may be received from them.
+ * .
+ * The schedule for sending commands to the Slave Applications is as follows:
+ * - In cycles which are multiples of 5, the command to set the temperature limit
+ *   in Slave 1 is sent
+ * - In cycles which are multiples of 6, the command to enable temperature monitoring
+ *   in Slave 1 is sent
+ * - In cycles which are multiples of 90, the command to disable temperature
+ *   monitoring in Slave 1 is sent
+ * .
+ * In all control cycles, the client socket waiting for reports from the two
+ * slave applications is polled through a call to <code>::CrDaClientSocketPoll</code>.
+ * When the application is compiled with <code>CR_DA_UDP</code> defined, the packets
+ * are exchanged as UDP datagrams and the UDP socket is polled instead through a call to
+ * <code>::CrDaUdpSocketPoll</code> (see <code>CrDaUdpSocket.h</code>).
+ * The commands which enable and disable temperature monitoring (in the fixed command
+ * schedule and in the first cycle of a run profile) are then sent once to the broadcast
+ * destination <code>#CR_DA_BROADCAST</code> and they are multicast to all slave applications.
+ *
+ * At the start of each control cycle, the Application State Machine is executed:
+ * the Load State Machine embedded in its NORMAL state sheds the low-priority traffic
+ * of the application under load (see <code>CrDaLoadSm.h</code>).
+ *
+ * The initialization, the control cycles and the termination of the application are
+ * implemented by <code>::CrMaAppInit</code>, <code>::CrMaAppExecCycle</code> and
+ * <code>::CrMaAppTerm</code> which are also called by the loopback harness
+ * of <code>CrDaLoopbackMain.c</code>.
+ *
+ * The number and the period of the control cycles and the traffic generated in each
+ * cycle are defined by the run profile which is set from the command line
+ * (see <code>CrDaProfile.h</code>).
+ * At the end of the run, a summary of the run statistics is printed
+ * (see <code>CrDaStats.h</code>).
+ * @param argc the number of command line arguments
+ * @param argv the command line arguments
+ * @return always returns EXIT_SUCCESS
+ */
+int main(int argc, char* argv[]) {
+	int i;
+
+	if (!CrMaAppInit(argc, argv))
+		return EXIT_SUCCESS;
+
+	/* Execute control cycles */
+	for (i=1; i<=(int)CrDaProfileGet()->nOfCycles; i++) {
+		CrMaAppExecCycle(i);
 
-		/* Wait 1 second and then continue */
-		sleep(1);
+		/* Wait for the start of the next cycle */
+		CrDaClockWaitCycleEnd();
 	}
 
+	CrMaAppTerm();
 	return EXIT_SUCCESS;
 }
-
+#endif
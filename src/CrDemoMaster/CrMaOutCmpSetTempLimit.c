@@ -37,18 +37,14 @@
 /* Include Demo Application files */
 #include "CrMaOutCmpSetTempLimit.h"
 
-/** The temperature limit */
-static char cmdTempLimit = 0;
-
 /*-----------------------------------------------------------------------------------------*/
 void CrMaOutCmpSetTempLimitSerialize(FwSmDesc_t smDesc) {
-	char* pcktPar = CrFwOutCmpGetParStart(smDesc);
 	CrFwOutCmpDefSerialize(smDesc);
 	CrFwOutCmpSetAckLevel(smDesc, 0, 1, 0, 0);
-	pcktPar[0] = cmdTempLimit;
 }
 
 /*-----------------------------------------------------------------------------------------*/
-void CrMaOutCmpSetTempLimitSetTempLimit(char tempLimit) {
-	cmdTempLimit = tempLimit;
+void CrMaOutCmpSetTempLimitSetTempLimit(FwSmDesc_t smDesc, char tempLimit) {
+	char* pcktPar = CrFwOutCmpGetParStart(smDesc);
+	pcktPar[0] = tempLimit;
 }
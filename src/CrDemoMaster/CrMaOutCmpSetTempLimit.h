@@ -14,11 +14,13 @@
  * - Ready Check Operation: the default Ready Check Operation of
  *   <code>CrFwSmCheckAlwaysTrue.h</code> is used.
  * - Serialize Operation: this operation calls the default Serialize Operation of
- *   <code>CrFwOutCmpDefSerialize.h</code> and then it writes the temperature
- *   limit in the first byte of the parameter part of the command packet; it sets
- *   the command destination (either Slave 1 or Slave 2); and it sets the acknowledge
+ *   <code>CrFwOutCmpDefSerialize.h</code> and then it sets the acknowledge
  *   level to acknowledge execution start.
  * .
+ * The temperature limit is not held by this module.
+ * It is written directly into the first byte of the parameter area of the packet of each
+ * OutComponent instance through <code>::CrMaOutCmpSetTempLimitSetTempLimit</code>
+ * before the OutComponent is loaded into the OutLoader.
  *
  * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
  * @author Alessandro Pasetti <pasetti@pnp-software.com>
@@ -44,20 +46,22 @@
 /**
  * Implementation of the Serialize Operation for the command setting the temperature limit.
  * This operation calls the default Serialize Operation of
- * <code>CrFwOutCmpDefSerialize.h</code> and then it writes the temperature
- * limit in the first byte of the parameter part of the command packet; and it sets the
+ * <code>CrFwOutCmpDefSerialize.h</code> and then it sets the
  * acknowledge level to "acknowledge execution start".
- * The value of the temperature limit is set through function
- * <code>::CrMaOutCmpSetTempLimitSetTempLimit</code>.
+ * The temperature limit is already in the packet (see
+ * <code>::CrMaOutCmpSetTempLimitSetTempLimit</code>).
  * @param smDesc the descriptor of the OutComponent state machine
  * @return the value of the Enable Flag
  */
 void CrMaOutCmpSetTempLimitSerialize(FwSmDesc_t smDesc);
 
 /**
- * Set the value of the temperature limit (an integer in the range 0 to 127).
- * @param tempLimit the temperature limit
+ * Set the value of the temperature limit in a command to set the temperature limit.
+ * The temperature limit is written in the first byte of the parameter area of the
+ * packet of the OutComponent.
+ * @param smDesc the descriptor of the OutComponent state machine
+ * @param tempLimit the temperature limit (an integer in the range 0 to 127)
  */
-void CrMaOutCmpSetTempLimitSetTempLimit(char tempLimit);
+void CrMaOutCmpSetTempLimitSetTempLimit(FwSmDesc_t smDesc, char tempLimit);
 
 #endif /* CRMA_OUTCMP_SET_TEMP_LIMIT_H_ */
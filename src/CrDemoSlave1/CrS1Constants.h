@@ -22,7 +22,7 @@
 #include "FwPrConstants.h"
 
 /** The number of framework components */
-#define CR_S1_N_OF_FW_CMP 8
+#define CR_S1_N_OF_FW_CMP 9
 
 /** The "low" temperature value */
 #define CR_S1_LOW_TEMP_VALUE 10
@@ -30,4 +30,16 @@
 /** The "high" temperature value */
 #define CR_S1_HIGH_TEMP_VALUE 90
 
+/** The maximum number of temperature channels monitored by the application (see <code>CrDaProfile.h</code>) */
+#define CR_S1_MAX_N_OF_CHANNELS 1024
+
+/** The lower limit of the temperature channels */
+#define CR_S1_CHANNEL_LOWER_LIMIT 0
+
+/** The upper limit of the temperature channels */
+#define CR_S1_CHANNEL_UPPER_LIMIT 50
+
+/** In a violation cycle, one channel in every <code>CR_S1_CHANNEL_STRIDE</code> channels is in violation */
+#define CR_S1_CHANNEL_STRIDE 64
+
 #endif /* CRFW_USERCONSTANTS_H_ */
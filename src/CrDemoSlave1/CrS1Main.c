@@ -57,10 +57,27 @@
 #include <unistd.h>
 /* Include Master Demo Files */
 #include "CrS1Constants.h"
+#include "CrS1Main.h"
 /* Include Common Demo Files */
 #include "CrDaConstants.h"
 #include "CrDaClientSocket.h"
 #include "CrDaServerSocket.h"
+#include "CrDaUdpSocket.h"
+#include "CrDaUdpLink.h"
+#include "CrDaPcktRecorder.h"
+#include "CrDaClock.h"
+#include "CrDaTempMonitor.h"
+#include "CrDaTempChannelMonitor.h"
+#include "CrDaProfile.h"
+#include "CrDaStartUp.h"
+#include "CrDaHeapGuard.h"
+#include "CrDaStats.h"
+#include "CrDaTrace.h"
+#include "CrDaSizing.h"
+#include "CrDaOutLane.h"
+#include "CrDaLoadSm.h"
+#include "CrDaBackpressure.h"
+#include "CrDaLoopback.h"
 /* Include FW Profile files */
 #include "FwSmConstants.h"
 #include "FwSmConfig.h"
@@ -70,6 +87,7 @@
 #include "FwPrConstants.h"
 /* Include framework files */
 #include "OutRegistry/CrFwOutRegistry.h"
+#include "AppStartUp/CrFwAppSm.h"
 #include "Aux/CrFwAux.h"
 #include "BaseCmp/CrFwBaseCmp.h"
 #include "Pckt/CrFwPckt.h"
@@ -87,39 +105,68 @@
 #include "CrFwOutRegistryUserPar.h"
 #include "CrFwOutFactoryUserPar.h"
 #include "CrFwInFactoryUserPar.h"
+#include "CrFwInStreamUserPar.h"
+#include "CrFwOutStreamUserPar.h"
+#include "CrFwInManagerUserPar.h"
+#include "CrFwOutManagerUserPar.h"
 #include "CrFwCmpData.h"
 
+/** The InStreams from which packets are loaded in every cycle */
+static FwSmDesc_t inStream1, inStream2;
+
+/** The temperature channels monitored by the application */
+static CrDaTempChannels_t channels;
+
+/** The number of temperature channels monitored by the application (zero if no channel array is monitored) */
+static unsigned int nOfChannels;
+
+/** The temperatures of the channels */
+static signed char channelTemp[CR_S1_MAX_N_OF_CHANNELS];
+
+/** The lower limits of the channels */
+static signed char channelLowerLimit[CR_S1_MAX_N_OF_CHANNELS];
+
+/** The upper limits of the channels */
+static signed char channelUpperLimit[CR_S1_MAX_N_OF_CHANNELS];
+
+/** The violation bitmask of the channels */
+static unsigned int channelViolationMask[CR_DA_TEMP_CHANNEL_MASK_SIZE(CR_S1_MAX_N_OF_CHANNELS)];
+
+/** The bitmask of the channels in violation since the last aggregated report */
+static unsigned int channelPendingMask[CR_DA_TEMP_CHANNEL_MASK_SIZE(CR_S1_MAX_N_OF_CHANNELS)];
+
+/** The last violating temperatures of the channels in violation since the last aggregated report */
+static signed char channelPendingTemp[CR_S1_MAX_N_OF_CHANNELS];
+
 /**
- * Main program for the Slave 1 Application.
- * This Main Program performs the following actions:
- * - It checks the consistency of the configuration parameters using
- *   <code>::CrFwAuxConfigCheck</code>.
- * - It initializes and configures the InStreams and OutStreams components
- *   (note that their initialization action initializes the server socket and
- *   this must be synchronized with the initialization of the client socket
- *   in the Master Application).
- * - It initializes and configures all framework components used by the
- *   Slave 1 Application.
- * - It executes a loop and in every cycle of the loop commands may be
- *   received from the Master Applications and reports may be sent to it.
- * .
- * In all control cycles, the server socket waiting for commands from the
- * Master Application or reports from the Slave 2 Application is polled
- * through a call to <code>::CrDaServerSocketPoll</code>.
- *
- * In principle, in all control cycles, the temperature to be monitored
- * should be acquired from some external device.
- * In this example, instead, the temperature is set to a "low" value in all
- * cycles except those which are multiples of 10 when it is set to a "high"
- * value.
- * @return always returns EXIT_SUCCESS
+ * Set the temperatures of the channels for a cycle.
+ * All channels are set to the "low" temperature value except, in a violation cycle,
+ * one channel in every <code>#CR_S1_CHANNEL_STRIDE</code> channels which is set to
+ * the "high" temperature value (the violating channels change from cycle to cycle).
+ * If the run profile defines the number of channels in violation (see
+ * <code>CrDaProfile.h</code>), that number of channels is instead spread over the
+ * channel array.
+ * @param cycle the cycle number
+ * @param violation 1 if the cycle is a violation cycle, 0 otherwise
  */
-int main() {
+static void setChannelTemps(int cycle, int violation);
+
+/* ---------------------------------------------------------------------------------------------*/
+int CrS1AppInit(int argc, char* argv[]) {
 	FwSmDesc_t fwCmp[CR_S1_N_OF_FW_CMP];
-	FwSmDesc_t inStream1, inStream2, outStream1, outStream2;
+	FwSmDesc_t outStream1, outStream2;
 	CrFwConfigCheckOutcome_t configCheckOutcome;
+	CrFwCounterU1_t inStreamPqSize[CR_FW_NOF_INSTREAM] = CR_FW_INSTREAM_PQSIZE;
+	CrFwCounterU1_t outStreamPqSize[CR_FW_NOF_OUTSTREAM] = CR_FW_OUTSTREAM_PQSIZE;
+	CrFwCounterU2_t inManagerPcrlSize[CR_FW_NOF_INMANAGER] = CR_FW_INMANAGER_PCRLSIZE;
+	CrFwCounterU2_t outManagerPoclSize[CR_FW_NOF_OUTMANAGER] = CR_FW_OUTMANAGER_POCLSIZE;
 	int i;
-	char temp;
+
+	CrDaStartUpBegin();
+
+	/* Set the run profile from the command line */
+	if (!CrDaProfileParse(argc, argv, CR_FW_HOST_APP_ID))
+		return 0;
 
 	/* Check consistency of configuration parameters */
 	configCheckOutcome = CrFwAuxConfigCheck();
@@ -132,18 +179,67 @@ int main() {
 			printf("Consistency check of InCommand parameters in InFactory failed\n");
 		if (configCheckOutcome == crInFactoryInRepConfigParInconsistent)
 			printf("Consistency check of InRepot parameters in InFactory failed\n");
-		return EXIT_SUCCESS;
+		return 0;
 	}
 	printf("S1: Consistency check of configuration parameters ran successfully.\n");
 
+	/* Select the simulation clock if requested in the environment */
+	if (getenv(CR_DA_CLOCK_ENV_VAR) != NULL) {
+		CrDaClockSetMode(crDaClockSim);
+		printf("S1: Using the simulation clock\n");
+	}
+	CrDaClockSetPeriod((unsigned long long)CrDaProfileGet()->period*1000000ULL);
+
+	/* Open the shared-memory statistics page */
+	CrDaStatsOpen(CR_FW_HOST_APP_ID);
+
+	/* Initialize the temperature channels if the run profile defines a channel array */
+	nOfChannels = CrDaProfileGet()->nOfChannels;
+	if (nOfChannels > CR_S1_MAX_N_OF_CHANNELS)
+		nOfChannels = CR_S1_MAX_N_OF_CHANNELS;
+	if (nOfChannels > 0) {
+		CrDaTempChannelMonitorInit(&channels, nOfChannels, channelTemp, channelLowerLimit,
+		                           channelUpperLimit, channelViolationMask, channelPendingMask, channelPendingTemp);
+		for (i=0; i<(int)nOfChannels; i++)
+			CrDaTempChannelMonitorSetLimits(&channels, (unsigned int)i, CR_S1_CHANNEL_LOWER_LIMIT,
+			                                CR_S1_CHANNEL_UPPER_LIMIT);
+		printf("S1: Monitoring %u temperature channels\n", nOfChannels);
+	}
+
+	/* Open the span tracer if a dump directory is given in the environment */
+	if (getenv(CR_DA_TRACE_ENV_VAR) != NULL) {
+		CrDaTraceOpen(CR_FW_HOST_APP_ID, getenv(CR_DA_TRACE_ENV_VAR));
+		printf("S1: Tracing control cycles to %s\n", getenv(CR_DA_TRACE_ENV_VAR));
+	}
+
+	/* Open the packet recorder if a capture path is given in the environment */
+	if (getenv(CR_DA_REC_ENV_VAR) != NULL) {
+		if (CrDaPcktRecorderOpen(getenv(CR_DA_REC_ENV_VAR), CR_FW_HOST_APP_ID, CR_DA_REC_SEGMENT_SIZE,
+		                         CR_DA_REC_MAX_SEGMENTS))
+			printf("S1: Recording packets to %s\n", getenv(CR_DA_REC_ENV_VAR));
+	}
+
 	/* Create In- and OutStreams */
 	inStream1 = CrFwInStreamMake(0);
 	inStream2 = CrFwInStreamMake(1);
 	outStream1 = CrFwOutStreamMake(0);
 	outStream2 = CrFwOutStreamMake(1);
 
+	/* Register the streams whose packet queues are sampled by the run statistics */
+	CrDaStatsAddStream(inStream1, inStreamPqSize[0]);
+	CrDaStatsAddStream(inStream2, inStreamPqSize[1]);
+	CrDaStatsAddStream(outStream1, outStreamPqSize[0]);
+	CrDaStatsAddStream(outStream2, outStreamPqSize[1]);
+
+#if defined(CR_DA_UDP)
+	/* Set base port number, host name and application identifier */
+	CrDaUdpSocketSetPort(CR_DA_UDP_PORT);
+	CrDaUdpSocketSetHost("localhost");
+	CrDaUdpSocketSetAppId(CR_FW_HOST_APP_ID);
+#elif !defined(CR_DA_LOOPBACK)
 	/* Set port number */
 	CrDaServerSocketSetPort(CR_DA_SOCKET_PORT);
+#endif
 
 	/* Initialize the InStreams and OutStreams */
 	CrFwCmpInit(outStream1);
@@ -159,9 +255,6 @@ int main() {
 	if (!CrFwCmpIsInInitialized(inStream2))
 		return 0;
 
-	printf("S1: Wait 5 seconds (to give time to the client sockets applications to start) and then continue\n");
-	sleep(5);
-
 	/* Configure the InStream and OutStream */
 	CrFwCmpReset(inStream1);
 	CrFwCmpReset(inStream2);
@@ -185,6 +278,7 @@ int main() {
 	fwCmp[5] = CrFwOutLoaderMake();
 	fwCmp[6] = CrFwOutRegistryMake();
 	fwCmp[7] = CrFwOutManagerMake(0);
+	fwCmp[8] = CrFwOutManagerMake(1);
 	for (i=0; i<CR_S1_N_OF_FW_CMP; i++) {
 		CrFwCmpInit(fwCmp[i]);
 		if (!CrFwCmpIsInInitialized(fwCmp[i]))
@@ -194,38 +288,237 @@ int main() {
 			return 0;
 	}
 
+	/* Register the managers whose pending lists are sampled by the run statistics */
+	CrDaStatsAddManager(CrFwInManagerMake(0), inManagerPcrlSize[0]);
+	CrDaStatsAddManager(CrFwOutManagerMake(0), outManagerPoclSize[0]);
+	CrDaStatsAddManager(CrFwOutManagerMake(1), outManagerPoclSize[1]);
+
+	/* Register the InStreams whose full packet queues hold back the packets of their source */
+	CrDaBackpressureAddInStream(inStream1, inStreamPqSize[0]);
+	CrDaBackpressureAddInStream(inStream2, inStreamPqSize[1]);
+
+	/* Register the queues of the Load State Machine (the violation reports are coalesced rather than suppressed) */
+	CrDaLoadSmAddQueue(outStream1, outStreamPqSize[0]);
+	CrDaLoadSmAddQueue(outStream2, outStreamPqSize[1]);
+	CrDaLoadSmAddQueue(CrFwOutManagerMake(0), outManagerPoclSize[0]);
+	CrDaLoadSmAddQueue(CrFwOutManagerMake(1), outManagerPoclSize[1]);
+
+	/* Start the Application State Machine (the Load State Machine is embedded in NORMAL) */
+	FwSmStart(CrFwAppSmMake());
+
+	/* Start the collection of the run statistics */
+	CrDaStatsStart();
+
+	CrDaStartUpEnd("S1");
+#ifdef CR_DA_HEAP_GUARD
+	/* From now on, the control cycles must not allocate memory */
+	CrDaHeapGuardArm("S1");
+#endif
+	return 1;
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrS1AppExecCycle(int cycle) {
+	char temp;
+	int violation;
+
+	CrDaClockStartCycle(cycle);
+	CrDaStatsStartCycle();
+	CrDaTraceStartCycle(cycle);
+	printf("S1: Starting cycle %d\n",cycle);
+	/* Execute the Application State Machine and the Load State Machine embedded in NORMAL */
+	CrDaTraceBegin("AppSm", -1);
+	FwSmExecute(CrFwAppSmMake());
+	CrDaTraceEnd("AppSm");
+	/* Set temperature value (randomly if the run profile defines a violation probability) */
+	if (CrDaProfileGet()->violationProb >= 0)
+		violation = (CrDaProfileRandom() < CrDaProfileGet()->violationProb);
+	else
+		violation = (cycle%10 == 0);
+	if (!violation)
+		temp = CR_S1_LOW_TEMP_VALUE;
+	else
+		temp = CR_S1_HIGH_TEMP_VALUE;
+	/* Perform temperature monitoring action */
+	CrDaTraceBegin("temp monitoring", -1);
+	CrDaTempMonitoringExec(temp, CR_FW_HOST_APP_ID);
+	CrDaTraceEnd("temp monitoring");
+	/* Perform temperature monitoring action on the channels (one aggregated report per coalescing interval) */
+	if (nOfChannels > 0) {
+		CrDaTraceBegin("channel monitoring", -1);
+		setChannelTemps(cycle, violation);
+		CrDaTempMonitoringExecChannels(&channels, CR_FW_HOST_APP_ID);
+		CrDaTraceEnd("channel monitoring");
+	}
+
+#ifdef CR_DA_LOOPBACK
+	/* Poll the bus queue for incoming packets */
+	CrDaTraceBegin("bus poll", -1);
+	CrDaLoopbackPoll();
+	CrDaTraceEnd("bus poll");
+#elif defined(CR_DA_UDP)
+	/* Poll the UDP socket for incoming reports */
+	CrDaTraceBegin("socket poll", -1);
+	CrDaUdpSocketPoll();
+	CrDaTraceEnd("socket poll");
+#else
+	/* Poll socket for incoming reports */
+	CrDaTraceBegin("socket poll", -1);
+	CrDaServerSocketPoll();
+	CrDaTraceEnd("socket poll");
+#endif
+	CrDaStatsSample();
+
+	/* Load packets from the two InStreams */
+	CrDaTraceBegin("InLoader", (int)CrFwInStreamGetSrc(inStream1));
+	CrFwInLoaderSetInStream(inStream1);
+	FwSmExecute(CrFwInLoaderMake());
+	CrDaTraceEnd("InLoader");
+	CrDaTraceBegin("InLoader", (int)CrFwInStreamGetSrc(inStream2));
+	CrFwInLoaderSetInStream(inStream2);
+	FwSmExecute(CrFwInLoaderMake());
+	CrDaTraceEnd("InLoader");
+	CrDaStatsSample();
+
+	/* Execute Managers */
+	CrDaTraceBegin("InManager", 0);
+	FwSmExecute(CrFwInManagerMake(0));
+	CrDaTraceEnd("InManager");
+	CrDaStatsSample();
+	CrDaOutLaneExec();	/* The bulk lane only runs within its budget of the cycle */
+
+	/* Check application errors */
+	if (CrFwGetAppErrCode() != crNoAppErr) {
+		printf("S1: Application Error Code is set and is equal to: %d\n",CrFwGetAppErrCode());
+	}
+
+	/* Update the run statistics */
+	CrDaTraceBegin("statistics", -1);
+	CrDaStatsEndCycle();
+	CrDaTraceEnd("statistics");
+
+	/* Prepare the next capture segment while the control thread is idle */
+	CrDaTraceBegin("recorder", -1);
+	CrDaPcktRecorderMaintain();
+	CrDaTraceEnd("recorder");
+
+	/* Dump the trace if requested or if the cycle overran its period */
+	CrDaTraceEndCycle();
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+void CrS1AppTerm() {
+#ifdef CR_DA_HEAP_GUARD
+	CrDaHeapGuardDisarm();
+	CrDaHeapGuardPrintSummary("S1");
+#endif
+	CrDaStatsPrintSummary("S1");
+	CrDaOutLanePrintSummary("S1");
+	CrDaLoadSmPrintSummary("S1");
+	CrDaBackpressurePrintSummary("S1");
+#ifdef CR_DA_UDP
+	CrDaUdpLinkPrintSummary("S1");
+#endif
+	CrDaSizingPrintReport("S1", CrDaProfileGet()->headroom);
+	if (getenv(CR_DA_SIZING_ENV_VAR) != NULL)
+		CrDaSizingWriteHeaders(getenv(CR_DA_SIZING_ENV_VAR), "CrConfigDemoSlave1", CrDaProfileGet()->headroom);
+	CrDaStatsClose();
+	CrDaTraceClose();
+	CrDaPcktRecorderClose();
+}
+
+/* ---------------------------------------------------------------------------------------------*/
+static void setChannelTemps(int cycle, int violation) {
+	unsigned int i, nOfViolating;
+
+	memset(channelTemp, CR_S1_LOW_TEMP_VALUE, nOfChannels);
+	if (!violation)
+		return;
+	if (CrDaProfileGet()->nOfViolatingChannels >= 0) {
+		nOfViolating = (unsigned int)CrDaProfileGet()->nOfViolatingChannels;
+		if (nOfViolating > nOfChannels)
+			nOfViolating = nOfChannels;
+		for (i=0; i<nOfViolating; i++)
+			channelTemp[(i*nOfChannels/nOfViolating + (unsigned int)cycle) % nOfChannels] =
+			    CR_S1_HIGH_TEMP_VALUE;
+		return;
+	}
+	for (i=(unsigned int)cycle%CR_S1_CHANNEL_STRIDE; i<nOfChannels; i+=CR_S1_CHANNEL_STRIDE)
+		channelTemp[i] = CR_S1_HIGH_TEMP_VALUE;
+}
+
+#ifndef CR_DA_LOOPBACK
+/**
+ * Main program for the Slave 1 Application.
+ * This Main Program performs the following actions:
+ * - It checks the consistency of the configuration parameters using
+ *   <code>::CrFwAuxConfigCheck</code>.
+ * - It initializes and configures the InStreams and OutStreams components
+ *   (note that their initialization action initializes the server socket: the
+ *   connections from the client sockets of the Master and Slave 2 Applications
+ *   are accepted by the socket poll function and the applications can therefore
+ *   be started in any order).
+ * - It initializes and configures all framework components used by the
+ *   Slave 1 Application.
+ * - It executes a loop and in every cycle of the loop commands may be
+ *   received from the Master Applications and reports may be sent to it.
+ * .
+ * In all control cycles, the server socket waiting for commands from the
+ * Master Application or reports from the Slave 2 Application is polled
+ * through a call to <code>::CrDaServerSocketPoll</code>.
+ * When the application is compiled with <code>CR_DA_UDP</code> defined, the packets
+ * are exchanged as UDP datagrams and the UDP socket is polled instead through a call to
+ * <code>::CrDaUdpSocketPoll</code> (see <code>CrDaUdpSocket.h</code>).
+ *
+ * In principle, in all control cycles, the temperature to be monitored
+ * should be acquired from some external device.
+ * In this example, instead, the temperature is set to a "low" value in all
+ * cycles except those which are multiples of 10 when it is set to a "high"
+ * value.
+ * If the run profile defines a violation probability (see <code>CrDaProfile.h</code>),
+ * the temperature is instead set to the "high" value with that probability.
+ *
+ * If the run profile defines a number of temperature channels, the application also
+ * monitors an array of that many channels (at most <code>#CR_S1_MAX_N_OF_CHANNELS</code>, see
+ * <code>::CrDaTempMonitoringExecChannels</code>).
+ * In the cycles in which the temperature is "high", one channel in every
+ * <code>#CR_S1_CHANNEL_STRIDE</code> channels is in violation and the violating channels
+ * are reported to the Master Application in one aggregated report (under load, the
+ * violations of several cycles are coalesced into one report).
+ *
+ * At the start of each control cycle, the Application State Machine is executed:
+ * the Load State Machine embedded in its NORMAL state sheds the low-priority traffic
+ * of the application under load (see <code>CrDaLoadSm.h</code>).
+ *
+ * The initialization, the control cycles and the termination of the application are
+ * implemented by <code>::CrS1AppInit</code>, <code>::CrS1AppExecCycle</code> and
+ * <code>::CrS1AppTerm</code> which are also called by the loopback harness
+ * of <code>CrDaLoopbackMain.c</code>.
+ *
+ * The number and the period of the control cycles and the traffic generated in each
+ * cycle are defined by the run profile which is set from the command line
+ * (see <code>CrDaProfile.h</code>).
+ * At the end of the run, a summary of the run statistics is printed
+ * (see <code>CrDaStats.h</code>).
+ * @param argc the number of command line arguments
+ * @param argv the command line arguments
+ * @return always returns EXIT_SUCCESS
+ */
+int main(int argc, char* argv[]) {
+	int i;
+
+	if (!CrS1AppInit(argc, argv))
+		return EXIT_SUCCESS;
+
 	/* Execute control cycles */
-	for (i=1; i<100; i++) {
-		printf("S1: Starting cycle %d\n",i);
-		/* Set temperature value */
-		if (i%10 != 0)
-			temp = CR_S1_LOW_TEMP_VALUE;
-		else
-			temp = CR_S1_HIGH_TEMP_VALUE;
-		/* Perform temperature monitoring action */
-		CrDaTempMonitoringExec(temp, CR_FW_HOST_APP_ID);
-
-		/* Poll socket for incoming reports */
-		CrDaServerSocketPoll();
-
-		/* Load packets from the two InStreams */
-		CrFwInLoaderSetInStream(inStream1);
-		FwSmExecute(CrFwInLoaderMake());
-		CrFwInLoaderSetInStream(inStream2);
-		FwSmExecute(CrFwInLoaderMake());
-
-		/* Execute Managers */
-		FwSmExecute(CrFwInManagerMake(0));
-		FwSmExecute(CrFwOutManagerMake(0));
-
-		/* Check application errors */
-		if (CrFwGetAppErrCode() != crNoAppErr) {
-			printf("S1: Application Error Code is set and is equal to: %d\n",CrFwGetAppErrCode());
-		}
-
-		/* Wait 1 second and then continue */
-		sleep(1);
+	for (i=1; i<=(int)CrDaProfileGet()->nOfCycles; i++) {
+		CrS1AppExecCycle(i);
+
+		/* Wait for the start of the next cycle */
+		CrDaClockWaitCycleEnd();
 	}
 
+	CrS1AppTerm();
 	return EXIT_SUCCESS;
 }
+#endif
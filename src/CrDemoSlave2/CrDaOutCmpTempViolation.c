@@ -1,52 +0,0 @@
-/**
- * @file
- * @ingroup crDemoSlave2
- * Implementation of the command to set the temperature limit.
- *
- * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
- * @author Alessandro Pasetti <pasetti@pnp-software.com>
- * @copyright P&P Software GmbH, 2013, All Rights Reserved
- *
- * This file is part of the CORDET Framework.
- *
- * This Source Code Form is subject to the terms of the Mozilla Public
- * License, v. 2.0. If a copy of the MPL was not distributed with this
- * file, You can obtain one at http://mozilla.org/MPL/2.0/.
- *
- * For information on alternative licensing, please contact P&P Software GmbH.
- */
-
-#include <stdlib.h>
-#include "CrDaConstants.h"
-/* Include configuration files */
-#include "CrFwCmpData.h"
-/* Include framework files */
-#include "CrFwConstants.h"
-#include "OutCmp/CrFwOutCmp.h"
-#include "BaseCmp/CrFwBaseCmp.h"
-#include "BaseCmp/CrFwInitProc.h"
-#include "BaseCmp/CrFwResetProc.h"
-#include "BaseCmp/CrFwDummyExecProc.h"
-#include "OutFactory/CrFwOutFactory.h"
-#include "Pckt/CrFwPckt.h"
-/* Include FW Profile files */
-#include "FwPrConfig.h"
-#include "FwPrDCreate.h"
-#include "FwSmConfig.h"
-#include "FwSmDCreate.h"
-#include "FwPrCore.h"
-
-/** The limit violating temperature */
-static char limitViolatingTemp = 0;
-
-/*-----------------------------------------------------------------------------------------*/
-void CrDaOutCmpTempViolationSerialize(FwSmDesc_t smDesc) {
-	char* pcktPar = CrFwOutCmpGetParStart(smDesc);
-	CrFwOutCmpDefSerialize(smDesc);
-	pcktPar[0] = limitViolatingTemp;
-}
-
-/*-----------------------------------------------------------------------------------------*/
-void CrDaOutCmpTempViolationSetTemp(char temp) {
-	limitViolatingTemp = temp;
-}
@@ -0,0 +1,59 @@
+/**
+ * @file
+ * @ingroup crDemoSlave2
+ * Interface to the initialization, control cycle and termination of the Slave 2 Application.
+ * These functions are called by the main program of the Slave 2 Application
+ * (see <code>CrS2Main.c</code>) and, in the loopback configuration of the
+ * CORDET Demo, by the loopback harness (see <code>CrDaLoopbackMain.c</code>).
+ * In the loopback configuration, they are the only global symbols of the
+ * Slave 2 Application and they therefore only use plain C types.
+ *
+ * @author Vaclav Cechticky <vaclav.cechticky@pnp-software.com>
+ * @author Alessandro Pasetti <pasetti@pnp-software.com>
+ * @copyright P&P Software GmbH, 2013, All Rights Reserved
+ *
+ * This file is part of the CORDET Framework.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For information on alternative licensing, please contact P&P Software GmbH.
+ */
+
+#ifndef CRS2_MAIN_H_
+#define CRS2_MAIN_H_
+
+/**
+ * Initialize the Slave 2 Application.
+ * This function checks the consistency of the configuration parameters and
+ * initializes and configures the InStreams, the OutStreams and all the other
+ * framework components used by the Slave 2 Application.
+ * The run profile is set from the command line (see <code>CrDaProfile.h</code>).
+ * @param argc the number of command line arguments
+ * @param argv the command line arguments
+ * @return 1 if the initialization was successful, 0 otherwise
+ */
+int CrS2AppInit(int argc, char* argv[]);
+
+/**
+ * Execute one control cycle of the Slave 2 Application.
+ * In a control cycle, the temperature monitoring action is executed, the incoming packets are
+ * collected and loaded and the InManager and the OutManagers of the priority lanes are executed
+ * (see <code>CrDaOutLane.h</code>).
+ * @param cycle the cycle number (starting from 1)
+ */
+void CrS2AppExecCycle(int cycle);
+
+/**
+ * Terminate the Slave 2 Application.
+ * This function prints the summary of the run statistics, the summary of the priority
+ * lanes (see <code>CrDaOutLane.h</code>) and the sizing report (see
+ * <code>CrDaSizing.h</code>), writes the sized configuration files if the environment
+ * variable <code>#CR_DA_SIZING_ENV_VAR</code> is set and closes the statistics page
+ * (see <code>CrDaStats.h</code>), the span tracer (see <code>CrDaTrace.h</code>) and
+ * the packet recorder (see <code>CrDaPcktRecorder.h</code>).
+ */
+void CrS2AppTerm();
+
+#endif /* CRS2_MAIN_H_ */